@@ -0,0 +1,77 @@
+#!/bin/bash
+
+#
+#	Compiler phase microbenchmark: run the Newton and Noisy compilers over
+#	the applications/newton and applications/noisy corpora with --trace-json,
+#	and sum the time spent in one phase (e.g., "lex" or "parse") of each run.
+#
+#	Usage: phaseThroughput.sh <path to repository root> <phase> [iterations]
+#
+#	To measure a change, run it on builds of the revisions before and
+#	after the change and compare the reported throughput.
+#
+#	The corpora are copied into a scratch directory first, since the
+#	Noisy compiler writes a .bc file next to each input.
+#
+
+repositoryDir=$(cd $1 && pwd)
+phase=$2
+iterations=${3:-5}
+scratchDir=$(mktemp -d)
+
+newtonBinary=$(ls $repositoryDir/src/newton/newton-*-EN | head -1)
+noisyBinary=$(ls $repositoryDir/src/noisy/noisy-*-EN | head -1)
+
+cp -R $repositoryDir/applications/newton $scratchDir/newton
+cp -R $repositoryDir/applications/noisy $scratchDir/noisy
+cp $repositoryDir/applications/newton/include/NewtonBaseSignals.nt $scratchDir/newton/
+
+#
+#	Prints the total microseconds between the B and E events of $phase in a trace.
+#
+phaseMicroseconds()
+{
+	awk -F'"ts": ' -v b="\"name\": \"$phase\", \"ph\": \"B\"" -v e="\"name\": \"$phase\", \"ph\": \"E\"" 'index($0, b) {split($2, t, "}"); begin = t[1]} index($0, e) {split($2, t, "}"); total += t[1] - begin} END {printf "%.3f", total}' $1
+}
+
+benchmark()
+{
+	binary=$1
+	corpusDir=$2
+	pattern=$3
+
+	files=$(cd $corpusDir && find . -name "$pattern" -type f)
+	totalBytes=0
+	totalMicroseconds=0
+	phaseRuns=0
+
+	for file in $files
+	do
+		for (( i=1; i<=$iterations; i++ ))
+		do
+			rm -f $scratchDir/trace.json
+			(cd $corpusDir && $binary --trace-json $scratchDir/trace.json $file > /dev/null 2>&1)
+
+			if [ ! -s $scratchDir/trace.json ]
+			then
+				continue
+			fi
+
+			microseconds=$(phaseMicroseconds $scratchDir/trace.json)
+			totalMicroseconds=$(echo "$totalMicroseconds + $microseconds" | bc)
+			totalBytes=$(( totalBytes + $(wc -c < $corpusDir/$file) ))
+			phaseRuns=$(( phaseRuns + 1 ))
+		done
+	done
+
+	echo "$(basename $binary): $phaseRuns runs, $totalBytes bytes, $totalMicroseconds us in $phase phase"
+	if [ $(echo "$totalMicroseconds > 0" | bc) -eq 1 ]
+	then
+		echo "    throughput: $(echo "scale=2; $totalBytes / $totalMicroseconds" | bc) MB/s"
+	fi
+}
+
+benchmark $newtonBinary $scratchDir/newton "*.n*"
+benchmark $noisyBinary $scratchDir/noisy "*.n*"
+
+rm -rf $scratchDir
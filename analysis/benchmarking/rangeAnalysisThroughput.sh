@@ -0,0 +1,70 @@
+#!/bin/bash
+
+#
+#	Range analysis microbenchmark: compile the applications/newton/llvm-ir
+#	c-files and CHStone sources to LLVM IR, run the Newton LLVM IR range
+#	optimizations over each with --trace-json, and sum the time spent in
+#	the "range analysis" phase of each run.
+#
+#	Usage: rangeAnalysisThroughput.sh <path to repository root> [iterations]
+#
+#	Needs clang and opt on the PATH, as the llvm-ir Makefiles do. To measure
+#	a change, run it on builds of the revisions before and after the change
+#	and compare the reported times.
+#
+#	The IR is generated in a scratch directory, since the Newton compiler
+#	writes its output next to each input.
+#
+
+repositoryDir=$(cd $1 && pwd)
+iterations=${2:-5}
+scratchDir=$(mktemp -d)
+
+newtonBinary=$(ls $repositoryDir/src/newton/newton-*-EN | head -1)
+description=$repositoryDir/applications/newton/sensors/test.nt
+
+cp -R $repositoryDir/applications/newton/llvm-ir $scratchDir/llvm-ir
+(cd $scratchDir/llvm-ir && make > /dev/null 2>&1)
+(cd $scratchDir/llvm-ir/CHStone_test && make > /dev/null 2>&1)
+
+#
+#	Prints the total microseconds between the B and E events of the phase in a trace.
+#
+phaseMicroseconds()
+{
+	awk -F'"ts": ' -v b='"name": "range analysis", "ph": "B"' -v e='"name": "range analysis", "ph": "E"' 'index($0, b) {split($2, t, "}"); begin = t[1]} index($0, e) {split($2, t, "}"); total += t[1] - begin} END {printf "%.3f", total}' $1
+}
+
+totalMicroseconds=0
+totalRuns=0
+
+for file in $(find $scratchDir/llvm-ir -maxdepth 2 -name "*.ll" ! -name "*_output*" -type f | sort)
+do
+	fileMicroseconds=0
+	fileRuns=0
+
+	for (( i=1; i<=$iterations; i++ ))
+	do
+		rm -f $scratchDir/trace.json
+		$newtonBinary --trace-json $scratchDir/trace.json --llvm-ir=$file --llvm-ir-liveness-check $description > /dev/null 2>&1
+
+		if [ ! -s $scratchDir/trace.json ]
+		then
+			continue
+		fi
+
+		fileMicroseconds=$(echo "$fileMicroseconds + $(phaseMicroseconds $scratchDir/trace.json)" | bc)
+		fileRuns=$(( fileRuns + 1 ))
+	done
+
+	if [ $fileRuns -gt 0 ]
+	then
+		echo "$(basename $file): $(echo "scale=3; $fileMicroseconds / $fileRuns" | bc) us per run"
+		totalMicroseconds=$(echo "$totalMicroseconds + $fileMicroseconds" | bc)
+		totalRuns=$(( totalRuns + fileRuns ))
+	fi
+done
+
+echo "$(basename $newtonBinary): $totalRuns runs, $totalMicroseconds us in range analysis phase"
+
+rm -rf $scratchDir
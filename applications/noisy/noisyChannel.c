@@ -0,0 +1,229 @@
+/*
+ *	Each direction of a channel is a bounded ring of Vyukov's design: the
+ *	slot for position p is free when its sequence is p and holds a message
+ *	when its sequence is p + 1. Each side of a ring takes positions from a
+ *	counter of its own, with fetch-and-add when several workers share that
+ *	side and with a plain store when one does.
+ *
+ *	The instance side of both rings belongs to whoever holds the channel.
+ *	A worker that waits on a ring tries to take the channel and, if it
+ *	gets it, hands every pending send to the instance and makes a message
+ *	for every pending receive, so one worker does the work of the others
+ *	while they wait. Sends come first, and a send returns only once the
+ *	instance has taken its message, so a body that sends and then receives
+ *	gets what the instance made after its send, as without channels.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <sched.h>
+#include "noisyChannel.h"
+
+enum
+{
+	kNoisyChannelSlots		= 64,
+	kNoisyChannelSlotHeader		= 16,
+	kNoisyChannelCacheLine		= 64,
+};
+
+typedef struct
+{
+	int64_t			enter __attribute__((aligned(kNoisyChannelCacheLine)));
+	int64_t			leave __attribute__((aligned(kNoisyChannelCacheLine)));
+	int64_t			messageSize;
+	int64_t			slotSize;
+	uint8_t *		slots;
+} NoisyChannelRing;
+
+struct NoisyChannel
+{
+	NoisyChannelRing	writes;
+	NoisyChannelRing	reads;
+	int64_t			served __attribute__((aligned(kNoisyChannelCacheLine)));
+	int			busy __attribute__((aligned(kNoisyChannelCacheLine)));
+	bool			isShared;
+	void *			instance;
+	void *			input;
+	NoisyChannelServe	write;
+	NoisyChannelServe	read;
+};
+
+static int64_t *
+noisyChannelSequence(NoisyChannelRing *  ring, int64_t position)
+{
+	return (int64_t *)(ring->slots + (position & (kNoisyChannelSlots - 1)) * ring->slotSize);
+}
+
+static void *
+noisyChannelMessage(NoisyChannelRing *  ring, int64_t position)
+{
+	return (uint8_t *)noisyChannelSequence(ring, position) + kNoisyChannelSlotHeader;
+}
+
+static int64_t
+noisyChannelReserve(int64_t *  counter, bool isShared)
+{
+	if (isShared)
+	{
+		return __atomic_fetch_add(counter, 1, __ATOMIC_RELAXED);
+	}
+
+	int64_t	position = __atomic_load_n(counter, __ATOMIC_RELAXED);
+	__atomic_store_n(counter, position + 1, __ATOMIC_RELAXED);
+
+	return position;
+}
+
+static bool
+noisyChannelServe(NoisyChannel *  channel)
+{
+	int	idle = 0;
+
+	if (__atomic_load_n(&channel->busy, __ATOMIC_RELAXED) != 0
+		|| !__atomic_compare_exchange_n(&channel->busy, &idle, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+	{
+		return false;
+	}
+
+	if (channel->write != NULL)
+	{
+		int64_t	position = channel->writes.leave;
+		while (__atomic_load_n(noisyChannelSequence(&channel->writes, position), __ATOMIC_ACQUIRE) == position + 1)
+		{
+			channel->write(channel->instance, channel->input, noisyChannelMessage(&channel->writes, position));
+			__atomic_store_n(noisyChannelSequence(&channel->writes, position), position + kNoisyChannelSlots, __ATOMIC_RELEASE);
+			__atomic_store_n(&channel->served, ++position, __ATOMIC_RELEASE);
+		}
+		channel->writes.leave = position;
+	}
+
+	/*
+	 *	Only as many messages as there are receives, since making one runs the instance.
+	 */
+	if (channel->read != NULL)
+	{
+		int64_t	position = channel->reads.enter;
+		while (position < __atomic_load_n(&channel->reads.leave, __ATOMIC_RELAXED)
+			&& __atomic_load_n(noisyChannelSequence(&channel->reads, position), __ATOMIC_ACQUIRE) == position)
+		{
+			channel->read(channel->instance, channel->input, noisyChannelMessage(&channel->reads, position));
+			__atomic_store_n(noisyChannelSequence(&channel->reads, position), position + 1, __ATOMIC_RELEASE);
+			position++;
+		}
+		channel->reads.enter = position;
+	}
+
+	__atomic_store_n(&channel->busy, 0, __ATOMIC_RELEASE);
+
+	return true;
+}
+
+static void
+noisyChannelWait(NoisyChannel *  channel)
+{
+	if (!noisyChannelServe(channel))
+	{
+		sched_yield();
+	}
+}
+
+static void
+noisyChannelRingInit(NoisyChannelRing *  ring, int64_t messageSize)
+{
+	void *	slots;
+
+	ring->enter		= 0;
+	ring->leave		= 0;
+	ring->messageSize	= messageSize;
+	ring->slotSize		= kNoisyChannelSlotHeader + (messageSize + kNoisyChannelSlotHeader - 1) / kNoisyChannelSlotHeader * kNoisyChannelSlotHeader;
+	if (posix_memalign(&slots, kNoisyChannelCacheLine, kNoisyChannelSlots * ring->slotSize) != 0)
+	{
+		fprintf(stderr, "Out of memory for a channel\n");
+		abort();
+	}
+
+	ring->slots = (uint8_t *)slots;
+	for (int64_t i = 0; i < kNoisyChannelSlots; i++)
+	{
+		*noisyChannelSequence(ring, i) = i;
+	}
+}
+
+/*
+ *	The kind is the one of the side of the body, the instance side of a
+ *	ring has one thread at a time either way. write and read may be NULL
+ *	when the body only receives or only sends.
+ */
+NoisyChannel *
+noisyChannelCreate(int kind, void *  instance, void *  input, NoisyChannelServe write, int64_t writeSize, NoisyChannelServe read, int64_t readSize)
+{
+	void *	memory;
+
+	if (posix_memalign(&memory, kNoisyChannelCacheLine, sizeof(NoisyChannel)) != 0)
+	{
+		fprintf(stderr, "Out of memory for a channel\n");
+		abort();
+	}
+
+	NoisyChannel *	channel = (NoisyChannel *)memory;
+
+	memset(channel, 0, sizeof(NoisyChannel));
+	channel->isShared	= kind == kNoisyChannelMultipleProducerMultipleConsumer;
+	channel->instance	= instance;
+	channel->input		= input;
+	channel->write		= write;
+	channel->read		= read;
+	if (write != NULL)
+	{
+		noisyChannelRingInit(&channel->writes, writeSize);
+	}
+	if (read != NULL)
+	{
+		noisyChannelRingInit(&channel->reads, readSize);
+	}
+
+	return channel;
+}
+
+void
+noisyChannelSend(NoisyChannel *  channel, void *  message)
+{
+	int64_t		position = noisyChannelReserve(&channel->writes.enter, channel->isShared);
+	int64_t *	sequence = noisyChannelSequence(&channel->writes, position);
+
+	while (__atomic_load_n(sequence, __ATOMIC_ACQUIRE) != position)
+	{
+		noisyChannelWait(channel);
+	}
+	memcpy(noisyChannelMessage(&channel->writes, position), message, channel->writes.messageSize);
+	__atomic_store_n(sequence, position + 1, __ATOMIC_RELEASE);
+
+	while (__atomic_load_n(&channel->served, __ATOMIC_ACQUIRE) <= position)
+	{
+		noisyChannelWait(channel);
+	}
+}
+
+void
+noisyChannelReceive(NoisyChannel *  channel, void *  message)
+{
+	int64_t		position = noisyChannelReserve(&channel->reads.leave, channel->isShared);
+	int64_t *	sequence = noisyChannelSequence(&channel->reads, position);
+
+	while (__atomic_load_n(sequence, __ATOMIC_ACQUIRE) != position + 1)
+	{
+		noisyChannelWait(channel);
+	}
+	memcpy(message, noisyChannelMessage(&channel->reads, position), channel->reads.messageSize);
+	__atomic_store_n(sequence, position + kNoisyChannelSlots, __ATOMIC_RELEASE);
+}
+
+void
+noisyChannelDestroy(NoisyChannel *  channel)
+{
+	free(channel->writes.slots);
+	free(channel->reads.slots);
+	free(channel);
+}
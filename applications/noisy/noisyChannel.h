@@ -0,0 +1,25 @@
+/*
+ *	Channels between the body of a parallel statement and the function
+ *	instances it captures. The body may run on several workers at once,
+ *	but an instance is a coroutine that one thread resumes at a time, so
+ *	sends and receives go through rings and whichever worker gets hold of
+ *	the instance serves everything pending. A message is one slot, so an
+ *	array goes across in one copy.
+ */
+
+#include <stdint.h>
+
+typedef void	(*NoisyChannelServe)(void *  instance, void *  input, void *  message);
+
+typedef enum
+{
+	kNoisyChannelSingleProducerSingleConsumer,
+	kNoisyChannelMultipleProducerMultipleConsumer,
+} NoisyChannelKind;
+
+typedef struct NoisyChannel	NoisyChannel;
+
+NoisyChannel *	noisyChannelCreate(int kind, void *  instance, void *  input, NoisyChannelServe write, int64_t writeSize, NoisyChannelServe read, int64_t readSize);
+void		noisyChannelSend(NoisyChannel *  channel, void *  message);
+void		noisyChannelReceive(NoisyChannel *  channel, void *  message);
+void		noisyChannelDestroy(NoisyChannel *  channel);
@@ -0,0 +1,114 @@
+/*
+ *	The size classes are multiples of the granularity. Each thread keeps
+ *	its own lists, since the instances of a parallel body are loaded and
+ *	destroyed on the worker that runs it, and a list holds a bounded number of
+ *	frames, so that a thread which only frees does not hold on to memory,
+ *	and goes back to malloc when its thread exits.
+ *	A frame starts after a header with its size class, which also links
+ *	the frame into its list while it is free. Frames larger than the
+ *	largest class go straight to malloc and free.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "noisyFramePool.h"
+
+enum
+{
+	kNoisyFramePoolGranularity	= 16,
+	kNoisyFramePoolClasses		= 64,
+	kNoisyFramePoolMaxFreeFrames	= 256,
+};
+
+typedef struct NoisyFrameHeader
+{
+	int64_t				sizeClass;
+	struct NoisyFrameHeader *	next;
+} NoisyFrameHeader;
+
+static __thread NoisyFrameHeader *	freeFrames[kNoisyFramePoolClasses];
+static __thread int			freeFrameCount[kNoisyFramePoolClasses];
+static __thread bool			hasFreeFrames;
+static pthread_once_t			freeFramesOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t			freeFramesKey;
+
+static void
+noisyFramePoolThreadExit(void *  unused)
+{
+	(void)unused;
+
+	for (int i = 0; i < kNoisyFramePoolClasses; i++)
+	{
+		while (freeFrames[i] != NULL)
+		{
+			NoisyFrameHeader *	header = freeFrames[i];
+
+			freeFrames[i] = header->next;
+			free(header);
+		}
+		freeFrameCount[i] = 0;
+	}
+}
+
+static void
+noisyFramePoolCreateKey(void)
+{
+	pthread_key_create(&freeFramesKey, noisyFramePoolThreadExit);
+}
+
+void *
+noisyFramePoolAllocate(int64_t size)
+{
+	int64_t			sizeClass = (size + kNoisyFramePoolGranularity - 1) / kNoisyFramePoolGranularity;
+	NoisyFrameHeader *	header;
+
+	if (sizeClass < kNoisyFramePoolClasses && freeFrames[sizeClass] != NULL)
+	{
+		header				= freeFrames[sizeClass];
+		freeFrames[sizeClass]		= header->next;
+		freeFrameCount[sizeClass]--;
+
+		return header + 1;
+	}
+
+	header = (NoisyFrameHeader *)malloc(sizeof(NoisyFrameHeader) + sizeClass * kNoisyFramePoolGranularity);
+	if (header == NULL)
+	{
+		fprintf(stderr, "Out of memory for a coroutine frame\n");
+		abort();
+	}
+	header->sizeClass = sizeClass;
+
+	return header + 1;
+}
+
+void
+noisyFramePoolFree(void *  memory)
+{
+	if (memory == NULL)
+	{
+		return;
+	}
+
+	NoisyFrameHeader *	header = (NoisyFrameHeader *)memory - 1;
+	int64_t			sizeClass = header->sizeClass;
+
+	if (sizeClass >= kNoisyFramePoolClasses || freeFrameCount[sizeClass] >= kNoisyFramePoolMaxFreeFrames)
+	{
+		free(header);
+		return;
+	}
+
+	if (!hasFreeFrames)
+	{
+		pthread_once(&freeFramesOnce, noisyFramePoolCreateKey);
+		pthread_setspecific(freeFramesKey, &hasFreeFrames);
+		hasFreeFrames = true;
+	}
+
+	header->next		= freeFrames[sizeClass];
+	freeFrames[sizeClass]	= header;
+	freeFrameCount[sizeClass]++;
+}
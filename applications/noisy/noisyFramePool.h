@@ -0,0 +1,12 @@
+/*
+ *	The allocator of coroutine frames when noisy runs with --frame-pool.
+ *	Frames come in a few sizes, one per function, and programs that load
+ *	an instance per sample or per recursive call free as many frames as
+ *	they allocate, so freed frames wait in a list per size class for the
+ *	next instance of that size.
+ */
+
+#include <stdint.h>
+
+void *		noisyFramePoolAllocate(int64_t size);
+void		noisyFramePoolFree(void *  memory);
@@ -1,5 +1,6 @@
 #include<stdio.h>
 #include<math.h>
+#include "noisyLib.h"
 
 int
 printInt32(int x)
@@ -0,0 +1,18 @@
+/*
+ *	The Noisy runtime. Compiled programs link against noisyLib.o, and
+ *	noisy --run hands these to the JIT in place of linking.
+ */
+
+int		printInt32(int x);
+int		printNat32(unsigned int x);
+int		printFloat64(double x);
+int		readInt32(void);
+int		readMiddleInt32FromCSV(void);
+short int	readInt16FromCSV(void);
+double		readFloat64FromCSV(void);
+double		readStartFloat64FromCSV(void);
+double		readMiddleFloat64FromCSV(void);
+int		ekfWrite(double ts, double theta, double dtheta, double thetaCov, double dthetaCov);
+int		bmeWrite(int temp, unsigned int pres, unsigned int hum);
+float		readFloat32FromCSV(void);
+int		readTemperature(void);
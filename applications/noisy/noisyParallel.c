@@ -0,0 +1,390 @@
+/*
+ *	Each worker owns a deque of tasks (Chase and Lev, "Dynamic Circular
+ *	Work-Stealing Deque", with the memory orders of Le et al., "Correct
+ *	and Efficient Work-Stealing for Weak Memory Models"). The owner pushes
+ *	and takes at the bottom, the other workers steal from the top.
+ *
+ *	A task is a range of indices of one parallel statement. The worker
+ *	running it splits off the upper half onto its deque until the range is
+ *	down to the grain, so idle workers steal the largest pieces first, and
+ *	then runs the rest. The worker that reached the parallel statement
+ *	runs tasks, its own ones first, until all the indices of the statement
+ *	have run, so nested parallel statements do not block a worker.
+ *
+ *	The thread that first reaches a parallel statement becomes worker 0.
+ *	NOISY_WORKERS sets the number of workers, the number of online
+ *	processors by default.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "noisyParallel.h"
+
+enum
+{
+	kNoisyParallelDequeSize		= 8192,
+	kNoisyParallelMaxWorkers	= 256,
+	kNoisyParallelSplitsPerWorker	= 8,
+	kNoisyParallelIdleRounds	= 64,
+	kNoisyParallelCacheLine		= 64,
+};
+
+typedef struct
+{
+	int64_t			pending;
+} NoisyParallelJoin;
+
+typedef struct
+{
+	NoisyParallelBody	body;
+	void *			environment;
+	int64_t			begin;
+	int64_t			end;
+	int64_t			grain;
+	NoisyParallelJoin *	join;
+} NoisyParallelTask;
+
+typedef struct
+{
+	int64_t			top __attribute__((aligned(kNoisyParallelCacheLine)));
+	int64_t			bottom __attribute__((aligned(kNoisyParallelCacheLine)));
+	NoisyParallelTask *	tasks[kNoisyParallelDequeSize] __attribute__((aligned(kNoisyParallelCacheLine)));
+	unsigned int		victimSeed;
+} NoisyParallelWorker;
+
+static NoisyParallelWorker *	workers[kNoisyParallelMaxWorkers];
+static int			workerCount;
+static int			sleeperCount;
+static pthread_once_t		workersOnce	= PTHREAD_ONCE_INIT;
+static pthread_mutex_t		sleepLock	= PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t		sleepCondition	= PTHREAD_COND_INITIALIZER;
+static __thread NoisyParallelWorker *	currentWorker;
+
+static bool
+noisyParallelPush(NoisyParallelWorker *  worker, NoisyParallelTask *  task)
+{
+	int64_t	bottom = __atomic_load_n(&worker->bottom, __ATOMIC_RELAXED);
+	int64_t	top = __atomic_load_n(&worker->top, __ATOMIC_ACQUIRE);
+
+	if (bottom - top >= kNoisyParallelDequeSize)
+	{
+		return false;
+	}
+
+	__atomic_store_n(&worker->tasks[bottom & (kNoisyParallelDequeSize - 1)], task, __ATOMIC_RELAXED);
+	__atomic_store_n(&worker->bottom, bottom + 1, __ATOMIC_RELEASE);
+
+	/*
+	 *	Pairs with the sleeper count increment in noisyParallelSleep:
+	 *	either the sleeper sees the task or we see the sleeper.
+	 */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&sleeperCount, __ATOMIC_RELAXED) > 0)
+	{
+		pthread_mutex_lock(&sleepLock);
+		pthread_cond_signal(&sleepCondition);
+		pthread_mutex_unlock(&sleepLock);
+	}
+
+	return true;
+}
+
+static NoisyParallelTask *
+noisyParallelTake(NoisyParallelWorker *  worker)
+{
+	int64_t	bottom = __atomic_load_n(&worker->bottom, __ATOMIC_RELAXED) - 1;
+
+	__atomic_store_n(&worker->bottom, bottom, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	int64_t			top = __atomic_load_n(&worker->top, __ATOMIC_RELAXED);
+	NoisyParallelTask *	task = NULL;
+
+	if (top <= bottom)
+	{
+		task = __atomic_load_n(&worker->tasks[bottom & (kNoisyParallelDequeSize - 1)], __ATOMIC_RELAXED);
+		if (top == bottom)
+		{
+			/*
+			 *	The last task: race the thieves for it.
+			 */
+			if (!__atomic_compare_exchange_n(&worker->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+			{
+				task = NULL;
+			}
+			__atomic_store_n(&worker->bottom, bottom + 1, __ATOMIC_RELAXED);
+		}
+	}
+	else
+	{
+		__atomic_store_n(&worker->bottom, bottom + 1, __ATOMIC_RELAXED);
+	}
+
+	return task;
+}
+
+static NoisyParallelTask *
+noisyParallelSteal(NoisyParallelWorker *  victim)
+{
+	int64_t	top = __atomic_load_n(&victim->top, __ATOMIC_ACQUIRE);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	int64_t	bottom = __atomic_load_n(&victim->bottom, __ATOMIC_ACQUIRE);
+
+	if (top >= bottom)
+	{
+		return NULL;
+	}
+
+	NoisyParallelTask *	task = __atomic_load_n(&victim->tasks[top & (kNoisyParallelDequeSize - 1)], __ATOMIC_RELAXED);
+	if (!__atomic_compare_exchange_n(&victim->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+	{
+		return NULL;
+	}
+
+	return task;
+}
+
+static NoisyParallelTask *
+noisyParallelFindTask(NoisyParallelWorker *  worker)
+{
+	NoisyParallelTask *	task = noisyParallelTake(worker);
+	if (task != NULL || workerCount == 1)
+	{
+		return task;
+	}
+
+	/*
+	 *	Start at a random victim so the thieves spread out.
+	 */
+	int	first = rand_r(&worker->victimSeed) % workerCount;
+	for (int i = 0; i < workerCount && task == NULL; i++)
+	{
+		NoisyParallelWorker *	victim = workers[(first + i) % workerCount];
+		if (victim != worker)
+		{
+			task = noisyParallelSteal(victim);
+		}
+	}
+
+	return task;
+}
+
+static void
+noisyParallelRun(NoisyParallelWorker *  worker, NoisyParallelTask task)
+{
+	while (task.end - task.begin > task.grain)
+	{
+		NoisyParallelTask *	upperHalf = (NoisyParallelTask *)malloc(sizeof(NoisyParallelTask));
+		if (upperHalf == NULL)
+		{
+			break;
+		}
+
+		/*
+		 *	Once pushed, the upper half may already be stolen and freed.
+		 */
+		int64_t	middle = task.begin + (task.end - task.begin) / 2;
+		*upperHalf = task;
+		upperHalf->begin = middle;
+		if (!noisyParallelPush(worker, upperHalf))
+		{
+			/*
+			 *	The deque is full, so we run the whole range here.
+			 */
+			free(upperHalf);
+			break;
+		}
+		task.end = middle;
+	}
+
+	for (int64_t i = task.begin; i < task.end; i++)
+	{
+		task.body(task.environment, i);
+	}
+
+	/*
+	 *	The join may be gone once the count reaches zero.
+	 */
+	__atomic_sub_fetch(&task.join->pending, task.end - task.begin, __ATOMIC_RELEASE);
+}
+
+static void
+noisyParallelRunFound(NoisyParallelWorker *  worker, NoisyParallelTask *  found)
+{
+	NoisyParallelTask	task = *found;
+
+	free(found);
+	noisyParallelRun(worker, task);
+}
+
+static bool
+noisyParallelHaveTasks(void)
+{
+	for (int i = 0; i < workerCount; i++)
+	{
+		if (__atomic_load_n(&workers[i]->top, __ATOMIC_SEQ_CST) < __atomic_load_n(&workers[i]->bottom, __ATOMIC_SEQ_CST))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void
+noisyParallelSleep(void)
+{
+	pthread_mutex_lock(&sleepLock);
+	__atomic_add_fetch(&sleeperCount, 1, __ATOMIC_SEQ_CST);
+	if (!noisyParallelHaveTasks())
+	{
+		pthread_cond_wait(&sleepCondition, &sleepLock);
+	}
+	__atomic_sub_fetch(&sleeperCount, 1, __ATOMIC_SEQ_CST);
+	pthread_mutex_unlock(&sleepLock);
+}
+
+static void *
+noisyParallelWorkerLoop(void *  argument)
+{
+	int	idleRounds = 0;
+
+	currentWorker = (NoisyParallelWorker *)argument;
+	for (;;)
+	{
+		NoisyParallelTask *	task = noisyParallelFindTask(currentWorker);
+		if (task != NULL)
+		{
+			noisyParallelRunFound(currentWorker, task);
+			idleRounds = 0;
+		}
+		else if (++idleRounds < kNoisyParallelIdleRounds)
+		{
+			sched_yield();
+		}
+		else
+		{
+			noisyParallelSleep();
+			idleRounds = 0;
+		}
+	}
+
+	return NULL;
+}
+
+static void
+noisyParallelStartWorkers(void)
+{
+	long		count = sysconf(_SC_NPROCESSORS_ONLN);
+	const char *	setting = getenv("NOISY_WORKERS");
+
+	if (setting != NULL && atoi(setting) > 0)
+	{
+		count = atoi(setting);
+	}
+	if (count < 1)
+	{
+		count = 1;
+	}
+	if (count > kNoisyParallelMaxWorkers)
+	{
+		count = kNoisyParallelMaxWorkers;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		void *	worker;
+		if (posix_memalign(&worker, kNoisyParallelCacheLine, sizeof(NoisyParallelWorker)) != 0)
+		{
+			count = i;
+			break;
+		}
+		workers[i] = (NoisyParallelWorker *)worker;
+		workers[i]->top = 0;
+		workers[i]->bottom = 0;
+		workers[i]->victimSeed = 0x9e3779b9u * (i + 1);
+	}
+	workerCount = count;
+	currentWorker = workers[0];
+
+	/*
+	 *	A worker whose thread does not start keeps an empty deque, which
+	 *	the others skip over.
+	 */
+	for (int i = 1; i < count; i++)
+	{
+		pthread_t	thread;
+		if (pthread_create(&thread, NULL, noisyParallelWorkerLoop, workers[i]) == 0)
+		{
+			pthread_detach(thread);
+		}
+	}
+}
+
+int
+noisyParallelWorkerCount(void)
+{
+	pthread_once(&workersOnce, noisyParallelStartWorkers);
+
+	return workerCount;
+}
+
+void
+noisyParallelFor(NoisyParallelBody body, void *  environment, int64_t count)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	pthread_once(&workersOnce, noisyParallelStartWorkers);
+
+	/*
+	 *	Threads other than the workers and the one that started them run
+	 *	their parallel statements sequentially.
+	 */
+	NoisyParallelWorker *	worker = currentWorker;
+	if (count == 1 || workerCount <= 1 || worker == NULL)
+	{
+		for (int64_t i = 0; i < count; i++)
+		{
+			body(environment, i);
+		}
+
+		return;
+	}
+
+	NoisyParallelJoin	join = {.pending = count};
+	NoisyParallelTask	task = {
+					.body = body,
+					.environment = environment,
+					.begin = 0,
+					.end = count,
+					.grain = count / (kNoisyParallelSplitsPerWorker * workerCount),
+					.join = &join,
+				};
+
+	if (task.grain < 1)
+	{
+		task.grain = 1;
+	}
+
+	noisyParallelRun(worker, task);
+
+	while (__atomic_load_n(&join.pending, __ATOMIC_ACQUIRE) != 0)
+	{
+		NoisyParallelTask *	found = noisyParallelFindTask(worker);
+		if (found != NULL)
+		{
+			noisyParallelRunFound(worker, found);
+		}
+		else
+		{
+			sched_yield();
+		}
+	}
+}
@@ -0,0 +1,14 @@
+/*
+ *	The work-stealing runtime behind the Noisy parallel statement. The
+ *	code generator outlines the body of a parallel statement into a
+ *	function of its environment and of the index of the element, and
+ *	hands it to noisyParallelFor, which returns once every index has
+ *	run.
+ */
+
+#include <stdint.h>
+
+typedef void	(*NoisyParallelBody)(void *  environment, int64_t index);
+
+void		noisyParallelFor(NoisyParallelBody body, void *  environment, int64_t count);
+int		noisyParallelWorkerCount(void);
@@ -0,0 +1,192 @@
+/*
+	Authored 2026. Phillip Stanley-Marbell.
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions
+	are met:
+
+	*	Redistributions of source code must retain the above
+		copyright notice, this list of conditions and the following
+		disclaimer.
+
+	*	Redistributions in binary form must reproduce the above
+		copyright notice, this list of conditions and the following
+		disclaimer in the documentation and/or other materials
+		provided with the distribution.
+
+	*	Neither the name of the author nor the names of its
+		contributors may be used to endorse or promote products
+		derived from this software without specific prior written
+		permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include <string.h>
+#include <stdint.h>
+#include "flextypes.h"
+#include "flexerror.h"
+#include "flex.h"
+#include "common-errors.h"
+#include "noisy-timeStamps.h"
+#include "common-timeStamps.h"
+#include "common-data-structures.h"
+#include "common-arena.h"
+
+
+/*
+ *	Objects whose lifetime is that of a compiler phase (tokens for the
+ *	lexer, IR nodes, scopes and symbols for the parser and the passes that
+ *	follow it) are bump-allocated from a per-phase arena rather than being
+ *	calloc()ed one at a time. Nothing allocated from an arena is freed
+ *	individually: a whole region is dropped at once with commonArenaReset().
+ *
+ *	Memory returned by commonArenaAlloc() is zeroed, so it is a drop-in
+ *	replacement for calloc(1, size).
+ */
+
+
+static const char *	arenaRegionNames[kCommonArenaRegionMax] =
+{
+	[kCommonArenaRegionLex]			= "lex",
+	[kCommonArenaRegionParse]		= "parse",
+	[kCommonArenaRegionPassScratch]		= "pass scratch",
+};
+
+
+static ArenaChunk *
+commonArenaNewChunk(State *  N, size_t size)
+{
+	ArenaChunk *	chunk = (ArenaChunk *)calloc(1, sizeof(ArenaChunk) + size);
+	if (chunk == NULL)
+	{
+		fatal(N, Emalloc);
+	}
+
+	chunk->size = size;
+
+	return chunk;
+}
+
+
+void *
+commonArenaAlloc(State *  N, ArenaRegion region, size_t size)
+{
+	Arena *		arena = &N->arenas[region];
+	ArenaChunk *	chunk = arena->chunks;
+
+	size = (size + kCommonArenaAlignment - 1) & ~((size_t)kCommonArenaAlignment - 1);
+
+	if ((chunk == NULL) || (chunk->size - chunk->used < size))
+	{
+		if (size > kCommonArenaChunkBytes/4)
+		{
+			/*
+			 *	Large requests get a chunk of their own, placed behind
+			 *	the head so the partially-filled head chunk stays in use.
+			 */
+			ArenaChunk *	large = commonArenaNewChunk(N, size);
+
+			if (chunk == NULL)
+			{
+				arena->chunks = large;
+			}
+			else
+			{
+				large->next = chunk->next;
+				chunk->next = large;
+			}
+			chunk = large;
+		}
+		else
+		{
+			chunk = commonArenaNewChunk(N, kCommonArenaChunkBytes);
+			chunk->next = arena->chunks;
+			arena->chunks = chunk;
+		}
+		arena->chunkCount++;
+	}
+
+	void *	p = &chunk->data[chunk->used];
+	chunk->used += size;
+
+	arena->allocationCount++;
+	arena->bytesInUse += size;
+	if (arena->bytesInUse > arena->highWaterBytes)
+	{
+		arena->highWaterBytes = arena->bytesInUse;
+	}
+
+	return p;
+}
+
+
+/*
+ *	Release every object in region. The high-water mark survives so the
+ *	statistics reflect the peak over the whole run.
+ */
+void
+commonArenaReset(State *  N, ArenaRegion region)
+{
+	Arena *		arena = &N->arenas[region];
+	ArenaChunk *	chunk = arena->chunks;
+
+	while (chunk != NULL)
+	{
+		ArenaChunk *	next = chunk->next;
+
+		free(chunk);
+		chunk = next;
+	}
+
+	arena->chunks = NULL;
+	arena->chunkCount = 0;
+	arena->bytesInUse = 0;
+}
+
+
+void
+commonArenaDumpStatistics(State *  N)
+{
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "Arena Information:\n\n");
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "    %-16s%16s%16s%16s%10s\n", "Region", "Allocations", "Bytes in use", "High water", "Chunks");
+	for (int i = 0; i < kCommonArenaRegionMax; i++)
+	{
+		Arena *	arena = &N->arenas[i];
+
+		flexprint(N->Fe, N->Fm, N->Fpinfo, "    %-16s%16llu%16llu%16llu%10llu\n",
+				arenaRegionNames[i],
+				arena->allocationCount,
+				arena->bytesInUse,
+				arena->highWaterBytes,
+				arena->chunkCount);
+	}
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "\n");
+}
+
+
+void
+commonArenaDealloc(State *  N)
+{
+	for (int i = 0; i < kCommonArenaRegionMax; i++)
+	{
+		commonArenaReset(N, i);
+	}
+}
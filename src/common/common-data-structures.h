@@ -730,6 +730,8 @@ typedef enum
 
 typedef enum
 {
+	kNoisyIrPassCoroutineFramePool			= (1 << 0),
+
 	/*
 	 *	Code depends on this bringing up the rear.
 	 */
@@ -768,6 +770,8 @@ typedef enum
 {
 	kNoisyIrBackendDot				= (1 << 0),
 	kNoisyIrBackendProtobuf				= (1 << 1),
+	kNoisyIrBackendObject				= (1 << 2),
+	kNoisyIrBackendJit				= (1 << 3),
 
 	/*
 	 *	Code depends on this bringing up the rear.
@@ -811,11 +815,23 @@ typedef enum
 	kCommonMaxPrintBufferLength			= 8192,
 	kCommonMaxTokenCharacters			= 32,
 	kCommonMaxFilenameLength			= 128,
-	kCommonTimestampTimelineLength			= 4000000 /* Set to, e.g., 4000000 if we want to capture very long traces for debug; set to 1 otherwise */,
+	kCommonTimestampTimelineLength			= 4194304 /* Must be a power of two. Set to, e.g., 4194304 if we want to capture very long traces for debug; set to 1 otherwise */,
+	kCommonTimestampPhaseSlots			= 4096,
 	kCommonCgiRandomDigits				= 10,
 	kCommonRlimitCpuSeconds				= 5*60,			/*	5 mins	*/
 	kCommonRlimitRssBytes				= 2*1024*1024*1024UL,	/*	2GB	*/
 	kCommonProgressTimerSeconds			= 5,
+	kCommonSymbolTableInitialIndexSlots		= 16,
+	kCommonStringInternInitialSlots			= 1024,
+	kCommonTokenStreamInitialSlots			= 4096,
+	kCommonKeywordTableMaxSlots			= 65536,
+	kCommonKeywordTableSeedsPerSize			= 64,
+	kCommonFirstAndFollowBitsetWords		= (kCommonIrNodeTypeMax + 63) / 64,
+	kCommonArenaChunkBytes				= 65536,
+	kCommonArenaAlignment				= 16,
+	kCommonRangeAnalysisWideningDelay		= 3,
+	kCommonRangeAnalysisNarrowingPasses		= 2,
+	kCommonRangeAnalysisMaxBlockVisits		= 64,
 
 	/*
 	 *	Code depends on this bringing up the rear.
@@ -840,6 +856,31 @@ typedef enum
 
 
 
+typedef enum
+{
+	/*
+	 *	Tokens, SourceInfo and interned strings
+	 */
+	kCommonArenaRegionLex,
+
+	/*
+	 *	IR nodes, scopes, symbols and symbol table indices
+	 */
+	kCommonArenaRegionParse,
+
+	/*
+	 *	Temporaries that an IR pass can drop wholesale once it is done
+	 */
+	kCommonArenaRegionPassScratch,
+
+	/*
+	 *	Code depends on this bringing up the rear.
+	 */
+	kCommonArenaRegionMax,
+} ArenaRegion;
+
+
+
 typedef enum
 {
 	kCommonPostFileWriteActionRenderDot		= (1 << 0),
@@ -894,6 +935,8 @@ typedef struct Invariant	Invariant;
 typedef struct Signal		Signal;
 typedef struct Sensor		Sensor;
 typedef struct Modality		Modality;
+typedef struct InternedString	InternedString;
+typedef struct ArenaChunk	ArenaChunk;
 
 typedef struct NoisyType	NoisyType;
 
@@ -1092,6 +1135,54 @@ struct IrNode
 };
 
 
+/*
+ *	An entry in the State's string interning pool (see common-stringIntern.c).
+ */
+struct InternedString
+{
+	uint64_t		hash;
+	size_t			length;
+	InternedString *	next;
+	char			string[];
+};
+
+
+/*
+ *	Arenas are bump allocators made of a list of chunks, with the chunk
+ *	currently being allocated from at the head (see common-arena.c).
+ */
+struct ArenaChunk
+{
+	ArenaChunk *		next;
+	size_t			size;
+	size_t			used;
+	char			data[] __attribute__((aligned(kCommonArenaAlignment)));
+};
+
+typedef struct
+{
+	ArenaChunk *		chunks;
+	uint64_t		chunkCount;
+	uint64_t		allocationCount;
+	uint64_t		bytesInUse;
+	uint64_t		highWaterBytes;
+} Arena;
+
+
+/*
+ *	The whole of a source file, either mapped or read in one call, and
+ *	followed by a '\0'. The lexer walks it a line at a time by pointing
+ *	lineBuffer into it (see lexSourceOpen() in common-lexers-helpers.c).
+ */
+typedef struct
+{
+	char *			buffer;
+	uint64_t		length;
+	uint64_t		offset;
+	bool			isMapped;
+} SourceBuffer;
+
+
 struct SourceInfo
 {
 	/*
@@ -1115,9 +1206,6 @@ struct Token
 	double			realConst;
 	char *			stringConst;
 	SourceInfo *		sourceInfo;
-	
-	Token *			prev;
-	Token *			next;
 };
 
 
@@ -1142,6 +1230,16 @@ struct Scope
 	 */
 	Symbol *		firstSymbol;
 
+	/*
+	 *	Tail of the firstSymbol list, so appends are O(1), and a hash index
+	 *	over the identifiers in this scope (chained via Symbol->hashNext),
+	 *	allocated lazily on the first insertion into the scope.
+	 */
+	Symbol *		lastSymbol;
+	Symbol **		symbolIndex;
+	uint64_t		symbolIndexSlots;
+	uint64_t		symbolCount;
+
 	/*
 	 *	Each invariant scope will have its own list of parameters
 	 */
@@ -1255,6 +1353,12 @@ struct Symbol
 	 */
 	Symbol *		next;
 	Symbol *		prev;
+
+	/*
+	 *	For chaining together symbols in the same bucket of the scope's symbolIndex
+	 */
+	uint64_t		identifierHash;
+	Symbol *		hashNext;
 };
 
 
@@ -1267,6 +1371,8 @@ typedef struct
 	TimeStamp *		timestamps;
 	uint64_t		timestampCount;
 	uint64_t		timestampSlots;
+	TimeStampPhase *	timestampPhases;
+	uint64_t		timestampPhaseCount;
 
 	/*
 	 *	Track aggregate time spent in all routines, by incrementing
@@ -1339,10 +1445,26 @@ typedef struct
 	 */
 	Scope *		moduleScopes;
 
+	/*
+	 *	One arena per allocation lifetime (see ArenaRegion)
+	 */
+	Arena			arenas[kCommonArenaRegionMax];
+
+	/*
+	 *	Pool of interned identifiers and file names, and statistics on
+	 *	the requests made of it (see common-stringIntern.c)
+	 */
+	InternedString **	internedStrings;
+	uint64_t		internedStringSlots;
+	uint64_t		internedStringCount;
+	uint64_t		internedStringBytes;
+	uint64_t		internRequestCount;
+	uint64_t		internRequestBytes;
+
 	/*
 	 *	Lexer state
 	 */
-	FILE *			filePointer;
+	SourceBuffer		source;
 	char *			fileName;
 	char *			lineBuffer;
 	uint64_t		columnNumber;
@@ -1350,10 +1472,37 @@ typedef struct
 	uint64_t		lineLength;
 	char *			currentToken;
 	uint64_t		currentTokenLength;
-	Token *			tokenList;
-	Token *			lastToken;
+
+	/*
+	 *	The token stream, in order. tokens[tokenCursor] is the next
+	 *	token lexGet() will return, so lookahead is just an index.
+	 */
+	Token **		tokens;
+	uint64_t		tokenCount;
+	uint64_t		tokenSlots;
+	uint64_t		tokenCursor;
+
 	Symbol *		currentFunction;
 
+	/*
+	 *	Collision-free hash of the token descriptions, so the lexer
+	 *	classifies keywords with one hash and one compare (see
+	 *	lexKeywordTableInit() in common-lexers-helpers.c).
+	 */
+	const char **		keywordStrings;
+	int *			keywordTable;
+	uint64_t		keywordTableSlots;
+	uint64_t		keywordTableSeed;
+
+	/*
+	 *	One bit per token type packings of the FIRST() and FOLLOW() tables
+	 *	last passed to inFirst() and inFollow() (see common-firstAndFollow.c)
+	 */
+	int *			firstsSource;
+	uint64_t *		firstsBitsets;
+	int *			followsSource;
+	uint64_t *		followsBitsets;
+
 	/*
 	 *	The root of the IR tree, and top scope
 	 */
@@ -1372,6 +1521,7 @@ typedef struct
 	char *			outputRTLFilePath;
 	char *			outputEstimatorSynthesisFilePath;
 	char *			outputIpsaFilePath;
+	char *			outputTraceJsonFilePath;
 	
 	/*
 	 *	Invariant identifiers specified for State Estimator Synthesis
@@ -1384,7 +1534,35 @@ typedef struct
 	 *	LLVM IR input file
 	 */
 	char *			llvmIR;
-	
+
+	/*
+	 *	The parsed LLVM IR module and its LLVMContext, shared by
+	 *	all the LLVM IR passes (see newton-irPass-LLVMIR-module.cpp)
+	 */
+	void *			llvmContext;
+	void *			llvmModule;
+
+	/*
+	 *	Threads for the per-function LLVM IR range analysis. With more
+	 *	than one, functions are analyzed in parallel.
+	 */
+	int			rangeAnalysisJobs;
+
+	/*
+	 *	Growth of the LLVM IR module allowed to the function specialization
+	 *	by range, in percent of its instructions: zero when not given, for
+	 *	the default of newton-irPass-LLVMIR-specializeByRange.cpp, and
+	 *	negative to specialize nothing.
+	 */
+	int			specializationBudget;
+
+	/*
+	 *	File keeping the range summaries of functions between runs, and
+	 *	the summaries read from it (see newton-irPass-LLVMIR-rangeSummaries.cpp)
+	 */
+	char *			rangeAnalysisCache;
+	void *			rangeSummaryStore;
+
 	/*
 	 *	Variables for storing lists of identifiers attached
 	 *	to a physical group number.
@@ -1405,9 +1583,14 @@ typedef struct
 	uint64_t		verbosityLevel;
 	uint64_t		dotDetailLevel;
 	uint64_t		optimizationLevel;
+	uint64_t		optimizationSizeLevel;
 	uint64_t		irPasses;
 	uint64_t		irBackends;
 
+	/*
+	 *	What init returned when the program was run with --run.
+	 */
+	int			jitExitStatus;
 
 	jmp_buf			jmpbuf;
 	bool			jmpbufIsValid;
@@ -1426,6 +1609,8 @@ void		error(State *  C, const char *  msg);
 void		timestampsInit(State *  C);
 void		timeStampDumpTimeline(State *  C);
 void		timeStampDumpResidencies(State *  C);
+void		timeStampDumpChromeTrace(State *  C, const char *  fileName);
+void		timeStampPhase(State *  C, const char *  phaseName, char type);
 State *		init(CommonMode mode);
 void		dealloc(State *  C);
 void		runPasses(State *  C);
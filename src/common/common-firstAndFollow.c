@@ -48,8 +48,53 @@
 #include "common-timeStamps.h"
 #include "common-data-structures.h"
 #include "common-lexers-helpers.h"
+#include "common-arena.h"
 #include "common-firstAndFollow.h"
 
+/*
+ *	The ffi2code tables hold, for each production or token, a list of token
+ *	types terminated by maxKey. The parsers test membership in them for
+ *	almost every production, so the first time a table is used we pack
+ *	each row into a bitset with one bit per token type, and membership
+ *	becomes a single word test.
+ */
+static uint64_t *
+commonFirstAndFollowBitsets(State *  N, int table[kCommonIrNodeTypeMax][kCommonIrNodeTypeMax], int maxKey)
+{
+	uint64_t *	bitsets = (uint64_t *)commonArenaAlloc(N, kCommonArenaRegionParse,
+						kCommonIrNodeTypeMax * kCommonFirstAndFollowBitsetWords * sizeof(uint64_t));
+
+	for (int productionOrToken = 0; productionOrToken < kCommonIrNodeTypeMax; productionOrToken++)
+	{
+		uint64_t *	row = &bitsets[productionOrToken * kCommonFirstAndFollowBitsetWords];
+
+		for (int i = 0; i < maxKey && table[productionOrToken][i] != maxKey; i++)
+		{
+			int	type = table[productionOrToken][i];
+
+			if ((type >= 0) && (type < kCommonIrNodeTypeMax))
+			{
+				row[type / 64] |= (1UL << (type % 64));
+			}
+		}
+	}
+
+	return bitsets;
+}
+
+
+static bool
+commonFirstAndFollowBitsetTest(uint64_t *  bitsets, IrNodeType productionOrToken, IrNodeType type)
+{
+	if ((type < 0) || (type >= kCommonIrNodeTypeMax))
+	{
+		return false;
+	}
+
+	return (bitsets[productionOrToken * kCommonFirstAndFollowBitsetWords + type / 64] >> (type % 64)) & 1;
+}
+
+
 /*
  *	NOTE: Unlike in our previous compilers (e.g., Crayon), we do
  *
@@ -66,23 +111,18 @@ inFirst(State *  N, IrNodeType productionOrToken, int firsts[kCommonIrNodeTypeMa
 
 	Token *	token = lexPeek(N, 1);
 
-	if (productionOrToken > kCommonIrNodeTypeMax)
+	if (productionOrToken >= kCommonIrNodeTypeMax)
 	{
 		fatal(N, Esanity);
 	}
 
-	/*
-	 *	NOTE: The arrays created by ffi2code have a maxKey element at the end of each sub-array
-	 */
-	for (int i = 0; i < maxKey && firsts[productionOrToken][i] != maxKey; i++)
+	if (N->firstsSource != &firsts[0][0])
 	{
-		if (firsts[productionOrToken][i] == token->type)
-		{
-			return true;
-		}
+		N->firstsBitsets = commonFirstAndFollowBitsets(N, firsts, maxKey);
+		N->firstsSource = &firsts[0][0];
 	}
 
-	return false;
+	return commonFirstAndFollowBitsetTest(N->firstsBitsets, productionOrToken, token->type);
 }
 
 
@@ -102,21 +142,16 @@ inFollow(State *  N, IrNodeType productionOrToken, int follows[kCommonIrNodeType
 
 	Token *	token = lexPeek(N, 1);
 
-	if (productionOrToken > kCommonIrNodeTypeMax)
+	if (productionOrToken >= kCommonIrNodeTypeMax)
 	{
 		fatal(N, Esanity);
 	}
 
-	/*
-	 *	NOTE: The arrays created by ffi2code have a maxKey element at the end of each sub-array
-	 */
-	for (int i = 0; i < maxKey && follows[productionOrToken][i] != maxKey; i++)
+	if (N->followsSource != &follows[0][0])
 	{
-		if (follows[productionOrToken][i] == token->type)
-		{
-			return true;
-		}
+		N->followsBitsets = commonFirstAndFollowBitsets(N, follows, maxKey);
+		N->followsSource = &follows[0][0];
 	}
 
-	return false;
+	return commonFirstAndFollowBitsetTest(N->followsBitsets, productionOrToken, token->type);
 }
@@ -55,6 +55,8 @@
 #include "common-irHelpers.h"
 #include "common-lexers-helpers.h"
 #include "common-symbolTable.h"
+#include "common-stringIntern.h"
+#include "common-arena.h"
 
 
 /*
@@ -65,11 +67,7 @@
 IrNode *
 shallowCopyIrNode(State *  N, IrNode *  original)
 {
-	IrNode *	clone = calloc(1, sizeof(IrNode));
-	if (clone == NULL)
-	{
-		fatal(N, Emalloc);
-	}
+	IrNode *	clone = commonArenaAlloc(N, kCommonArenaRegionParse, sizeof(IrNode));
 
 	memcpy(clone, original, sizeof(IrNode));
 	// clone->irLeftChild = NULL;
@@ -91,39 +89,30 @@ shallowCopyIrNode(State *  N, IrNode *  original)
 IrNode *
 deepCopyIrNode(State * N,IrNode * original,int loadCount)
 {
-	IrNode *	clone = calloc(1, sizeof(IrNode));
-	if (clone == NULL)
-	{
-		fatal(N, Emalloc);
-	}
+	IrNode *	clone = commonArenaAlloc(N, kCommonArenaRegionParse, sizeof(IrNode));
 	memcpy(clone,original,sizeof(IrNode));
 
 
 	if (original->symbol != NULL)
 	{
-		Symbol * symbolClone = calloc(1,sizeof(Symbol));
-
-		if (symbolClone == NULL)
-		{
-			fatal(N, Emalloc);
-		}
-
-		memcpy(symbolClone,original->symbol,sizeof(Symbol));
 		char * newSymbolName;
-		asprintf(&newSymbolName,"%s_%d",symbolClone->identifier,loadCount);
-		symbolClone->identifier = strdup(newSymbolName);
+		asprintf(&newSymbolName,"%s_%d",original->symbol->identifier,loadCount);
+		char * cloneIdentifier = (char *)commonStringIntern(N, newSymbolName);
+		free(newSymbolName);
 
-		clone->symbol = commonSymbolTableSymbolForIdentifier(N,symbolClone->scope,newSymbolName);
+		/*
+		 *	Only allocate the symbol copy once we know we need it, since
+		 *	arena allocations cannot be given back individually.
+		 */
+		clone->symbol = commonSymbolTableSymbolForIdentifier(N,original->symbol->scope,cloneIdentifier);
 
-		if (clone->symbol != NULL)
+		if (clone->symbol == NULL)
 		{
-			free(symbolClone);
-		}
-		else
-		{
-			symbolClone->next = original->symbol->scope->firstSymbol;
-			original->symbol->scope->firstSymbol = symbolClone;
-			symbolClone->prev = NULL;
+			Symbol * symbolClone = commonArenaAlloc(N, kCommonArenaRegionParse, sizeof(Symbol));
+
+			memcpy(symbolClone,original->symbol,sizeof(Symbol));
+			symbolClone->identifier = cloneIdentifier;
+			commonSymbolTableInsertSymbolAtHead(N, original->symbol->scope, symbolClone);
 			clone->symbol = symbolClone;
 		}
 	}
@@ -149,13 +138,7 @@ genIrNode(State *  N, IrNodeType type, IrNode *  irLeftChild, IrNode *  irRightC
 
 	IrNode *		node;
 
-	node = (IrNode *) calloc(1, sizeof(IrNode));
-	if (node == NULL)
-	{
-		fatal(N, Emalloc);
-
-		/*	Not reached	*/
-	}
+	node = (IrNode *) commonArenaAlloc(N, kCommonArenaRegionParse, sizeof(IrNode));
 
 	node->type		= type;
 	node->sourceInfo	= sourceInfo;
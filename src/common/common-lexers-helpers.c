@@ -43,6 +43,10 @@
 #include <string.h>
 #include <stdint.h>
 #include <inttypes.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "flextypes.h"
 #include "flexerror.h"
 #include "flex.h"
@@ -55,8 +59,143 @@
 #endif
 #include "common-timeStamps.h"
 #include "common-data-structures.h"
+#include "common-stringIntern.h"
+#include "common-arena.h"
 #include "common-lexers-helpers.h"
 
+/*
+ *	Map the source file, or read it in one call when it cannot be mapped
+ *	(e.g., a pipe), so the lexer can scan it in place rather than copying
+ *	it out a line at a time. The buffer is always followed by a '\0': a
+ *	mapping whose length is not a multiple of the page size gets that for
+ *	free from the zero-filled tail of its last page, and everything else
+ *	is read into a buffer with room for it.
+ */
+void
+lexSourceOpen(State *  N, char *  fileName)
+{
+	TimeStampTraceMacro(kCommonTimeStampKeyLexerSourceOpen);
+
+	struct stat	sourceStat;
+	int		fd;
+
+
+	N->source.buffer	= NULL;
+	N->source.length	= 0;
+	N->source.offset	= 0;
+	N->source.isMapped	= false;
+
+	fd = open(fileName, O_RDONLY);
+	if (fd < 0 || fstat(fd, &sourceStat) != 0)
+	{
+		flexprint(N->Fe, N->Fm, N->Fperr, "Could not open file \"%s\".\n", fileName);
+		fatal(N, Eopen);
+	}
+
+	if (S_ISREG(sourceStat.st_mode) && sourceStat.st_size > 0 && (sourceStat.st_size % sysconf(_SC_PAGESIZE)) != 0)
+	{
+		void *	mapping = mmap(NULL, sourceStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (mapping != MAP_FAILED)
+		{
+			posix_madvise(mapping, sourceStat.st_size, POSIX_MADV_SEQUENTIAL);
+
+			N->source.buffer	= mapping;
+			N->source.length	= sourceStat.st_size;
+			N->source.isMapped	= true;
+			close(fd);
+
+			return;
+		}
+	}
+
+	/*
+	 *	Regular files are read with a single read() of their full size; for
+	 *	anything else we do not know the size up front, so grow the buffer.
+	 */
+	size_t	bufferSize = (S_ISREG(sourceStat.st_mode) ? sourceStat.st_size : 0) + kCommonMaxBufferLength;
+
+	N->source.buffer = malloc(bufferSize + 1);
+	if (N->source.buffer == NULL)
+	{
+		fatal(N, Emalloc);
+	}
+
+	for (;;)
+	{
+		ssize_t	count = read(fd, &N->source.buffer[N->source.length], bufferSize - N->source.length);
+
+		if (count < 0)
+		{
+			flexprint(N->Fe, N->Fm, N->Fperr, "Could not read file \"%s\".\n", fileName);
+			fatal(N, Eopen);
+		}
+
+		if (count == 0)
+		{
+			break;
+		}
+
+		N->source.length += count;
+		if (N->source.length == bufferSize)
+		{
+			bufferSize *= 2;
+			N->source.buffer = realloc(N->source.buffer, bufferSize + 1);
+			if (N->source.buffer == NULL)
+			{
+				fatal(N, Emalloc);
+			}
+		}
+	}
+	N->source.buffer[N->source.length] = '\0';
+	close(fd);
+}
+
+/*
+ *	Point N->lineBuffer at the next line of the source buffer. The line
+ *	is not copied and N->lineLength includes its '\n', as with getline().
+ */
+bool
+lexSourceNextLine(State *  N)
+{
+	TimeStampTraceMacro(kCommonTimeStampKeyLexerSourceNextLine);
+
+	if (N->source.offset >= N->source.length)
+	{
+		return false;
+	}
+
+	char *	line		= &N->source.buffer[N->source.offset];
+	char *	newline		= memchr(line, '\n', N->source.length - N->source.offset);
+
+	N->lineBuffer	= line;
+	N->lineLength	= (newline == NULL) ? (N->source.length - N->source.offset) : (newline - line + 1);
+	N->source.offset += N->lineLength;
+
+	return true;
+}
+
+void
+lexSourceClose(State *  N)
+{
+	TimeStampTraceMacro(kCommonTimeStampKeyLexerSourceClose);
+
+	if (N->source.isMapped)
+	{
+		munmap(N->source.buffer, N->source.length);
+	}
+	else
+	{
+		free(N->source.buffer);
+	}
+
+	N->source.buffer	= NULL;
+	N->source.length	= 0;
+	N->source.offset	= 0;
+	N->source.isMapped	= false;
+	N->lineBuffer		= NULL;
+}
+
 void
 checkTokenLength(State *  N, int  count)
 {
@@ -81,15 +220,11 @@ gobble(State *  N, int count)
 {
 	TimeStampTraceMacro(kCommonTimeStampKeyLexerGobble);
 
-	checkTokenLength(N, count);
-	strncpy(N->currentToken, &N->lineBuffer[N->columnNumber], count);
-
-	if (N->verbosityLevel & kCommonVerbosityDebugLexer)
-	{
-		//flexprint(N->Fe, N->Fm, N->Fperr, "gobble, N->currentToken = \"%s\"\n", N->currentToken);
-		//fprintf(stderr, "gobble, N->currentToken = \"%s\"\n", N->currentToken);
-	}
-
+	/*
+	 *	Gobbled operators and separators are fully described by their token
+	 *	type, so their characters are left in the source buffer rather than
+	 *	being copied into N->currentToken.
+	 */
 	N->columnNumber += count;
 }
 
@@ -104,7 +239,11 @@ done(State *  N, Token *  newToken)
 								N->columnNumber - N->currentTokenLength /*	columnNumber	*/,
 								N->currentTokenLength			/*	length		*/);
 
-	bzero(N->currentToken, kCommonMaxBufferLength);
+	/*
+	 *	Everything past N->currentTokenLength is already zero, so only
+	 *	the characters of this token need clearing.
+	 */
+	bzero(N->currentToken, N->currentTokenLength);
 	N->currentTokenLength = 0;
 	lexPut(N, newToken);
 }
@@ -114,7 +253,7 @@ eqf(State *  N)
 {
 	TimeStampTraceMacro(kCommonTimeStampKeyLexerEqf);
 
-	return (N->lineLength >= 2 && N->lineBuffer[N->columnNumber+1] == '=');
+	return (N->columnNumber + 2 <= N->lineLength && N->lineBuffer[N->columnNumber+1] == '=');
 }
 
 
@@ -486,6 +625,129 @@ stringToEngineeringRealConst(State *  N, char *  string)
 
 
 
+/*
+ *	The lexer used to classify every identifier-like token by running
+ *	strcmp() against each entry of the token description table. Instead,
+ *	we hash the descriptions once per State into a table where no two
+ *	distinct descriptions share a slot (i.e., a perfect hash for that
+ *	set), trying successive seeds and then doubling the table until one
+ *	fits. A lookup is then one hash and at most one compare, both linear
+ *	in the token length.
+ */
+static uint64_t
+lexKeywordHash(const char *  string, size_t length, uint64_t seed)
+{
+	uint64_t	hash = 14695981039346656037UL ^ (seed * 0x9e3779b97f4a7c15UL);
+
+	for (size_t i = 0; i < length; i++)
+	{
+		hash ^= (uint8_t)string[i];
+		hash *= 1099511628211UL;
+	}
+
+	return hash ^ (hash >> 32);
+}
+
+
+static bool
+lexKeywordTablePlace(int *  table, uint64_t slots, uint64_t seed, const char *  tokenDescriptionArray[], int tokenTypeMax)
+{
+	for (uint64_t i = 0; i < slots; i++)
+	{
+		table[i] = -1;
+	}
+
+	for (int i = 0; i < tokenTypeMax; i++)
+	{
+		if (tokenDescriptionArray[i] == NULL)
+		{
+			continue;
+		}
+
+		uint64_t	slot = lexKeywordHash(tokenDescriptionArray[i], strlen(tokenDescriptionArray[i]), seed) & (slots - 1);
+
+		if (table[slot] < 0)
+		{
+			table[slot] = i;
+		}
+		else if (strcmp(tokenDescriptionArray[table[slot]], tokenDescriptionArray[i]))
+		{
+			return false;
+		}
+
+		/*
+		 *	Otherwise it is a duplicate description: the lowest type wins,
+		 *	as it did with the linear search.
+		 */
+	}
+
+	return true;
+}
+
+
+void
+lexKeywordTableInit(State *  N, const char *  tokenDescriptionArray[], int tokenTypeMax)
+{
+	int		descriptionCount = 0;
+	uint64_t	slots = 64;
+
+	for (int i = 0; i < tokenTypeMax; i++)
+	{
+		descriptionCount += (tokenDescriptionArray[i] != NULL);
+	}
+
+	while (slots < 4*(uint64_t)descriptionCount)
+	{
+		slots *= 2;
+	}
+
+	int *	table = (int *)calloc(kCommonKeywordTableMaxSlots, sizeof(int));
+	if (table == NULL)
+	{
+		fatal(N, Emalloc);
+	}
+
+	for (; slots <= kCommonKeywordTableMaxSlots; slots *= 2)
+	{
+		for (uint64_t seed = 0; seed < kCommonKeywordTableSeedsPerSize; seed++)
+		{
+			if (lexKeywordTablePlace(table, slots, seed, tokenDescriptionArray, tokenTypeMax))
+			{
+				N->keywordTable = (int *)commonArenaAlloc(N, kCommonArenaRegionLex, slots*sizeof(int));
+				memcpy(N->keywordTable, table, slots*sizeof(int));
+				N->keywordTableSlots = slots;
+				N->keywordTableSeed = seed;
+				N->keywordStrings = tokenDescriptionArray;
+				free(table);
+
+				return;
+			}
+		}
+	}
+
+	free(table);
+	fatal(N, Esanity);
+}
+
+
+/*
+ *	Return the token type whose description is the first length
+ *	characters of token, or -1 if there is none.
+ */
+int
+lexKeywordLookup(State *  N, const char *  token, size_t length)
+{
+	int	type = N->keywordTable[lexKeywordHash(token, length, N->keywordTableSeed) & (N->keywordTableSlots - 1)];
+
+	if ((type < 0) || strncmp(N->keywordStrings[type], token, length) || (N->keywordStrings[type][length] != '\0'))
+	{
+		return -1;
+	}
+
+	return type;
+}
+
+
 SourceInfo *
 lexAllocateSourceInfo(	State *  N, char **  genealogy, char *  fileName,
 				uint64_t lineNumber, uint64_t columnNumber, uint64_t length)
@@ -494,14 +756,10 @@ lexAllocateSourceInfo(	State *  N, char **  genealogy, char *  fileName,
 
 	SourceInfo *	newSourceInfo;
 
-	newSourceInfo = (SourceInfo *) calloc(1, sizeof(SourceInfo));
-	if (newSourceInfo == NULL)
-	{
-		fatal(N, Emalloc);
-	}
+	newSourceInfo = (SourceInfo *) commonArenaAlloc(N, kCommonArenaRegionLex, sizeof(SourceInfo));
 
 	newSourceInfo->genealogy	= genealogy;
-	newSourceInfo->fileName		= (fileName == NULL ? NULL : strdup(fileName));
+	newSourceInfo->fileName		= (char *)commonStringIntern(N, fileName);
 	newSourceInfo->lineNumber	= lineNumber;
 	newSourceInfo->columnNumber	= columnNumber;
 	newSourceInfo->length		= length;
@@ -519,17 +777,13 @@ lexAllocateToken(	State *  N, IrNodeType type, char *  identifier,
 
 	Token *	newToken;
 
-	newToken = (Token *) calloc(1, sizeof(Token));
-	if (newToken == NULL)
-	{
-		fatal(N, Emalloc);
-	}
+	newToken = (Token *) commonArenaAlloc(N, kCommonArenaRegionLex, sizeof(Token));
 
 	newToken->type		= type;
-	newToken->identifier	= (identifier == NULL ? NULL : strdup(identifier));
+	newToken->identifier	= (char *)commonStringIntern(N, identifier);
 	newToken->integerConst	= integerConst;
 	newToken->realConst	= realConst;
-	newToken->stringConst	= (stringConst == NULL ? NULL : strdup(stringConst));
+	newToken->stringConst	= (char *)commonStringIntern(N, stringConst);
 	newToken->sourceInfo	= sourceInfo;
 
 	return newToken;
@@ -548,18 +802,20 @@ lexPut(State *  N, Token *  newToken)
 	}
 
 	/*
-	 *	If the token list is empty, we allocate and put on an EOF node, which we never remove.
-	 */	
-	if (N->tokenList == NULL)
-	{
-		N->lastToken = N->tokenList = newToken;
-	}
-	else
+	 *	The array only holds pointers, so the tokens themselves stay put
+	 *	in the lex arena when it grows.
+	 */
+	if (N->tokenCount == N->tokenSlots)
 	{
-		newToken->prev = N->lastToken;
-		N->lastToken->next = newToken;
-		N->lastToken = newToken;
+		N->tokenSlots = (N->tokenSlots == 0) ? kCommonTokenStreamInitialSlots : 2 * N->tokenSlots;
+		N->tokens = realloc(N->tokens, N->tokenSlots * sizeof(Token *));
+		if (N->tokens == NULL)
+		{
+			fatal(N, Emalloc);
+		}
 	}
+
+	N->tokens[N->tokenCount++] = newToken;
 }
 
 
@@ -568,16 +824,19 @@ lexGet(State *  N, const char *  tokenDescriptionArray[kCommonIrNodeTypeMax])
 {
 	TimeStampTraceMacro(kCommonTimeStampKeyLexGet);
 
-	if (N->tokenList == NULL)
+	if (N->tokenCursor >= N->tokenCount)
 	{
 		fatal(N, Esanity);
 	}
 
-	Token *	t = N->tokenList;
-	
-	if (t->next != NULL)
+	Token *	t = N->tokens[N->tokenCursor];
+
+	/*
+	 *	The last token (the EOF) is never consumed.
+	 */
+	if (N->tokenCursor + 1 < N->tokenCount)
 	{
-		N->tokenList = N->tokenList->next;
+		N->tokenCursor++;
 	}
 	else if ((t->type != kNewtonIrNodeType_Zeof) && (t->type != kNoisyIrNodeType_Zeof))
 	{
@@ -598,28 +857,25 @@ lexPeek(State *  N, int lookAhead)
 {
 	TimeStampTraceMacro(kCommonTimeStampKeyLexPeek);
 
-	if (N->tokenList == NULL)
-	{
-		fatal(N, Esanity);
-	}
-
-	Token *	tmp = N->tokenList;
-	int 		which = 1;
-	while ((tmp != NULL) && (which++ < lookAhead))
+	/*
+	 *	A lookahead below 1 peeks at the next token, like 1 does. The Noisy
+	 *	assignment statement parser relies on it.
+	 */
+	if (lookAhead < 1)
 	{
-		tmp = tmp->next;
+		lookAhead = 1;
 	}
 
 	/*
 	 *	We don't intend for callers to check if the result of lexPeek is NULL
 	 *	as it should only be used when lexPeek should never result in NULL 
 	 */
-	if (tmp == NULL)
+	if (N->tokenCursor + lookAhead > N->tokenCount)
 	{
 		fatal(N, Esanity);
 	}
 
-	return tmp;
+	return N->tokens[N->tokenCursor + lookAhead - 1];
 }
 
 
@@ -741,13 +997,14 @@ lexPeekPrint(State *  N, int maxTokens, int formatCharacters, const char *  toke
 {
 	TimeStampTraceMacro(kCommonTimeStampKeyLexPeekPrint);
 
-	if (N->tokenList == NULL)
+	if (N->tokenCursor >= N->tokenCount)
 	{
 		fatal(N, Esanity);
 	}
 
 	int		tripCharacters = 0, done = 0;
-	Token *	tmp = N->tokenList;
+	uint64_t	index = N->tokenCursor;
+	Token *		tmp = N->tokens[index];
 
 	if (N->mode & kCommonModeCGI)
 	{
@@ -760,6 +1017,8 @@ lexPeekPrint(State *  N, int maxTokens, int formatCharacters, const char *  toke
 
 	while (tmp != NULL)
 	{
+		Token *	next = (index + 1 < N->tokenCount) ? N->tokens[index + 1] : NULL;
+
 		if (maxTokens > 0 && (done++ > maxTokens))
 		{
 			flexprint(N->Fe, N->Fm, N->Fperr, "...");
@@ -844,18 +1103,18 @@ lexPeekPrint(State *  N, int maxTokens, int formatCharacters, const char *  toke
 				}
 			}
 
-			if ((tmp->next != NULL) && (tmp->sourceInfo->lineNumber != tmp->next->sourceInfo->lineNumber))
+			if ((next != NULL) && (tmp->sourceInfo->lineNumber != next->sourceInfo->lineNumber))
 			{
 				//flexprint(N->Fe, N->Fm, N->Fperr, "(newlines)");
 				tripCharacters = 0;
 
 				if (N->mode & kCommonModeCGI)
 				{
-					flexprint(N->Fe, N->Fm, N->Fperr, "\n\tline %5d\t\t", tmp->next->sourceInfo->lineNumber);
+					flexprint(N->Fe, N->Fm, N->Fperr, "\n\tline %5d\t\t", next->sourceInfo->lineNumber);
 				}
 				else
 				{
-					flexprint(N->Fe, N->Fm, N->Fperr, "\n\tsource file: %40s, line %5d\t\t", tmp->sourceInfo->fileName, tmp->next->sourceInfo->lineNumber);
+					flexprint(N->Fe, N->Fm, N->Fperr, "\n\tsource file: %40s, line %5d\t\t", tmp->sourceInfo->fileName, next->sourceInfo->lineNumber);
 				}
 			}
 			else if (tripCharacters >= formatCharacters)
@@ -872,7 +1131,8 @@ lexPeekPrint(State *  N, int maxTokens, int formatCharacters, const char *  toke
 			}
 		}
 
-		tmp = tmp->next;
+		tmp = next;
+		index++;
 	}
 	flexprint(N->Fe, N->Fm, N->Fperr, "\n");
 }
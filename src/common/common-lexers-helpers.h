@@ -35,6 +35,9 @@
 	POSSIBILITY OF SUCH DAMAGE.
 */
 
+void		lexSourceOpen(State *  N, char *  fileName);
+bool		lexSourceNextLine(State *  N);
+void		lexSourceClose(State *  N);
 void		checkTokenLength(State *  N, int  count);
 char		cur(State *  N);
 void		gobble(State *  N, int count);
@@ -54,6 +57,8 @@ double		stringToRealConst(State *  N, char *  string);
 double		stringToEngineeringRealConst(State *  N, char *  string);
 
 
+void		lexKeywordTableInit(State *  N, const char *  tokenDescriptionArray[], int tokenTypeMax);
+int		lexKeywordLookup(State *  N, const char *  token, size_t length);
 SourceInfo *	lexAllocateSourceInfo(	State *  N, char **  genealogy, 
 							char *  fileName, uint64_t lineNumber,
 							uint64_t columnNumber, uint64_t length);
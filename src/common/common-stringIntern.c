@@ -0,0 +1,243 @@
+/*
+	Authored 2026. Phillip Stanley-Marbell.
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions
+	are met:
+
+	*	Redistributions of source code must retain the above
+		copyright notice, this list of conditions and the following
+		disclaimer.
+
+	*	Redistributions in binary form must reproduce the above
+		copyright notice, this list of conditions and the following
+		disclaimer in the documentation and/or other materials
+		provided with the distribution.
+
+	*	Neither the name of the author nor the names of its
+		contributors may be used to endorse or promote products
+		derived from this software without specific prior written
+		permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include <string.h>
+#include <stdint.h>
+#include "flextypes.h"
+#include "flexerror.h"
+#include "flex.h"
+#include "common-errors.h"
+#include "noisy-timeStamps.h"
+#include "common-timeStamps.h"
+#include "common-data-structures.h"
+#include "common-stringIntern.h"
+#include "common-arena.h"
+
+
+/*
+ *	A single pool of interned strings hangs off the State. Each distinct
+ *	string is stored exactly once, and callers get back a stable handle
+ *	that lives as long as the State. Two interned strings are equal if
+ *	and only if their handles are equal, so identifier comparisons in
+ *	the symbol table and elsewhere can be pointer comparisons.
+ *
+ *	Interned strings must never be modified or freed by callers.
+ */
+
+
+static uint64_t
+commonStringInternHash(const char *  string, size_t length)
+{
+	uint64_t	hash = 14695981039346656037UL;
+
+	for (size_t i = 0; i < length; i++)
+	{
+		hash ^= (uint8_t)string[i];
+		hash *= 1099511628211UL;
+	}
+
+	return hash;
+}
+
+
+static InternedString *
+commonStringInternFind(State *  N, const char *  string, size_t length, uint64_t hash)
+{
+	if (N->internedStrings == NULL)
+	{
+		return NULL;
+	}
+
+	InternedString *	p = N->internedStrings[hash & (N->internedStringSlots - 1)];
+	while (p != NULL)
+	{
+		if ((p->hash == hash) && (p->length == length) && !memcmp(p->string, string, length))
+		{
+			return p;
+		}
+		p = p->next;
+	}
+
+	return NULL;
+}
+
+
+/*
+ *	Keep the load factor at or below one. Entries carry their hash,
+ *	so growing only relinks them.
+ */
+static void
+commonStringInternGrow(State *  N)
+{
+	if ((N->internedStrings != NULL) && (N->internedStringCount < N->internedStringSlots))
+	{
+		return;
+	}
+
+	uint64_t		newSlots = (N->internedStrings == NULL) ? kCommonStringInternInitialSlots : 2*N->internedStringSlots;
+	InternedString **	newTable = (InternedString **)calloc(newSlots, sizeof(InternedString *));
+	if (newTable == NULL)
+	{
+		fatal(N, Emalloc);
+	}
+
+	for (uint64_t i = 0; i < N->internedStringSlots; i++)
+	{
+		InternedString *	p = N->internedStrings[i];
+		while (p != NULL)
+		{
+			InternedString *	next = p->next;
+
+			p->next = newTable[p->hash & (newSlots - 1)];
+			newTable[p->hash & (newSlots - 1)] = p;
+			p = next;
+		}
+	}
+
+	free(N->internedStrings);
+	N->internedStrings = newTable;
+	N->internedStringSlots = newSlots;
+}
+
+
+/*
+ *	Intern the first length characters of string (which need not be
+ *	NUL-terminated). The returned handle is always NUL-terminated.
+ */
+const char *
+commonStringInternLength(State *  N, const char *  string, size_t length)
+{
+	if (string == NULL)
+	{
+		return NULL;
+	}
+
+	uint64_t		hash = commonStringInternHash(string, length);
+	InternedString *	entry = commonStringInternFind(N, string, length, hash);
+
+	N->internRequestCount++;
+	N->internRequestBytes += length + 1;
+
+	if (entry != NULL)
+	{
+		return entry->string;
+	}
+
+	commonStringInternGrow(N);
+
+	entry = (InternedString *)commonArenaAlloc(N, kCommonArenaRegionLex, sizeof(InternedString) + length + 1);
+	entry->hash	= hash;
+	entry->length	= length;
+	memcpy(entry->string, string, length);
+	entry->string[length] = '\0';
+
+	entry->next = N->internedStrings[hash & (N->internedStringSlots - 1)];
+	N->internedStrings[hash & (N->internedStringSlots - 1)] = entry;
+
+	N->internedStringCount++;
+	N->internedStringBytes += length + 1;
+
+	return entry->string;
+}
+
+
+const char *
+commonStringIntern(State *  N, const char *  string)
+{
+	if (string == NULL)
+	{
+		return NULL;
+	}
+
+	return commonStringInternLength(N, string, strlen(string));
+}
+
+
+/*
+ *	Return the handle for string if it has already been interned, or NULL
+ *	otherwise. Since every identifier that can appear in the symbol table
+ *	is interned, a NULL return means no symbol can match.
+ */
+const char *
+commonStringInternLookup(State *  N, const char *  string)
+{
+	if (string == NULL)
+	{
+		return NULL;
+	}
+
+	size_t			length = strlen(string);
+	InternedString *	entry = commonStringInternFind(N, string, length, commonStringInternHash(string, length));
+
+	return (entry == NULL ? NULL : entry->string);
+}
+
+
+void
+commonStringInternDumpStatistics(State *  N)
+{
+	uint64_t	poolBytes = N->internedStringBytes
+					+ N->internedStringCount*sizeof(InternedString)
+					+ N->internedStringSlots*sizeof(InternedString *);
+
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "String Interning Information:\n\n");
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "    Intern requests                      : %llu\n", N->internRequestCount);
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "    Unique interned strings              : %llu\n", N->internedStringCount);
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "    Allocations without interning        : %llu\n", N->internRequestCount);
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "    Allocations with interning           : %llu\n", N->internedStringCount + (N->internedStrings == NULL ? 0 : 1));
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "    String bytes without interning       : %llu\n", N->internRequestBytes);
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "    Pool bytes with interning            : %llu\n", poolBytes);
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "\n");
+}
+
+
+/*
+ *	The entries themselves live in the lex arena and go away with it.
+ */
+void
+commonStringInternDealloc(State *  N)
+{
+	free(N->internedStrings);
+	N->internedStrings = NULL;
+	N->internedStringSlots = 0;
+	N->internedStringCount = 0;
+	N->internedStringBytes = 0;
+}
@@ -49,6 +49,8 @@
 #include "noisy-timeStamps.h"
 #include "common-timeStamps.h"
 #include "common-data-structures.h"
+#include "common-stringIntern.h"
+#include "common-arena.h"
 #include "common-symbolTable.h"
 
 
@@ -63,15 +65,116 @@ commonSymbolTableAllocScope(State *  N)
 
 	Scope *	newScope;
 
-	newScope = (Scope *)calloc(1, sizeof(Scope));
-	if (newScope == NULL)
+	newScope = (Scope *)commonArenaAlloc(N, kCommonArenaRegionParse, sizeof(Scope));
+
+	return newScope;
+}
+
+/*
+ *	Symbol identifiers are interned (see common-stringIntern.c), so we
+ *	hash and compare the handles rather than the characters. Symbols
+ *	cache the hash in identifierHash so growing a scope's index is cheap.
+ */
+static uint64_t
+commonSymbolTableHashIdentifier(const char *  identifier)
+{
+	uint64_t	hash = (uint64_t)(uintptr_t)identifier;
+
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdUL;
+	hash ^= hash >> 33;
+
+	return hash;
+}
+
+
+/*
+ *	Walk only the bucket for identifier in this one scope (not its parents).
+ */
+static Symbol *
+commonSymbolTableLookupInScope(State *  N, Scope *  scope, const char *  identifier, uint64_t hash)
+{
+	if (scope->symbolIndex == NULL)
 	{
-		fatal(N, Emalloc);
+		return NULL;
 	}
 
-	return newScope;
+	Symbol *	sym = scope->symbolIndex[hash & (scope->symbolIndexSlots - 1)];
+	while (sym != NULL)
+	{
+		if (sym->identifier == identifier)
+		{
+			return sym;
+		}
+		sym = sym->hashNext;
+	}
+
+	return NULL;
+}
+
+
+/*
+ *	Lookups return the first symbol in firstSymbol list order with a
+ *	matching identifier, so a symbol only goes into the index if it is
+ *	not shadowed by one already there (append), or if it shadows any
+ *	existing one (prepend, from deepCopyIrNode()).
+ */
+static void
+commonSymbolTableIndexSymbol(State *  N, Scope *  scope, Symbol *  symbol, bool shadowsExisting)
+{
+	uint64_t	bucket = symbol->identifierHash & (scope->symbolIndexSlots - 1);
+
+	if (shadowsExisting)
+	{
+		symbol->hashNext = scope->symbolIndex[bucket];
+		scope->symbolIndex[bucket] = symbol;
+
+		return;
+	}
+
+	if (commonSymbolTableLookupInScope(N, scope, symbol->identifier, symbol->identifierHash) != NULL)
+	{
+		symbol->hashNext = NULL;
+
+		return;
+	}
+
+	symbol->hashNext = scope->symbolIndex[bucket];
+	scope->symbolIndex[bucket] = symbol;
 }
 
+
+/*
+ *	Keep the load factor at or below one. The index is rebuilt from
+ *	the firstSymbol list so that shadowing order is preserved. Returns
+ *	true if it rebuilt the index (and hence indexed every symbol).
+ */
+static bool
+commonSymbolTableGrowIndex(State *  N, Scope *  scope)
+{
+	if ((scope->symbolIndex != NULL) && (scope->symbolCount <= scope->symbolIndexSlots))
+	{
+		return false;
+	}
+
+	uint64_t	newSlots = (scope->symbolIndex == NULL) ? kCommonSymbolTableInitialIndexSlots : 2*scope->symbolIndexSlots;
+
+	/*
+	 *	The old index stays behind in the parse arena; the geometric
+	 *	growth bounds that waste to the size of the final index.
+	 */
+	scope->symbolIndex = (Symbol **)commonArenaAlloc(N, kCommonArenaRegionParse, newSlots * sizeof(Symbol *));
+	scope->symbolIndexSlots = newSlots;
+
+	for (Symbol *  p = scope->firstSymbol; p != NULL; p = p->next)
+	{
+		commonSymbolTableIndexSymbol(N, scope, p, false /* shadowsExisting */);
+	}
+
+	return true;
+}
+
+
 Symbol *
 commonSymbolTableAddOrLookupSymbolForToken(State *  N, Scope *  scope, Token *  token)
 {
@@ -79,20 +182,17 @@ commonSymbolTableAddOrLookupSymbolForToken(State *  N, Scope *  scope, Token *
 
 	Symbol *	newSymbol;
 
-	newSymbol = (Symbol *)calloc(1, sizeof(Symbol));
-	if (newSymbol == NULL)
-	{
-		fatal(N, Emalloc);
-	}
+	newSymbol = (Symbol *)commonArenaAlloc(N, kCommonArenaRegionParse, sizeof(Symbol));
 
-	newSymbol->identifier	= token->identifier;
-	newSymbol->sourceInfo	= token->sourceInfo;
-	newSymbol->scope	= scope;
+	newSymbol->identifier		= (char *)commonStringIntern(N, token->identifier);
+	newSymbol->identifierHash	= commonSymbolTableHashIdentifier(newSymbol->identifier);
+	newSymbol->sourceInfo		= token->sourceInfo;
+	newSymbol->scope		= scope;
 
 	/*
 	 *	NOTE:	An extant definition might not exist.
 	 */
-	newSymbol->definition	= commonSymbolTableSymbolForIdentifier(N, scope, token->identifier);
+	newSymbol->definition	= commonSymbolTableSymbolForIdentifier(N, scope, newSymbol->identifier);
 
 	/*
 	 *	NOTE:	Caller sets (1) intconst/etc. fields, (2) type, based on context.
@@ -104,66 +204,87 @@ commonSymbolTableAddOrLookupSymbolForToken(State *  N, Scope *  scope, Token *
 	}
 	else
 	{
-		Symbol *	p = scope->firstSymbol;
-		while (p->next != NULL)
-		{
-			p = p->next;
-		}
-		p->next = newSymbol;
+		scope->lastSymbol->next = newSymbol;
+	}
+	scope->lastSymbol = newSymbol;
+	scope->symbolCount++;
+
+	if (!commonSymbolTableGrowIndex(N, scope))
+	{
+		commonSymbolTableIndexSymbol(N, scope, newSymbol, false /* shadowsExisting */);
 	}
 
 	return newSymbol;
 }
 
 
+/*
+ *	Insert an already-populated symbol at the head of the scope, so that
+ *	it shadows any extant symbol with the same identifier.
+ */
+void
+commonSymbolTableInsertSymbolAtHead(State *  N, Scope *  scope, Symbol *  symbol)
+{
+	symbol->identifier	= (char *)commonStringIntern(N, symbol->identifier);
+	symbol->identifierHash	= commonSymbolTableHashIdentifier(symbol->identifier);
+	symbol->scope		= scope;
+	symbol->prev		= NULL;
+	symbol->next		= scope->firstSymbol;
+	symbol->hashNext	= NULL;
+
+	scope->firstSymbol = symbol;
+	if (scope->lastSymbol == NULL)
+	{
+		scope->lastSymbol = symbol;
+	}
+	scope->symbolCount++;
+
+	if (!commonSymbolTableGrowIndex(N, scope))
+	{
+		commonSymbolTableIndexSymbol(N, scope, symbol, true /* shadowsExisting */);
+	}
+}
+
+
 Symbol *
 commonSymbolTableSymbolForIdentifier(State *  N, Scope *  scope, const char *  identifier)
 {
 //	TimeStampTraceMacro(kNoisyTimeStampKeySymbolTableSymbolForIdentifier);
 
+	const char *	internedIdentifier = commonStringInternLookup(N, identifier);
+	Symbol *	sym;
+
 	/*
-	 *	Recursion falls out when we reach root which has nil parent,
-	 *	and this is the point at which we check the module scopes:
+	 *	If the identifier has never been interned, no symbol can have it.
 	 */
-	if (scope == NULL)
+	if (internedIdentifier == NULL)
 	{
-		Scope *	moduleScope = N->moduleScopes;
-
-		// while (moduleScope != NULL)
-		// {
-		if (moduleScope != NULL)
-		{
-			Symbol *	moduleSym = moduleScope->firstSymbol;
-
-			while (moduleSym != NULL)
-			{
-				if (!strcmp(moduleSym->identifier, identifier))
-				{
-					return moduleSym;
-				}
-				moduleSym = moduleSym->next;
-			}
-		}
-			// moduleScope = moduleScope->next;
-		// }
-
 		return NULL;
 	}
 
+	uint64_t	hash = commonSymbolTableHashIdentifier(internedIdentifier);
+
 	/*
 	 *	Search current and parent (not siblings or children)
 	 */
-	Symbol *	sym = scope->firstSymbol;
-	while (sym != NULL)
+	for (Scope *  p = scope; p != NULL; p = p->parent)
 	{
-		if (!strcmp(sym->identifier, identifier))
+		sym = commonSymbolTableLookupInScope(N, p, internedIdentifier, hash);
+		if (sym != NULL)
 		{
 			return sym;
 		}
-		sym = sym->next;
 	}
 
-	return commonSymbolTableSymbolForIdentifier(N, scope->parent, identifier);
+	/*
+	 *	Once we reach root which has nil parent, we check the module scopes:
+	 */
+	if (N->moduleScopes != NULL)
+	{
+		return commonSymbolTableLookupInScope(N, N->moduleScopes, internedIdentifier, hash);
+	}
+
+	return NULL;
 }
 
 
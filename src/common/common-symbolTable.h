@@ -40,6 +40,7 @@
 
 Scope *		commonSymbolTableAllocScope(State *  N);
 Symbol *	commonSymbolTableAddOrLookupSymbolForToken(State *  N, Scope *  scope, Token *  token);
+void		commonSymbolTableInsertSymbolAtHead(State *  N, Scope *  scope, Symbol *  symbol);
 Symbol *	commonSymbolTableSymbolForIdentifier(State *  N, Scope *  scope, const char *  identifier);
 Scope *		commonSymbolTableGetScopeWithName(State * N, Scope * scope, const char * identifier);
 Scope *		commonSymbolTableOpenScope(State *  N, Scope *  scope, IrNode *  subtree);
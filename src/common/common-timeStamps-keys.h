@@ -66,6 +66,9 @@
 	kCommonTimeStampKeyLexerIsHexConstWithoutLeading0x,
 	kCommonTimeStampKeyLexerIsRadixConst,
 	kCommonTimeStampKeyLexerIsRealConst,
+	kCommonTimeStampKeyLexerSourceClose,
+	kCommonTimeStampKeyLexerSourceNextLine,
+	kCommonTimeStampKeyLexerSourceOpen,
 	kCommonTimeStampKeyLexerStringAtLeft,
 	kCommonTimeStampKeyLexerStringAtRight,
 	kCommonTimeStampKeyLexerStringToEngineeringRealConst,
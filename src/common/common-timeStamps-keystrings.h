@@ -65,6 +65,9 @@
 	[	kCommonTimeStampKeyLexerIsHexConstWithoutLeading0x]	"kCommonTimeStampKeyLexerIsHexConstWithoutLeading0x",
 	[	kCommonTimeStampKeyLexerIsRadixConst]			"kCommonTimeStampKeyLexerIsRadixConst",
 	[	kCommonTimeStampKeyLexerIsRealConst]			"kCommonTimeStampKeyLexerIsRealConst",
+	[	kCommonTimeStampKeyLexerSourceClose]			"kCommonTimeStampKeyLexerSourceClose",
+	[	kCommonTimeStampKeyLexerSourceNextLine]		"kCommonTimeStampKeyLexerSourceNextLine",
+	[	kCommonTimeStampKeyLexerSourceOpen]			"kCommonTimeStampKeyLexerSourceOpen",
 	[	kCommonTimeStampKeyLexerStringAtLeft]			"kCommonTimeStampKeyLexerStringAtLeft",
 	[	kCommonTimeStampKeyLexerStringAtRight]			"kCommonTimeStampKeyLexerStringAtRight",
 	[	kCommonTimeStampKeyLexerStringToEngineeringRealConst]	"kCommonTimeStampKeyLexerStringToEngineeringRealConst",
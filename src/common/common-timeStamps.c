@@ -71,6 +71,11 @@ machtimeToNanoseconds(uint64_t machTime)
 
 	//TODO: there might be multitplication overflow...
 	return (machTime * sTimebaseInfo.numer / sTimebaseInfo.denom);
+#elif defined(CommonOsLinux)
+	/*
+	 *	TimeMacro is already in nanoseconds on Linux.
+	 */
+	return machTime;
 #else
 	return 0;
 #endif
@@ -79,19 +84,26 @@ machtimeToNanoseconds(uint64_t machTime)
 void
 timeStampDumpTimeline(State *  N)
 {
-	flexprint(N->Fe, N->Fm, N->Fpinfo, "\nRoutine invocation trace (%d calls):\n\n",
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "\nRoutine invocation trace (%llu calls):\n\n",
 					N->timestampCount);
 
-	for (int i = 0; i < N->timestampCount; i++)
+	/*
+	 *	Once the ring has wrapped, only the last timestampSlots entries remain.
+	 */
+	uint64_t	first = (N->timestampCount > N->timestampSlots) ? N->timestampCount - N->timestampSlots : 0;
+
+	for (uint64_t i = first; i < N->timestampCount; i++)
 	{
-		if (	(N->timestamps[i].key >=0) &&
-			(N->timestamps[i].key < kCommonTimeStampKeyMax) &&
-			(TimeStampKeyStrings[N->timestamps[i].key] != NULL)
+		TimeStamp *	timestamp = &N->timestamps[i & (N->timestampSlots - 1)];
+
+		if (	(timestamp->key >=0) &&
+			(timestamp->key < kCommonTimeStampKeyMax) &&
+			(TimeStampKeyStrings[timestamp->key] != NULL)
 		)
 		{
-			flexprint(N->Fe, N->Fm, N->Fpinfo, "    %-6d\t(init + %-06.1f us) in routine %s\n",
-							i, (double)machtimeToNanoseconds(N->timestamps[i].nanoseconds - N->initializationTimestamp)/1000.0,
-							(TimeStampKeyStrings[N->timestamps[i].key] == NULL ? "?" : (strchr(TimeStampKeyStrings[N->timestamps[i].key], 'y') + 1)));
+			flexprint(N->Fe, N->Fm, N->Fpinfo, "    %-6llu\t(init + %-06.1f us) in routine %s\n",
+							i, (double)machtimeToNanoseconds(timestamp->nanoseconds - N->initializationTimestamp)/1000.0,
+							(strchr(TimeStampKeyStrings[timestamp->key], 'y') + 1));
 		}
 	}
 	flexprint(N->Fe, N->Fm, N->Fpinfo, "\n");
@@ -124,3 +136,81 @@ timeStampDumpResidencies(State *  N)
 	flexprint(N->Fe, N->Fm, N->Fpinfo, "\n");
 
 }
+
+
+void
+timeStampPhase(State *  N, const char *  phaseName, char type)
+{
+	/*
+	 *	Phases are coarse, so a full table simply drops the rest.
+	 */
+	if (N->timestampPhaseCount >= kCommonTimestampPhaseSlots)
+	{
+		return;
+	}
+
+	N->timestampPhases[N->timestampPhaseCount].name = phaseName;
+	N->timestampPhases[N->timestampPhaseCount].nanoseconds = TimeMacro;
+	N->timestampPhases[N->timestampPhaseCount].type = type;
+	N->timestampPhaseCount++;
+}
+
+
+/*
+ *	Write the phases and the routine timeline in the Chrome trace-event
+ *	JSON format (load it in chrome://tracing or ui.perfetto.dev). Phases
+ *	are begin/end pairs on one track; each routine timestamp becomes a
+ *	complete event lasting until the next timestamp, on a second track.
+ *	Times in the trace are in microseconds since timestampsInit().
+ */
+void
+timeStampDumpChromeTrace(State *  N, const char *  fileName)
+{
+	FILE *	traceFile;
+
+	traceFile = fopen(fileName, "w");
+	if (traceFile == NULL)
+	{
+		flexprint(N->Fe, N->Fm, N->Fperr, "\n%s: %s.\n", Eopen, fileName);
+		consolePrintBuffers(N);
+
+		return;
+	}
+
+	fprintf(traceFile, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+	fprintf(traceFile, "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, \"args\": {\"name\": \"phases\"}},\n");
+	fprintf(traceFile, "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 2, \"args\": {\"name\": \"routines\"}}");
+
+	for (uint64_t i = 0; i < N->timestampPhaseCount; i++)
+	{
+		fprintf(traceFile, ",\n{\"name\": \"%s\", \"ph\": \"%c\", \"pid\": 1, \"tid\": 1, \"ts\": %.3f}",
+				N->timestampPhases[i].name,
+				N->timestampPhases[i].type,
+				(double)machtimeToNanoseconds(N->timestampPhases[i].nanoseconds - N->initializationTimestamp)/1000.0);
+	}
+
+	uint64_t	first = (N->timestampCount > N->timestampSlots) ? N->timestampCount - N->timestampSlots : 0;
+	uint64_t	now = TimeMacro;
+
+	for (uint64_t i = first; i < N->timestampCount; i++)
+	{
+		TimeStamp *	timestamp = &N->timestamps[i & (N->timestampSlots - 1)];
+		uint64_t	end = (i + 1 < N->timestampCount) ? N->timestamps[(i + 1) & (N->timestampSlots - 1)].nanoseconds : now;
+
+		if (	(timestamp->key < 0) ||
+			(timestamp->key >= kCommonTimeStampKeyMax) ||
+			(TimeStampKeyStrings[timestamp->key] == NULL)
+		)
+		{
+			continue;
+		}
+
+		fprintf(traceFile, ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": 2, \"ts\": %.3f, \"dur\": %.3f}",
+				(strchr(TimeStampKeyStrings[timestamp->key], 'y') + 1),
+				(double)machtimeToNanoseconds(timestamp->nanoseconds - N->initializationTimestamp)/1000.0,
+				(double)machtimeToNanoseconds(end - timestamp->nanoseconds)/1000.0);
+	}
+
+	fprintf(traceFile, "\n]}\n");
+	fclose(traceFile);
+}
@@ -41,15 +41,33 @@ typedef struct
 	TimeStampKey	key;
 } TimeStamp;
 
+/*
+ *	Compiler phases (lexing, parsing, each IR pass, ...) are bracketed
+ *	by a begin and an end record so that the Chrome trace export can
+ *	nest the routine-level timeline inside them. The type is the Chrome
+ *	trace-event phase character, 'B' or 'E'.
+ */
+typedef struct
+{
+	const char *	name;
+	uint64_t	nanoseconds;
+	char		type;
+} TimeStampPhase;
+
 
 #ifdef CommonOsMacOSX
 #	include <mach/mach.h>
 #	include <mach/mach_time.h>
 #endif /* CommonOsMacOSX */
 
+#ifdef CommonOsLinux
+#	include <time.h>
+#endif /* CommonOsLinux */
+
 /*
- *	NOTE: The final N->callAggregateTotal and N->timestampCount won't match
- *	because we roll timestampCount modulo number of slots. 
+ *	NOTE: N->timestamps is a ring: N->timestampCount keeps counting, and
+ *	only the most recent N->timestampSlots entries of the timeline are kept.
+ *	N->timestampSlots must be a power of two so the slot index is a mask.
  *
  *	We get complementary information from DTrace (see precommitStatisticsHook.sh).
  *	However, having this manual tracing ability that we can statically compile in
@@ -58,6 +76,16 @@ typedef struct
  */
 #ifdef CommonOsMacOSX
 #	define TimeMacro mach_absolute_time()
+#elif defined(CommonOsLinux)
+/*
+ *	CLOCK_MONOTONIC is served from the vDSO without a system call and,
+ *	unlike a raw rdtsc, needs no calibration and is safe across cores.
+ */
+#	define TimeMacro ({\
+				struct timespec	timeMacroNow;\
+				clock_gettime(CLOCK_MONOTONIC, &timeMacroNow);\
+				((uint64_t)timeMacroNow.tv_sec * 1000000000ULL) + (uint64_t)timeMacroNow.tv_nsec;\
+			})
 #else
 #	define TimeMacro 0
 #endif /* CommonOsMacOSX */
@@ -70,21 +98,33 @@ typedef struct
 							}\
 							\
 							uint64_t	now = TimeMacro;\
+							TimeStamp *	slot = &N->timestamps[N->timestampCount & (N->timestampSlots - 1)];\
 							\
-							N->timestamps[N->timestampCount].nanoseconds = now;\
-							N->timestamps[N->timestampCount].key = (routineKey);\
+							slot->nanoseconds = now;\
+							slot->key = (routineKey);\
 							\
-							if (N->callAggregateTotal > 0)\
-							{\
-								N->timeAggregates[N->timeAggregatesLastKey] += (now - N->timeAggregatesLastTimestamp);\
-								N->timeAggregateTotal += (now - N->timeAggregatesLastTimestamp);\
-							}\
+							/*\
+							 *	timestampsInit() seeds timeAggregatesLastTimestamp,\
+							 *	so the first interval is charged to TimeStampInit.\
+							 */\
+							N->timeAggregates[N->timeAggregatesLastKey] += (now - N->timeAggregatesLastTimestamp);\
+							N->timeAggregateTotal += (now - N->timeAggregatesLastTimestamp);\
 							\
 							N->timeAggregatesLastKey = (routineKey);\
 							N->timeAggregatesLastTimestamp = now;\
-							N->timestampCount = (N->timestampCount + 1) % N->timestampSlots;\
+							N->timestampCount++;\
 							N->callAggregates[(routineKey)]++;\
 							N->callAggregateTotal++;\
 						}\
 
+#define TimeStampPhaseBeginMacro(phaseName)	if (N->mode & kCommonModeCallStatistics)\
+						{\
+							timeStampPhase(N, (phaseName), 'B');\
+						}\
+
+#define TimeStampPhaseEndMacro(phaseName)	if (N->mode & kCommonModeCallStatistics)\
+						{\
+							timeStampPhase(N, (phaseName), 'E');\
+						}\
+
 extern const char *	TimeStampKeyStrings[kCommonTimeStampKeyMax];
@@ -67,6 +67,8 @@
 #include "common-timeStamps.h"
 #include "common-data-structures.h"
 #include "common-errors.h"
+#include "common-stringIntern.h"
+#include "common-arena.h"
 
 /*
  *	NOTE: -Tpng:gd gets rid of the ugly edge borders which are there in
@@ -92,10 +94,15 @@ timestampsInit(State *  N)
 	}
 	N->timestampSlots = kCommonTimestampTimelineLength;
 
+	N->timestampPhases = (TimeStampPhase *) calloc(kCommonTimestampPhaseSlots, sizeof(TimeStampPhase));
+	if (N->timestampPhases == NULL)
+	{
+		fatal(NULL, Emalloc);
+	}
+	N->timestampPhaseCount = 0;
+
 	//TODO: replace this with a libflex call...
-#ifdef CommonOsMacOSX
-	N->initializationTimestamp = mach_absolute_time();
-#endif
+	N->initializationTimestamp = TimeMacro;
 
 
 	N->timeAggregates = (uint64_t *) calloc(kCommonTimeStampKeyMax, sizeof(uint64_t));
@@ -113,7 +120,7 @@ timestampsInit(State *  N)
 
 	N->timestampCount = 0;
 	N->callAggregateTotal = 0;
-	N->timeAggregatesLastTimestamp = TimeMacro;
+	N->timeAggregatesLastTimestamp = N->initializationTimestamp;
 	N->timeAggregatesLastKey = kCommonTimeStampKeyTimeStampInit;
 
 	return;
@@ -391,11 +398,18 @@ dealloc(State *  N)
 	if (N->mode & kCommonModeCallStatistics)
 	{
 		free(N->timestamps);
+		free(N->timestampPhases);
 		free(N->timeAggregates);
 		free(N->callAggregates);
 	}
 
-	//TODO: recursively free all the nodes
+	/*
+	 *	IR nodes, tokens, symbols and scopes all live in the arenas;
+	 *	only the array of pointers to the tokens is ours to free.
+	 */
+	free(N->tokens);
+	commonStringInternDealloc(N);
+	commonArenaDealloc(N);
 }
 
 
@@ -70,6 +70,8 @@
 #include "newton-parser.h"
 #include "newton-lexer.h"
 #include "common-symbolTable.h"
+#include "common-stringIntern.h"
+#include "common-arena.h"
 #include "newton.h"
 #include "newton-irPass-dotBackend.h"
 #include "newton-irPass-smtBackend.h"
@@ -98,7 +100,6 @@ static char *			newtonCodeBuffer = NULL;
 
 
 State *				newtonCgiState;
-State *				newtonCgiDimensionsState;
 
 enum
 {
@@ -373,7 +374,6 @@ main(void)
 
 
 	newtonCgiState = init(kCommonModeDefault|kCommonModeCallStatistics/* | kCommonModeCallTracing */|kCommonModeCGI);
-	newtonCgiDimensionsState = init(kCommonModeDefault|kCommonModeCallStatistics/* | kCommonModeCallTracing */|kCommonModeCGI);
 	timestampsInit(newtonCgiState);
 
 
@@ -640,12 +640,10 @@ main(void)
 	fflush(stdout);
 
 	jumpParameter = setjmp(newtonCgiState->jmpbuf);
-	memcpy(newtonCgiDimensionsState->jmpbuf, newtonCgiState->jmpbuf, sizeof(newtonCgiDimensionsState->jmpbuf));
 
 	if (!jumpParameter)
 	{
 		newtonCgiState->jmpbufIsValid = true;
-		newtonCgiDimensionsState->jmpbufIsValid = true;
 
 		/*
 		 *	Return from call to setjmp
@@ -679,13 +677,11 @@ main(void)
 		 *	Create a top-level scope, then parse.
 		 */
 		newtonCgiState->newtonIrTopScope = commonSymbolTableAllocScope(newtonCgiState);
-		
-
-		newtonLexInit(newtonCgiDimensionsState, inputFilePath);
-		newtonCgiDimensionsState->newtonIrTopScope = commonSymbolTableAllocScope(newtonCgiDimensionsState);
-		newtonDimensionPassParse(newtonCgiDimensionsState, newtonCgiDimensionsState->newtonIrTopScope);
 
-		newtonCgiState->newtonIrTopScope->firstDimension = newtonCgiDimensionsState->newtonIrTopScope->firstDimension;
+		/*
+		 *	The dimension pass reads the same tokens as the main parse.
+		 */
+		newtonDimensionPassParse(newtonCgiState, newtonCgiState->newtonIrTopScope);
 
 		if(newtonCgiState->newtonIrTopScope->firstDimension != NULL)
 		{
@@ -766,6 +762,10 @@ main(void)
 			flexprint(newtonCgiState->Fe, newtonCgiState->Fm, newtonCgiState->Fpinfo, "Intermediate Representation Information:\n\n");
 			flexprint(newtonCgiState->Fe, newtonCgiState->Fm, newtonCgiState->Fpinfo, "    IR node count                        : %llu\n", irNodeCount);
 			flexprint(newtonCgiState->Fe, newtonCgiState->Fm, newtonCgiState->Fpinfo, "    Symbol Table node count              : %llu\n", symbolTableNodeCount);
+			flexprint(newtonCgiState->Fe, newtonCgiState->Fm, newtonCgiState->Fpinfo, "\n");
+
+			commonStringInternDumpStatistics(newtonCgiState);
+			commonArenaDumpStatistics(newtonCgiState);
 
 			/*
 			 *	Libflex malloc statistics:
@@ -883,14 +883,6 @@ doTail(int fmtWidth, int cgiSparameter, int cgiOparameter, int cgiTparameter)
 		printf("<span style=\"background-color:whitesmoke; display:none;\" id='newtonerrs'>%s</span></pre></td></tr></table>", newtonCgiState->Fperr->circbuf);
 	}
 
-	if (strlen(newtonCgiDimensionsState->Fperr->circbuf) != 0)
-	{
-		printf("<div width=\"%d\" style=\"background-color:#FFDB58; padding:3px;\" onclick=\"JavaScript:toggle('newtonerrs')\">", fmtWidth);
-		printf("&nbsp;&nbsp;Error Report&nbsp;&nbsp;&nbsp;<b>(Click here to show/hide.)</b>&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;");
-		printf("&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;</div><table width=\"%d\" border=\"0\"><tr><td><pre>", fmtWidth);
-		printf("<span style=\"background-color:whitesmoke; display:none;\" id='newtonerrs'>%s</span></pre></td></tr></table>", newtonCgiDimensionsState->Fperr->circbuf);
-	}
-
 	if (strlen(newtonCgiState->Fpmathjax->circbuf) != 0)
 	{
 		printf("<div width=\"%d\" style=\"background-color:#EEEE11; padding:3px;\" onclick=\"JavaScript:toggle('newtonmathjax')\">", fmtWidth);
@@ -1022,17 +1014,13 @@ doTail(int fmtWidth, int cgiSparameter, int cgiOparameter, int cgiTparameter)
 	printf("            editor.setShowPrintMargin(false);\n");
 
 	/*
-	 *	Was disabled (see #132). We now try both the dimensions pass's state as well as the main parser to find the line number.
+	 *	Was disabled (see #132). The dimension pass and the main parser share one
+	 *	token stream, so its current token is where either of them stopped.
 	 */
 	if (strlen(newtonCgiState->Fperr->circbuf) != 0)
 	{
 		printf("            editor.gotoLine(%"PRIu64", %"PRIu64", true);\n", lexPeek(newtonCgiState, 1)->sourceInfo->lineNumber, lexPeek(newtonCgiState, 1)->sourceInfo->columnNumber-1);
 	}
-	
-	if (strlen(newtonCgiDimensionsState->Fperr->circbuf) != 0)
-	{
-		printf("            editor.gotoLine(%"PRIu64", %"PRIu64", true);\n", lexPeek(newtonCgiDimensionsState, 1)->sourceInfo->lineNumber, lexPeek(newtonCgiDimensionsState, 1)->sourceInfo->columnNumber-1);
-	}
 
 	/*
 	 *	Have ACE autosize the height, with an upper limit at maxLines
@@ -110,6 +110,9 @@ main(int argc, char *argv[])
 			{"llvm-ir",		required_argument,	0,	'I'},
 			{"llvm-ir-liveness-check",	no_argument,	0,	'L'},
 			{"llvm-ir-auto-quantization",	no_argument,	0,	'Q'},
+			{"llvm-ir-range-jobs",	required_argument,	0,	552},
+			{"llvm-ir-range-cache",	required_argument,	0,	553},
+			{"llvm-ir-specialization-budget",	required_argument,	0,	554},
 			{"estimator-synthesis",	required_argument,	0,	420},
 			{"process",		required_argument,	0,	421},
 			{"measurement",		required_argument,	0,	422},
@@ -122,6 +125,7 @@ main(int argc, char *argv[])
 			{"generate-header",	required_argument,	0,	493},
 			{"signal-typedef-to",	required_argument,	0,	496},
 			{"no-sensors",		required_argument,	0,	550},
+			{"trace-json",		required_argument,	0,	551},
 			{0,			0,			0,	0}
 		};
 
@@ -427,11 +431,24 @@ main(int argc, char *argv[])
 			case 'Q':
 			{
 				N->irPasses |= kNewtonirPassLLVMIRAutoQuantization;
+				break;
+			}
 
-				flexprint(N->Fe, N->Fm, N->Fperr, "AutoQuantization pass was disabled at compilation.\n");
-				consolePrintBuffers(N);
-				exit(EXIT_FAILURE);
+			case 552:
+			{
+				N->rangeAnalysisJobs = atoi(optarg);
+				break;
+			}
 
+			case 553:
+			{
+				N->rangeAnalysisCache = optarg;
+				break;
+			}
+
+			case 554:
+			{
+				N->specializationBudget = atoi(optarg);
 				break;
 			}
 
@@ -491,6 +508,16 @@ main(int argc, char *argv[])
 				break;
 			}
 
+			case 551:
+			{
+				/*
+				 *	The trace is built from the statistics timeline.
+				 */
+				N->mode |= kCommonModeCallStatistics;
+				N->outputTraceJsonFilePath = optarg;
+				break;
+			}
+
 			case '?':
 			{
 				/*
@@ -583,6 +610,11 @@ usage(State *  N)
 						"                | (--generate-header=<path to output file>					  \n"
 						"                | (--signal-typedef-to=<data type string>					  \n"
 						"                | (--trace, -t)                                              \n"
+						"                | (--trace-json <path to output file>)                       \n"
+						"                | (--llvm-ir-auto-quantization)                              \n"
+						"                | (--llvm-ir-range-jobs <number of threads>)                 \n"
+						"                | (--llvm-ir-range-cache <path to summary file>)             \n"
+						"                | (--llvm-ir-specialization-budget <percent of module size>) \n"
 						"                | (--statistics, -s)                                         \n"
 						"                | (--latex, -x)                                              \n"
 						"                | (--estimator-synthesis=<path to output file>)              \n"
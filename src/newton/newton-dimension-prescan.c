@@ -57,6 +57,7 @@
 #include "common-data-structures.h"
 #include "common-irHelpers.h"
 #include "common-lexers-helpers.h"
+#include "common-symbolTable.h"
 #include "newton-lexer.h"
 #include "newton-symbolTable.h"
 #include "common-firstAndFollow.h"
@@ -74,7 +75,19 @@ newtonDimensionPassParse(State *  N, Scope *  currentScope)
 {
 	TimeStampTraceMacro(kNewtonTimeStampKeyDimensionPassParse);
 
-	newtonDimensionPassParseFile(N, currentScope);
+	/*
+	 *	The pass reads the token stream that the main parse will read,
+	 *	so we rewind it afterwards. Its symbols go into a scope of its
+	 *	own to keep them out of the main parse's way, and only the
+	 *	dimensions it finds are handed on to currentScope.
+	 */
+	uint64_t	firstToken	= N->tokenCursor;
+	Scope *		dimensionScope	= commonSymbolTableAllocScope(N);
+
+	newtonDimensionPassParseFile(N, dimensionScope);
+
+	currentScope->firstDimension	= dimensionScope->firstDimension;
+	N->tokenCursor			= firstToken;
 }
 
 /*
@@ -101,7 +114,7 @@ newtonDimensionPassParseFile(State *  N, Scope *  currentScope)
 	/*
 	 *	Skip eof token without using lexGet
 	 */
-	N->tokenList = N->tokenList->next;
+	N->tokenCursor++;
 }
 
 void
@@ -78,6 +78,7 @@ extern "C"
 #include "newton-irPass-autoDiff.h"
 #include "newton-irPass-estimatorSynthesisBackend.h"
 #include "newton-irPass-invariantSignalAnnotation.h"
+#include "newton-irPass-LLVMIR-module.h"
 
 class PhysicsInfo {
 private:
@@ -575,20 +576,7 @@ dimensionalityCheck(Function &  llvmIrFunction, State *  N)
 void
 irPassLLVMIRDimensionCheck(State *  N)
 {
-	if (N->llvmIR == nullptr)
-	{
-		flexprint(N->Fe, N->Fm, N->Fperr, "Please specify the LLVM IR input file\n");
-		fatal(N, Esanity);
-	}
-
-	SMDiagnostic 	Err;
-	LLVMContext 	Context;
-	std::unique_ptr<Module>	Mod(parseIRFile(N->llvmIR, Err, Context));
-	if (!Mod)
-	{
-		flexprint(N->Fe, N->Fm, N->Fperr, "Error: Couldn't parse IR file.");
-		fatal(N, Esanity);
-	}
+	Module *	Mod = irPassLLVMIRModule(N);
 
 	for (auto & mi : *Mod)
 	{
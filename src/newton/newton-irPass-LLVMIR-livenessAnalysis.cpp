@@ -35,14 +35,20 @@
 	POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include "newton-irPass-LLVMIR-livenessAnalysis.h"
+#include "newton-irPass-LLVMIR-module.h"
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <setjmp.h>
 #include <stdint.h>
-#include <set>
 #include <algorithm>
-#include <map>
+#include <deque>
+#include <vector>
 
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/IR/CFG.h"
 #include "llvm/IR/Metadata.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Instructions.h"
@@ -58,244 +64,358 @@ using namespace llvm;
 extern "C"
 {
 
-#include "flextypes.h"
-#include "flexerror.h"
-#include "flex.h"
-#include "common-errors.h"
-#include "version.h"
-#include "newton-timeStamps.h"
-#include "common-timeStamps.h"
-#include "common-data-structures.h"
-#include "noisy-parser.h"
-#include "newton-parser.h"
-#include "noisy-lexer.h"
-#include "newton-lexer.h"
-#include "common-irPass-helpers.h"
-#include "common-lexers-helpers.h"
-#include "common-irHelpers.h"
-#include "common-symbolTable.h"
-#include "newton-types.h"
-#include "newton-symbolTable.h"
-#include "newton-irPass-cBackend.h"
-#include "newton-irPass-autoDiff.h"
-#include "newton-irPass-estimatorSynthesisBackend.h"
-#include "newton-irPass-invariantSignalAnnotation.h"
-
-
-typedef struct LivenessState {
-	std::map<BasicBlock *, std::set<Value *>>	upwardExposedVariables;
-	std::map<BasicBlock *, std::set<Value *>>	killedVariables;
-	std::map<BasicBlock *, std::set<Value *>>	liveOutVariables;
-} LivenessState;
-
-void
-printBasicBlockSets(const std::map<BasicBlock *, std::set<Value *>>&  basicBlockSets)
+/*
+ * number the arguments and the instructions that produce a value, and the
+ * blocks, so that the sets are bit vectors indexed by these numbers.
+ * */
+static void
+numberValues(LivenessInfo *  livenessInfo, Function &  llvmIrFunction)
 {
-	for (auto const& basicBlockSet : basicBlockSets)
+	for (Argument &  llvmIrArgument : llvmIrFunction.args())
 	{
-		outs() << "Basic Block: \n";
-		outs() << *(basicBlockSet.first->getFirstNonPHI()) << "\n";
-		for (auto const& var : basicBlockSet.second)
+		livenessInfo->valueNumbers[&llvmIrArgument] = livenessInfo->values.size();
+		livenessInfo->values.push_back(&llvmIrArgument);
+	}
+
+	for (BasicBlock &  llvmIrBasicBlock : llvmIrFunction)
+	{
+		livenessInfo->blockNumbers[&llvmIrBasicBlock] = livenessInfo->blocks.size();
+		livenessInfo->blocks.push_back(&llvmIrBasicBlock);
+
+		for (Instruction &  llvmIrInstruction : llvmIrBasicBlock)
 		{
-			outs() << "		" << *var <<  "\n";
+			if (llvmIrInstruction.getType()->isVoidTy())
+			{
+				continue;
+			}
+			livenessInfo->valueNumbers[&llvmIrInstruction] = livenessInfo->values.size();
+			livenessInfo->values.push_back(&llvmIrInstruction);
 		}
-		outs() << "=================================\n";
 	}
 }
 
+static int
+valueNumber(const LivenessInfo *  livenessInfo, const Value *  value)
+{
+	auto	numberIt = livenessInfo->valueNumbers.find(value);
+	return numberIt == livenessInfo->valueNumbers.end() ? -1 : (int)numberIt->second;
+}
 
-void
-initBasicBlock(LivenessState *  livenessState, BasicBlock &  llvmIrBasicBlock)
+static int
+blockNumber(const LivenessInfo *  livenessInfo, const BasicBlock *  llvmIrBasicBlock)
 {
-	livenessState->upwardExposedVariables[&llvmIrBasicBlock].empty();
-	livenessState->killedVariables[&llvmIrBasicBlock].empty();
+	auto	numberIt = livenessInfo->blockNumbers.find(llvmIrBasicBlock);
+	return numberIt == livenessInfo->blockNumbers.end() ? -1 : (int)numberIt->second;
+}
+
+/*
+ * the local sets of a block: the values it uses before defining them, the
+ * values it defines, and the values its successors' phis take from it.
+ * */
+static void
+initBasicBlock(LivenessInfo *  livenessInfo, BasicBlock &  llvmIrBasicBlock)
+{
+	unsigned	blockIndex = livenessInfo->blockNumbers[&llvmIrBasicBlock];
+	BitVector &	upwardExposedVariables = livenessInfo->upwardExposedVariables[blockIndex];
+	BitVector &	killedVariables = livenessInfo->killedVariables[blockIndex];
+	BitVector &	phiUsedVariables = livenessInfo->phiUsedVariables[blockIndex];
 
 	for (Instruction &  llvmIrInstruction : llvmIrBasicBlock)
 	{
-		switch (llvmIrInstruction.getOpcode())
+		if (!isa<PHINode>(llvmIrInstruction))
 		{
-			case Instruction::Add:
-			case Instruction::FAdd:
-			case Instruction::Sub:
-			case Instruction::FSub:
-			case Instruction::Mul:
-			case Instruction::FMul:
-			case Instruction::SDiv:
-			case Instruction::FDiv:
-			case Instruction::UDiv:
-			case Instruction::URem:
-			case Instruction::SRem:
-			case Instruction::FRem:
-			case Instruction::And:
-			case Instruction::Or:
-			case Instruction::Xor:
-			case Instruction::ICmp:
-			case Instruction::FCmp:
+			for (Value *  operand : llvmIrInstruction.operands())
 			{
-				auto leftOperand = llvmIrInstruction.getOperand(0);
-				auto rightOperand = llvmIrInstruction.getOperand(1);
-
-				if (livenessState->killedVariables[&llvmIrBasicBlock].count(leftOperand) == 0 && !isa<llvm::Constant>(leftOperand))
+				int	operandNumber = valueNumber(livenessInfo, operand);
+				if (operandNumber >= 0 && !killedVariables.test(operandNumber))
 				{
-					livenessState->upwardExposedVariables[&llvmIrBasicBlock].insert(leftOperand);
+					upwardExposedVariables.set(operandNumber);
 				}
+			}
+		}
 
-				if (livenessState->killedVariables[&llvmIrBasicBlock].count(rightOperand) == 0 && !isa<llvm::Constant>(rightOperand))
-				{
-					livenessState->upwardExposedVariables[&llvmIrBasicBlock].insert(rightOperand);
-				}
+		int	instructionNumber = valueNumber(livenessInfo, &llvmIrInstruction);
+		if (instructionNumber >= 0)
+		{
+			killedVariables.set(instructionNumber);
+		}
+	}
 
-				livenessState->killedVariables[&llvmIrBasicBlock].insert(&llvmIrInstruction);
-			}
-			case Instruction::SExt:
-			case Instruction::ZExt:
-			case Instruction::AShr:
-			case Instruction::LShr:
-			case Instruction::Shl:
-			case Instruction::Trunc:
-			case Instruction::SIToFP:
-			case Instruction::FNeg:
-			case Instruction::FPToUI:
-			case Instruction::FPToSI:
-			case Instruction::UIToFP:
-			case Instruction::FPTrunc:
-			case Instruction::FPExt:
-			case Instruction::PtrToInt:
-			case Instruction::IntToPtr:
-			case Instruction::BitCast:
-			case Instruction::AddrSpaceCast:
-			case Instruction::ExtractElement:
+	for (BasicBlock *  successorBasicBlock : successors(&llvmIrBasicBlock))
+	{
+		for (PHINode &  phiNode : successorBasicBlock->phis())
+		{
+			int	incomingNumber = valueNumber(livenessInfo, phiNode.getIncomingValueForBlock(&llvmIrBasicBlock));
+			if (incomingNumber >= 0)
 			{
-				auto operand = llvmIrInstruction.getOperand(0);
+				phiUsedVariables.set(incomingNumber);
+			}
+		}
+	}
+}
 
-				if (livenessState->killedVariables[&llvmIrBasicBlock].count(operand) == 0 && !isa<llvm::Constant>(operand))
-				{
-					livenessState->upwardExposedVariables[&llvmIrBasicBlock].insert(operand);
-				}
+/*
+ * liveOut(B) = phiUsed(B) | union over successors S of liveIn(S), and
+ * liveIn(B) = upwardExposed(B) | (liveOut(B) & ~killed(B)). The worklist starts
+ * in post order, so that most blocks see their successors' sets before their
+ * own, and a block goes back on it only when the live-in set of one of its
+ * successors grew.
+ * */
+LivenessInfo *
+computeLiveness(Function &  llvmIrFunction)
+{
+	auto	livenessInfo = new LivenessInfo();
 
-				livenessState->killedVariables[&llvmIrBasicBlock].insert(&llvmIrInstruction);
-			}
-			case Instruction::Call:
-			{
-				if (auto llvmIrCallInstruction = dyn_cast<CallInst>(&llvmIrInstruction)) {
-					Function *calledFunction = llvmIrCallInstruction->getCalledFunction();
-                    if (calledFunction == nullptr || !calledFunction->hasName() || calledFunction->getName().empty())
-                        continue;
-					if (calledFunction->getName().startswith("llvm.dbg.declare")) {
-						continue;
-					}
-					for (auto &argumentIterator: llvmIrCallInstruction->args()) {
-						if (livenessState->killedVariables[&llvmIrBasicBlock].count(argumentIterator) == 0 &&
-							!isa<llvm::Constant>(*argumentIterator)) {
-							livenessState->upwardExposedVariables[&llvmIrBasicBlock].insert(argumentIterator);
-						}
+	livenessInfo->function = &llvmIrFunction;
+	numberValues(livenessInfo, llvmIrFunction);
 
-						livenessState->killedVariables[&llvmIrBasicBlock].insert(llvmIrCallInstruction);
-					}
-				}
+	size_t	valueCount = livenessInfo->values.size();
+	size_t	blockCount = livenessInfo->blocks.size();
+	livenessInfo->upwardExposedVariables.assign(blockCount, BitVector(valueCount));
+	livenessInfo->killedVariables.assign(blockCount, BitVector(valueCount));
+	livenessInfo->phiUsedVariables.assign(blockCount, BitVector(valueCount));
+	livenessInfo->liveInVariables.assign(blockCount, BitVector(valueCount));
+	livenessInfo->liveOutVariables.assign(blockCount, BitVector(valueCount));
+
+	for (BasicBlock &  llvmIrBasicBlock : llvmIrFunction)
+	{
+		initBasicBlock(livenessInfo, llvmIrBasicBlock);
+	}
+
+	std::deque<unsigned>	worklist;
+	BitVector		onWorklist(blockCount);
+
+	if (!llvmIrFunction.isDeclaration())
+	{
+		for (BasicBlock *  llvmIrBasicBlock : post_order(&llvmIrFunction.getEntryBlock()))
+		{
+			unsigned	blockIndex = livenessInfo->blockNumbers[llvmIrBasicBlock];
+			worklist.push_back(blockIndex);
+			onWorklist.set(blockIndex);
+		}
+	}
+	for (unsigned blockIndex = 0; blockIndex < blockCount; blockIndex++)
+	{
+		if (!onWorklist.test(blockIndex))
+		{
+			worklist.push_back(blockIndex);
+			onWorklist.set(blockIndex);
+		}
+	}
+
+	BitVector	liveInVariables(valueCount);
+	while (!worklist.empty())
+	{
+		unsigned	blockIndex = worklist.front();
+		worklist.pop_front();
+		onWorklist.reset(blockIndex);
+
+		BasicBlock *	llvmIrBasicBlock = livenessInfo->blocks[blockIndex];
+		BitVector &	liveOutVariables = livenessInfo->liveOutVariables[blockIndex];
+
+		liveOutVariables = livenessInfo->phiUsedVariables[blockIndex];
+		for (BasicBlock *  successorBasicBlock : successors(llvmIrBasicBlock))
+		{
+			liveOutVariables |= livenessInfo->liveInVariables[livenessInfo->blockNumbers[successorBasicBlock]];
+		}
+
+		liveInVariables = liveOutVariables;
+		liveInVariables.reset(livenessInfo->killedVariables[blockIndex]);
+		liveInVariables |= livenessInfo->upwardExposedVariables[blockIndex];
+
+		if (liveInVariables == livenessInfo->liveInVariables[blockIndex])
+		{
+			continue;
+		}
+		livenessInfo->liveInVariables[blockIndex] = liveInVariables;
+
+		for (BasicBlock *  predecessorBasicBlock : predecessors(llvmIrBasicBlock))
+		{
+			unsigned	predecessorIndex = livenessInfo->blockNumbers[predecessorBasicBlock];
+			if (!onWorklist.test(predecessorIndex))
+			{
+				worklist.push_back(predecessorIndex);
+				onWorklist.set(predecessorIndex);
 			}
 		}
 	}
 
-	livenessState->liveOutVariables[&llvmIrBasicBlock].empty();
+	return livenessInfo;
 }
 
-std::set<Value *>
-computeLiveOurVariables(LivenessState *  livenessState, BasicBlock &  llvmIrBasicBlock)
+bool
+isLiveIn(const LivenessInfo *  livenessInfo, const BasicBlock *  llvmIrBasicBlock, const Value *  value)
 {
-	std::set<Value *>	computedLiveOutVariables;
+	int	blockIndex = blockNumber(livenessInfo, llvmIrBasicBlock);
+	int	valueIndex = valueNumber(livenessInfo, value);
+	return blockIndex >= 0 && valueIndex >= 0 && livenessInfo->liveInVariables[blockIndex].test(valueIndex);
+}
 
-	auto 	terminatorInstruction = llvmIrBasicBlock.getTerminator();
-	auto	successorNumber = terminatorInstruction->getNumSuccessors();
+bool
+isLiveOut(const LivenessInfo *  livenessInfo, const BasicBlock *  llvmIrBasicBlock, const Value *  value)
+{
+	int	blockIndex = blockNumber(livenessInfo, llvmIrBasicBlock);
+	int	valueIndex = valueNumber(livenessInfo, value);
+	return blockIndex >= 0 && valueIndex >= 0 && livenessInfo->liveOutVariables[blockIndex].test(valueIndex);
+}
 
-	for (unsigned int i = 0; i < successorNumber; i++)
+static std::vector<Value *>
+valuesOf(const LivenessInfo *  livenessInfo, const BitVector &  variables)
+{
+	std::vector<Value *>	values;
+	for (unsigned valueIndex : variables.set_bits())
 	{
-		BasicBlock *	successorBasicBlock = terminatorInstruction->getSuccessor(i);
+		values.push_back(livenessInfo->values[valueIndex]);
+	}
+	return values;
+}
+
+std::vector<Value *>
+liveInValues(const LivenessInfo *  livenessInfo, const BasicBlock *  llvmIrBasicBlock)
+{
+	int	blockIndex = blockNumber(livenessInfo, llvmIrBasicBlock);
+	return blockIndex < 0 ? std::vector<Value *>() : valuesOf(livenessInfo, livenessInfo->liveInVariables[blockIndex]);
+}
 
-		std::set<Value *>	successorUpwardExposedVariables = livenessState->upwardExposedVariables[successorBasicBlock];
-		std::set<Value *>	successorKilledVariables = livenessState->killedVariables[successorBasicBlock];
-		std::set<Value *>	successorLiveOutVariables = livenessState->liveOutVariables[successorBasicBlock];
+std::vector<Value *>
+liveOutValues(const LivenessInfo *  livenessInfo, const BasicBlock *  llvmIrBasicBlock)
+{
+	int	blockIndex = blockNumber(livenessInfo, llvmIrBasicBlock);
+	return blockIndex < 0 ? std::vector<Value *>() : valuesOf(livenessInfo, livenessInfo->liveOutVariables[blockIndex]);
+}
+
+/*
+ * one segment for each block the value is defined in or live into. A value
+ * that is not live out of a block ends at its last use there, other than
+ * by a phi, or at its definition when nothing in the block uses it.
+ * */
+std::vector<LiveSegment>
+liveRange(const LivenessInfo *  livenessInfo, const Value *  value)
+{
+	std::vector<LiveSegment>	segments;
 
-		std::set<Value *>	successorContributionToLiveOutVariables;
-		std::set<Value *>	liveOutVariablesSetDifferenceKilledVariables;
+	int	valueIndex = valueNumber(livenessInfo, value);
+	if (valueIndex < 0)
+	{
+		return segments;
+	}
 
-		std::set_difference(successorLiveOutVariables.begin(), successorLiveOutVariables.end(),
-							successorKilledVariables.begin(), successorKilledVariables.end(),
-							std::inserter(liveOutVariablesSetDifferenceKilledVariables,
-										  liveOutVariablesSetDifferenceKilledVariables.end()));
+	auto	definition = dyn_cast<Instruction>(value);
+	for (unsigned blockIndex = 0; blockIndex < livenessInfo->blocks.size(); blockIndex++)
+	{
+		BasicBlock *	llvmIrBasicBlock = livenessInfo->blocks[blockIndex];
+		bool		isDefinedHere = definition != nullptr && definition->getParent() == llvmIrBasicBlock;
 
-		std::set_union(successorUpwardExposedVariables.begin(), successorUpwardExposedVariables.end(),
-					   liveOutVariablesSetDifferenceKilledVariables.begin(), liveOutVariablesSetDifferenceKilledVariables.end(),
-					   std::inserter(successorContributionToLiveOutVariables,
-									 successorContributionToLiveOutVariables.end()));
+		if (!isDefinedHere && !livenessInfo->liveInVariables[blockIndex].test(valueIndex))
+		{
+			continue;
+		}
 
-		std::set_union(computedLiveOutVariables.begin(), computedLiveOutVariables.end(),
-					   successorContributionToLiveOutVariables.begin(), successorContributionToLiveOutVariables.end(),
-					   std::inserter(computedLiveOutVariables,
-									 computedLiveOutVariables.end()));
+		LiveSegment	segment = {llvmIrBasicBlock, isDefinedHere ? const_cast<Instruction *>(definition) : nullptr, nullptr};
+		if (!livenessInfo->liveOutVariables[blockIndex].test(valueIndex))
+		{
+			segment.end = segment.start;
+			for (Instruction &  llvmIrInstruction : *llvmIrBasicBlock)
+			{
+				if (isa<PHINode>(llvmIrInstruction))
+				{
+					continue;
+				}
+				for (Value *  operand : llvmIrInstruction.operands())
+				{
+					if (operand == value)
+					{
+						segment.end = &llvmIrInstruction;
+					}
+				}
+			}
+		}
+		segments.push_back(segment);
 	}
 
-	return computedLiveOutVariables;
+	return segments;
 }
 
-void
-livenessAnalysis(State *  N, LivenessState *  livenessState, Function &  llvmIrFunction)
+/*
+ * the most values live at once in a block, walking back from its live-out
+ * set: a rough register pressure for the passes that choose value types.
+ * */
+unsigned
+maxLiveValues(const LivenessInfo *  livenessInfo, const BasicBlock *  llvmIrBasicBlock)
 {
-	for (BasicBlock &  llvmIrBasicBlock : llvmIrFunction)
+	int	blockIndex = blockNumber(livenessInfo, llvmIrBasicBlock);
+	if (blockIndex < 0)
 	{
-		initBasicBlock(livenessState, llvmIrBasicBlock);
+		return 0;
 	}
 
-	auto	changed = true;
-	while (changed)
+	BitVector	liveVariables = livenessInfo->liveOutVariables[blockIndex];
+	unsigned	maxLive = liveVariables.count();
+
+	for (auto instructionIt = llvmIrBasicBlock->rbegin(); instructionIt != llvmIrBasicBlock->rend(); instructionIt++)
 	{
-		changed = false;
-		for (BasicBlock &  llvmIrBasicBlock : llvmIrFunction)
+		if (isa<PHINode>(*instructionIt))
 		{
-			auto 	computedLiveOutVariables = computeLiveOurVariables(livenessState, llvmIrBasicBlock);
+			break;
+		}
 
-			if (computedLiveOutVariables != livenessState->liveOutVariables[&llvmIrBasicBlock])
+		int	instructionNumber = valueNumber(livenessInfo, &*instructionIt);
+		if (instructionNumber >= 0)
+		{
+			liveVariables.reset(instructionNumber);
+		}
+		for (const Value *  operand : instructionIt->operands())
+		{
+			int	operandNumber = valueNumber(livenessInfo, operand);
+			if (operandNumber >= 0)
 			{
-				changed = true;
-				livenessState->liveOutVariables[&llvmIrBasicBlock] = computedLiveOutVariables;
+				liveVariables.set(operandNumber);
 			}
 		}
+		maxLive = std::max(maxLive, (unsigned)liveVariables.count());
 	}
+
+	return std::max(maxLive, (unsigned)livenessInfo->liveInVariables[blockIndex].count());
 }
 
 void
-irPassLLVMIRLivenessAnalysis(State *  N)
+printLiveness(const LivenessInfo *  livenessInfo)
 {
-	if (N->llvmIR == nullptr)
-	{
-		flexprint(N->Fe, N->Fm, N->Fperr, "Please specify the LLVM IR input file\n");
-		fatal(N, Esanity);
-	}
-
-	SMDiagnostic 	Err;
-	LLVMContext 	Context;
-	std::unique_ptr<Module>	Mod(parseIRFile(N->llvmIR, Err, Context));
-	if (!Mod)
+	outs() << "Function: " << livenessInfo->function->getName() << "\n";
+	for (BasicBlock *  llvmIrBasicBlock : livenessInfo->blocks)
 	{
-		flexprint(N->Fe, N->Fm, N->Fperr, "Error: Couldn't parse IR file.");
-		fatal(N, Esanity);
+		outs() << "Basic Block: \n";
+		outs() << *(llvmIrBasicBlock->getFirstNonPHI()) << "\n";
+		outs() << "	live in:\n";
+		for (Value *  var : liveInValues(livenessInfo, llvmIrBasicBlock))
+		{
+			outs() << "		" << *var <<  "\n";
+		}
+		outs() << "	live out:\n";
+		for (Value *  var : liveOutValues(livenessInfo, llvmIrBasicBlock))
+		{
+			outs() << "		" << *var <<  "\n";
+		}
+		outs() << "=================================\n";
 	}
+}
 
-	auto	livenessState = new LivenessState();
+void
+irPassLLVMIRLivenessAnalysis(State *  N)
+{
+	Module *	Mod = irPassLLVMIRModule(N);
 
 	for (auto & mi : *Mod)
 	{
-		livenessAnalysis(N, livenessState, mi);
-	}
+		if (mi.isDeclaration())
+		{
+			continue;
+		}
 
-//    outs() << "kill: killedVariables\n";
-//    printBasicBlockSets(livenessState->killedVariables);
-//
-//    outs() << "gen: liveOutVariables\n";
-//	printBasicBlockSets(livenessState->liveOutVariables);
-//
-//    outs() << "update: upwardExposedVariables\n";
-//    printBasicBlockSets(livenessState->upwardExposedVariables);
+		auto	livenessInfo = computeLiveness(mi);
+//		printLiveness(livenessInfo);
+		delete livenessInfo;
+	}
 }
 
 }
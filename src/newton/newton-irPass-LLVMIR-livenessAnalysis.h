@@ -1,11 +1,73 @@
+#ifndef NEWTON_IR_PASS_LLVM_IR_LIVENESS_ANALYSIS
+#define NEWTON_IR_PASS_LLVM_IR_LIVENESS_ANALYSIS
+
+#ifdef __cplusplus
+#include "llvm/ADT/BitVector.h"
+#include "newton-irPass-LLVMIR-rangeAnalysis.h"
+#endif /* __cplusplus */
 
 #ifdef __cplusplus
 extern "C"
 {
-#	endif /* __cplusplus */
+#endif /* __cplusplus */
+
+#ifdef __cplusplus
+/*
+ * the liveness of one function. The arguments and the instructions that
+ * produce a value are numbered in order, and each block keeps one bit per
+ * value number in its sets. A phi is a use at the end of its incoming block,
+ * so its operands are in the live-out set of that block and not in the
+ * live-in set of the phi's block.
+ * */
+typedef struct LivenessInfo {
+	llvm::Function *				function = nullptr;
+	std::vector<llvm::Value *>			values;
+	llvm::DenseMap<const llvm::Value *, unsigned>	valueNumbers;
+	std::vector<llvm::BasicBlock *>			blocks;
+	llvm::DenseMap<const llvm::BasicBlock *, unsigned> blockNumbers;
+	std::vector<llvm::BitVector>			upwardExposedVariables;
+	std::vector<llvm::BitVector>			killedVariables;
+	std::vector<llvm::BitVector>			phiUsedVariables;
+	std::vector<llvm::BitVector>			liveInVariables;
+	std::vector<llvm::BitVector>			liveOutVariables;
+} LivenessInfo;
+
+/*
+ * the part of a block where a value is live: from start, or the entry of the
+ * block when start is null, to end, or the exit of the block when end is null.
+ * */
+typedef struct LiveSegment {
+	llvm::BasicBlock *	block;
+	llvm::Instruction *	start;
+	llvm::Instruction *	end;
+} LiveSegment;
+
+LivenessInfo *
+computeLiveness(llvm::Function & llvmIrFunction);
+
+bool
+isLiveIn(const LivenessInfo * livenessInfo, const llvm::BasicBlock * llvmIrBasicBlock, const llvm::Value * value);
+
+bool
+isLiveOut(const LivenessInfo * livenessInfo, const llvm::BasicBlock * llvmIrBasicBlock, const llvm::Value * value);
+
+std::vector<llvm::Value *>
+liveInValues(const LivenessInfo * livenessInfo, const llvm::BasicBlock * llvmIrBasicBlock);
+
+std::vector<llvm::Value *>
+liveOutValues(const LivenessInfo * livenessInfo, const llvm::BasicBlock * llvmIrBasicBlock);
+
+std::vector<LiveSegment>
+liveRange(const LivenessInfo * livenessInfo, const llvm::Value * value);
+
+unsigned
+maxLiveValues(const LivenessInfo * livenessInfo, const llvm::BasicBlock * llvmIrBasicBlock);
+#endif /* __cplusplus */
 
 void    irPassLLVMIRLivenessAnalysis(State *  N);
 
-#	ifdef __cplusplus
+#ifdef __cplusplus
 } /* extern "C" */
-#	endif /* __cplusplus */
+#endif /* __cplusplus */
+
+#endif /* NEWTON_IR_PASS_LLVM_IR_LIVENESS_ANALYSIS */
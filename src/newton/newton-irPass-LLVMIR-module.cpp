@@ -0,0 +1,120 @@
+/*
+	Authored 2026. Phillip Stanley-Marbell.
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions
+	are met:
+
+	*	Redistributions of source code must retain the above
+		copyright notice, this list of conditions and the following
+		disclaimer.
+
+	*	Redistributions in binary form must reproduce the above
+		copyright notice, this list of conditions and the following
+		disclaimer in the documentation and/or other materials
+		provided with the distribution.
+
+	*	Neither the name of the author nor the names of its
+		contributors may be used to endorse or promote products
+		derived from this software without specific prior written
+		permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include <stdint.h>
+
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+extern "C"
+{
+
+#include "flextypes.h"
+#include "flexerror.h"
+#include "flex.h"
+#include "common-errors.h"
+#include "version.h"
+#include "newton-timeStamps.h"
+#include "common-timeStamps.h"
+#include "common-data-structures.h"
+#include "newton-irPass-LLVMIR-module.h"
+
+/*
+ *	The module named by N->llvmIR, parsed on first use and then shared
+ *	by all the LLVM IR passes, which run one after another on it. Bitcode
+ *	(.bc) goes through the lazy bitcode reader and textual IR (.ll) through
+ *	the IR parser; getLazyIRFileModule picks the reader from the file magic.
+ */
+Module *
+irPassLLVMIRModule(State * N)
+{
+	if (N->llvmModule != NULL)
+	{
+		return static_cast<Module *>(N->llvmModule);
+	}
+
+	if (N->llvmIR == nullptr)
+	{
+		flexprint(N->Fe, N->Fm, N->Fperr, "Please specify the LLVM IR input file\n");
+		fatal(N, Esanity);
+	}
+
+	LLVMContext *		context = new LLVMContext();
+	SMDiagnostic		Err;
+	std::unique_ptr<Module>	Mod = getLazyIRFileModule(N->llvmIR, Err, *context);
+	if (!Mod)
+	{
+		flexprint(N->Fe, N->Fm, N->Fperr, "Error: Couldn't parse IR file.");
+		fatal(N, Esanity);
+	}
+
+	/*
+	 *	The passes walk every function body, so read them all in now
+	 *	rather than have each pass materialize them on demand.
+	 */
+	if (Error materializeError = Mod->materializeAll())
+	{
+		flexprint(N->Fe, N->Fm, N->Fperr, "Error: Couldn't read IR file: %s\n",
+			  toString(std::move(materializeError)).c_str());
+		fatal(N, Esanity);
+	}
+
+	N->llvmContext = context;
+	N->llvmModule = Mod.release();
+
+	return static_cast<Module *>(N->llvmModule);
+}
+
+void
+irPassLLVMIRModuleRelease(State * N)
+{
+	delete static_cast<Module *>(N->llvmModule);
+	delete static_cast<LLVMContext *>(N->llvmContext);
+	N->llvmModule = NULL;
+	N->llvmContext = NULL;
+}
+
+}
@@ -37,10 +37,14 @@
 
 #ifdef __cplusplus
 #include "newton-irPass-LLVMIR-rangeAnalysis.h"
+#include "newton-irPass-LLVMIR-rangeSummaries.h"
 #include "newton-irPass-LLVMIR-simplifyControlFlowByRange.h"
+#include "newton-irPass-LLVMIR-specializeByRange.h"
 #include "newton-irPass-LLVMIR-constantSubstitution.h"
 #include "newton-irPass-LLVMIR-shrinkTypeByRange.h"
 #include "newton-irPass-LLVMIR-quantization.h"
+#include "newton-irPass-LLVMIR-module.h"
+#include "newton-irPass-LLVMIR-optimizeByRange.h"
 #endif /* __cplusplus */
 
 #include <algorithm>
@@ -50,8 +54,14 @@
 #include <setjmp.h>
 #include <stdint.h>
 #include <string.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <set>
+#include <thread>
 
+#include "llvm/ADT/SCCIterator.h"
+#include "llvm/Analysis/CallGraph.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/DebugInfoMetadata.h"
 #include "llvm/IR/Metadata.h"
@@ -69,7 +79,7 @@ using namespace llvm;
 extern "C"{
 
 void
-dumpIR(State * N, std::string fileSuffix, std::unique_ptr<Module> Mod)
+dumpIR(State * N, std::string fileSuffix, Module * Mod)
 {
 	StringRef   filePath(N->llvmIR);
 	std::string dirPath	= std::string(sys::path::parent_path(filePath)) + "/";
@@ -92,24 +102,6 @@ mergeBoundInfo(BoundInfo * dst, const BoundInfo * src)
 	return;
 }
 
-void
-collectCalleeBoundInfo(std::map<std::string, BoundInfo *> & funcBoundInfo, const BoundInfo * boundInfo)
-{
-	for (auto & calleeInfo : boundInfo->calleeBound)
-	{
-		funcBoundInfo.emplace(calleeInfo.first, calleeInfo.second);
-		collectCalleeBoundInfo(funcBoundInfo, calleeInfo.second);
-	}
-	return;
-}
-
-void
-collectCallerMap(std::map<std::string, CallInst *> & callerMap, const BoundInfo * boundInfo)
-{
-	callerMap.insert(boundInfo->callerMap.begin(), boundInfo->callerMap.end());
-	return;
-}
-
 class FunctionNode {
 	mutable AssertingVH<Function>	 F;
 	FunctionComparator::FunctionHash Hash;
@@ -150,13 +142,17 @@ class FunctionNodeCmp {
 using hashFuncSet = std::set<FunctionNode, FunctionNodeCmp>;
 
 void
-overloadFunc(std::unique_ptr<Module> & Mod, std::map<std::string, CallInst *> callerMap)
+overloadFunc(Module * Mod)
 {
 	/*
-	 * compare the functions and remove the redundant one
+	 * compare the functions and merge each specialization that came out the same
+	 * as a function after it into that one. The comparisons look into the calls,
+	 * so the functions are only replaced once all of them are compared. The comparison
+	 * leaves out the argument ranges of the specializations, so those of the function
+	 * kept are widened to cover the ones merged into it.
 	 * */
-	hashFuncSet baseFuncs;
-	auto	    baseFuncNum = baseFuncs.size();
+	hashFuncSet					 baseFuncs;
+	std::vector<std::pair<Function *, Function *>> sameImplFuncs;
 	for (auto itFunc = Mod->getFunctionList().rbegin(); itFunc != Mod->getFunctionList().rend(); itFunc++)
 	{
 		if (!itFunc->hasName() || itFunc->getName().empty())
@@ -166,80 +162,27 @@ overloadFunc(std::unique_ptr<Module> & Mod, std::map<std::string, CallInst *> ca
 			continue;
 		if (itFunc->isDeclaration())
 			continue;
-		baseFuncs.emplace(FunctionNode(&(*itFunc)));
-		/*
-		 * find the function with the same implementation and change the callInst
-		 * */
-		if (baseFuncNum == baseFuncs.size())
+		auto baseFuncIt = baseFuncs.emplace(FunctionNode(&(*itFunc)));
+		if (!baseFuncIt.second && itFunc->hasLocalLinkage() && itFunc->hasGlobalUnnamedAddr())
 		{
-			auto callerIt = callerMap.find(itFunc->getName().str());
-			assert(callerIt != callerMap.end());
-			auto		  currentCallerInst = callerIt->second;
-			auto		  currentFuncNode   = FunctionNode(&(*itFunc));
-			GlobalNumberState cmpGlobalNumbers;
-			auto		  sameImplIt = std::find_if(baseFuncs.begin(), baseFuncs.end(),
-								    [currentFuncNode, &cmpGlobalNumbers](const FunctionNode & func) {
-								    FunctionComparator FCmp(func.getFunc(), currentFuncNode.getFunc(), &cmpGlobalNumbers);
-								    return func.getHash() == currentFuncNode.getHash() && FCmp.compare() == 0;
-							    });
-			assert(sameImplIt != baseFuncs.end());
-			currentCallerInst->setCalledFunction(sameImplIt->getFunc());
+			sameImplFuncs.emplace_back(&(*itFunc), baseFuncIt.first->getFunc());
 		}
-		else
-			baseFuncNum = baseFuncs.size();
 	}
 
-	std::set<std::string> baseFuncNames;
-	for (auto f : baseFuncs)
+	for (auto & sameImplFunc : sameImplFuncs)
 	{
-		baseFuncNames.emplace(f.getFunc()->getName().str());
-	}
-
-	/*
-	 * iterate functions in Mod, if it cannot be found in baseFuncs, delete it.
-	 * */
-	for (auto itFunc = Mod->getFunctionList().begin(); itFunc != Mod->getFunctionList().end(); itFunc++)
-	{
-		if (!itFunc->hasName() || itFunc->getName().empty())
-			continue;
-		if (itFunc->getName().startswith("llvm.dbg.value") ||
-		    itFunc->getName().startswith("llvm.dbg.declare"))
-			continue;
-		if (itFunc->isDeclaration())
-			continue;
-		if (baseFuncNames.find(itFunc->getName().str()) == baseFuncNames.end() && itFunc->hasLocalLinkage())
-		{
-			Mod->getFunctionList().remove(itFunc);
-			itFunc--;
-		}
+		mergeSpecializationRanges(sameImplFunc.second, sameImplFunc.first);
+		sameImplFunc.first->replaceAllUsesWith(sameImplFunc.second);
+		sameImplFunc.first->eraseFromParent();
 	}
 }
 
 void
-irPassLLVMIROptimizeByRange(State * N)
+collectSensorTypeRange(State * N, std::map<std::string, std::pair<double, double>> & typeRange)
 {
-	if (N->llvmIR == nullptr)
-	{
-		flexprint(N->Fe, N->Fm, N->Fperr, "Please specify the LLVM IR input file\n");
-		fatal(N, Esanity);
-	}
-
-	SMDiagnostic		Err;
-	LLVMContext		Context;
-	std::unique_ptr<Module> Mod(parseIRFile(N->llvmIR, Err, Context));
-	if (!Mod)
-	{
-		flexprint(N->Fe, N->Fm, N->Fperr, "Error: Couldn't parse IR file.");
-		fatal(N, Esanity);
-	}
-
-	auto				   globalBoundInfo = new BoundInfo();
-	std::map<std::string, BoundInfo *> funcBoundInfo;
-
 	/*
 	 * get sensor info, we only concern the id and range here
 	 * */
-	std::map<std::string, std::pair<double, double>> typeRange;
 	if (N->sensorList != NULL)
 	{
 		for (Modality * currentModality = N->sensorList->modalityList; currentModality != NULL; currentModality = currentModality->next)
@@ -250,11 +193,15 @@ irPassLLVMIROptimizeByRange(State * N)
 			typeRange.emplace(currentModality->identifier, std::make_pair(currentModality->rangeLowerBound, currentModality->rangeUpperBound));
 		}
 	}
+}
 
+void
+collectGlobalBoundInfo(State * N, Module * Mod, BoundInfo * globalBoundInfo,
+		       std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange)
+{
 	/*
 	 * get const global variables
 	 * */
-	std::map<llvm::Value *, std::vector<std::pair<double, double>>> virtualRegisterVectorRange;
 	for (auto & globalVar : Mod->getGlobalList())
 	{
 		if (!globalVar.hasInitializer())
@@ -324,123 +271,308 @@ irPassLLVMIROptimizeByRange(State * N)
 	}
 
 	/*
-	 * analyze the range of all local variables in each function
+	 * the argument ranges of the functions specialized by range
 	 * */
-	flexprint(N->Fe, N->Fm, N->Fpinfo, "infer bound\n");
-	std::map<std::string, CallInst *> callerMap;
-	const bool			  useOverLoad = true;
+	collectSpecializationBoundInfo(Mod, globalBoundInfo);
+}
+
+/*
+ * the analysis of inferModuleBound from summaries, spread over N->rangeAnalysisJobs
+ * threads, which only read the IR. The SCCs of the call graph are handed out in post-order,
+ * each once the SCCs of its callees are done, so that the callees are summarized before their callers.
+ * With N->rangeAnalysisCache, the summaries of unchanged functions come from
+ * earlier runs and those computed here are added to it.
+ * Each function reports into private buffers, which are appended to those of N
+ * in the order of the module, as the serial analysis would print them.
+ * */
+void
+inferModuleBoundFromSummaries(State * N, Module * Mod, const std::map<std::string, std::pair<double, double>> & typeRange,
+			 const std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange,
+			 const BoundInfo * globalBoundInfo, std::map<std::string, BoundInfo *> & funcBoundInfo)
+{
+	std::vector<Function *>	     moduleFunctions;
+	std::map<Function *, size_t> moduleIndex;
 	for (auto & mi : *Mod)
 	{
-		auto boundInfo = new BoundInfo();
-		mergeBoundInfo(boundInfo, globalBoundInfo);
-		rangeAnalysis(N, typeRange, virtualRegisterVectorRange, boundInfo, mi, useOverLoad);
-		funcBoundInfo.emplace(mi.getName(), boundInfo);
-		collectCalleeBoundInfo(funcBoundInfo, boundInfo);
-		collectCallerMap(callerMap, boundInfo);
+		moduleIndex.emplace(&mi, moduleFunctions.size());
+		moduleFunctions.emplace_back(&mi);
 	}
 
 	/*
-	 * simplify the condition of each branch
+	 * the SCCs in post-order, with the SCCs that call each of them and
+	 * the count of the SCCs each one still waits for
 	 * */
-	flexprint(N->Fe, N->Fm, N->Fpinfo, "simplify control flow by range\n");
-	for (auto & mi : *Mod)
+	CallGraph			 callGraph(*Mod);
+	std::map<Function *, size_t>	 functionScc;
+	std::vector<std::vector<size_t>> sccFunctions;
+	std::vector<std::vector<size_t>> sccCallers;
+	std::vector<size_t>		 sccPendingCallees;
+	for (auto sccIt = scc_begin(&callGraph); !sccIt.isAtEnd(); ++sccIt)
 	{
-		auto boundInfoIt = funcBoundInfo.find(mi.getName().str());
-		if (boundInfoIt != funcBoundInfo.end())
+		std::vector<size_t> functions;
+		for (CallGraphNode * callGraphNode : *sccIt)
 		{
-			simplifyControlFlow(N, boundInfoIt->second, mi);
+			if (callGraphNode->getFunction() != nullptr)
+			{
+				functionScc.emplace(callGraphNode->getFunction(), sccFunctions.size());
+				functions.emplace_back(moduleIndex[callGraphNode->getFunction()]);
+			}
 		}
-		else
+		if (functions.empty())
 		{
-			assert(false);
+			continue;
 		}
-	}
 
-	legacy::PassManager passManager;
-	passManager.add(createCFGSimplificationPass());
-	passManager.add(createInstSimplifyLegacyPass());
-	passManager.run(*Mod);
-
-	if (useOverLoad)
-		overloadFunc(Mod, callerMap);
+		size_t		 scc = sccFunctions.size();
+		std::set<size_t> calleeSccs;
+		for (CallGraphNode * callGraphNode : *sccIt)
+		{
+			for (auto & callRecord : *callGraphNode)
+			{
+				auto calleeIt = functionScc.find(callRecord.second->getFunction());
+				if (calleeIt != functionScc.end() && calleeIt->second != scc)
+				{
+					calleeSccs.insert(calleeIt->second);
+				}
+			}
+		}
+		sccFunctions.emplace_back(functions);
+		sccCallers.emplace_back();
+		sccPendingCallees.emplace_back(calleeSccs.size());
+		for (auto calleeScc : calleeSccs)
+		{
+			sccCallers[calleeScc].emplace_back(scc);
+		}
+	}
 
-	flexprint(N->Fe, N->Fm, N->Fpinfo, "infer bound\n");
-	callerMap.clear();
-	funcBoundInfo.clear();
-	for (auto & mi : *Mod)
+	CalleeSummaries					 calleeSummaries;
+	std::vector<BoundInfo *>			 functionBoundInfo(moduleFunctions.size());
+	std::vector<std::pair<std::string, std::string>> functionReport(moduleFunctions.size());
+	std::mutex					 schedulerLock;
+	std::condition_variable				 sccReady;
+	std::deque<size_t>				 readySccs;
+	size_t						 remainingSccs = sccFunctions.size();
+	for (size_t scc = 0; scc < sccFunctions.size(); scc++)
 	{
-		auto boundInfo = new BoundInfo();
-		mergeBoundInfo(boundInfo, globalBoundInfo);
-		rangeAnalysis(N, typeRange, virtualRegisterVectorRange, boundInfo, mi, useOverLoad);
-		funcBoundInfo.emplace(mi.getName(), boundInfo);
-		collectCalleeBoundInfo(funcBoundInfo, boundInfo);
-		collectCallerMap(callerMap, boundInfo);
+		if (sccPendingCallees[scc] == 0)
+		{
+			readySccs.emplace_back(scc);
+		}
 	}
-
-	flexprint(N->Fe, N->Fm, N->Fpinfo, "constant substitution\n");
-	for (auto & mi : *Mod)
+	if (N->rangeAnalysisCache != NULL)
 	{
-		auto boundInfoIt = funcBoundInfo.find(mi.getName().str());
-		if (boundInfoIt != funcBoundInfo.end())
+		rangeSummaryKeyFunctions(Mod, rangeSummaryConfigurationKey(typeRange, virtualRegisterVectorRange, globalBoundInfo),
+					 &calleeSummaries);
+		rangeSummaryRestore(N, Mod, &calleeSummaries);
+	}
+
+	auto analyzeFunctions = [&]() {
+		State taskState = *N;
+		taskState.Fe	= (FlexErrState *)calloc(1, sizeof(FlexErrState));
+		taskState.Fm	= (FlexMstate *)calloc(1, sizeof(FlexMstate));
+		if (taskState.Fe == NULL || taskState.Fm == NULL)
 		{
-			constantSubstitution(N, boundInfoIt->second, mi);
+			fatal(NULL, Emalloc);
 		}
-		else
+		while (true)
 		{
-			assert(false);
+			size_t scc;
+			{
+				std::unique_lock<std::mutex> guard(schedulerLock);
+				sccReady.wait(guard, [&]() { return !readySccs.empty() || remainingSccs == 0; });
+				if (readySccs.empty())
+				{
+					break;
+				}
+				scc = readySccs.front();
+				readySccs.pop_front();
+			}
+
+			for (size_t idx : sccFunctions[scc])
+			{
+				auto summaryKey = std::make_pair(moduleFunctions[idx], kRangeSummaryTopLevelKey);
+				{
+					std::lock_guard<std::mutex> guard(calleeSummaries.lock);
+					auto			    summaryIt = calleeSummaries.summaries.find(summaryKey);
+					if (summaryIt != calleeSummaries.summaries.end())
+					{
+						functionBoundInfo[idx] = summaryIt->second.boundInfo;
+						functionReport[idx]    = std::make_pair(summaryIt->second.info, summaryIt->second.errors);
+						continue;
+					}
+				}
+
+				taskState.Fpinfo = rangeAnalysisPrintBuffer();
+				taskState.Fperr	 = rangeAnalysisPrintBuffer();
+				auto boundInfo	 = new BoundInfo();
+				mergeBoundInfo(boundInfo, globalBoundInfo);
+				boundInfo->calleeSummaries = &calleeSummaries;
+				auto returnRange	   = rangeAnalysis(&taskState, typeRange, virtualRegisterVectorRange, boundInfo, *moduleFunctions[idx]);
+				functionBoundInfo[idx]	   = boundInfo;
+				functionReport[idx]	   = std::make_pair(std::string(taskState.Fpinfo->circbuf), std::string(taskState.Fperr->circbuf));
+				rangeAnalysisFreePrintBuffer(taskState.Fpinfo);
+				rangeAnalysisFreePrintBuffer(taskState.Fperr);
+
+				std::lock_guard<std::mutex> guard(calleeSummaries.lock);
+				calleeSummaries.summaries.emplace(summaryKey, CalleeSummary{boundInfo, returnRange, functionReport[idx].first,
+											     functionReport[idx].second});
+			}
+
+			{
+				std::lock_guard<std::mutex> guard(schedulerLock);
+				remainingSccs--;
+				for (auto callerScc : sccCallers[scc])
+				{
+					if (--sccPendingCallees[callerScc] == 0)
+					{
+						readySccs.emplace_back(callerScc);
+					}
+				}
+			}
+			sccReady.notify_all();
 		}
+		free(taskState.Fe);
+		free(taskState.Fm);
+	};
+
+	std::vector<std::thread> workers;
+	size_t			 workerCount = std::min(static_cast<size_t>(std::max(N->rangeAnalysisJobs, 1)), sccFunctions.size());
+	for (size_t idx = 0; idx < workerCount; idx++)
+	{
+		workers.emplace_back(analyzeFunctions);
+	}
+	for (auto & worker : workers)
+	{
+		worker.join();
 	}
 
-	//	flexprint(N->Fe, N->Fm, N->Fpinfo, "shrink data type by range\n");
-	//    for (auto & mi : *Mod)
-	//    {
-	//        auto boundInfoIt = funcBoundInfo.find(mi.getName().str());
-	//        if (boundInfoIt != funcBoundInfo.end()) {
-	//            shrinkType(N, boundInfoIt->second, mi);
-	//        } else {
-	//            assert(false);
-	//        }
-	//    }
+	for (size_t idx = 0; idx < moduleFunctions.size(); idx++)
+	{
+		rangeAnalysisReplayReport(N, N->Fpinfo, functionReport[idx].first.c_str());
+		rangeAnalysisReplayReport(N, N->Fperr, functionReport[idx].second.c_str());
+		funcBoundInfo.emplace(moduleFunctions[idx]->getName(), functionBoundInfo[idx]);
+	}
 
-	if (useOverLoad)
-		overloadFunc(Mod, callerMap);
+	if (N->rangeAnalysisCache != NULL)
+	{
+		rangeSummaryPersist(N, &calleeSummaries);
+	}
+}
 
+/*
+ * analyze the range of all local variables in each function, with each callee
+ * analyzed at its call sites for the argument ranges there
+ * */
+void
+inferModuleBound(State * N, Module * Mod, const std::map<std::string, std::pair<double, double>> & typeRange,
+		 const std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange,
+		 const BoundInfo * globalBoundInfo, std::map<std::string, BoundInfo *> & funcBoundInfo)
+{
 	flexprint(N->Fe, N->Fm, N->Fpinfo, "infer bound\n");
-	callerMap.clear();
 	funcBoundInfo.clear();
+	if (N->rangeAnalysisJobs > 1 || N->rangeAnalysisCache != NULL)
+	{
+		inferModuleBoundFromSummaries(N, Mod, typeRange, virtualRegisterVectorRange, globalBoundInfo, funcBoundInfo);
+		return;
+	}
 	for (auto & mi : *Mod)
 	{
 		auto boundInfo = new BoundInfo();
 		mergeBoundInfo(boundInfo, globalBoundInfo);
-		rangeAnalysis(N, typeRange, virtualRegisterVectorRange, boundInfo, mi, useOverLoad);
+		rangeAnalysis(N, typeRange, virtualRegisterVectorRange, boundInfo, mi);
 		funcBoundInfo.emplace(mi.getName(), boundInfo);
-		collectCalleeBoundInfo(funcBoundInfo, boundInfo);
-		collectCallerMap(callerMap, boundInfo);
 	}
+}
+
+/*
+ * infer the bounds afresh and hand each function with its bounds to rangePass,
+ * without inferring anything when there is no rangePass
+ * */
+void
+applyRangePass(State * N, Module * Mod, const std::map<std::string, std::pair<double, double>> & typeRange,
+	       const std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange,
+	       const BoundInfo * globalBoundInfo, RangePass rangePass)
+{
+	if (!rangePass)
+	{
+		return;
+	}
+
+	std::map<std::string, BoundInfo *> funcBoundInfo;
+	TimeStampPhaseBeginMacro("range analysis");
+	inferModuleBound(N, Mod, typeRange, virtualRegisterVectorRange, globalBoundInfo, funcBoundInfo);
+	TimeStampPhaseEndMacro("range analysis");
 
-	/*
-	 *
-	 * */
-	flexprint(N->Fe, N->Fm, N->Fpinfo, "auto quantize data by precision\n");
 	for (auto & mi : *Mod)
 	{
 		auto boundInfoIt = funcBoundInfo.find(mi.getName().str());
 		if (boundInfoIt != funcBoundInfo.end())
 		{
-			irPassLLVMIRAutoQuantization(N, boundInfoIt->second, mi);
+			rangePass(N, boundInfoIt->second, mi);
 		}
 		else
 		{
 			assert(false);
 		}
 	}
+}
+
+void
+irPassLLVMIROptimizeByRange(State * N)
+{
+	Module * Mod = irPassLLVMIRModule(N);
+
+	auto						    globalBoundInfo = new BoundInfo();
+	std::map<std::string, std::pair<double, double>>	    typeRange;
+	std::map<llvm::Value *, std::vector<std::pair<double, double>>> virtualRegisterVectorRange;
+
+	collectSensorTypeRange(N, typeRange);
+	collectGlobalBoundInfo(N, Mod, globalBoundInfo, virtualRegisterVectorRange);
+
+	/*
+	 * clone the callees for the argument ranges of their call sites, where the
+	 * estimated gain is worth the code and within N->specializationBudget
+	 * */
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "specialize functions by range\n");
+	specializeFunctionsByRange(N, Mod, typeRange, virtualRegisterVectorRange, globalBoundInfo);
+
+	/*
+	 * simplify the condition of each branch
+	 * */
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "simplify control flow by range\n");
+	applyRangePass(N, Mod, typeRange, virtualRegisterVectorRange, globalBoundInfo, simplifyControlFlow);
+
+	legacy::PassManager passManager;
+	passManager.add(createCFGSimplificationPass());
+	passManager.add(createInstSimplifyLegacyPass());
+	passManager.run(*Mod);
+
+	overloadFunc(Mod);
 
-	if (useOverLoad)
-		overloadFunc(Mod, callerMap);
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "constant substitution\n");
+	applyRangePass(N, Mod, typeRange, virtualRegisterVectorRange, globalBoundInfo, constantSubstitution);
+
+	overloadFunc(Mod);
+
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "shrink data type by range\n");
+	applyRangePass(N, Mod, typeRange, virtualRegisterVectorRange, globalBoundInfo, shrinkType);
+
+	overloadFunc(Mod);
+
+	/*
+	 * convert the floating-point code to fixed point, with --llvm-ir-auto-quantization
+	 * */
+	if (N->irPasses & kNewtonirPassLLVMIRAutoQuantization)
+	{
+		flexprint(N->Fe, N->Fm, N->Fpinfo, "auto quantize data by precision\n");
+		applyRangePass(N, Mod, typeRange, virtualRegisterVectorRange, globalBoundInfo, irPassLLVMIRAutoQuantization);
+
+		overloadFunc(Mod);
+	}
 
 	/*
 	 * Dump BC file to a file.
 	 * */
-	dumpIR(N, "output", std::move(Mod));
+	dumpIR(N, "output", Mod);
 }
 }
@@ -38,11 +38,40 @@
 #ifndef NEWTON_IR_PASS_LLVM_IR_OPTIMIZE_BY_RANGE
 #define NEWTON_IR_PASS_LLVM_IR_OPTIMIZE_BY_RANGE
 
+#ifdef __cplusplus
+#include <functional>
+#include "newton-irPass-LLVMIR-rangeAnalysis.h"
+#endif /* __cplusplus */
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif /* __cplusplus */
 
+#ifdef __cplusplus
+typedef std::function<void(State *, BoundInfo *, llvm::Function &)> RangePass;
+
+void
+collectSensorTypeRange(State * N, std::map<std::string, std::pair<double, double>> & typeRange);
+
+void
+collectGlobalBoundInfo(State * N, llvm::Module * Mod, BoundInfo * globalBoundInfo,
+		       std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange);
+
+void
+inferModuleBound(State * N, llvm::Module * Mod, const std::map<std::string, std::pair<double, double>> & typeRange,
+		 const std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange,
+		 const BoundInfo * globalBoundInfo, std::map<std::string, BoundInfo *> & funcBoundInfo);
+
+void
+applyRangePass(State * N, llvm::Module * Mod, const std::map<std::string, std::pair<double, double>> & typeRange,
+	       const std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange,
+	       const BoundInfo * globalBoundInfo, RangePass rangePass);
+
+void
+overloadFunc(llvm::Module * Mod);
+#endif /* __cplusplus */
+
 void
 irPassLLVMIROptimizeByRange(State * N);
 
@@ -0,0 +1,398 @@
+/*
+	Authored 2026. Phillip Stanley-Marbell.
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions
+	are met:
+
+	*	Redistributions of source code must retain the above
+		copyright notice, this list of conditions and the following
+		disclaimer.
+
+	*	Redistributions in binary form must reproduce the above
+		copyright notice, this list of conditions and the following
+		disclaimer in the documentation and/or other materials
+		provided with the distribution.
+
+	*	Neither the name of the author nor the names of its
+		contributors may be used to endorse or promote products
+		derived from this software without specific prior written
+		permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ *	The Newton range-based optimizations packaged as a new pass manager
+ *	plugin, so that they run inside opt or clang rather than only in the
+ *	newton binary:
+ *
+ *		opt -load-pass-plugin=./libNewtonPassPlugin-$(OSTYPE).so \
+ *			-passes='newton-optimize-by-range<sensors.nt>' in.ll -S -o out.ll
+ *
+ *		clang -O2 -fpass-plugin=./libNewtonPassPlugin-$(OSTYPE).so \
+ *			-Xclang -load -Xclang ./libNewtonPassPlugin-$(OSTYPE).so \
+ *			-mllvm -newton-description=sensors.nt in.c
+ *
+ *	The sensor ranges come from the Newton description given either as
+ *	the pass parameter or through -newton-description. Each description
+ *	is parsed once per process and its State kept for the later passes.
+ *	What the passes report goes to stderr once they are done, since opt
+ *	and clang may be writing the module to stdout.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <map>
+#include <string>
+
+#include "llvm/IR/PassManager.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Passes/PassPlugin.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Transforms/Scalar/SimplifyCFG.h"
+#include "llvm/Transforms/Scalar/InstSimplifyPass.h"
+
+#include "newton-irPass-LLVMIR-optimizeByRange.h"
+#include "newton-irPass-LLVMIR-simplifyControlFlowByRange.h"
+#include "newton-irPass-LLVMIR-specializeByRange.h"
+#include "newton-irPass-LLVMIR-constantSubstitution.h"
+#include "newton-irPass-LLVMIR-shrinkTypeByRange.h"
+#include "newton-irPass-LLVMIR-quantization.h"
+
+extern "C"
+{
+#include "newton.h"
+}
+
+using namespace llvm;
+
+static cl::opt<std::string>	newtonDescription("newton-description",
+						  cl::desc("Newton description supplying the sensor ranges for the Newton passes"),
+						  cl::value_desc("file.nt"), cl::init(""));
+static cl::opt<int>		newtonRangeJobs("newton-range-jobs",
+						cl::desc("Threads for the Newton range analysis (see --llvm-ir-range-jobs)"),
+						cl::init(0));
+static cl::opt<std::string>	newtonRangeCache("newton-range-cache",
+						 cl::desc("File keeping the Newton range summaries between runs (see --llvm-ir-range-cache)"),
+						 cl::value_desc("file"), cl::init(""));
+static cl::opt<int>		newtonSpecializationBudget("newton-specialization-budget",
+							   cl::desc("Growth of the module allowed to Newton function specialization, in percent "
+								    "(see --llvm-ir-specialization-budget)"),
+							   cl::init(0));
+
+static std::map<std::string, State *>	newtonStates;
+
+static State *
+newtonState(const std::string & descriptionPath)
+{
+	auto stateIt = newtonStates.find(descriptionPath);
+	if (stateIt != newtonStates.end())
+	{
+		return stateIt->second;
+	}
+
+	State *	N = init(kCommonModeDefault);
+	N->rangeAnalysisJobs = newtonRangeJobs;
+	N->specializationBudget = newtonSpecializationBudget;
+	if (!newtonRangeCache.empty())
+	{
+		N->rangeAnalysisCache = strdup(newtonRangeCache.c_str());
+	}
+	if (!descriptionPath.empty())
+	{
+		if (!setjmp(N->jmpbuf))
+		{
+			N->jmpbufIsValid = true;
+			processNewtonFile(N, strdup(descriptionPath.c_str()));
+		}
+		else
+		{
+			flexprint(N->Fe, N->Fm, N->Fperr, "Processing Newton file \"%s\" failed, running without sensor ranges\n", descriptionPath.c_str());
+		}
+		N->jmpbufIsValid = false;
+	}
+
+	newtonStates.emplace(descriptionPath, N);
+	return N;
+}
+
+/*
+ *	Print the report collected on N so far and start it afresh, so that
+ *	the next report does not repeat it.
+ */
+static void
+newtonPrintReport(State * N)
+{
+	if (strlen(N->Fpinfo->circbuf))
+	{
+		fprintf(stderr, "\nInformational Report:\n---------------------\n%s", N->Fpinfo->circbuf);
+	}
+	if (strlen(N->Fperr->circbuf))
+	{
+		fprintf(stderr, "\nError Report:\n-------------\n%s", N->Fperr->circbuf);
+	}
+
+	rangeAnalysisFreePrintBuffer(N->Fpinfo);
+	rangeAnalysisFreePrintBuffer(N->Fperr);
+	N->Fpinfo = rangeAnalysisPrintBuffer();
+	N->Fperr  = rangeAnalysisPrintBuffer();
+}
+
+/*
+ *	One range-driven transformation: infer the bounds of every function,
+ *	apply rangePass to each function, optionally tidy the CFG it left
+ *	behind, then merge the specializations that came out identical.
+ */
+class NewtonRangePass : public PassInfoMixin<NewtonRangePass> {
+	std::string	descriptionPath;
+	RangePass	rangePass;
+	bool		simplifyCFG;
+
+	public:
+	NewtonRangePass(std::string descriptionPath, RangePass rangePass, bool simplifyCFG = false)
+	    : descriptionPath(std::move(descriptionPath)), rangePass(std::move(rangePass)), simplifyCFG(simplifyCFG) {}
+
+	PreservedAnalyses
+	run(Module & Mod, ModuleAnalysisManager & MAM)
+	{
+		State *	N = newtonState(descriptionPath);
+
+		auto						    globalBoundInfo = new BoundInfo();
+		std::map<std::string, std::pair<double, double>>	    typeRange;
+		std::map<llvm::Value *, std::vector<std::pair<double, double>>> virtualRegisterVectorRange;
+
+		collectSensorTypeRange(N, typeRange);
+		collectGlobalBoundInfo(N, &Mod, globalBoundInfo, virtualRegisterVectorRange);
+		applyRangePass(N, &Mod, typeRange, virtualRegisterVectorRange, globalBoundInfo, rangePass);
+
+		if (simplifyCFG)
+		{
+			auto &			FAM = MAM.getResult<FunctionAnalysisManagerModuleProxy>(Mod).getManager();
+			FunctionPassManager	FPM;
+			FPM.addPass(SimplifyCFGPass());
+			FPM.addPass(InstSimplifyPass());
+			for (auto & mi : Mod)
+			{
+				if (mi.isDeclaration())
+				{
+					continue;
+				}
+				FAM.invalidate(mi, PreservedAnalyses::none());
+				FPM.run(mi, FAM);
+			}
+		}
+
+		overloadFunc(&Mod);
+
+		delete globalBoundInfo;
+
+		return PreservedAnalyses::none();
+	}
+
+	static bool
+	isRequired()
+	{
+		return true;
+	}
+};
+
+/*
+ *	Clone the callees for the argument ranges of their call sites, as
+ *	specializeFunctionsByRange does for the newton binary. The ranges of
+ *	the clones go with them as metadata, for the passes that follow.
+ */
+class NewtonSpecializationPass : public PassInfoMixin<NewtonSpecializationPass> {
+	std::string	descriptionPath;
+
+	public:
+	NewtonSpecializationPass(std::string descriptionPath)
+	    : descriptionPath(std::move(descriptionPath)) {}
+
+	PreservedAnalyses
+	run(Module & Mod, ModuleAnalysisManager &)
+	{
+		State *	N = newtonState(descriptionPath);
+
+		auto						    globalBoundInfo = new BoundInfo();
+		std::map<std::string, std::pair<double, double>>	    typeRange;
+		std::map<llvm::Value *, std::vector<std::pair<double, double>>> virtualRegisterVectorRange;
+
+		collectSensorTypeRange(N, typeRange);
+		collectGlobalBoundInfo(N, &Mod, globalBoundInfo, virtualRegisterVectorRange);
+		specializeFunctionsByRange(N, &Mod, typeRange, virtualRegisterVectorRange, globalBoundInfo);
+
+		delete globalBoundInfo;
+
+		return PreservedAnalyses::none();
+	}
+
+	static bool
+	isRequired()
+	{
+		return true;
+	}
+};
+
+/*
+ *	Merge the functions that came out identical, without a range analysis.
+ */
+class NewtonOverloadPass : public PassInfoMixin<NewtonOverloadPass> {
+	public:
+	PreservedAnalyses
+	run(Module & Mod, ModuleAnalysisManager &)
+	{
+		overloadFunc(&Mod);
+		return PreservedAnalyses::none();
+	}
+
+	static bool
+	isRequired()
+	{
+		return true;
+	}
+};
+
+/*
+ *	Print the report of the Newton passes before it, after the last of them.
+ */
+class NewtonReportPass : public PassInfoMixin<NewtonReportPass> {
+	std::string	descriptionPath;
+
+	public:
+	NewtonReportPass(std::string descriptionPath)
+	    : descriptionPath(std::move(descriptionPath)) {}
+
+	PreservedAnalyses
+	run(Module &, ModuleAnalysisManager &)
+	{
+		newtonPrintReport(newtonState(descriptionPath));
+		return PreservedAnalyses::all();
+	}
+
+	static bool
+	isRequired()
+	{
+		return true;
+	}
+};
+
+/*
+ *	Accept both "name" and "name<file.nt>"; the bare form falls back to
+ *	-newton-description.
+ */
+static bool
+parseNewtonPassName(StringRef name, StringRef passName, std::string & descriptionPath)
+{
+	if (name == passName)
+	{
+		descriptionPath = newtonDescription;
+		return true;
+	}
+
+	if (name.consume_front(passName) && name.consume_front("<") && name.consume_back(">"))
+	{
+		descriptionPath = name.str();
+		return true;
+	}
+
+	return false;
+}
+
+/*
+ *	The same sequence irPassLLVMIROptimizeByRange runs in the newton binary.
+ *	Auto quantization is left to newton-auto-quantization, as the binary
+ *	leaves it to --llvm-ir-auto-quantization.
+ */
+static void
+addNewtonOptimizeByRange(ModulePassManager & MPM, const std::string & descriptionPath)
+{
+	MPM.addPass(NewtonSpecializationPass(descriptionPath));
+	MPM.addPass(NewtonRangePass(descriptionPath, simplifyControlFlow, true));
+	MPM.addPass(NewtonRangePass(descriptionPath, constantSubstitution));
+	MPM.addPass(NewtonRangePass(descriptionPath, shrinkType));
+	MPM.addPass(NewtonReportPass(descriptionPath));
+}
+
+static bool
+newtonPipelineParsingCallback(StringRef name, ModulePassManager & MPM, ArrayRef<PassBuilder::PipelineElement>)
+{
+	std::string	descriptionPath;
+
+	if (parseNewtonPassName(name, "newton-optimize-by-range", descriptionPath))
+	{
+		addNewtonOptimizeByRange(MPM, descriptionPath);
+		return true;
+	}
+	if (parseNewtonPassName(name, "newton-overload-function", descriptionPath))
+	{
+		MPM.addPass(NewtonOverloadPass());
+		return true;
+	}
+
+	if (parseNewtonPassName(name, "newton-specialize-function", descriptionPath))
+	{
+		MPM.addPass(NewtonSpecializationPass(descriptionPath));
+	}
+	else if (parseNewtonPassName(name, "newton-simplify-control-flow", descriptionPath))
+	{
+		MPM.addPass(NewtonRangePass(descriptionPath, simplifyControlFlow, true));
+	}
+	else if (parseNewtonPassName(name, "newton-constant-substitution", descriptionPath))
+	{
+		MPM.addPass(NewtonRangePass(descriptionPath, constantSubstitution));
+	}
+	else if (parseNewtonPassName(name, "newton-shrink-type", descriptionPath))
+	{
+		MPM.addPass(NewtonRangePass(descriptionPath, shrinkType));
+	}
+	else if (parseNewtonPassName(name, "newton-auto-quantization", descriptionPath))
+	{
+		MPM.addPass(NewtonRangePass(descriptionPath, irPassLLVMIRAutoQuantization));
+	}
+	else
+	{
+		return false;
+	}
+
+	MPM.addPass(NewtonReportPass(descriptionPath));
+	return true;
+}
+
+extern "C" LLVM_ATTRIBUTE_WEAK PassPluginLibraryInfo
+llvmGetPassPluginInfo()
+{
+	return {
+		LLVM_PLUGIN_API_VERSION, "NewtonRangeOptimization", LLVM_VERSION_STRING,
+		[](PassBuilder & PB) {
+			PB.registerPipelineParsingCallback(newtonPipelineParsingCallback);
+
+			/*
+			 *	With -fpass-plugin clang builds its own pipeline, so hook
+			 *	in at the end of the optimizer whenever a description is given.
+			 */
+			PB.registerOptimizerLastEPCallback(
+				[](ModulePassManager & MPM, OptimizationLevel) {
+					if (!newtonDescription.empty())
+					{
+						addNewtonOptimizeByRange(MPM, newtonDescription);
+					}
+				});
+		}};
+}
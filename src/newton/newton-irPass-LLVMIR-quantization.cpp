@@ -31,106 +31,588 @@
 
 #include "newton-irPass-LLVMIR-quantization.h"
 
+#include <cmath>
+
+#include "llvm/ADT/EquivalenceClasses.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/IR/Dominators.h"
+
 using namespace llvm;
 
 extern "C"
 {
+/*
+ * Values are quantized to Q-formats in int32_t words: x with f fractional bits
+ * is held as x * 2^f, f being the most that its range leaves room for. Results
+ * are computed in int64_t, where the product of two words, the operands of a sum
+ * aligned to the format of the result and the dividend of a quotient fit.
+ * */
+const int	kQuantizationWordBits		 = 32;
+const int	kQuantizationDefaultFractionBits = 16;
+/*
+ * a divisor is quantized only if its smallest magnitude leaves this many bits
+ * in its word, so that the rounding of the operations before it cannot make it 0
+ * */
+const int	kQuantizationDivisorBits	 = 8;
+/*
+ * the soft-float operations a conversion into or out of fixed point (a multiply
+ * and a conversion) stands for, and the weight of each loop level over the code
+ * around it in the cost model
+ * */
+const double	kQuantizationConversionCost	 = 2.0;
+const double	kQuantizationLoopWeight		 = 8.0;
+
+typedef struct QuantizationState {
+	State *				N;
+	BoundInfo *			boundInfo;
+	Function *			llvmIrFunction;
+	int				requiredFractionBits;
+	/*
+	 * the fractional bits of each float value, or -1 for one without a Q-format
+	 * */
+	std::map<Value *, int>		fractionBits;
+	/*
+	 * the word of each float value the quantized code reads or defines
+	 * */
+	std::map<Value *, Value *>	fixedValues;
+} QuantizationState;
+
+/*
+ * the fractional bits the sensors need, to resolve the finest step,
+ * range / 2^precisionBits, of any of their modalities
+ * */
+int
+quantizationRequiredFractionBits(State * N)
+{
+	int requiredFractionBits = -1;
+	if (N->sensorList != NULL)
+	{
+		for (Modality * currentModality = N->sensorList->modalityList; currentModality != NULL; currentModality = currentModality->next)
+		{
+			double rangeWidth = currentModality->rangeUpperBound - currentModality->rangeLowerBound;
+			if (currentModality->precisionBits <= 0 || !(rangeWidth > 0) || !std::isfinite(rangeWidth))
+			{
+				continue;
+			}
+			int fractionBits     = static_cast<int>(std::ceil(currentModality->precisionBits - std::log2(rangeWidth)));
+			requiredFractionBits = std::max(requiredFractionBits, std::max(fractionBits, 0));
+		}
+	}
+	return requiredFractionBits < 0 ? kQuantizationDefaultFractionBits : requiredFractionBits;
+}
+
+bool
+quantizationIsFloatType(Type * valueType)
+{
+	return valueType->isFloatTy() || valueType->isDoubleTy();
+}
+
+/*
+ * the fractional bits of the Q-format of a float value: the most that keep the
+ * magnitude of its words below 2^31, if they are no fewer than the sensors need
+ * */
+int
+quantizationValueFractionBits(QuantizationState * Q, Value * value)
+{
+	auto fractionBitsIt = Q->fractionBits.find(value);
+	if (fractionBitsIt != Q->fractionBits.end())
+	{
+		return fractionBitsIt->second;
+	}
+
+	double lowerBound, upperBound;
+	bool   hasRange = false;
+	if (ConstantFP * constFp = dyn_cast<ConstantFP>(value))
+	{
+		lowerBound = constFp->getValueAPF().convertToDouble();
+		upperBound = lowerBound;
+		hasRange   = true;
+	}
+	else if (isa<Argument>(value) || (isa<Instruction>(value) && !cast<Instruction>(value)->isTerminator()))
+	{
+		auto vrRangeIt = Q->boundInfo->virtualRegisterRange.find(value);
+		if (vrRangeIt != Q->boundInfo->virtualRegisterRange.end())
+		{
+			lowerBound = vrRangeIt->second.first;
+			upperBound = vrRangeIt->second.second;
+			hasRange   = true;
+		}
+	}
+
+	int fractionBits = -1;
+	if (hasRange && quantizationIsFloatType(value->getType()))
+	{
+		double maxMagnitude = std::max(std::fabs(lowerBound), std::fabs(upperBound));
+		if (std::isfinite(maxMagnitude))
+		{
+			int exponent;
+			std::frexp(maxMagnitude, &exponent);
+			fractionBits = std::min(kQuantizationWordBits - 1 - exponent, kQuantizationWordBits - 1);
+			if (fractionBits < Q->requiredFractionBits)
+			{
+				fractionBits = -1;
+			}
+		}
+	}
+	Q->fractionBits.emplace(value, fractionBits);
+	return fractionBits;
+}
+
+/*
+ * whether the divisor's words stay clear of 0 by kQuantizationDivisorBits
+ * */
+bool
+quantizationIsSafeDivisor(QuantizationState * Q, Value * divisor)
+{
+	double lowerBound, upperBound;
+	if (ConstantFP * constFp = dyn_cast<ConstantFP>(divisor))
+	{
+		lowerBound = constFp->getValueAPF().convertToDouble();
+		upperBound = lowerBound;
+	}
+	else
+	{
+		auto vrRangeIt = Q->boundInfo->virtualRegisterRange.find(divisor);
+		if (vrRangeIt == Q->boundInfo->virtualRegisterRange.end())
+		{
+			return false;
+		}
+		lowerBound = vrRangeIt->second.first;
+		upperBound = vrRangeIt->second.second;
+	}
+	if (!(lowerBound > 0) && !(upperBound < 0))
+	{
+		return false;
+	}
+	double minMagnitude = std::min(std::fabs(lowerBound), std::fabs(upperBound));
+	return std::ldexp(minMagnitude, quantizationValueFractionBits(Q, divisor)) >= std::ldexp(1.0, kQuantizationDivisorBits);
+}
+
+/*
+ * whether an instruction has a fixed point equivalent for the ranges of its
+ * float result and operands
+ * */
+bool
+quantizationIsCandidate(QuantizationState * Q, Instruction * llvmIrInstruction)
+{
+	switch (llvmIrInstruction->getOpcode())
+	{
+		case Instruction::FAdd:
+		case Instruction::FSub:
+		case Instruction::FMul:
+		case Instruction::FDiv:
+		case Instruction::FNeg:
+		case Instruction::FPExt:
+		case Instruction::FPTrunc:
+		case Instruction::PHI:
+		case Instruction::Select:
+		case Instruction::SIToFP:
+			if (quantizationValueFractionBits(Q, llvmIrInstruction) < 0)
+			{
+				return false;
+			}
+			break;
+		case Instruction::FCmp:
+		case Instruction::FPToSI:
+			break;
+		default:
+			return false;
+	}
+
+	if (llvmIrInstruction->getOpcode() == Instruction::SIToFP || llvmIrInstruction->getOpcode() == Instruction::FPToSI)
+	{
+		Type * integerType = llvmIrInstruction->getOpcode() == Instruction::SIToFP ? llvmIrInstruction->getOperand(0)->getType()
+											 : llvmIrInstruction->getType();
+		if (!integerType->isIntegerTy() || integerType->getIntegerBitWidth() > 64)
+		{
+			return false;
+		}
+	}
+	if (llvmIrInstruction->getOpcode() == Instruction::FDiv && !quantizationIsSafeDivisor(Q, llvmIrInstruction->getOperand(1)))
+	{
+		return false;
+	}
+	for (Value * operand : llvmIrInstruction->operands())
+	{
+		if (quantizationIsFloatType(operand->getType()) && quantizationValueFractionBits(Q, operand) < 0)
+		{
+			return false;
+		}
+		if (!quantizationIsFloatType(operand->getType()) && llvmIrInstruction->getOpcode() != Instruction::Select &&
+		    llvmIrInstruction->getOpcode() != Instruction::SIToFP)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+ * a word or an int64_t with fromBits fractional bits as an int64_t with toBits
+ * */
+Value *
+quantizationAlign(IRBuilder<> & Builder, Value * fixedValue, int fromBits, int toBits)
+{
+	Value * wideValue = Builder.CreateSExt(fixedValue, Builder.getInt64Ty());
+	if (toBits > fromBits)
+	{
+		return Builder.CreateShl(wideValue, toBits - fromBits);
+	}
+	if (toBits < fromBits)
+	{
+		return Builder.CreateAShr(wideValue, fromBits - toBits);
+	}
+	return wideValue;
+}
+
+/*
+ * the word of a float operand of the quantized code. One defined outside of it
+ * is converted once, where it is defined.
+ * */
+Value *
+quantizationFixedOperand(QuantizationState * Q, Value * value)
+{
+	auto fixedValueIt = Q->fixedValues.find(value);
+	if (fixedValueIt != Q->fixedValues.end())
+	{
+		return fixedValueIt->second;
+	}
+
+	int	     fractionBits = quantizationValueFractionBits(Q, value);
+	IntegerType * wordType	   = Type::getInt32Ty(value->getContext());
+	Value *	     fixedValue;
+	if (ConstantFP * constFp = dyn_cast<ConstantFP>(value))
+	{
+		double scaledValue = std::nearbyint(std::ldexp(constFp->getValueAPF().convertToDouble(), fractionBits));
+		scaledValue	   = std::max(std::min(scaledValue, static_cast<double>(INT32_MAX)), static_cast<double>(INT32_MIN));
+		fixedValue	   = ConstantInt::get(wordType, static_cast<int64_t>(scaledValue), true);
+	}
+	else
+	{
+		Instruction * insertPoint;
+		if (isa<Argument>(value))
+		{
+			insertPoint = &*Q->llvmIrFunction->getEntryBlock().getFirstInsertionPt();
+		}
+		else if (isa<PHINode>(value))
+		{
+			insertPoint = &*cast<Instruction>(value)->getParent()->getFirstInsertionPt();
+		}
+		else
+		{
+			insertPoint = cast<Instruction>(value)->getNextNode();
+		}
+		IRBuilder<> Builder(insertPoint);
+		Value *	    scaledValue = Builder.CreateFMul(value, ConstantFP::get(value->getType(), std::ldexp(1.0, fractionBits)));
+		fixedValue		= Builder.CreateFPToSI(scaledValue, wordType);
+	}
+	Q->fixedValues.emplace(value, fixedValue);
+	return fixedValue;
+}
+
+Value *
+quantizationAlignedOperand(QuantizationState * Q, IRBuilder<> & Builder, Value * operand, int toBits)
+{
+	return quantizationAlign(Builder, quantizationFixedOperand(Q, operand), quantizationValueFractionBits(Q, operand), toBits);
+}
+
+/*
+ * the fixed point equivalent of llvmIrInstruction, inserted before it. That of a
+ * float instruction is its word, those of FCmp and FPToSI replace them directly.
+ * */
+Value *
+quantizeInstruction(QuantizationState * Q, Instruction * llvmIrInstruction)
+{
+	IRBuilder<>   Builder(llvmIrInstruction);
+	IntegerType * wordType	  = Builder.getInt32Ty();
+	unsigned      opcode	  = llvmIrInstruction->getOpcode();
+	int	      resultBits = quantizationIsFloatType(llvmIrInstruction->getType()) ? quantizationValueFractionBits(Q, llvmIrInstruction) : 0;
+
+	switch (opcode)
+	{
+		case Instruction::FAdd:
+		case Instruction::FSub:
+		{
+			Value * lhs = quantizationAlignedOperand(Q, Builder, llvmIrInstruction->getOperand(0), resultBits);
+			Value * rhs = quantizationAlignedOperand(Q, Builder, llvmIrInstruction->getOperand(1), resultBits);
+			return Builder.CreateTrunc(opcode == Instruction::FAdd ? Builder.CreateAdd(lhs, rhs) : Builder.CreateSub(lhs, rhs), wordType);
+		}
+		case Instruction::FMul:
+		{
+			Value * lhs	   = llvmIrInstruction->getOperand(0);
+			Value * rhs	   = llvmIrInstruction->getOperand(1);
+			Value * product = Builder.CreateMul(Builder.CreateSExt(quantizationFixedOperand(Q, lhs), Builder.getInt64Ty()),
+							    Builder.CreateSExt(quantizationFixedOperand(Q, rhs), Builder.getInt64Ty()));
+			return Builder.CreateTrunc(quantizationAlign(Builder, product,
+								     quantizationValueFractionBits(Q, lhs) + quantizationValueFractionBits(Q, rhs),
+								     resultBits),
+						   wordType);
+		}
+		case Instruction::FDiv:
+		{
+			/*
+			 * the quotient of a dividend with resultBits + divisorBits fractional bits
+			 * has resultBits
+			 * */
+			Value * rhs	    = llvmIrInstruction->getOperand(1);
+			Value * dividend = quantizationAlignedOperand(Q, Builder, llvmIrInstruction->getOperand(0),
+								       resultBits + quantizationValueFractionBits(Q, rhs));
+			Value * divisor  = Builder.CreateSExt(quantizationFixedOperand(Q, rhs), Builder.getInt64Ty());
+			return Builder.CreateTrunc(Builder.CreateSDiv(dividend, divisor), wordType);
+		}
+		case Instruction::FNeg:
+			return Builder.CreateTrunc(Builder.CreateNeg(quantizationAlignedOperand(Q, Builder, llvmIrInstruction->getOperand(0), resultBits)),
+						   wordType);
+		case Instruction::FPExt:
+		case Instruction::FPTrunc:
+			return Builder.CreateTrunc(quantizationAlignedOperand(Q, Builder, llvmIrInstruction->getOperand(0), resultBits), wordType);
+		case Instruction::SIToFP:
+			return Builder.CreateTrunc(quantizationAlign(Builder, llvmIrInstruction->getOperand(0), 0, resultBits), wordType);
+		case Instruction::FPToSI:
+		{
+			/*
+			 * sdiv by 2^f rounds toward zero, as fptosi does
+			 * */
+			Value * operand	 = llvmIrInstruction->getOperand(0);
+			int	operandBits = quantizationValueFractionBits(Q, operand);
+			Value * wideValue	 = Builder.CreateSExt(quantizationFixedOperand(Q, operand), Builder.getInt64Ty());
+			if (operandBits > 0)
+			{
+				wideValue = Builder.CreateSDiv(wideValue, Builder.getInt64(1ULL << operandBits));
+			}
+			return Builder.CreateSExtOrTrunc(wideValue, llvmIrInstruction->getType());
+		}
+		case Instruction::FCmp:
+		{
+			Value * lhs	  = llvmIrInstruction->getOperand(0);
+			Value * rhs	  = llvmIrInstruction->getOperand(1);
+			int	commonBits = std::max(quantizationValueFractionBits(Q, lhs), quantizationValueFractionBits(Q, rhs));
+			CmpInst::Predicate predicate;
+			switch (cast<FCmpInst>(llvmIrInstruction)->getPredicate())
+			{
+				case CmpInst::FCMP_OEQ:
+				case CmpInst::FCMP_UEQ:
+					predicate = CmpInst::ICMP_EQ;
+					break;
+				case CmpInst::FCMP_ONE:
+				case CmpInst::FCMP_UNE:
+					predicate = CmpInst::ICMP_NE;
+					break;
+				case CmpInst::FCMP_OGT:
+				case CmpInst::FCMP_UGT:
+					predicate = CmpInst::ICMP_SGT;
+					break;
+				case CmpInst::FCMP_OGE:
+				case CmpInst::FCMP_UGE:
+					predicate = CmpInst::ICMP_SGE;
+					break;
+				case CmpInst::FCMP_OLT:
+				case CmpInst::FCMP_ULT:
+					predicate = CmpInst::ICMP_SLT;
+					break;
+				case CmpInst::FCMP_OLE:
+				case CmpInst::FCMP_ULE:
+					predicate = CmpInst::ICMP_SLE;
+					break;
+				case CmpInst::FCMP_ORD:
+				case CmpInst::FCMP_TRUE:
+					/*
+					 * values with a finite range are never NaN
+					 * */
+					return Builder.getTrue();
+				default:
+					return Builder.getFalse();
+			}
+			return Builder.CreateICmp(predicate, quantizationAlignedOperand(Q, Builder, lhs, commonBits),
+						  quantizationAlignedOperand(Q, Builder, rhs, commonBits));
+		}
+		case Instruction::Select:
+		{
+			Value * trueValue  = quantizationAlignedOperand(Q, Builder, llvmIrInstruction->getOperand(1), resultBits);
+			Value * falseValue = quantizationAlignedOperand(Q, Builder, llvmIrInstruction->getOperand(2), resultBits);
+			return Builder.CreateTrunc(Builder.CreateSelect(llvmIrInstruction->getOperand(0), trueValue, falseValue), wordType);
+		}
+		case Instruction::PHI:
+			/*
+			 * the incoming words are added once every value has one
+			 * */
+			return Builder.CreatePHI(wordType, cast<PHINode>(llvmIrInstruction)->getNumIncomingValues());
+		default:
+			assert(false && "not a candidate for quantization");
+			return nullptr;
+	}
+}
+
+/*
+ * Steps of irPassLLVMIRAutoQuantization:
+ *  1. find the instructions with a fixed point equivalent: float arithmetic, comparisons,
+ *     conversions, phis and selects whose values all have a Q-format for their range
+ *  2. group them by their def-use chains, and keep the groups where the soft-float operations
+ *     removed outweigh the conversions at their boundaries, weighting each by its loop depth
+ *  3. rewrite the groups in reverse post-order, converting the float values they read where
+ *     those are defined, and converting their results back for the code outside them
+ *  4. remove the float instructions
+ * */
 void
 irPassLLVMIRAutoQuantization(State * N, BoundInfo * boundInfo, llvm::Function & llvmIrFunction)
 {
-    flexprint(N->Fe, N->Fm, N->Fpinfo, "\tauto quantization.\n");
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "\tauto quantization.\n");
+	if (llvmIrFunction.isDeclaration())
+	{
+		return;
+	}
+
+	QuantizationState Q;
+	Q.N		       = N;
+	Q.boundInfo	       = boundInfo;
+	Q.llvmIrFunction       = &llvmIrFunction;
+	Q.requiredFractionBits = quantizationRequiredFractionBits(N);
+
+	DominatorTree dominatorTree(llvmIrFunction);
+	LoopInfo      loopInfo(dominatorTree);
+	auto	      weight = [&](Value * value) {
+		if (auto llvmIrInstruction = dyn_cast<Instruction>(value))
+		{
+			return std::pow(kQuantizationLoopWeight, loopInfo.getLoopDepth(llvmIrInstruction->getParent()));
+		}
+		return 1.0;
+	};
+
 	/*
-	 * Some special instructions that need to pay attention:
-	 * %i = alloca type, the type of this instruction is "type*"
-	 * %i = call retType @func_name (type %p1, ...)
-	 * call void @llvm.dbg.declare/value (metadata type %p, ...)
-	 * %i = load type, type* %op, the type of this instruction is "type"
-	 * %i = gep type, type1* %op1, type2 %op2, (type3 %op3)
-	 * %i = castInst type1 %op1 to type2
-	 * store type %op1, type* %op2
-	 * %.i = phi type [%op1, %bb1], [%op2, %bb2], ...
-	 * %i = binary type %op1, %op2
-	 * %i = unary type %op
+	 * 1. and 2.
 	 * */
-	for (BasicBlock & llvmIrBasicBlock : llvmIrFunction)
+	std::vector<Instruction *>	   candidates;
+	std::set<Instruction *>		   candidateSet;
+	EquivalenceClasses<Instruction *> groups;
+	for (Instruction & llvmIrInstruction : instructions(llvmIrFunction))
+	{
+		if (quantizationIsCandidate(&Q, &llvmIrInstruction))
+		{
+			candidates.push_back(&llvmIrInstruction);
+			candidateSet.insert(&llvmIrInstruction);
+			groups.insert(&llvmIrInstruction);
+		}
+	}
+	for (Instruction * candidate : candidates)
 	{
-		for (BasicBlock::iterator itBB = llvmIrBasicBlock.begin(); itBB != llvmIrBasicBlock.end();)
+		for (Value * operand : candidate->operands())
 		{
-			Instruction * llvmIrInstruction = &*itBB++;
-			switch (llvmIrInstruction->getOpcode())
+			if (candidateSet.count(dyn_cast<Instruction>(operand)))
 			{
-				case Instruction::Call:
-				case Instruction::Add:
-				case Instruction::FAdd:
-				case Instruction::Sub:
-				case Instruction::FSub:
-				case Instruction::Mul:
-				case Instruction::FMul:
-				case Instruction::SDiv:
-				case Instruction::FDiv:
-				case Instruction::UDiv:
-				case Instruction::URem:
-				case Instruction::SRem:
-				case Instruction::FRem:
-				case Instruction::Shl:
-				case Instruction::LShr:
-				case Instruction::AShr:
-				case Instruction::And:
-				case Instruction::Or:
-				case Instruction::Xor:
-				case Instruction::FNeg:
-				case Instruction::FPToUI:
-				case Instruction::FPToSI:
-				case Instruction::SIToFP:
-				case Instruction::UIToFP:
-				case Instruction::ZExt:
-				case Instruction::SExt:
-				case Instruction::FPExt:
-				case Instruction::Trunc:
-				case Instruction::FPTrunc:
-				case Instruction::BitCast:
-				case Instruction::Load:
-				case Instruction::GetElementPtr:
-				case Instruction::PHI:
-				case Instruction::Store:
-				case Instruction::ICmp:
-				case Instruction::FCmp:
-				case Instruction::Ret:
-				case Instruction::Switch:
-				case Instruction::Br:
-				case Instruction::Select:
-				case Instruction::IndirectBr:
-				case Instruction::Invoke:
-				case Instruction::Resume:
-				case Instruction::Unreachable:
-				case Instruction::CleanupRet:
-				case Instruction::CatchRet:
-				case Instruction::CatchSwitch:
-				case Instruction::CallBr:
-				case Instruction::Fence:
-				case Instruction::AtomicCmpXchg:
-				case Instruction::AtomicRMW:
-				case Instruction::PtrToInt:
-				case Instruction::IntToPtr:
-				case Instruction::AddrSpaceCast:
-				case Instruction::CleanupPad:
-				case Instruction::CatchPad:
-				case Instruction::UserOp1:
-				case Instruction::UserOp2:
-				case Instruction::VAArg:
-				case Instruction::ExtractElement:
-				case Instruction::InsertElement:
-				case Instruction::ShuffleVector:
-				case Instruction::ExtractValue:
-				case Instruction::InsertValue:
-				case Instruction::LandingPad:
-				case Instruction::Freeze:
-					break;
-				default:
-					break;
+				groups.unionSets(candidate, cast<Instruction>(operand));
 			}
 		}
 	}
-	return;
+
+	std::set<Instruction *> quantized;
+	for (auto groupIt = groups.begin(); groupIt != groups.end(); ++groupIt)
+	{
+		if (!groupIt->isLeader())
+		{
+			continue;
+		}
+		double		operationCost  = 0.0;
+		double		conversionCost = 0.0;
+		std::set<Value *> convertedInputs;
+		for (auto memberIt = groups.member_begin(groupIt); memberIt != groups.member_end(); ++memberIt)
+		{
+			Instruction * member = *memberIt;
+			if (!isa<PHINode>(member) && !isa<SelectInst>(member))
+			{
+				operationCost += weight(member);
+			}
+			for (Value * operand : member->operands())
+			{
+				if (quantizationIsFloatType(operand->getType()) && !isa<llvm::Constant>(operand) &&
+				    !candidateSet.count(dyn_cast<Instruction>(operand)) && convertedInputs.insert(operand).second)
+				{
+					conversionCost += kQuantizationConversionCost * weight(operand);
+				}
+			}
+			if (quantizationIsFloatType(member->getType()) &&
+			    std::any_of(member->user_begin(), member->user_end(), [&](User * user) { return !candidateSet.count(dyn_cast<Instruction>(user)); }))
+			{
+				conversionCost += kQuantizationConversionCost * weight(member);
+			}
+		}
+		if (conversionCost < operationCost)
+		{
+			quantized.insert(groups.member_begin(groupIt), groups.member_end());
+		}
+	}
+	if (quantized.empty())
+	{
+		return;
+	}
+
+	/*
+	 * 3.
+	 * */
+	std::vector<Instruction *> rewritten;
+	ReversePostOrderTraversal<Function *> rpot(&llvmIrFunction);
+	for (BasicBlock * llvmIrBasicBlock : rpot)
+	{
+		for (Instruction & llvmIrInstruction : *llvmIrBasicBlock)
+		{
+			if (!quantized.count(&llvmIrInstruction))
+			{
+				continue;
+			}
+			Value * fixedValue = quantizeInstruction(&Q, &llvmIrInstruction);
+			rewritten.push_back(&llvmIrInstruction);
+			if (quantizationIsFloatType(llvmIrInstruction.getType()))
+			{
+				Q.fixedValues.emplace(&llvmIrInstruction, fixedValue);
+			}
+			else
+			{
+				llvmIrInstruction.replaceAllUsesWith(fixedValue);
+			}
+		}
+	}
+	for (Instruction * llvmIrInstruction : rewritten)
+	{
+		PHINode * llvmIrPhi = dyn_cast<PHINode>(llvmIrInstruction);
+		if (llvmIrPhi == nullptr)
+		{
+			continue;
+		}
+		PHINode * fixedPhi   = cast<PHINode>(Q.fixedValues[llvmIrPhi]);
+		int	  resultBits = quantizationValueFractionBits(&Q, llvmIrPhi);
+		for (unsigned idx = 0; idx < llvmIrPhi->getNumIncomingValues(); idx++)
+		{
+			BasicBlock * incomingBlock = llvmIrPhi->getIncomingBlock(idx);
+			IRBuilder<>  Builder(incomingBlock->getTerminator());
+			Value *	     incomingValue = quantizationAlignedOperand(&Q, Builder, llvmIrPhi->getIncomingValue(idx), resultBits);
+			fixedPhi->addIncoming(Builder.CreateTrunc(incomingValue, Builder.getInt32Ty()), incomingBlock);
+		}
+	}
+	for (Instruction * llvmIrInstruction : rewritten)
+	{
+		if (!quantizationIsFloatType(llvmIrInstruction->getType()) ||
+		    std::all_of(llvmIrInstruction->user_begin(), llvmIrInstruction->user_end(), [&](User * user) { return quantized.count(dyn_cast<Instruction>(user)); }))
+		{
+			continue;
+		}
+		IRBuilder<> Builder(isa<PHINode>(llvmIrInstruction) ? &*llvmIrInstruction->getParent()->getFirstInsertionPt() : llvmIrInstruction);
+		Value *	    floatValue = Builder.CreateSIToFP(Q.fixedValues[llvmIrInstruction], llvmIrInstruction->getType());
+		llvmIrInstruction->replaceAllUsesWith(Builder.CreateFMul(floatValue, ConstantFP::get(llvmIrInstruction->getType(),
+												     std::ldexp(1.0, -quantizationValueFractionBits(&Q, llvmIrInstruction)))));
+	}
+
+	/*
+	 * 4.
+	 * */
+	for (Instruction * llvmIrInstruction : rewritten)
+	{
+		llvmIrInstruction->dropAllReferences();
+	}
+	for (Instruction * llvmIrInstruction : rewritten)
+	{
+		boundInfo->virtualRegisterRange.erase(llvmIrInstruction);
+		llvmIrInstruction->eraseFromParent();
+	}
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "\t\tquantized %zu instructions with at least %d fractional bits\n",
+		  rewritten.size(), Q.requiredFractionBits);
 }
 }
@@ -46,7 +46,7 @@ const bool valueRangeDebug = false;
 
 std::pair<bool, std::pair<double, double>>
 getGEPArrayRange(State * N, GetElementPtrInst * llvmIrGetElePtrInstruction,
-		 std::map<llvm::Value *, std::pair<double, double>> virtualRegisterRange)
+		 const ValueRangeTable & virtualRegisterRange)
 {
 	/*
 	 * if it's a constant
@@ -177,6 +177,7 @@ checkPhiRange(State * N, PHINode * phiNode, BoundInfo * boundInfo,
 {
 	std::vector<double>				    minValueVec, maxValueVec;
 	std::vector<std::vector<std::pair<double, double>>> minPHIValueVectors, maxPHIValueVectors;
+	bool						    pendingIncoming = false;
 	for (size_t idx = 0; idx < phiNode->getNumIncomingValues(); idx++)
 	{
 		auto phiValue = phiNode->getIncomingValue(idx);
@@ -232,8 +233,11 @@ checkPhiRange(State * N, PHINode * phiNode, BoundInfo * boundInfo,
 			}
 			else
 			{
-				assert(!valueRangeDebug && "failed to get range");
-				return false;
+				/*
+				 * the incoming block has not been visited by the fixpoint yet,
+				 * e.g. the back edge of a loop, so the value contributes nothing
+				 * */
+				pendingIncoming = true;
 			}
 		}
 	}
@@ -305,6 +309,10 @@ checkPhiRange(State * N, PHINode * phiNode, BoundInfo * boundInfo,
 
 	if (minValueVec.empty() && minPHIValueVectors.empty())
 	{
+		if (pendingIncoming)
+		{
+			return false;
+		}
 		flexprint(N->Fe, N->Fm, N->Fperr, "Error: min value vectors are both empty.");
 	}
 
@@ -475,479 +483,594 @@ modInterval(const int64_t lhsLow, const int64_t lhsHigh, const int64_t rhsLow, c
 	}
 }
 
-std::vector<std::string>
-getDisjointUnionSet(const std::bitset<64> & lowerBinSet,
-		    const std::bitset<64> & upperBinSet, uint8_t bitSize)
-{
-	std::string lowerBin = lowerBinSet.to_string();
-	std::string upperBin = upperBinSet.to_string();
-	lowerBin	     = lowerBin.substr(lowerBin.size() - bitSize);
-	upperBin	     = upperBin.substr(upperBin.size() - bitSize);
-	std::vector<std::string> disjointUnionSet;
-	std::string		 binStrEle;
+/*
+ * the bits known to be 0 and known to be 1 in every value of a range,
+ * as 64-bit words of the sign-extended values
+ * */
+typedef struct IntervalKnownBits {
+	uint64_t zero;
+	uint64_t one;
+} IntervalKnownBits;
 
+IntervalKnownBits
+intervalKnownBits(const int64_t low, const int64_t high)
+{
 	/*
-	 * the turning point is where lowerBin different from upperBin
+	 * an interval that does not cross zero is contiguous as unsigned words too,
+	 * so all its values share the leading bits that its bounds share. The bounds
+	 * of one that crosses zero differ in the sign bit, leaving no bit known.
 	 * */
-	std::string xorStr = (lowerBinSet ^ upperBinSet).to_string();
-	xorStr		   = xorStr.substr(xorStr.size() - bitSize);
-	if (xorStr.find_first_of('1') == std::string::npos)
+	const uint64_t differentBits = static_cast<uint64_t>(low) ^ static_cast<uint64_t>(high);
+	const uint64_t knownMask     = differentBits == 0 ? UINT64_MAX : ~(UINT64_MAX >> countLeadingZeros(differentBits));
+	return {~static_cast<uint64_t>(low) & knownMask, static_cast<uint64_t>(low) & knownMask};
+}
+
+/*
+ * the smallest and the largest value with the known bits: the unknown sign bit
+ * set for the smallest and clear for the largest, the other unknown bits clear
+ * for the smallest and set for the largest
+ * */
+std::pair<int64_t, int64_t>
+knownBitsInterval(const IntervalKnownBits & knownBits)
+{
+	const uint64_t signBit	   = 1ULL << 63;
+	const uint64_t unknownBits = ~(knownBits.zero | knownBits.one);
+	return std::make_pair(static_cast<int64_t>(knownBits.one | (unknownBits & signBit)),
+			      static_cast<int64_t>(knownBits.one | (unknownBits & ~signBit)));
+}
+
+/*
+ * bounds of x | y, x & y and x ^ y for x in [a, b] and y in [c, d] as unsigned
+ * words, from Hacker's Delight (4-3): walking down from the top bit, the bound
+ * of one operand is moved to the next multiple of a power of two when that gives
+ * the result a bit it would otherwise lack (or drops one it would otherwise have)
+ * */
+uint64_t
+minOrBound(uint64_t a, uint64_t b, uint64_t c, uint64_t d)
+{
+	for (uint64_t m = 1ULL << 63; m != 0; m >>= 1)
 	{
-		/*
-		 * lower bound == higher bound, return with itself
-		 * */
-		disjointUnionSet.emplace_back(lowerBin);
-		return disjointUnionSet;
+		if (~a & c & m)
+		{
+			uint64_t temp = (a | m) & -m;
+			if (temp <= b)
+			{
+				a = temp;
+				break;
+			}
+		}
+		else if (a & ~c & m)
+		{
+			uint64_t temp = (c | m) & -m;
+			if (temp <= d)
+			{
+				c = temp;
+				break;
+			}
+		}
 	}
-	const auto turningPoint = xorStr.find_first_of('1');
-	/*
-	 * for the right-most continuously bit of lower bound,
-	 *  if they're '0', then change them to 'x'
-	 *  if it's '1', then emplace '1'
-	 */
-	const auto lowerStartPos = lowerBin.substr(1).find_last_of('1') + 1;
-	if (lowerStartPos == bitSize - 1)
+	return a | c;
+}
+
+uint64_t
+maxOrBound(uint64_t a, uint64_t b, uint64_t c, uint64_t d)
+{
+	for (uint64_t m = 1ULL << 63; m != 0; m >>= 1)
 	{
-		disjointUnionSet.emplace_back(lowerBin);
+		if (b & d & m)
+		{
+			uint64_t temp = (b - m) | (m - 1);
+			if (temp >= a)
+			{
+				b = temp;
+				break;
+			}
+			temp = (d - m) | (m - 1);
+			if (temp >= c)
+			{
+				d = temp;
+				break;
+			}
+		}
 	}
-	else
+	return b | d;
+}
+
+uint64_t
+minAndBound(uint64_t a, uint64_t b, uint64_t c, uint64_t d)
+{
+	for (uint64_t m = 1ULL << 63; m != 0; m >>= 1)
 	{
-		/* substitute all the right most '0' in lowerBin to 'x'
-		 *  e.g.
-		 *  ([010100], [011101]) -> {[0101xx], ...}
-		 * but if the turning point is righter than 'lowerStartPos'
-		 * only substitute bits right after the turning point
-		 *  e.g.
-		 *  ([01000], [01110]) -> {[010xx], ...}
-		 * */
-		const auto substituteBit = lowerStartPos > turningPoint ? lowerStartPos : turningPoint;
-		binStrEle		 = lowerBin.substr(0, substituteBit + 1);
-		binStrEle.append(bitSize - substituteBit - 1, 'x');
-		disjointUnionSet.emplace_back(binStrEle);
-		binStrEle.clear();
+		if (~a & ~c & m)
+		{
+			uint64_t temp = (a | m) & -m;
+			if (temp <= b)
+			{
+				a = temp;
+				break;
+			}
+			temp = (c | m) & -m;
+			if (temp <= d)
+			{
+				c = temp;
+				break;
+			}
+		}
 	}
-	/*
-	 * when splitting the lower bound, iterate from right to left
-	 * */
-	for (int idx = lowerStartPos - 1; idx > turningPoint; idx--)
+	return a & c;
+}
+
+uint64_t
+maxAndBound(uint64_t a, uint64_t b, uint64_t c, uint64_t d)
+{
+	for (uint64_t m = 1ULL << 63; m != 0; m >>= 1)
 	{
-		if (idx < 0)
-			break;
-		/*
-		 * substitute the '0' to '1' and append with 'x' to get the large number
-		 * */
-		if (lowerBin[idx] == '0')
+		if (b & ~d & m)
 		{
-			binStrEle = lowerBin.substr(0, idx) + '1';
-			binStrEle.append(bitSize - idx - 1, 'x');
-			disjointUnionSet.emplace_back(binStrEle);
-			binStrEle.clear();
+			uint64_t temp = (b & ~m) | (m - 1);
+			if (temp >= a)
+			{
+				b = temp;
+				break;
+			}
+		}
+		else if (~b & d & m)
+		{
+			uint64_t temp = (d & ~m) | (m - 1);
+			if (temp >= c)
+			{
+				d = temp;
+				break;
+			}
 		}
 	}
+	return b & d;
+}
 
-	/*
-	 * for the right-most continuously bit of upper bound,
-	 *  if they're '1', then change them to 'x'
-	 *  if it's '0', then emplace '0'
-	 * */
-	const auto upperEndPos = upperBin.substr(1).find_last_of('0') + 1;
-	if (upperEndPos == bitSize - 1)
+/*
+ * the range of an And, Or or Xor. The known bits of the operands give the bits
+ * known in the result, and so a range for it. Splitting each operand range at
+ * zero into parts whose values are contiguous as unsigned words, and of one sign,
+ * the unsigned bounds of each pair of parts are exact, and, since the sign of the
+ * result is the same throughout a pair, are its signed bounds too.
+ * The result is the meet of the two.
+ * */
+std::pair<int64_t, int64_t>
+bitwiseInterval(int64_t lhsLow, int64_t lhsHigh,
+		int64_t rhsLow, int64_t rhsHigh,
+		const unsigned opcode)
+{
+	if (lhsLow > lhsHigh)
 	{
-		disjointUnionSet.emplace_back(upperBin);
+		std::swap(lhsLow, lhsHigh);
 	}
-	else
+	if (rhsLow > rhsHigh)
 	{
-		/* substitute all of the right most '1' in upperBin to 'x'.
-		 *  e.g.
-		 *  ([010001], [011011]) -> {[0110xx], ...}
-		 * but if the turning point is righter than 'upperEndPos'
-		 * only substitute bits right after the turning point
-		 *  e.g.
-		 *  ([010001], [011111]) -> {[011xxx], ...}
-		 * */
-		const auto substituteBit = upperEndPos > turningPoint ? upperEndPos : turningPoint;
-		binStrEle		 = upperBin.substr(0, substituteBit + 1);
-		binStrEle.append(bitSize - substituteBit - 1, 'x');
-		disjointUnionSet.emplace_back(binStrEle);
-		binStrEle.clear();
+		std::swap(rhsLow, rhsHigh);
 	}
-	/*
-	 * when splitting the upper bound, iterate from left to right
-	 * */
-	for (int idx = turningPoint + 1; idx < upperEndPos; idx++)
+	const IntervalKnownBits lhsBits = intervalKnownBits(lhsLow, lhsHigh);
+	const IntervalKnownBits rhsBits = intervalKnownBits(rhsLow, rhsHigh);
+	IntervalKnownBits	resBits;
+	switch (opcode)
 	{
-		/*
-		 * substitute the '1' to '0' and append with 'x' to get the smaller number
-		 * */
-		if (upperBin[idx] == '1')
+		case Instruction::And:
+			resBits.zero = lhsBits.zero | rhsBits.zero;
+			resBits.one  = lhsBits.one & rhsBits.one;
+			break;
+		case Instruction::Or:
+			resBits.zero = lhsBits.zero & rhsBits.zero;
+			resBits.one  = lhsBits.one | rhsBits.one;
+			break;
+		case Instruction::Xor:
+			resBits.zero = (lhsBits.zero & rhsBits.zero) | (lhsBits.one & rhsBits.one);
+			resBits.one  = (lhsBits.zero & rhsBits.one) | (lhsBits.one & rhsBits.zero);
+			break;
+		default:
+			assert(false && "unknown bit_wise operation");
+			return std::make_pair(INT64_MIN, INT64_MAX);
+	}
+	const auto knownBitsRange = knownBitsInterval(resBits);
+
+	std::vector<std::pair<uint64_t, uint64_t>> lhsParts, rhsParts;
+	for (auto part : {std::make_pair(lhsLow, std::min<int64_t>(lhsHigh, -1)), std::make_pair(std::max<int64_t>(lhsLow, 0), lhsHigh)})
+	{
+		if (part.first <= part.second)
 		{
-			binStrEle = upperBin.substr(0, idx) + '0';
-			binStrEle.append(bitSize - idx - 1, 'x');
-			disjointUnionSet.emplace_back(binStrEle);
-			binStrEle.clear();
+			lhsParts.emplace_back(part.first, part.second);
 		}
 	}
-
-	return disjointUnionSet;
-}
-
-enum BitSetType {
-	HAS_BIT	 = 1,
-	ALL_SAME = 2,
-	ALL_DIFF = 3,
-};
-
-using bitSets	= std::vector<std::vector<size_t>>;
-using signedBit = std::pair<bool, std::vector<size_t>>;
-struct hashFunc {
-	size_t
-	operator()(const signedBit & x) const
+	for (auto part : {std::make_pair(rhsLow, std::min<int64_t>(rhsHigh, -1)), std::make_pair(std::max<int64_t>(rhsLow, 0), rhsHigh)})
 	{
-		size_t secondXor;
-		for (const auto & s : x.second)
+		if (part.first <= part.second)
 		{
-			if (s == SIZE_MAX)
-				return x.first;
-			secondXor ^= s;
+			rhsParts.emplace_back(part.first, part.second);
 		}
-		return x.first ^ secondXor;
 	}
-};
-using signedBitSets = std::unordered_set<signedBit, hashFunc>;
-
-signedBitSets
-getBitPos(bitSets lhsVecs, bitSets rhsVecs,
-	  std::vector<std::string> lhsDus,
-	  std::vector<std::string> rhsDus,
-	  const std::string &	   bitwiseFunc,
-	  BitSetType		   bsType)
-{
-	signedBitSets		  res;
-	const std::vector<size_t> nonExit(1, SIZE_MAX);
-	for (size_t lhsIdx = 0; lhsIdx < lhsVecs.size(); lhsIdx++)
+	int64_t lowerBound = INT64_MAX, upperBound = INT64_MIN;
+	for (const auto & lhs : lhsParts)
 	{
-		for (size_t rhsIdx = 0; rhsIdx < rhsVecs.size(); rhsIdx++)
+		for (const auto & rhs : rhsParts)
 		{
-			std::vector<size_t> tmpSamePos;
-			if (bsType == BitSetType::HAS_BIT)
-			{
-				std::set_union(lhsVecs[lhsIdx].begin(), lhsVecs[lhsIdx].end(),
-					       rhsVecs[rhsIdx].begin(), rhsVecs[rhsIdx].end(),
-					       std::back_inserter(tmpSamePos));
-			}
-			else if (bsType == BitSetType::ALL_SAME)
+			uint64_t a = lhs.first, b = lhs.second, c = rhs.first, d = rhs.second;
+			uint64_t partLow, partHigh;
+			if (opcode == Instruction::And)
 			{
-				std::set_intersection(lhsVecs[lhsIdx].begin(), lhsVecs[lhsIdx].end(),
-						      rhsVecs[rhsIdx].begin(), rhsVecs[rhsIdx].end(),
-						      std::back_inserter(tmpSamePos));
+				partLow	 = minAndBound(a, b, c, d);
+				partHigh = maxAndBound(a, b, c, d);
 			}
-			else if (bsType == BitSetType::ALL_DIFF)
+			else if (opcode == Instruction::Or)
 			{
-				std::set_difference(lhsVecs[lhsIdx].begin(), lhsVecs[lhsIdx].end(),
-						    rhsVecs[rhsIdx].begin(), rhsVecs[rhsIdx].end(),
-						    std::back_inserter(tmpSamePos));
+				partLow	 = minOrBound(a, b, c, d);
+				partHigh = maxOrBound(a, b, c, d);
 			}
 			else
-				assert(false && "unknown enum of BitSetType");
-			tmpSamePos = tmpSamePos.empty() ? nonExit : tmpSamePos;
-			if (bitwiseFunc == "and")
 			{
-				res.emplace(std::make_pair((lhsDus[lhsIdx][0] - 48) & (rhsDus[rhsIdx][0] - 48),
-							   tmpSamePos));
-			}
-			else if (bitwiseFunc == "or")
-			{
-				res.emplace(std::make_pair((lhsDus[lhsIdx][0] - 48) | (rhsDus[rhsIdx][0] - 48),
-							   tmpSamePos));
-			}
-			else
-			{
-				res.emplace(std::make_pair((lhsDus[lhsIdx][0] - 48) ^ (rhsDus[rhsIdx][0] - 48),
-							   tmpSamePos));
+				partLow	 = minAndBound(a, b, ~d, ~c) | minAndBound(~b, ~a, c, d);
+				partHigh = maxOrBound(0, maxAndBound(a, b, ~d, ~c), 0, maxAndBound(~b, ~a, c, d));
 			}
+			lowerBound = std::min(lowerBound, static_cast<int64_t>(partLow));
+			upperBound = std::max(upperBound, static_cast<int64_t>(partHigh));
 		}
 	}
-	return res;
+	return std::make_pair(std::max(lowerBound, knownBitsRange.first), std::min(upperBound, knownBitsRange.second));
 }
 
-int64_t
-convertBin2Dec(const std::string & binResStr, const uint8_t bitSize)
+/*
+ * lattice operations of the fixpoint in `rangeAnalysis`
+ * */
+std::pair<double, double>
+joinRange(const std::pair<double, double> & lhs, const std::pair<double, double> & rhs)
+{
+	return std::make_pair(std::fmin(lhs.first, rhs.first), std::fmax(lhs.second, rhs.second));
+}
+
+/*
+ * used by narrowing, so an empty intersection keeps the (sound) previous range
+ * */
+std::pair<double, double>
+meetRange(const std::pair<double, double> & previous, const std::pair<double, double> & current)
 {
-	int64_t res;
-	if (binResStr[0] == '1')
+	double lowerBound = std::fmax(previous.first, current.first);
+	double upperBound = std::fmin(previous.second, current.second);
+	if (lowerBound > upperBound)
 	{
-		auto tmpRes = binResStr;
-		/*
-		 * minus 1
-		 * */
-		if (tmpRes.back() == '1')
-		{
-			tmpRes.back() = '0';
-		}
-		else
-		{
-			const size_t lastOne = tmpRes.find_last_of('1');
-			std::string  appendOne(bitSize - lastOne - 1, '1');
-			tmpRes[lastOne] = '0';
-			tmpRes		= tmpRes.substr(0, lastOne + 1) + appendOne;
-		}
-		/*
-		 * negate
-		 * */
-		std::bitset<64> resDb(tmpRes);
-		res = -resDb.flip().to_ulong();
+		return previous;
 	}
-	else
+	return std::make_pair(lowerBound, upperBound);
+}
+
+bool
+sameRange(const std::pair<double, double> & lhs, const std::pair<double, double> & rhs)
+{
+	return (lhs.first == rhs.first || (std::isnan(lhs.first) && std::isnan(rhs.first))) &&
+	       (lhs.second == rhs.second || (std::isnan(lhs.second) && std::isnan(rhs.second)));
+}
+
+/*
+ * the widest range a value of this type (or pointed to by this type) can hold
+ * */
+std::pair<double, double>
+typeLimitRange(Type * valueType)
+{
+	if (valueType->isPointerTy())
+	{
+		valueType = valueType->getPointerElementType();
+	}
+	if (valueType->isIntegerTy(1))
 	{
-		std::bitset<64> resDb(binResStr);
-		res = resDb.to_ulong();
+		return std::make_pair(0.0, 1.0);
 	}
-	return res;
+	if (valueType->isIntegerTy())
+	{
+		unsigned bitWidth = std::min(valueType->getIntegerBitWidth(), 64u);
+		return std::make_pair(-ldexp(1.0, bitWidth - 1), ldexp(1.0, bitWidth - 1) - 1);
+	}
+	if (valueType->isFloatTy())
+	{
+		return std::make_pair(-static_cast<double>(FLT_MAX), static_cast<double>(FLT_MAX));
+	}
+	return std::make_pair(-DBL_MAX, DBL_MAX);
 }
 
-std::pair<int64_t, int64_t>
-bitwiseInterval(const int64_t lhsLow, const int64_t lhsHigh,
-		const int64_t rhsLow, const int64_t rhsHigh,
-		const std::string & bitwiseFunc)
+/*
+ * widening with thresholds: a bound that is still moving jumps to the nearest
+ * constant of the function beyond it, and then to the limit of the type.
+ * A range that already left the type wraps around (or saturates), so it becomes
+ * the whole type. `thresholds` must be sorted.
+ * */
+std::pair<double, double>
+widenRange(const std::pair<double, double> & previous, const std::pair<double, double> & current,
+	   const std::vector<double> & thresholds, const std::pair<double, double> & limits)
 {
-	/*
-	 * 1. get the max bit size
-	 *  for negative number, it has the same or smaller remaining bit size with its positive,
-	 *  like -8="1...1000", 8="0...1000"; -14="1...0010", 14="0...1110"
-	 *  so when meet negative number, we get its max bit size with its absolute value.
-	 *  PS: the first bit is a sign bit.
-	 * */
-	std::vector<int64_t> ranges{std::abs(lhsLow), std::abs(lhsHigh),
-				    std::abs(rhsLow), std::abs(rhsHigh)};
-	auto		     maxAbsValue = std::max_element(ranges.begin(), ranges.end());
-	const auto	     maxSizePos	 = std::bitset<64>(*maxAbsValue).to_string().find('1');
-	const uint8_t	     bitSize	 = 64 - (maxSizePos == std::string::npos ? 63 : maxSizePos) + 1;
+	if (current.first < limits.first || current.second > limits.second)
+	{
+		return limits;
+	}
+	double lowerBound = previous.first;
+	double upperBound = previous.second;
+	if (current.first < previous.first)
+	{
+		auto thresholdIt = std::upper_bound(thresholds.begin(), thresholds.end(), current.first);
+		lowerBound	 = thresholdIt != thresholds.begin() && *std::prev(thresholdIt) >= limits.first
+				       ? *std::prev(thresholdIt)
+				       : limits.first;
+	}
+	if (current.second > previous.second)
+	{
+		auto thresholdIt = std::lower_bound(thresholds.begin(), thresholds.end(), current.second);
+		upperBound	 = thresholdIt != thresholds.end() && *thresholdIt <= limits.second
+				       ? *thresholdIt
+				       : limits.second;
+	}
+	return std::make_pair(lowerBound, upperBound);
+}
 
-	/*
-	 * 2. convert to binary number
-	 * */
-	std::bitset<64> llBin(lhsLow);
-	std::bitset<64> lhBin(lhsHigh);
-	std::bitset<64> rlBin(rhsLow);
-	std::bitset<64> rhBin(rhsHigh);
+/*
+ * the range of an integer value with int64_t bounds, taken from its doubles
+ * when they are integers that an int64_t holds
+ * */
+ValueRange
+integerValueRange(Type * valueType, const ValueRange & range)
+{
+	if (range.isInteger || !valueType->isIntegerTy() || valueType->getIntegerBitWidth() > 64)
+	{
+		return range;
+	}
+	if (!(range.first >= -0x1p63 && range.second < 0x1p63) ||
+	    std::floor(range.first) != range.first || std::floor(range.second) != range.second)
+	{
+		return range;
+	}
+	return ValueRange::integer(static_cast<int64_t>(range.first), static_cast<int64_t>(range.second));
+}
 
-	/*
-	 * 3. construct disjoint union set of each binary number
-	 * */
-	auto lhsDus = getDisjointUnionSet(llBin, lhBin, bitSize);
-	auto rhsDus = getDisjointUnionSet(rlBin, rhBin, bitSize);
+ValueRange
+joinValueRange(const ValueRange & lhs, const ValueRange & rhs)
+{
+	if (lhs.isInteger && rhs.isInteger)
+	{
+		return ValueRange::integer(std::min(lhs.integerFirst, rhs.integerFirst), std::max(lhs.integerSecond, rhs.integerSecond));
+	}
+	return joinRange(lhs, rhs);
+}
 
-	/*
-	 * 4. for different bit_wise operation, we have different formulas and purpose
-	 * */
-	/*collect all bits index with '0' and '1'*/
-	bitSets lhsZeroVecs, lhsOneVecs;
-	for (const auto & lhs : lhsDus)
+bool
+sameValueRange(const ValueRange & lhs, const ValueRange & rhs)
+{
+	if (lhs.isInteger && rhs.isInteger)
 	{
-		std::vector<size_t> matchZero, matchOne;
-		/*no need to check the sign bit*/
-		std::vector<size_t> indexVec(bitSize - 1);
-		std::iota(indexVec.begin(), indexVec.end(), 1);
-		std::copy_if(indexVec.begin(), indexVec.end(), std::back_inserter(matchZero), [lhs](size_t v) {
-			return lhs[v] == '0';
-		});
-		lhsZeroVecs.emplace_back(matchZero);
-		std::copy_if(indexVec.begin(), indexVec.end(), std::back_inserter(matchOne), [lhs](size_t v) {
-			return lhs[v] == '1';
-		});
-		lhsOneVecs.emplace_back(matchOne);
+		return lhs.integerFirst == rhs.integerFirst && lhs.integerSecond == rhs.integerSecond;
+	}
+	return sameRange(lhs, rhs);
+}
+
+/*
+ * the exact bounds of an integer operand, a ConstantInt or a value with an integer range
+ * */
+bool
+integerOperandRange(BoundInfo * boundInfo, Value * operand, int64_t & lowerBound, int64_t & upperBound)
+{
+	if (auto constInt = dyn_cast<ConstantInt>(operand))
+	{
+		if (constInt->getBitWidth() > 64)
+		{
+			return false;
+		}
+		lowerBound = constInt->getSExtValue();
+		upperBound = lowerBound;
+		return true;
 	}
-	bitSets rhsZeroVecs, rhsOneVecs;
-	for (const auto & rhs : rhsDus)
+	auto vrRangeIt = boundInfo->virtualRegisterRange.find(operand);
+	if (vrRangeIt == boundInfo->virtualRegisterRange.end())
 	{
-		std::vector<size_t> matchZero, matchOne;
-		/*no need to check the sign bit*/
-		std::vector<size_t> indexVec(bitSize - 1);
-		std::iota(indexVec.begin(), indexVec.end(), 1);
-		std::copy_if(indexVec.begin(), indexVec.end(), std::back_inserter(matchZero), [rhs](size_t v) {
-			return rhs[v] == '0';
-		});
-		rhsZeroVecs.emplace_back(matchZero);
-		std::copy_if(indexVec.begin(), indexVec.end(), std::back_inserter(matchOne), [rhs](size_t v) {
-			return rhs[v] == '1';
-		});
-		rhsOneVecs.emplace_back(matchOne);
+		return false;
 	}
+	ValueRange range = integerValueRange(operand->getType(), vrRangeIt->second);
+	lowerBound	 = range.integerFirst;
+	upperBound	 = range.integerSecond;
+	return range.isInteger;
+}
 
-	signedBitSets sameOnePos    = getBitPos(lhsOneVecs, rhsOneVecs, lhsDus, rhsDus,
-						bitwiseFunc, BitSetType::ALL_SAME);
-	signedBitSets sameZeroPos   = getBitPos(lhsZeroVecs, rhsZeroVecs, lhsDus, rhsDus,
-						bitwiseFunc, BitSetType::ALL_SAME);
-	signedBitSets existOnePos   = getBitPos(lhsOneVecs, rhsOneVecs, lhsDus, rhsDus,
-						bitwiseFunc, BitSetType::HAS_BIT);
-	signedBitSets existZeroPos  = getBitPos(lhsZeroVecs, rhsZeroVecs, lhsDus, rhsDus,
-						bitwiseFunc, BitSetType::HAS_BIT);
-	signedBitSets diffFirstPos  = getBitPos(lhsOneVecs, rhsZeroVecs, lhsDus, rhsDus,
-						bitwiseFunc, BitSetType::ALL_SAME);
-	signedBitSets diffSecondPos = getBitPos(lhsZeroVecs, rhsOneVecs, lhsDus, rhsDus,
-						bitwiseFunc, BitSetType::ALL_SAME);
-	signedBitSets unionMin, unionMax;
-	// todo: there's a bug of xor: [-5, -4, 0, 1]
-	std::set_union(diffFirstPos.begin(), diffFirstPos.end(),
-		       diffSecondPos.begin(), diffSecondPos.end(),
-		       std::inserter(unionMin, unionMin.begin()));
-	std::set_union(sameZeroPos.begin(), sameZeroPos.end(),
-		       sameOnePos.begin(), sameOnePos.end(),
-		       std::inserter(unionMax, unionMax.begin()));
-
-	signedBitSets::iterator minResIt, maxResIt;
-	auto			compSingBit = [](const signedBit & a, const signedBit & b) {
-		   auto aIt = a.second.begin();
-		   auto bIt = b.second.begin();
-		   while (aIt != a.second.end() && bIt != b.second.end())
-		   {
-			   if ((*aIt) < (*bIt))
-				   return true;
-			   else if ((*aIt) > (*bIt))
-			   {
-				   return false;
-			   }
-			   else
-			   {
-				   aIt++;
-				   bIt++;
-			   }
-		   }
-		   return aIt != a.second.end();
-	};
-	if (bitwiseFunc == "and")
+/*
+ * give the range of an integer instruction int64_t bounds. The cases of
+ * rangeAnalysis compute in doubles, which round beyond 2^53, so Add, Sub and
+ * Mul of operands with integer ranges are recomputed exactly, unless they
+ * overflow an int64_t, And, Or and Xor are recomputed from the exact bounds,
+ * and SExt keeps the bounds of its operand.
+ * */
+void
+refineIntegerRange(BoundInfo * boundInfo, Instruction * llvmIrInstruction)
+{
+	auto vrRangeIt = boundInfo->virtualRegisterRange.find(llvmIrInstruction);
+	if (vrRangeIt == boundInfo->virtualRegisterRange.end() || !llvmIrInstruction->getType()->isIntegerTy() ||
+	    llvmIrInstruction->getType()->getIntegerBitWidth() > 64)
 	{
-		/*
-		 * and:
-		 *  0 & 0 = 0, 0 & 1 = 0, 0 & x = 0
-		 *  1 & 1 = 1, 1 & x = x, x & x = x
-		 *   min: find the same '1', the larger the better, others are '0'
-		 *   max: find '0' exist, the larger the better, others are '1'
-		 * */
-		minResIt = std::max_element(sameOnePos.begin(), sameOnePos.end(),
-					    [compSingBit](const signedBit & a, const signedBit & b) {
-						    if (a.first < b.first)
-							    return true;
-						    else if (a.first > b.first)
-							    return false;
-						    else
-						    {
-							    return compSingBit(a, b);
-						    }
-					    });
-		maxResIt = std::max_element(existZeroPos.begin(), existZeroPos.end(),
-					    [compSingBit](const signedBit & a, const signedBit & b) {
-						    if (a.first > b.first)
-							    return true;
-						    else if (a.first < b.first)
-							    return false;
-						    else
-						    {
-							    return compSingBit(a, b);
-						    }
-					    });
+		return;
 	}
-	else if (bitwiseFunc == "or")
+
+	int64_t leftLowerBound, leftUpperBound, rightLowerBound, rightUpperBound;
+	int64_t lowerBound = 0, upperBound = 0;
+	bool	overflow   = true;
+	switch (llvmIrInstruction->getOpcode())
 	{
-		/*
-		 *  or:
-		 *  1 | 1 = 1, 1 | 0 = 1, 1 | x = 1
-		 *  0 | 0 = 0, 0 | x = x, x | x = x
-		 *   min: find '1' exist, the larger the better, others are '0'
-		 *   max: find the same '0', the larger the better, others are '1'
-		 * */
-		minResIt = std::max_element(existOnePos.begin(), existOnePos.end(),
-					    [compSingBit](const signedBit & a, const signedBit & b) {
-						    if (a.first < b.first)
-							    return true;
-						    else if (a.first > b.first)
-							    return false;
-						    else
-						    {
-							    return compSingBit(a, b);
-						    }
-					    });
-		maxResIt = std::max_element(sameZeroPos.begin(), sameZeroPos.end(),
-					    [compSingBit](const signedBit & a, const signedBit & b) {
-						    if (a.first > b.first)
-							    return true;
-						    else if (a.first < b.first)
-							    return false;
-						    else
-						    {
-							    return compSingBit(a, b);
-						    }
-					    });
+		case Instruction::Add:
+		case Instruction::Sub:
+		case Instruction::Mul:
+			if (!integerOperandRange(boundInfo, llvmIrInstruction->getOperand(0), leftLowerBound, leftUpperBound) ||
+			    !integerOperandRange(boundInfo, llvmIrInstruction->getOperand(1), rightLowerBound, rightUpperBound))
+			{
+				break;
+			}
+			if (llvmIrInstruction->getOpcode() == Instruction::Add)
+			{
+				overflow = AddOverflow(leftLowerBound, rightLowerBound, lowerBound) ||
+					   AddOverflow(leftUpperBound, rightUpperBound, upperBound);
+			}
+			else if (llvmIrInstruction->getOpcode() == Instruction::Sub)
+			{
+				overflow = SubOverflow(leftLowerBound, rightUpperBound, lowerBound) ||
+					   SubOverflow(leftUpperBound, rightLowerBound, upperBound);
+			}
+			else
+			{
+				int64_t products[4];
+				overflow = MulOverflow(leftLowerBound, rightLowerBound, products[0]) ||
+					   MulOverflow(leftLowerBound, rightUpperBound, products[1]) ||
+					   MulOverflow(leftUpperBound, rightLowerBound, products[2]) ||
+					   MulOverflow(leftUpperBound, rightUpperBound, products[3]);
+				if (!overflow)
+				{
+					lowerBound = *std::min_element(products, products + 4);
+					upperBound = *std::max_element(products, products + 4);
+				}
+			}
+			break;
+		case Instruction::And:
+		case Instruction::Or:
+		case Instruction::Xor:
+			overflow = !integerOperandRange(boundInfo, llvmIrInstruction->getOperand(0), leftLowerBound, leftUpperBound) ||
+				   !integerOperandRange(boundInfo, llvmIrInstruction->getOperand(1), rightLowerBound, rightUpperBound);
+			if (!overflow)
+			{
+				std::tie(lowerBound, upperBound) = bitwiseInterval(leftLowerBound, leftUpperBound,
+										   rightLowerBound, rightUpperBound,
+										   llvmIrInstruction->getOpcode());
+			}
+			break;
+		case Instruction::SExt:
+			overflow = !integerOperandRange(boundInfo, llvmIrInstruction->getOperand(0), lowerBound, upperBound);
+			break;
+		default:
+			break;
 	}
-	else if (bitwiseFunc == "xor")
+
+	if (!overflow)
 	{
-		/*
-		 *  xor:
-		 *  0 ^ 0 = 0, 0 ^ 1 = 1, 1 ^ 1 = 0
-		 *  x ^ 0 = x, x ^ 1 = x, x ^ x = x
-		 *   min: find the different '0' + different '1', the larger the better, others are '0'
-		 *   max: find the same '0' + same '1', the larger the better, others are '1'
-		 * */
-		minResIt = std::max_element(unionMin.begin(), unionMin.end(),
-					    [compSingBit](const signedBit & a, const signedBit & b) {
-						    if (a.first < b.first)
-							    return true;
-						    else if (a.first > b.first)
-							    return false;
-						    else
-						    {
-							    return compSingBit(a, b);
-						    }
-					    });
-		maxResIt = std::max_element(unionMax.begin(), unionMax.end(),
-					    [compSingBit](const signedBit & a, const signedBit & b) {
-						    if (a.first > b.first)
-							    return true;
-						    else if (a.first < b.first)
-							    return false;
-						    else
-						    {
-							    return compSingBit(a, b);
-						    }
-					    });
+		vrRangeIt->second = ValueRange::integer(lowerBound, upperBound);
 	}
 	else
 	{
-		assert(false && "unknown bit_wise operation");
+		vrRangeIt->second = integerValueRange(llvmIrInstruction->getType(), vrRangeIt->second);
 	}
+}
 
-	std::string minResStr(bitSize, '0'), maxResStr(bitSize, '1');
-	minResStr[0] = minResIt->first ? '1' : '0';
-	for (const auto & bit : minResIt->second)
+FlexPrintBuf *
+rangeAnalysisPrintBuffer(void)
+{
+	FlexPrintBuf * printBuffer = (FlexPrintBuf *)calloc(1, sizeof(FlexPrintBuf));
+	if (printBuffer == NULL)
+	{
+		fatal(NULL, Emalloc);
+	}
+	printBuffer->circbuf = (char *)calloc(1, FLEX_CIRCBUFSZ);
+	if (printBuffer->circbuf == NULL)
 	{
-		if (bit != SIZE_MAX)
+		fatal(NULL, Emalloc);
+	}
+	return printBuffer;
+}
+
+void
+rangeAnalysisFreePrintBuffer(FlexPrintBuf * printBuffer)
+{
+	free(printBuffer->circbuf);
+	free(printBuffer);
+}
+
+/*
+ * append a report captured in a private buffer to printBuffer of N,
+ * line by line to stay within what a single flexprint formats
+ * */
+void
+rangeAnalysisReplayReport(State * N, FlexPrintBuf * printBuffer, const char * report)
+{
+	const char * line = report;
+	while (*line != '\0')
+	{
+		const char * lineEnd = strchr(line, '\n');
+		int	     length  = lineEnd == NULL ? strlen(line) : lineEnd - line;
+		flexprint(N->Fe, N->Fm, printBuffer, lineEnd == NULL ? "%.*s" : "%.*s\n", length, line);
+		line += lineEnd == NULL ? length : length + 1;
+	}
+}
+
+/*
+ * the analysis of a callee, looked up in (or added to) the shared summaries.
+ * On a miss the callee is analyzed with private print buffers, and in both
+ * cases its report is appended to the buffers of N.
+ * innerBoundInfo carries the argument ranges in and the summary out: when the
+ * summary is not the one it came in with, the one it came in with is deleted.
+ * */
+std::pair<Value *, std::pair<double, double>>
+summarizedCalleeRange(State * N, const std::map<std::string, std::pair<double, double>> & typeRange,
+		      const std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange,
+		      CalleeSummaries * calleeSummaries, BoundInfo *& innerBoundInfo, Function & calledFunction)
+{
+	std::vector<uint64_t> argumentKey;
+	for (auto & arg : calledFunction.args())
+	{
+		auto vrRangeIt = innerBoundInfo->virtualRegisterRange.find(&arg);
+		if (vrRangeIt != innerBoundInfo->virtualRegisterRange.end())
 		{
-			minResStr[bit] = '1';
+			uint64_t lowerBits, upperBits;
+			memcpy(&lowerBits, &vrRangeIt->second.first, sizeof(lowerBits));
+			memcpy(&upperBits, &vrRangeIt->second.second, sizeof(upperBits));
+			argumentKey.insert(argumentKey.end(), {arg.getArgNo(), lowerBits, upperBits});
 		}
 	}
-	maxResStr[0] = maxResIt->first ? '1' : '0';
-	for (const auto & bit : maxResIt->second)
+	auto summaryKey = std::make_pair(&calledFunction, argumentKey);
+
 	{
-		if (bit != SIZE_MAX)
+		std::lock_guard<std::mutex> guard(calleeSummaries->lock);
+		auto			    summaryIt = calleeSummaries->summaries.find(summaryKey);
+		if (summaryIt != calleeSummaries->summaries.end())
 		{
-			maxResStr[bit] = '0';
+			delete innerBoundInfo;
+			innerBoundInfo = summaryIt->second.boundInfo;
+			rangeAnalysisReplayReport(N, N->Fpinfo, summaryIt->second.info.c_str());
+			rangeAnalysisReplayReport(N, N->Fperr, summaryIt->second.errors.c_str());
+			return summaryIt->second.returnRange;
 		}
 	}
 
 	/*
-	 * 5. convert binary string to decimal int64_t
+	 * analyzed outside the lock: another thread may analyze the same callee
+	 * meanwhile, but the result and the report of both are the same, so the
+	 * one that comes second keeps the summary of the first
 	 * */
-	int64_t minRes = convertBin2Dec(minResStr, bitSize);
-	int64_t maxRes = convertBin2Dec(maxResStr, bitSize);
-	return std::make_pair(minRes, maxRes);
+	State calleeState		= *N;
+	calleeState.Fpinfo		= rangeAnalysisPrintBuffer();
+	calleeState.Fperr		= rangeAnalysisPrintBuffer();
+	innerBoundInfo->calleeSummaries = calleeSummaries;
+
+	CalleeSummary summary;
+	summary.returnRange = rangeAnalysis(&calleeState, typeRange, virtualRegisterVectorRange, innerBoundInfo, calledFunction);
+	summary.boundInfo   = innerBoundInfo;
+	summary.info	    = calleeState.Fpinfo->circbuf;
+	summary.errors	    = calleeState.Fperr->circbuf;
+	rangeAnalysisFreePrintBuffer(calleeState.Fpinfo);
+	rangeAnalysisFreePrintBuffer(calleeState.Fperr);
+
+	rangeAnalysisReplayReport(N, N->Fpinfo, summary.info.c_str());
+	rangeAnalysisReplayReport(N, N->Fperr, summary.errors.c_str());
+
+	std::lock_guard<std::mutex> guard(calleeSummaries->lock);
+	auto			    summaryIt = calleeSummaries->summaries.emplace(summaryKey, summary);
+	if (!summaryIt.second)
+	{
+		delete innerBoundInfo;
+		innerBoundInfo = summaryIt.first->second.boundInfo;
+	}
+	return summaryIt.first->second.returnRange;
 }
 
 std::pair<Value *, std::pair<double, double>>
 rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>> & typeRange,
 	      const std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange,
-	      BoundInfo * boundInfo, Function & llvmIrFunction, bool useOverLoad)
+	      BoundInfo * boundInfo, Function & llvmIrFunction)
 {
 	flexprint(N->Fe, N->Fm, N->Fpinfo, "\tCall: Analyze function %s.\n", llvmIrFunction.getName());
+	boundInfo->virtualRegisterRange.numberFunction(llvmIrFunction);
 	/*
 	 * information for the union data structure
 	 * */
@@ -956,10 +1079,273 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 	 * function arguments
 	 * */
 	std::map<Value *, Value *> storeParamMap;
-	for (BasicBlock & llvmIrBasicBlock : llvmIrFunction)
+
+	/*
+	 * a declaration has no blocks, the calls to it are handled at the call sites
+	 * */
+	if (llvmIrFunction.isDeclaration())
+	{
+		return {nullptr, {}};
+	}
+
+	/*
+	 * The ranges are the fixpoint of an abstract interpretation over the CFG:
+	 * basic blocks are taken from a worklist in reverse post-order, and a block
+	 * is revisited whenever a value it uses or the memory flowing into it changes.
+	 * SSA values live in boundInfo->virtualRegisterRange and only grow (join);
+	 * the addresses written by stores are tracked per basic block, so that a
+	 * store still overwrites the range within a block, and the ranges coming
+	 * from the predecessors are joined at its entry.
+	 * At loop headers (targets of back edges), the PHI nodes and the memory are
+	 * widened once a header has been visited kCommonRangeAnalysisWideningDelay
+	 * times, and kCommonRangeAnalysisNarrowingPasses sweeps without widening
+	 * then recover the bounds that the widening overshot.
+	 * */
+	ReversePostOrderTraversal<Function *> rpoTraversal(&llvmIrFunction);
+	std::vector<BasicBlock *>	      rpoBlocks(rpoTraversal.begin(), rpoTraversal.end());
+	std::map<BasicBlock *, size_t>	      rpoIndex;
+	std::set<BasicBlock *>		      loopHeaders;
+	for (size_t idx = 0; idx < rpoBlocks.size(); idx++)
+	{
+		rpoIndex.emplace(rpoBlocks[idx], idx);
+	}
+	std::set<Value *>   memoryCells;
+	std::vector<double> wideningThresholds;
+	for (BasicBlock * llvmIrBasicBlock : rpoBlocks)
+	{
+		for (BasicBlock * predecessor : predecessors(llvmIrBasicBlock))
+		{
+			auto predIt = rpoIndex.find(predecessor);
+			if (predIt != rpoIndex.end() && predIt->second >= rpoIndex[llvmIrBasicBlock])
+			{
+				loopHeaders.emplace(llvmIrBasicBlock);
+			}
+		}
+		for (Instruction & llvmIrInstruction : *llvmIrBasicBlock)
+		{
+			if (auto llvmIrStoreInstruction = dyn_cast<StoreInst>(&llvmIrInstruction))
+			{
+				memoryCells.emplace(llvmIrStoreInstruction->getPointerOperand());
+			}
+			for (Value * operand : llvmIrInstruction.operands())
+			{
+				if (ConstantInt * constInt = dyn_cast<ConstantInt>(operand))
+				{
+					if (constInt->getBitWidth() <= 64)
+					{
+						wideningThresholds.emplace_back(static_cast<double>(constInt->getSExtValue()));
+					}
+				}
+				else if (ConstantFP * constFp = dyn_cast<ConstantFP>(operand))
+				{
+					wideningThresholds.emplace_back((constFp->getValueAPF()).convertToDouble());
+				}
+			}
+		}
+	}
+	std::sort(wideningThresholds.begin(), wideningThresholds.end());
+	wideningThresholds.erase(std::unique(wideningThresholds.begin(), wideningThresholds.end()), wideningThresholds.end());
+
+	std::map<Value *, std::pair<double, double>> functionEntryCells;
+	for (Value * cell : memoryCells)
 	{
+		auto vrRangeIt = boundInfo->virtualRegisterRange.find(cell);
+		if (vrRangeIt != boundInfo->virtualRegisterRange.end())
+		{
+			functionEntryCells.emplace(cell, vrRangeIt->second);
+		}
+	}
+
+	std::map<BasicBlock *, std::map<Value *, std::pair<double, double>>> blockEntryCells, blockExitCells;
+	std::map<BasicBlock *, size_t>					     blockVisits;
+	/*
+	 * argument ranges of the calls to defined functions when they were last analyzed,
+	 * the callee is only analyzed again when they change
+	 * */
+	std::map<CallInst *, std::vector<std::pair<double, double>>> analyzedCalls;
+	Value *							     returnInstruction = nullptr;
+	std::pair<double, double>				     returnRange;
+	size_t							     narrowingPass = 0;
+	std::set<size_t>					     worklist;
+	for (size_t idx = 0; idx < rpoBlocks.size(); idx++)
+	{
+		worklist.emplace(idx);
+	}
+	while (!worklist.empty())
+	{
+		BasicBlock & llvmIrBasicBlock = *rpoBlocks[*worklist.begin()];
+		worklist.erase(worklist.begin());
+		bool narrowing	= narrowingPass > 0;
+		bool loopHeader = loopHeaders.find(&llvmIrBasicBlock) != loopHeaders.end();
+		if (!narrowing)
+		{
+			blockVisits[&llvmIrBasicBlock]++;
+		}
+		bool widening  = !narrowing && loopHeader && blockVisits[&llvmIrBasicBlock] > kCommonRangeAnalysisWideningDelay;
+		bool propagate = !narrowing && blockVisits[&llvmIrBasicBlock] <= kCommonRangeAnalysisMaxBlockVisits;
+		if (!narrowing && blockVisits[&llvmIrBasicBlock] == kCommonRangeAnalysisMaxBlockVisits + 1)
+		{
+			flexprint(N->Fe, N->Fm, N->Fperr, "\tRange analysis of %s did not converge, ranges may be unsound.\n",
+				  llvmIrFunction.getName().str().c_str());
+		}
+
+		/*
+		 * the memory at the entry of the block
+		 * */
+		std::map<Value *, std::pair<double, double>> cellRanges;
+		if (&llvmIrBasicBlock == &llvmIrFunction.getEntryBlock())
+		{
+			cellRanges = functionEntryCells;
+		}
+		for (BasicBlock * predecessor : predecessors(&llvmIrBasicBlock))
+		{
+			auto exitIt = blockExitCells.find(predecessor);
+			if (exitIt == blockExitCells.end())
+			{
+				continue;
+			}
+			for (const auto & cell : exitIt->second)
+			{
+				auto cellIt = cellRanges.find(cell.first);
+				if (cellIt != cellRanges.end())
+				{
+					cellIt->second = joinRange(cellIt->second, cell.second);
+				}
+				else
+				{
+					cellRanges.emplace(cell.first, cell.second);
+				}
+			}
+		}
+		auto entryIt = blockEntryCells.find(&llvmIrBasicBlock);
+		if (loopHeader && entryIt != blockEntryCells.end())
+		{
+			for (auto & cell : cellRanges)
+			{
+				auto previousIt = entryIt->second.find(cell.first);
+				if (previousIt == entryIt->second.end())
+				{
+					continue;
+				}
+				if (narrowing)
+				{
+					cell.second = meetRange(previousIt->second, cell.second);
+				}
+				else
+				{
+					cell.second = joinRange(previousIt->second, cell.second);
+					if (widening)
+					{
+						cell.second = widenRange(previousIt->second, cell.second, wideningThresholds,
+									 typeLimitRange(cell.first->getType()));
+					}
+				}
+			}
+		}
+		for (Value * cell : memoryCells)
+		{
+			auto cellIt = cellRanges.find(cell);
+			if (cellIt != cellRanges.end())
+			{
+				boundInfo->virtualRegisterRange[cell] = cellIt->second;
+			}
+			else
+			{
+				boundInfo->virtualRegisterRange.erase(cell);
+			}
+		}
+		blockEntryCells[&llvmIrBasicBlock] = cellRanges;
+
+		std::vector<Instruction *>	definedValues;
+		std::map<Value *, ValueRange>	previousRanges;
+		/*
+		 * join (or widen, or narrow) the new range of a value with the one of the previous visit,
+		 * and revisit its users when it changed
+		 * */
+		auto settleRange = [&](Instruction * definedValue) {
+			auto vrRangeIt	= boundInfo->virtualRegisterRange.find(definedValue);
+			auto previousIt = previousRanges.find(definedValue);
+			bool changed	= false;
+			if (previousIt == previousRanges.end())
+			{
+				changed = vrRangeIt != boundInfo->virtualRegisterRange.end();
+			}
+			else if (vrRangeIt == boundInfo->virtualRegisterRange.end())
+			{
+				boundInfo->virtualRegisterRange.emplace(definedValue, previousIt->second);
+			}
+			else
+			{
+				bool loopHeaderPhi = loopHeader && isa<PHINode>(definedValue);
+				if (narrowing)
+				{
+					if (loopHeaderPhi)
+					{
+						vrRangeIt->second = meetRange(previousIt->second, vrRangeIt->second);
+					}
+				}
+				else
+				{
+					vrRangeIt->second = joinValueRange(previousIt->second, vrRangeIt->second);
+					if (widening && loopHeaderPhi)
+					{
+						vrRangeIt->second = widenRange(previousIt->second, vrRangeIt->second, wideningThresholds,
+									       typeLimitRange(definedValue->getType()));
+					}
+				}
+				vrRangeIt->second = integerValueRange(definedValue->getType(), vrRangeIt->second);
+				changed		  = !sameValueRange(previousIt->second, vrRangeIt->second);
+			}
+			if (changed && propagate)
+			{
+				for (User * user : definedValue->users())
+				{
+					if (auto userInstruction = dyn_cast<Instruction>(user))
+					{
+						auto indexIt = rpoIndex.find(userInstruction->getParent());
+						if (indexIt != rpoIndex.end())
+						{
+							worklist.emplace(indexIt->second);
+						}
+					}
+				}
+			}
+		};
+
 		for (Instruction & llvmIrInstruction : llvmIrBasicBlock)
 		{
+			if (auto llvmIrCallInstruction = dyn_cast<CallInst>(&llvmIrInstruction))
+			{
+				Function * calledFunction = llvmIrCallInstruction->getCalledFunction();
+				if (calledFunction != nullptr && !calledFunction->isDeclaration())
+				{
+					std::vector<std::pair<double, double>> argRanges;
+					for (Value * arg : llvmIrCallInstruction->args())
+					{
+						auto vrRangeIt = boundInfo->virtualRegisterRange.find(arg);
+						argRanges.emplace_back(vrRangeIt != boundInfo->virtualRegisterRange.end()
+									   ? static_cast<std::pair<double, double>>(vrRangeIt->second)
+									   : std::make_pair(static_cast<double>(NAN), static_cast<double>(NAN)));
+					}
+					auto callIt = analyzedCalls.find(llvmIrCallInstruction);
+					if (callIt != analyzedCalls.end() &&
+					    std::equal(argRanges.begin(), argRanges.end(), callIt->second.begin(), callIt->second.end(), sameRange))
+					{
+						continue;
+					}
+					analyzedCalls[llvmIrCallInstruction] = argRanges;
+				}
+			}
+			if (!llvmIrInstruction.getType()->isVoidTy() && memoryCells.find(&llvmIrInstruction) == memoryCells.end())
+			{
+				definedValues.emplace_back(&llvmIrInstruction);
+				auto vrRangeIt = boundInfo->virtualRegisterRange.find(&llvmIrInstruction);
+				if (vrRangeIt != boundInfo->virtualRegisterRange.end())
+				{
+					previousRanges.emplace(&llvmIrInstruction, vrRangeIt->second);
+					boundInfo->virtualRegisterRange.erase(vrRangeIt);
+				}
+			}
 			switch (llvmIrInstruction.getOpcode())
 			{
 				case Instruction::Call:
@@ -1175,22 +1561,10 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 									  calledFunction->getName().str().c_str());
 								auto innerBoundInfo = new BoundInfo();
 								/*
-								 * get the range of args and rename the called function with args range
-								 * */
-								std::string newFuncName = calledFunction->getName().str();
-								/*
-								 * check if the ranges have been set to the function name
+								 * get the range of args
 								 * */
 								for (size_t idx = 0; idx < llvmIrCallInstruction->getNumOperands() - 1; idx++)
 								{
-									std::vector<std::string> argRanges;
-									std::regex		 regexp("_([0-9]{1,})_([0-9]{1,})*");
-									std::smatch		 match;
-									regex_search(newFuncName, match, regexp);
-									for (size_t i = 1; i < match.size(); i++)
-									{
-										argRanges.emplace_back(match[i]);
-									}
 									/*
 									 * First, we check if it's a constant value
 									 * */
@@ -1201,11 +1575,6 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 										innerBoundInfo->virtualRegisterRange.emplace(calledFunction->getArg(idx),
 															     std::make_pair(static_cast<double>(constIntValue),
 																	    static_cast<double>(constIntValue)));
-										std::string argVal = std::to_string(constIntValue);
-										if (argRanges.empty())
-											newFuncName = newFuncName + "_" + argVal + "_" + argVal;
-										else if (argVal != argRanges[0] || argVal != argRanges[1])
-											newFuncName = match.prefix().str() + "_" + argVal + "_" + argVal;
 									}
 									else if (ConstantFP * constFp = dyn_cast<ConstantFP>(llvmIrCallInstruction->getOperand(idx)))
 									{
@@ -1213,11 +1582,6 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 										flexprint(N->Fe, N->Fm, N->Fpinfo, "\tCall: It's a constant double value: %f.\n", constDoubleValue);
 										innerBoundInfo->virtualRegisterRange.emplace(calledFunction->getArg(idx),
 															     std::make_pair(constDoubleValue, constDoubleValue));
-										std::string argVal = std::to_string((int)constDoubleValue);
-										if (argRanges.empty())
-											newFuncName = newFuncName + "_" + argVal + "_" + argVal;
-										else if (argVal != argRanges[0] || argVal != argRanges[1])
-											newFuncName = match.prefix().str() + "_" + argVal + "_" + argVal;
 									}
 									else
 									{
@@ -1231,12 +1595,6 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 											flexprint(N->Fe, N->Fm, N->Fpinfo, "\tCall: the range of the operand is: %f - %f.\n",
 												  vrRangeIt->second.first, vrRangeIt->second.second);
 											innerBoundInfo->virtualRegisterRange.emplace(calledFunction->getArg(idx), vrRangeIt->second);
-											std::string argLowVal  = std::to_string((int)vrRangeIt->second.first);
-											std::string argHighVal = std::to_string((int)vrRangeIt->second.second);
-											if (argRanges.empty())
-												newFuncName = newFuncName + "_" + argLowVal + "_" + argHighVal;
-											else if (argLowVal != argRanges[0] || argHighVal != argRanges[1])
-												newFuncName = match.prefix().str() + "_" + argLowVal + "_" + argHighVal;
 										}
 										else
 										{
@@ -1244,142 +1602,49 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 										}
 									}
 								}
-								Function *					    realCallee;
+								/*
+								 * the callee is analyzed in place, specializing it to the ranges of the
+								 * call is left to specializeFunctionsByRange. For variables of innerBoundInfo
+								 * that has been stored in boundInfo, we get the union set of them
+								 * */
 								std::pair<llvm::Value *, std::pair<double, double>> returnRange;
-								auto						    uniqueNewFunc = boundInfo->callerMap.find(newFuncName) != boundInfo->callerMap.end();
-								if (useOverLoad && newFuncName != calledFunction->getName().str() && uniqueNewFunc)
+								if (boundInfo->calleeSummaries != nullptr)
 								{
-									/*
-									 * rename the llvmIrCallInstruction to the new function name
-									 */
-									ValueToValueMapTy vMap;
-									realCallee	    = Function::Create(calledFunction->getFunctionType(),
-													       calledFunction->getLinkage(),
-													       calledFunction->getAddressSpace(),
-													       newFuncName);
-									auto * newFuncArgIt = realCallee->arg_begin();
-									for (auto & arg : calledFunction->args())
-									{
-										auto argName = arg.getName();
-										newFuncArgIt->setName(argName);
-										vMap[&arg] = &(*newFuncArgIt++);
-									}
-									SmallVector<ReturnInst *, 8> Returns;
-									CloneFunctionInto(realCallee, calledFunction, vMap,
-											  CloneFunctionChangeType::LocalChangesOnly, Returns);
-									// Set the linkage and visibility late as CloneFunctionInto has some
-									// implicit requirements.
-									realCallee->setVisibility(GlobalValue::DefaultVisibility);
-									realCallee->setLinkage(GlobalValue::PrivateLinkage);
-
-									// Copy metadata
-									SmallVector<std::pair<unsigned, MDNode *>, 1> MDs;
-									calledFunction->getAllMetadata(MDs);
-									for (auto MDIt : MDs)
-									{
-										if (!realCallee->hasMetadata())
-										{
-											realCallee->addMetadata(MDIt.first, *MDIt.second);
-										}
-									}
-
-									Module & funcModule = *calledFunction->getParent();
-									funcModule.getFunctionList().insert(calledFunction->getIterator(), realCallee);
-									realCallee->setDSOLocal(true);
-									llvmIrCallInstruction->setCalledFunction(realCallee);
-									boundInfo->callerMap.emplace(realCallee->getName().str(), llvmIrCallInstruction);
-									/*
-									 * update the inner bound info with the new function.
-									 * // todo: this code is a bit wired, maybe can be improved
-									 * */
-									auto innerBoundInfo = new BoundInfo();
-									for (size_t idx = 0; idx < llvmIrCallInstruction->getNumOperands() - 1; idx++)
-									{
-										/*
-										 * First, we check if it's a constant value
-										 * */
-										if (ConstantInt * cInt = dyn_cast<ConstantInt>(llvmIrCallInstruction->getOperand(idx)))
-										{
-											int64_t constIntValue = cInt->getSExtValue();
-											flexprint(N->Fe, N->Fm, N->Fpinfo, "\tCall: It's a constant int value: %d.\n", constIntValue);
-											innerBoundInfo->virtualRegisterRange.emplace(realCallee->getArg(idx),
-																     std::make_pair(static_cast<double>(constIntValue),
-																		    static_cast<double>(constIntValue)));
-										}
-										else if (ConstantFP * constFp = dyn_cast<ConstantFP>(llvmIrCallInstruction->getOperand(idx)))
-										{
-											double constDoubleValue = (constFp->getValueAPF()).convertToDouble();
-											flexprint(N->Fe, N->Fm, N->Fpinfo, "\tCall: It's a constant double value: %f.\n", constDoubleValue);
-											innerBoundInfo->virtualRegisterRange.emplace(realCallee->getArg(idx),
-																     std::make_pair(constDoubleValue,
-																		    constDoubleValue));
-										}
-										else
-										{
-											/*
-											 *	if we find the operand in boundInfo->virtualRegisterRange,
-											 *	we know it's a variable with range.
-											 */
-											auto vrRangeIt = boundInfo->virtualRegisterRange.find(llvmIrCallInstruction->getOperand(idx));
-											if (vrRangeIt != boundInfo->virtualRegisterRange.end())
-											{
-												flexprint(N->Fe, N->Fm, N->Fpinfo, "\tCall: the range of the operand is: %f - %f.\n",
-													  vrRangeIt->second.first, vrRangeIt->second.second);
-												innerBoundInfo->virtualRegisterRange.emplace(realCallee->getArg(idx),
-																	     vrRangeIt->second);
-											}
-											else
-											{
-												assert(!valueRangeDebug && "failed to get range");
-											}
-										}
-									}
-
-									returnRange = rangeAnalysis(N, typeRange, virtualRegisterVectorRange,
-												    innerBoundInfo, *realCallee, useOverLoad);
-									if (returnRange.first != nullptr)
-									{
-										boundInfo->virtualRegisterRange.emplace(llvmIrCallInstruction, returnRange.second);
-									}
-									boundInfo->calleeBound.emplace(newFuncName, innerBoundInfo);
+									returnRange = summarizedCalleeRange(N, typeRange, virtualRegisterVectorRange,
+													    boundInfo->calleeSummaries, innerBoundInfo, *calledFunction);
 								}
 								else
 								{
-									/*
-									 * if we don't use overload function here, for variables of innerBoundInfo
-									 * that has been stored in boundInfo, we get the union set of them
-									 * */
-									realCallee  = calledFunction;
 									returnRange = rangeAnalysis(N, typeRange, virtualRegisterVectorRange,
-												    innerBoundInfo, *realCallee, useOverLoad);
-									if (returnRange.first != nullptr)
+												    innerBoundInfo, *calledFunction);
+								}
+								if (returnRange.first != nullptr)
+								{
+									boundInfo->virtualRegisterRange.emplace(llvmIrCallInstruction, returnRange.second);
+								}
+								for (const auto & vrRange : innerBoundInfo->virtualRegisterRange)
+								{
+									auto ibIt = boundInfo->virtualRegisterRange.find(vrRange.first);
+									if (ibIt != boundInfo->virtualRegisterRange.end())
 									{
-										boundInfo->virtualRegisterRange.emplace(llvmIrCallInstruction, returnRange.second);
+										auto innerLowerBound			     = vrRange.second.first < ibIt->second.first ? vrRange.second.first : ibIt->second.first;
+										auto innerUpperBound			     = vrRange.second.second > ibIt->second.second ? vrRange.second.second : ibIt->second.second;
+										boundInfo->virtualRegisterRange[ibIt->first] = std::make_pair(innerLowerBound,
+																	      innerUpperBound);
 									}
-									for (const auto & vrRange : innerBoundInfo->virtualRegisterRange)
+									else
 									{
-										auto ibIt = boundInfo->virtualRegisterRange.find(vrRange.first);
-										if (ibIt != boundInfo->virtualRegisterRange.end())
-										{
-											auto innerLowerBound			     = vrRange.second.first < ibIt->second.first ? vrRange.second.first : ibIt->second.first;
-											auto innerUpperBound			     = vrRange.second.second > ibIt->second.second ? vrRange.second.second : ibIt->second.second;
-											boundInfo->virtualRegisterRange[ibIt->first] = std::make_pair(innerLowerBound,
-																		      innerUpperBound);
-										}
-										else
-										{
-											boundInfo->virtualRegisterRange.emplace(vrRange.first, vrRange.second);
-										}
+										boundInfo->virtualRegisterRange.emplace(vrRange.first, vrRange.second);
 									}
 								}
 								/*
-								 * Check the return type of the function,
-								 * if it's a physical type that records in `typeRange`
-								 * but didn't match the range we inferred from `rangeAnalysis` algorithm,
-								 * we give a warning to the programmer.
-								 * But we still believe in the range we inferred from the function body.
-								 */
-								DISubprogram * subProgram = realCallee->getSubprogram();
+								 * a summary keeps its innerBoundInfo, otherwise it is ours to free
+								 * */
+								if (boundInfo->calleeSummaries == nullptr)
+								{
+									delete innerBoundInfo;
+								}
+								DISubprogram * subProgram = calledFunction->getSubprogram();
 								DITypeRefArray typeArray  = subProgram->getType()->getTypeArray();
 								if (typeArray[0] != nullptr)
 								{
@@ -2152,9 +2417,9 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 								std::pair<int64_t, int64_t> and_res = bitwiseInterval(lowerBound, upperBound,
 														      vrRangeIt->second.first,
 														      vrRangeIt->second.second,
-														      "and");
+														      Instruction::And);
 								boundInfo->virtualRegisterRange.emplace(llvmIrBinaryOperator,
-													std::make_pair(and_res.first, and_res.second));
+													ValueRange::integer(and_res.first, and_res.second));
 							}
 							else
 							{
@@ -2185,9 +2450,9 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 								std::pair<int64_t, int64_t> and_res = bitwiseInterval(constValue, constValue,
 														      vrRangeIt->second.first,
 														      vrRangeIt->second.second,
-														      "and");
+														      Instruction::And);
 								boundInfo->virtualRegisterRange.emplace(llvmIrBinaryOperator,
-													std::make_pair(and_res.first, and_res.second));
+													ValueRange::integer(and_res.first, and_res.second));
 							}
 							else
 							{
@@ -2240,9 +2505,9 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 								std::pair<int64_t, int64_t> and_res = bitwiseInterval(lowerBound, upperBound,
 														      vrRangeIt->second.first,
 														      vrRangeIt->second.second,
-														      "or");
+														      Instruction::Or);
 								boundInfo->virtualRegisterRange.emplace(llvmIrBinaryOperator,
-													std::make_pair(and_res.first, and_res.second));
+													ValueRange::integer(and_res.first, and_res.second));
 							}
 							else
 							{
@@ -2273,9 +2538,9 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 								std::pair<int64_t, int64_t> and_res = bitwiseInterval(constValue, constValue,
 														      vrRangeIt->second.first,
 														      vrRangeIt->second.second,
-														      "or");
+														      Instruction::Or);
 								boundInfo->virtualRegisterRange.emplace(llvmIrBinaryOperator,
-													std::make_pair(and_res.first, and_res.second));
+													ValueRange::integer(and_res.first, and_res.second));
 							}
 							else
 							{
@@ -2328,9 +2593,9 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 								std::pair<int64_t, int64_t> and_res = bitwiseInterval(lowerBound, upperBound,
 														      vrRangeIt->second.first,
 														      vrRangeIt->second.second,
-														      "xor");
+														      Instruction::Xor);
 								boundInfo->virtualRegisterRange.emplace(llvmIrBinaryOperator,
-													std::make_pair(and_res.first, and_res.second));
+													ValueRange::integer(and_res.first, and_res.second));
 							}
 							else
 							{
@@ -2361,9 +2626,9 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 								std::pair<int64_t, int64_t> and_res = bitwiseInterval(constValue, constValue,
 														      vrRangeIt->second.first,
 														      vrRangeIt->second.second,
-														      "xor");
+														      Instruction::Xor);
 								boundInfo->virtualRegisterRange.emplace(llvmIrBinaryOperator,
-													std::make_pair(and_res.first, and_res.second));
+													ValueRange::integer(and_res.first, and_res.second));
 							}
 							else
 							{
@@ -2791,7 +3056,12 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 							auto vrRangeIt = boundInfo->virtualRegisterRange.find(llvmIrReturnInstruction->getOperand(0));
 							if (vrRangeIt != boundInfo->virtualRegisterRange.end())
 							{
-								return {llvmIrReturnInstruction, vrRangeIt->second};
+								/*
+								 * the range of the function is the join of all its returns
+								 * */
+								returnRange	  = returnInstruction == nullptr ? static_cast<std::pair<double, double>>(vrRangeIt->second)
+													 : joinRange(returnRange, vrRangeIt->second);
+								returnInstruction = llvmIrReturnInstruction;
 							}
 							else
 							{
@@ -2809,8 +3079,8 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 							if (vrRangeIt != boundInfo->virtualRegisterRange.end())
 							{
 								boundInfo->virtualRegisterRange.emplace(
-								    llvmIrFNegInstruction, std::make_pair(-vrRangeIt->second.first,
-													  -vrRangeIt->second.second));
+								    llvmIrFNegInstruction, std::make_pair(-vrRangeIt->second.second,
+													  -vrRangeIt->second.first));
 							}
 							else
 							{
@@ -2833,6 +3103,45 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 					break;
 
 				case Instruction::Select:
+					if (auto llvmIrSelectInstruction = dyn_cast<SelectInst>(&llvmIrInstruction))
+					{
+						/*
+						 * the join of the ranges of the two values it selects from
+						 * */
+						std::vector<ValueRange> selectedRanges;
+						for (Value * selectedValue : {llvmIrSelectInstruction->getTrueValue(), llvmIrSelectInstruction->getFalseValue()})
+						{
+							if (ConstantFP * constFp = llvm::dyn_cast<llvm::ConstantFP>(selectedValue))
+							{
+								double constValue = (constFp->getValueAPF()).convertToDouble();
+								selectedRanges.emplace_back(constValue, constValue);
+							}
+							else if (ConstantInt * constInt = llvm::dyn_cast<llvm::ConstantInt>(selectedValue))
+							{
+								if (constInt->getBitWidth() <= 64)
+								{
+									selectedRanges.push_back(ValueRange::integer(constInt->getSExtValue(), constInt->getSExtValue()));
+								}
+							}
+							else
+							{
+								auto vrRangeIt = boundInfo->virtualRegisterRange.find(selectedValue);
+								if (vrRangeIt != boundInfo->virtualRegisterRange.end())
+								{
+									selectedRanges.push_back(vrRangeIt->second);
+								}
+							}
+						}
+						if (selectedRanges.size() == 2)
+						{
+							boundInfo->virtualRegisterRange.emplace(llvmIrSelectInstruction,
+												joinValueRange(selectedRanges[0], selectedRanges[1]));
+						}
+						else
+						{
+							assert(!valueRangeDebug && "failed to get range");
+						}
+					}
 					break;
 
 				case Instruction::Switch:
@@ -2867,8 +3176,72 @@ rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>>
 				default:
 					continue;
 			}
+
+			refineIntegerRange(boundInfo, &llvmIrInstruction);
+
+			/*
+			 * PHI nodes are settled right away, so the rest of the block reads the widened range
+			 * */
+			if (isa<PHINode>(&llvmIrInstruction) && !definedValues.empty() && definedValues.back() == &llvmIrInstruction)
+			{
+				settleRange(&llvmIrInstruction);
+			}
+		}
+
+		for (Instruction * definedValue : definedValues)
+		{
+			if (!isa<PHINode>(definedValue))
+			{
+				settleRange(definedValue);
+			}
+		}
+
+		/*
+		 * the memory at the exit of the block
+		 * */
+		std::map<Value *, std::pair<double, double>> exitCells;
+		for (Value * cell : memoryCells)
+		{
+			auto vrRangeIt = boundInfo->virtualRegisterRange.find(cell);
+			if (vrRangeIt != boundInfo->virtualRegisterRange.end())
+			{
+				exitCells.emplace(cell, vrRangeIt->second);
+			}
+		}
+		auto exitIt	     = blockExitCells.find(&llvmIrBasicBlock);
+		bool exitChanged = exitIt == blockExitCells.end() ||
+				   !std::equal(exitCells.begin(), exitCells.end(), exitIt->second.begin(), exitIt->second.end(),
+					       [](const std::pair<Value * const, std::pair<double, double>> & lhs,
+						  const std::pair<Value * const, std::pair<double, double>> & rhs) {
+						       return lhs.first == rhs.first && sameRange(lhs.second, rhs.second);
+					       });
+		blockExitCells[&llvmIrBasicBlock] = exitCells;
+		if (exitChanged && propagate)
+		{
+			for (BasicBlock * successor : successors(&llvmIrBasicBlock))
+			{
+				auto indexIt = rpoIndex.find(successor);
+				if (indexIt != rpoIndex.end())
+				{
+					worklist.emplace(indexIt->second);
+				}
+			}
+		}
+
+		/*
+		 * once the ascending iteration has converged, sweep the blocks again
+		 * in reverse post-order without widening
+		 * */
+		if (worklist.empty() && narrowingPass < kCommonRangeAnalysisNarrowingPasses)
+		{
+			narrowingPass++;
+			returnInstruction = nullptr;
+			for (size_t idx = 0; idx < rpoBlocks.size(); idx++)
+			{
+				worklist.emplace(idx);
+			}
 		}
 	}
-	return {nullptr, {}};
+	return {returnInstruction, returnRange};
 }
 }
@@ -39,7 +39,6 @@
 
 #include <algorithm>
 #include <assert.h>
-#include <bitset>
 #include <numeric>
 #include <cmath>
 #include <float.h>
@@ -52,12 +51,16 @@
 #include <string.h>
 #include <set>
 #include <map>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/PostOrderIterator.h"
 #include "llvm/Analysis/MemorySSAUpdater.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/CFG.h"
 #include "llvm/IR/DebugInfoMetadata.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Metadata.h"
@@ -67,6 +70,7 @@
 #include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Value.h"
 #include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/Path.h"
@@ -75,6 +79,288 @@
 #include "llvm/Transforms/Utils/Cloning.h"
 #include "llvm/Transforms/Utils/FunctionComparator.h"
 
+/*
+ * the range of a value. first and second are the bounds as doubles, as in the
+ * std::pair this replaces. Integer ranges also keep their bounds as int64_t,
+ * since doubles only hold integers exactly up to 2^53.
+ * */
+typedef struct ValueRange {
+	double	first	      = 0.0;
+	double	second	      = 0.0;
+	bool	isInteger     = false;
+	int64_t integerFirst  = 0;
+	int64_t integerSecond = 0;
+
+	ValueRange() = default;
+
+	ValueRange(double lowerBound, double upperBound)
+	    : first(lowerBound), second(upperBound)
+	{
+	}
+
+	template <typename LowerType, typename UpperType>
+	ValueRange(const std::pair<LowerType, UpperType> & range)
+	    : first(range.first), second(range.second)
+	{
+	}
+
+	static ValueRange
+	integer(int64_t lowerBound, int64_t upperBound)
+	{
+		ValueRange range(static_cast<double>(lowerBound), static_cast<double>(upperBound));
+		range.isInteger	    = true;
+		range.integerFirst  = lowerBound;
+		range.integerSecond = upperBound;
+		return range;
+	}
+
+	operator std::pair<double, double>() const
+	{
+		return std::make_pair(first, second);
+	}
+
+	bool
+	operator==(const ValueRange & other) const
+	{
+		return first == other.first && second == other.second && isInteger == other.isInteger &&
+		       integerFirst == other.integerFirst && integerSecond == other.integerSecond;
+	}
+
+	bool
+	operator!=(const ValueRange & other) const
+	{
+		return !(*this == other);
+	}
+} ValueRange;
+
+/*
+ * the ranges of a BoundInfo in a flat vector, in place of a std::map walked on
+ * every lookup. A value gets its slot the first time it is seen, and
+ * numberFunction() hands out the slots of the arguments and instructions of a
+ * function in order before it is analyzed, so the values of a function are
+ * numbered densely. Erasing a range empties its slot and keeps the number.
+ * The interface is the part of std::map the passes use: emplace() does not
+ * replace a range already there, and iterators stay valid while ranges are added.
+ * */
+class ValueRangeTable {
+public:
+	typedef std::pair<llvm::Value *, ValueRange> value_type;
+
+	template <typename TableType, typename SlotType>
+	class SlotIterator {
+	public:
+		SlotIterator(TableType * table, size_t slot)
+		    : table(table), slot(slot)
+		{
+			skipEmptySlots();
+		}
+
+		template <typename OtherTableType, typename OtherSlotType>
+		SlotIterator(const SlotIterator<OtherTableType, OtherSlotType> & other)
+		    : table(other.table), slot(other.slot)
+		{
+		}
+
+		SlotType &
+		operator*() const
+		{
+			return table->slots[slot];
+		}
+
+		SlotType *
+		operator->() const
+		{
+			return &table->slots[slot];
+		}
+
+		SlotIterator &
+		operator++()
+		{
+			slot++;
+			skipEmptySlots();
+			return *this;
+		}
+
+		bool
+		operator==(const SlotIterator & other) const
+		{
+			return slot == other.slot;
+		}
+
+		bool
+		operator!=(const SlotIterator & other) const
+		{
+			return slot != other.slot;
+		}
+
+	private:
+		template <typename, typename>
+		friend class SlotIterator;
+		friend class ValueRangeTable;
+
+		void
+		skipEmptySlots()
+		{
+			while (slot < table->slots.size() && table->slots[slot].first == nullptr)
+			{
+				slot++;
+			}
+		}
+
+		TableType * table;
+		size_t	    slot;
+	};
+
+	typedef SlotIterator<ValueRangeTable, value_type>		  iterator;
+	typedef SlotIterator<const ValueRangeTable, const value_type> const_iterator;
+
+	iterator
+	begin()
+	{
+		return iterator(this, 0);
+	}
+
+	iterator
+	end()
+	{
+		return iterator(this, slots.size());
+	}
+
+	const_iterator
+	begin() const
+	{
+		return const_iterator(this, 0);
+	}
+
+	const_iterator
+	end() const
+	{
+		return const_iterator(this, slots.size());
+	}
+
+	size_t
+	size() const
+	{
+		return rangeCount;
+	}
+
+	bool
+	empty() const
+	{
+		return rangeCount == 0;
+	}
+
+	iterator
+	find(const llvm::Value * value)
+	{
+		auto slotIt = slotNumbers.find(value);
+		if (slotIt == slotNumbers.end() || slots[slotIt->second].first == nullptr)
+		{
+			return end();
+		}
+		return iterator(this, slotIt->second);
+	}
+
+	const_iterator
+	find(const llvm::Value * value) const
+	{
+		auto slotIt = slotNumbers.find(value);
+		if (slotIt == slotNumbers.end() || slots[slotIt->second].first == nullptr)
+		{
+			return end();
+		}
+		return const_iterator(this, slotIt->second);
+	}
+
+	size_t
+	count(const llvm::Value * value) const
+	{
+		return find(value) != end() ? 1 : 0;
+	}
+
+	std::pair<iterator, bool>
+	emplace(llvm::Value * value, ValueRange range)
+	{
+		/*
+		 * range is a copy, as it may be a range of this table that
+		 * slotNumber() moves when it grows the slots
+		 * */
+		size_t slot = slotNumber(value);
+		if (slots[slot].first != nullptr)
+		{
+			return std::make_pair(iterator(this, slot), false);
+		}
+		slots[slot] = value_type(value, range);
+		rangeCount++;
+		return std::make_pair(iterator(this, slot), true);
+	}
+
+	template <typename InputIterator>
+	void
+	insert(InputIterator first, InputIterator last)
+	{
+		for (; first != last; ++first)
+		{
+			emplace(first->first, first->second);
+		}
+	}
+
+	ValueRange &
+	operator[](llvm::Value * value)
+	{
+		return emplace(value, ValueRange()).first->second;
+	}
+
+	void
+	erase(iterator position)
+	{
+		slots[position.slot].first = nullptr;
+		rangeCount--;
+	}
+
+	size_t
+	erase(const llvm::Value * value)
+	{
+		auto rangeIt = find(value);
+		if (rangeIt == end())
+		{
+			return 0;
+		}
+		erase(rangeIt);
+		return 1;
+	}
+
+	void
+	numberFunction(llvm::Function & llvmIrFunction)
+	{
+		slots.reserve(slots.size() + llvmIrFunction.arg_size() + llvmIrFunction.getInstructionCount());
+		for (auto & llvmIrArgument : llvmIrFunction.args())
+		{
+			slotNumber(&llvmIrArgument);
+		}
+		for (auto & llvmIrInstruction : llvm::instructions(llvmIrFunction))
+		{
+			slotNumber(&llvmIrInstruction);
+		}
+	}
+
+private:
+	size_t
+	slotNumber(const llvm::Value * value)
+	{
+		auto slotIt = slotNumbers.insert(std::make_pair(value, static_cast<uint32_t>(slots.size())));
+		if (slotIt.second)
+		{
+			slots.emplace_back(nullptr, ValueRange());
+		}
+		return slotIt.first->second;
+	}
+
+	llvm::DenseMap<const llvm::Value *, uint32_t> slotNumbers;
+	std::vector<value_type>			       slots;
+	size_t					       rangeCount = 0;
+};
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -103,16 +389,59 @@ extern "C"
 #include "newton-irPass-estimatorSynthesisBackend.h"
 #include "newton-irPass-invariantSignalAnnotation.h"
 
+struct CalleeSummaries;
+
 typedef struct BoundInfo {
-	std::map<llvm::Value *, std::pair<double, double>> virtualRegisterRange;
-	std::map<std::string, BoundInfo *>		   calleeBound;
-	std::map<std::string, llvm::CallInst *>		   callerMap;
+	ValueRangeTable		virtualRegisterRange;
+	CalleeSummaries *	calleeSummaries = nullptr;
 } BoundInfo;
 
+/*
+ * analyses of callees, shared by the functions analyzed in parallel
+ * and by the estimates of function specialization, keyed by the callee and the bit patterns of its argument ranges.
+ * The report of each analysis is kept with it, so that a caller reusing a summary
+ * prints what it would have printed analyzing the callee itself.
+ * */
+typedef struct CalleeSummary {
+	BoundInfo *					    boundInfo;
+	std::pair<llvm::Value *, std::pair<double, double>> returnRange;
+	std::string					    info;
+	std::string					    errors;
+} CalleeSummary;
+
+typedef struct CalleeSummaries {
+	std::mutex						   lock;
+	std::map<std::pair<llvm::Function *, std::vector<uint64_t>>, CalleeSummary> summaries;
+	/*
+	 * only with a summary cache, see newton-irPass-LLVMIR-rangeSummaries.cpp
+	 * */
+	std::map<llvm::Function *, uint64_t>			   functionKeys;
+} CalleeSummaries;
+
+/*
+ * the argument key of the analysis of a function on its own, with the globals
+ * but without argument ranges; argument keys of callees come in triples
+ * */
+const std::vector<uint64_t> kRangeSummaryTopLevelKey = {UINT64_MAX};
+
 std::pair<llvm::Value *, std::pair<double, double>>
 rangeAnalysis(State * N, const std::map<std::string, std::pair<double, double>> & typeRange,
 	      const std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange,
-	      BoundInfo * boundInfo, llvm::Function & llvmIrFunction, bool overLoadFunc);
+	      BoundInfo * boundInfo, llvm::Function & llvmIrFunction);
+
+std::pair<llvm::Value *, std::pair<double, double>>
+summarizedCalleeRange(State * N, const std::map<std::string, std::pair<double, double>> & typeRange,
+		      const std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange,
+		      CalleeSummaries * calleeSummaries, BoundInfo *& innerBoundInfo, llvm::Function & calledFunction);
+
+FlexPrintBuf *
+rangeAnalysisPrintBuffer(void);
+
+void
+rangeAnalysisFreePrintBuffer(FlexPrintBuf * printBuffer);
+
+void
+rangeAnalysisReplayReport(State * N, FlexPrintBuf * printBuffer, const char * report);
 
 #ifdef __cplusplus
 } /* extern "C" */
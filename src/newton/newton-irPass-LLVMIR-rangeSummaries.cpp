@@ -0,0 +1,665 @@
+/*
+	Authored 2026. Phillip Stanley-Marbell.
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions
+	are met:
+
+	*	Redistributions of source code must retain the above
+		copyright notice, this list of conditions and the following
+		disclaimer.
+
+	*	Redistributions in binary form must reproduce the above
+		copyright notice, this list of conditions and the following
+		disclaimer in the documentation and/or other materials
+		provided with the distribution.
+
+	*	Neither the name of the author nor the names of its
+		contributors may be used to endorse or promote products
+		derived from this software without specific prior written
+		permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ *	Range summaries kept across runs in the file N->rangeAnalysisCache.
+ *
+ *	A summary is the analysis of one function for one argument key of
+ *	CalleeSummaries. It is filed under a key of the function that covers
+ *	its name, its body (the FunctionComparator hash used by overloadFunc,
+ *	refined by an MD5 of the instructions and their operands, which that
+ *	hash leaves out), the keys of the functions it calls and the sensor
+ *	and global ranges of the run. Changing a function therefore changes
+ *	its key and those of its transitive callers, and only they are
+ *	analyzed again.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "llvm/ADT/SCCIterator.h"
+#include "llvm/Analysis/CallGraph.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include "newton-irPass-LLVMIR-rangeSummaries.h"
+
+using namespace llvm;
+
+extern "C"
+{
+
+static const char *	kRangeSummaryFileHeader = "newton-range-summaries 2 " LLVM_VERSION_STRING;
+
+static uint64_t
+md5Key(StringRef content)
+{
+	MD5		md5;
+	MD5::MD5Result	md5Result;
+	md5.update(content);
+	md5.final(md5Result);
+	return md5Result.low();
+}
+
+static void
+printRangeBits(raw_ostream & stream, double bound)
+{
+	uint64_t	bits;
+	memcpy(&bits, &bound, sizeof(bits));
+	stream << format_hex_no_prefix(bits, 16) << " ";
+}
+
+uint64_t
+rangeSummaryConfigurationKey(const std::map<std::string, std::pair<double, double>> & typeRange,
+			     const std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange,
+			     const BoundInfo * globalBoundInfo)
+{
+	std::string		configuration;
+	raw_string_ostream	configurationStream(configuration);
+	for (const auto & typeRangeIt : typeRange)
+	{
+		configurationStream << "type " << typeRangeIt.first << " ";
+		printRangeBits(configurationStream, typeRangeIt.second.first);
+		printRangeBits(configurationStream, typeRangeIt.second.second);
+	}
+	/*
+	 * both maps are keyed by pointers, so order the globals by name
+	 * */
+	std::map<std::string, std::string> globals;
+	for (const auto & vectorRange : virtualRegisterVectorRange)
+	{
+		std::string		globalRanges;
+		raw_string_ostream	globalStream(globalRanges);
+		for (const auto & range : vectorRange.second)
+		{
+			printRangeBits(globalStream, range.first);
+			printRangeBits(globalStream, range.second);
+		}
+		globals["vector " + vectorRange.first->getName().str()] = globalStream.str();
+	}
+	for (const auto & vrRange : globalBoundInfo->virtualRegisterRange)
+	{
+		std::string		globalRanges;
+		raw_string_ostream	globalStream(globalRanges);
+		printRangeBits(globalStream, vrRange.second.first);
+		printRangeBits(globalStream, vrRange.second.second);
+		/*
+		 * the arguments of specialized functions (see newton-irPass-LLVMIR-specializeByRange.cpp)
+		 * are often unnamed, so they go by their function and position
+		 * */
+		if (auto llvmIrArgument = dyn_cast<Argument>(vrRange.first))
+		{
+			globals["argument " + llvmIrArgument->getParent()->getName().str() + " " +
+				std::to_string(llvmIrArgument->getArgNo())] = globalStream.str();
+			continue;
+		}
+		globals["scalar " + vrRange.first->getName().str()] = globalStream.str();
+	}
+	for (const auto & global : globals)
+	{
+		configurationStream << global.first << " " << global.second;
+	}
+	return md5Key(configurationStream.str());
+}
+
+/*
+ *	What of a function the range analysis depends on, apart from its
+ *	callees: the types and opcodes (as FunctionComparator hashes them),
+ *	but also the constants, the globals and callees by name, the
+ *	predicates, and the debug type names that select sensor ranges.
+ */
+static void
+printFunctionBody(raw_ostream & stream, Function & llvmIrFunction)
+{
+	std::map<const Value *, size_t> localIndex;
+	for (auto & arg : llvmIrFunction.args())
+	{
+		localIndex.emplace(&arg, localIndex.size());
+	}
+	for (auto & llvmIrBasicBlock : llvmIrFunction)
+	{
+		localIndex.emplace(&llvmIrBasicBlock, localIndex.size());
+		for (auto & llvmIrInstruction : llvmIrBasicBlock)
+		{
+			localIndex.emplace(&llvmIrInstruction, localIndex.size());
+		}
+	}
+
+	auto printOperand = [&](const Value * operand) {
+		auto localIt = localIndex.find(operand);
+		if (localIt != localIndex.end())
+		{
+			stream << "%" << localIt->second;
+		}
+		else if (auto global = dyn_cast<GlobalValue>(operand))
+		{
+			stream << "@" << global->getName();
+		}
+		else if (auto constant = dyn_cast<llvm::Constant>(operand))
+		{
+			constant->print(stream);
+		}
+		else
+		{
+			stream << "?";
+		}
+	};
+
+	stream << llvmIrFunction.getName() << " ";
+	llvmIrFunction.getFunctionType()->print(stream);
+	if (DISubprogram * subProgram = llvmIrFunction.getSubprogram())
+	{
+		DITypeRefArray typeArray = subProgram->getType()->getTypeArray();
+		if (typeArray.size() > 0 && typeArray[0] != nullptr)
+		{
+			stream << " returns " << typeArray[0]->getName();
+		}
+	}
+	stream << "\n";
+
+	for (auto & llvmIrBasicBlock : llvmIrFunction)
+	{
+		stream << "%" << localIndex[&llvmIrBasicBlock] << ":\n";
+		for (auto & llvmIrInstruction : llvmIrBasicBlock)
+		{
+			stream << llvmIrInstruction.getOpcodeName() << " ";
+			llvmIrInstruction.getType()->print(stream);
+			if (auto llvmIrCmpInstruction = dyn_cast<CmpInst>(&llvmIrInstruction))
+			{
+				stream << " " << CmpInst::getPredicateName(llvmIrCmpInstruction->getPredicate());
+			}
+			for (const Value * operand : llvmIrInstruction.operands())
+			{
+				stream << " ";
+				if (auto metadata = dyn_cast<MetadataAsValue>(operand))
+				{
+					if (auto variable = dyn_cast<DIVariable>(metadata->getMetadata()))
+					{
+						stream << "!" << variable->getName() << ":" << (variable->getType() ? variable->getType()->getName() : "");
+					}
+					else if (auto valueAsMetadata = dyn_cast<ValueAsMetadata>(metadata->getMetadata()))
+					{
+						stream << "!";
+						printOperand(valueAsMetadata->getValue());
+					}
+					else
+					{
+						stream << "!";
+					}
+				}
+				else
+				{
+					printOperand(operand);
+				}
+			}
+			if (auto llvmIrPhiInstruction = dyn_cast<PHINode>(&llvmIrInstruction))
+			{
+				for (auto incomingBlock : llvmIrPhiInstruction->blocks())
+				{
+					stream << " %" << localIndex[incomingBlock];
+				}
+			}
+			stream << "\n";
+		}
+	}
+}
+
+/*
+ *	Keys of the defined functions, bottom-up over the call graph so the
+ *	keys of the callees are known. The members of a recursive cycle share
+ *	the key of the whole cycle.
+ */
+void
+rangeSummaryKeyFunctions(Module * Mod, uint64_t configurationKey, CalleeSummaries * calleeSummaries)
+{
+	CallGraph callGraph(*Mod);
+	for (auto sccIt = scc_begin(&callGraph); !sccIt.isAtEnd(); ++sccIt)
+	{
+		std::set<Function *>		     sccFunctions;
+		std::map<std::string, std::string>   sccBodies;
+		std::set<uint64_t>		     calleeKeys;
+		for (CallGraphNode * callGraphNode : *sccIt)
+		{
+			Function * llvmIrFunction = callGraphNode->getFunction();
+			if (llvmIrFunction != nullptr && !llvmIrFunction->isDeclaration())
+			{
+				sccFunctions.emplace(llvmIrFunction);
+			}
+		}
+		for (Function * llvmIrFunction : sccFunctions)
+		{
+			std::string	   body;
+			raw_string_ostream bodyStream(body);
+			bodyStream << FunctionComparator::functionHash(*llvmIrFunction) << " ";
+			printFunctionBody(bodyStream, *llvmIrFunction);
+			sccBodies.emplace(llvmIrFunction->getName().str(), bodyStream.str());
+			for (auto & callRecord : *callGraph[llvmIrFunction])
+			{
+				Function * calledFunction = callRecord.second->getFunction();
+				auto	   calleeKeyIt	  = calleeSummaries->functionKeys.find(calledFunction);
+				if (calleeKeyIt != calleeSummaries->functionKeys.end() && sccFunctions.count(calledFunction) == 0)
+				{
+					calleeKeys.emplace(calleeKeyIt->second);
+				}
+			}
+		}
+
+		std::string	   sccContent;
+		raw_string_ostream sccStream(sccContent);
+		sccStream << configurationKey << "\n";
+		for (const auto & sccBody : sccBodies)
+		{
+			sccStream << sccBody.second;
+		}
+		for (uint64_t calleeKey : calleeKeys)
+		{
+			sccStream << "calls " << calleeKey << "\n";
+		}
+		uint64_t sccKey = md5Key(sccStream.str());
+		for (Function * llvmIrFunction : sccFunctions)
+		{
+			calleeSummaries->functionKeys.emplace(llvmIrFunction,
+							       md5Key(std::to_string(sccKey) + " " + llvmIrFunction->getName().str()));
+		}
+	}
+}
+
+static bool
+readRangeBits(StringRef & line, uint64_t & bits)
+{
+	StringRef field;
+	std::tie(field, line) = line.split(' ');
+	return !field.getAsInteger(16, bits);
+}
+
+static bool
+readSummaryValue(StringRef line, RangeSummaryValue & value, std::pair<uint64_t, uint64_t> & range)
+{
+	StringRef kind, index;
+	std::tie(kind, line)  = line.split(' ');
+	std::tie(index, line) = line.split(' ');
+	if (kind.size() != 1 || index.getAsInteger(10, value.index) || !readRangeBits(line, range.first) ||
+	    !readRangeBits(line, range.second))
+	{
+		return false;
+	}
+	value.kind  = kind[0];
+	value.owner = line.str();
+	return true;
+}
+
+/*
+ *	Read N->rangeAnalysisCache on first use. A file that is missing,
+ *	from another version or damaged just leaves the cache empty.
+ */
+RangeSummaryStore *
+rangeSummaryLoad(State * N)
+{
+	if (N->rangeSummaryStore != NULL)
+	{
+		return static_cast<RangeSummaryStore *>(N->rangeSummaryStore);
+	}
+
+	auto store	     = new RangeSummaryStore();
+	N->rangeSummaryStore = store;
+
+	auto fileBuffer = MemoryBuffer::getFile(N->rangeAnalysisCache);
+	if (!fileBuffer)
+	{
+		return store;
+	}
+	StringRef contents = (*fileBuffer)->getBuffer();
+	StringRef line;
+	std::tie(line, contents) = contents.split('\n');
+	if (line != kRangeSummaryFileHeader)
+	{
+		flexprint(N->Fe, N->Fm, N->Fpinfo, "\tRange summaries: ignoring \"%s\" written by another version\n", N->rangeAnalysisCache);
+		return store;
+	}
+
+	while (!contents.empty())
+	{
+		std::tie(line, contents) = contents.split('\n');
+		StringRef		 field;
+		uint64_t		 functionKey, argumentKeySize;
+		std::vector<uint64_t>	 argumentKey;
+		RangeSummaryRecord	 record = {};
+		std::tie(field, line)	= line.split(' ');
+		if (field != "summary" || !readRangeBits(line, functionKey) || !readRangeBits(line, argumentKeySize) ||
+		    argumentKeySize > line.size())
+		{
+			flexprint(N->Fe, N->Fm, N->Fpinfo, "\tRange summaries: \"%s\" is damaged, ignoring the rest of it\n", N->rangeAnalysisCache);
+			break;
+		}
+		argumentKey.resize(argumentKeySize);
+		bool damaged = false;
+		for (auto & argumentKeyElement : argumentKey)
+		{
+			damaged = damaged || !readRangeBits(line, argumentKeyElement);
+		}
+
+		while (!damaged)
+		{
+			std::tie(line, contents) = contents.split('\n');
+			std::tie(field, line)	 = line.split(' ');
+			if (field == "return")
+			{
+				record.hasReturn = true;
+				damaged		 = !readSummaryValue(line, record.returnValue, record.returnRange);
+			}
+			else if (field == "range" || field == "integer")
+			{
+				RangeSummaryRange range;
+				range.isInteger = field == "integer";
+				damaged		= !readSummaryValue(line, range.value, range.bits);
+				record.ranges.emplace_back(range);
+			}
+			else if (field == "info" || field == "errors")
+			{
+				size_t length;
+				damaged = line.getAsInteger(10, length) || length > contents.size();
+				if (!damaged)
+				{
+					(field == "info" ? record.info : record.errors) = contents.substr(0, length).str();
+					contents					= contents.drop_front(length);
+				}
+			}
+			else if (field == "end")
+			{
+				break;
+			}
+			else
+			{
+				damaged = true;
+			}
+		}
+		if (damaged)
+		{
+			flexprint(N->Fe, N->Fm, N->Fpinfo, "\tRange summaries: \"%s\" is damaged, ignoring the rest of it\n", N->rangeAnalysisCache);
+			break;
+		}
+		store->records.emplace(std::make_pair(functionKey, argumentKey), record);
+	}
+
+	return store;
+}
+
+/*
+ *	Hand the summaries of the cache whose functions are unchanged to
+ *	calleeSummaries, with their values resolved in Mod.
+ */
+void
+rangeSummaryRestore(State * N, Module * Mod, CalleeSummaries * calleeSummaries)
+{
+	RangeSummaryStore *				     store = rangeSummaryLoad(N);
+	std::map<uint64_t, Function *>			     keyedFunctions;
+	std::map<Function *, std::vector<Instruction *>>     functionInstructions;
+	for (const auto & functionKey : calleeSummaries->functionKeys)
+	{
+		keyedFunctions.emplace(functionKey.second, functionKey.first);
+	}
+
+	auto resolveValue = [&](const RangeSummaryValue & value) -> Value * {
+		if (value.kind == 'G')
+		{
+			return Mod->getGlobalVariable(value.owner, true);
+		}
+		Function * llvmIrFunction = Mod->getFunction(value.owner);
+		if (llvmIrFunction == nullptr || value.index < 0)
+		{
+			return nullptr;
+		}
+		if (value.kind == 'A')
+		{
+			return static_cast<size_t>(value.index) < llvmIrFunction->arg_size() ? llvmIrFunction->getArg(value.index) : nullptr;
+		}
+		auto & functionBody = functionInstructions[llvmIrFunction];
+		if (functionBody.empty())
+		{
+			for (auto & llvmIrInstruction : instructions(*llvmIrFunction))
+			{
+				functionBody.emplace_back(&llvmIrInstruction);
+			}
+		}
+		return static_cast<size_t>(value.index) < functionBody.size() ? functionBody[value.index] : nullptr;
+	};
+
+	size_t restored = 0;
+	for (auto & recordIt : store->records)
+	{
+		auto keyedFunctionIt = keyedFunctions.find(recordIt.first.first);
+		if (keyedFunctionIt == keyedFunctions.end())
+		{
+			continue;
+		}
+		RangeSummaryRecord & record = recordIt.second;
+		CalleeSummary	     summary;
+		bool		     resolved = true;
+		summary.boundInfo	      = new BoundInfo();
+		summary.returnRange.first     = nullptr;
+		if (record.hasReturn)
+		{
+			summary.returnRange.first = resolveValue(record.returnValue);
+			resolved		  = summary.returnRange.first != nullptr;
+			memcpy(&summary.returnRange.second.first, &record.returnRange.first, sizeof(double));
+			memcpy(&summary.returnRange.second.second, &record.returnRange.second, sizeof(double));
+		}
+		for (const auto & range : record.ranges)
+		{
+			Value * value = resolveValue(range.value);
+			if (value == nullptr)
+			{
+				resolved = false;
+				break;
+			}
+			ValueRange bounds;
+			if (range.isInteger)
+			{
+				bounds = ValueRange::integer(static_cast<int64_t>(range.bits.first), static_cast<int64_t>(range.bits.second));
+			}
+			else
+			{
+				memcpy(&bounds.first, &range.bits.first, sizeof(double));
+				memcpy(&bounds.second, &range.bits.second, sizeof(double));
+			}
+			summary.boundInfo->virtualRegisterRange.emplace(value, bounds);
+		}
+		if (!resolved)
+		{
+			delete summary.boundInfo;
+			continue;
+		}
+		summary.info   = record.info;
+		summary.errors = record.errors;
+		calleeSummaries->summaries.emplace(std::make_pair(keyedFunctionIt->second, recordIt.first.second), summary);
+		record.live = true;
+		restored++;
+	}
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "\tRange summaries: %zu restored from \"%s\"\n", restored, N->rangeAnalysisCache);
+}
+
+static bool
+summaryValue(Value * value, std::map<Function *, std::map<const Instruction *, int64_t>> & instructionIndex,
+	     RangeSummaryValue & summaryValue)
+{
+	if (auto global = dyn_cast<GlobalVariable>(value))
+	{
+		summaryValue = {'G', global->getName().str(), 0};
+		return global->hasName();
+	}
+	if (auto arg = dyn_cast<Argument>(value))
+	{
+		summaryValue = {'A', arg->getParent()->getName().str(), arg->getArgNo()};
+		return arg->getParent()->hasName();
+	}
+	if (auto llvmIrInstruction = dyn_cast<Instruction>(value))
+	{
+		Function * llvmIrFunction = llvmIrInstruction->getFunction();
+		auto &	   indices	  = instructionIndex[llvmIrFunction];
+		if (indices.empty())
+		{
+			for (auto & functionInstruction : instructions(*llvmIrFunction))
+			{
+				indices.emplace(&functionInstruction, indices.size());
+			}
+		}
+		summaryValue = {'I', llvmIrFunction->getName().str(), indices[llvmIrInstruction]};
+		return llvmIrFunction->hasName();
+	}
+	return false;
+}
+
+static void
+printSummaryValue(raw_ostream & stream, const char * field, const RangeSummaryValue & value,
+		  const std::pair<uint64_t, uint64_t> & range)
+{
+	stream << field << " " << value.kind << " " << value.index << " " << format_hex_no_prefix(range.first, 16) << " "
+	       << format_hex_no_prefix(range.second, 16) << " " << value.owner << "\n";
+}
+
+/*
+ *	Add the summaries computed in this run to the cache and write out
+ *	those used or computed by this process, dropping stale ones.
+ *	Summaries with values that cannot be named are not kept.
+ */
+void
+rangeSummaryPersist(State * N, CalleeSummaries * calleeSummaries)
+{
+	RangeSummaryStore *						 store = rangeSummaryLoad(N);
+	std::map<Function *, std::map<const Instruction *, int64_t>>	 instructionIndex;
+	for (const auto & summaryIt : calleeSummaries->summaries)
+	{
+		auto functionKeyIt = calleeSummaries->functionKeys.find(summaryIt.first.first);
+		if (functionKeyIt == calleeSummaries->functionKeys.end())
+		{
+			continue;
+		}
+		auto recordKey = std::make_pair(functionKeyIt->second, summaryIt.first.second);
+		auto recordIt  = store->records.find(recordKey);
+		if (recordIt != store->records.end())
+		{
+			recordIt->second.live = true;
+			continue;
+		}
+
+		const CalleeSummary & summary = summaryIt.second;
+		RangeSummaryRecord    record  = {};
+		bool		      named   = true;
+		record.hasReturn	      = summary.returnRange.first != nullptr;
+		if (record.hasReturn)
+		{
+			named = summaryValue(summary.returnRange.first, instructionIndex, record.returnValue);
+			memcpy(&record.returnRange.first, &summary.returnRange.second.first, sizeof(double));
+			memcpy(&record.returnRange.second, &summary.returnRange.second.second, sizeof(double));
+		}
+		for (const auto & vrRange : summary.boundInfo->virtualRegisterRange)
+		{
+			RangeSummaryRange range;
+			named		= named && summaryValue(vrRange.first, instructionIndex, range.value);
+			range.isInteger = vrRange.second.isInteger;
+			if (range.isInteger)
+			{
+				range.bits = std::make_pair(static_cast<uint64_t>(vrRange.second.integerFirst),
+							    static_cast<uint64_t>(vrRange.second.integerSecond));
+			}
+			else
+			{
+				memcpy(&range.bits.first, &vrRange.second.first, sizeof(double));
+				memcpy(&range.bits.second, &vrRange.second.second, sizeof(double));
+			}
+			record.ranges.emplace_back(range);
+		}
+		if (!named)
+		{
+			continue;
+		}
+		record.info   = summary.info;
+		record.errors = summary.errors;
+		record.live   = true;
+		store->records.emplace(recordKey, record);
+	}
+
+	std::string	cachePath = std::string(N->rangeAnalysisCache) + ".tmp";
+	std::error_code errorCode;
+	raw_fd_ostream	cacheFile(cachePath, errorCode);
+	if (errorCode)
+	{
+		flexprint(N->Fe, N->Fm, N->Fperr, "\tRange summaries: cannot write \"%s\": %s\n", cachePath.c_str(), errorCode.message().c_str());
+		return;
+	}
+	cacheFile << kRangeSummaryFileHeader << "\n";
+	for (const auto & recordIt : store->records)
+	{
+		const RangeSummaryRecord & record = recordIt.second;
+		if (!record.live)
+		{
+			continue;
+		}
+		cacheFile << "summary " << format_hex_no_prefix(recordIt.first.first, 16) << " "
+			  << format_hex_no_prefix(recordIt.first.second.size(), 16);
+		for (uint64_t argumentKeyElement : recordIt.first.second)
+		{
+			cacheFile << " " << format_hex_no_prefix(argumentKeyElement, 16);
+		}
+		cacheFile << "\n";
+		if (record.hasReturn)
+		{
+			printSummaryValue(cacheFile, "return", record.returnValue, record.returnRange);
+		}
+		for (const auto & range : record.ranges)
+		{
+			printSummaryValue(cacheFile, range.isInteger ? "integer" : "range", range.value, range.bits);
+		}
+		cacheFile << "info " << record.info.size() << "\n" << record.info;
+		cacheFile << "errors " << record.errors.size() << "\n" << record.errors;
+		cacheFile << "end\n";
+	}
+	cacheFile.close();
+
+	errorCode = sys::fs::rename(cachePath, N->rangeAnalysisCache);
+	if (errorCode)
+	{
+		flexprint(N->Fe, N->Fm, N->Fperr, "\tRange summaries: cannot write \"%s\": %s\n", N->rangeAnalysisCache, errorCode.message().c_str());
+	}
+}
+
+} /* extern "C" */
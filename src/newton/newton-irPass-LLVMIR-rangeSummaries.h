@@ -0,0 +1,107 @@
+/*
+	Authored 2026. Phillip Stanley-Marbell.
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions
+	are met:
+
+	*	Redistributions of source code must retain the above
+		copyright notice, this list of conditions and the following
+		disclaimer.
+
+	*	Redistributions in binary form must reproduce the above
+		copyright notice, this list of conditions and the following
+		disclaimer in the documentation and/or other materials
+		provided with the distribution.
+
+	*	Neither the name of the author nor the names of its
+		contributors may be used to endorse or promote products
+		derived from this software without specific prior written
+		permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef NEWTON_IR_PASS_LLVM_IR_RANGE_SUMMARIES
+#define NEWTON_IR_PASS_LLVM_IR_RANGE_SUMMARIES
+
+#include "newton-irPass-LLVMIR-rangeAnalysis.h"
+
+extern "C"
+{
+
+/*
+ *	A value of a summary, by the function (or global) it belongs to
+ *	and its position there: 'I' for the index of an instruction in
+ *	the function, 'A' for an argument number, 'G' for a global.
+ */
+typedef struct RangeSummaryValue {
+	char		kind;
+	std::string	owner;
+	int64_t		index;
+} RangeSummaryValue;
+
+/*
+ *	The bit patterns of the bounds of a range, as doubles or, for
+ *	the integer ranges of ValueRange, as int64_t.
+ */
+typedef struct RangeSummaryRange {
+	RangeSummaryValue		value;
+	bool				isInteger;
+	std::pair<uint64_t, uint64_t>	bits;
+} RangeSummaryRange;
+
+typedef struct RangeSummaryRecord {
+	bool				hasReturn;
+	RangeSummaryValue		returnValue;
+	std::pair<uint64_t, uint64_t>	returnRange;
+	std::vector<RangeSummaryRange>	ranges;
+	std::string			info;
+	std::string			errors;
+	bool				live;
+} RangeSummaryRecord;
+
+/*
+ *	The summaries of N->rangeAnalysisCache, keyed by the key of the
+ *	function and the argument key of CalleeSummaries.
+ */
+typedef struct RangeSummaryStore {
+	std::map<std::pair<uint64_t, std::vector<uint64_t>>, RangeSummaryRecord> records;
+} RangeSummaryStore;
+
+uint64_t
+rangeSummaryConfigurationKey(const std::map<std::string, std::pair<double, double>> & typeRange,
+			     const std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange,
+			     const BoundInfo * globalBoundInfo);
+
+/*
+ *	Copies of N made after the first call share the summaries with N.
+ */
+RangeSummaryStore *
+rangeSummaryLoad(State * N);
+
+void
+rangeSummaryKeyFunctions(llvm::Module * Mod, uint64_t configurationKey, CalleeSummaries * calleeSummaries);
+
+void
+rangeSummaryRestore(State * N, llvm::Module * Mod, CalleeSummaries * calleeSummaries);
+
+void
+rangeSummaryPersist(State * N, CalleeSummaries * calleeSummaries);
+
+} /* extern "C" */
+
+#endif /* NEWTON_IR_PASS_LLVM_IR_RANGE_SUMMARIES */
@@ -42,17 +42,6 @@ using namespace llvm;
 extern "C"
 {
 
-enum varType {
-	INT1	= 1,
-	INT8	= 2,
-	INT16	= 3,
-	INT32	= 4,
-	INT64	= 5,
-	FLOAT	= 6,
-	DOUBLE	= 7,
-	UNKNOWN = 8,
-};
-
 varType
 getIntegerTypeEnum(double min, double max, bool signFlag)
 {
@@ -108,1716 +97,806 @@ getFloatingTypeEnum(double min, double max)
 	return finalType;
 }
 
+/*
+ * the type of a value before it was shrunk, and for a GEP its source element type
+ * */
 typedef struct typeInfo {
 	Type * valueType;
 	bool   signFlag;
+	Type * sourceElementType = nullptr;
 } typeInfo;
 
 /*
- * nullptr means cannot do shrinkType
- * else return the shrinkIntType
+ * The values of a dependency link must have the same type, up to pointers and arrays:
+ * the operands and result of an arithmetic instruction, the incoming values and result
+ * of a phi, the address and value of a load or store, and so on. The link is shrunk as
+ * a whole, with casts at its boundary, and rolled back as a whole.
  * */
-typeInfo
-getShrinkIntType(State * N, Value * boundValue, const std::pair<double, double> & boundRange)
-{
-	typeInfo typeInformation;
-	typeInformation.valueType = nullptr;
+typedef struct dependencyLink {
 	/*
-	 * Signed-ness in LLVM is not stored into the integer, it is left to
-	 * interpretation to the instruction that use them.
+	 * the values in program order
 	 * */
-	typeInformation.signFlag = boundRange.first < 0;
-
-	varType finalType = getIntegerTypeEnum(boundRange.first, boundRange.second, typeInformation.signFlag);
+	std::vector<Value *>			     values;
+	/*
+	 * the operands replaced by a cast or a shrunk constant, with the values they had
+	 * */
+	std::vector<std::pair<Use *, Value *>>	     rewrittenOperands;
+	/*
+	 * the loads and stores of the shrunk memory, with their previous alignment
+	 * */
+	std::vector<std::pair<Instruction *, Align>> rewrittenAlignments;
+	size_t					     shrunkValues = 0;
+	size_t					     castCount	  = 0;
+} dependencyLink;
 
-	auto	 previousType = boundValue->getType();
-	auto	 typeId	      = previousType->getTypeID();
-	auto &	 context      = previousType->getContext();
-	unsigned bitWidth;
+/*
+ * disjoint sets of the values of a function, numbered in program order
+ * */
+typedef struct dependencySets {
+	DenseMap<Value *, unsigned> valueIds;
+	std::vector<Value *>	    values;
+	std::vector<unsigned>	    parents;
+	std::vector<unsigned>	    sizes;
+	std::vector<bool>	    linked;
+} dependencySets;
+
+unsigned
+getDependencyId(dependencySets & sets, Value * value)
+{
+	auto idIt = sets.valueIds.find(value);
+	if (idIt != sets.valueIds.end())
+	{
+		return idIt->second;
+	}
+	unsigned id = sets.values.size();
+	sets.valueIds[value] = id;
+	sets.values.emplace_back(value);
+	sets.parents.emplace_back(id);
+	sets.sizes.emplace_back(1);
+	sets.linked.emplace_back(false);
+	return id;
+}
 
-	bool	 isPointer = false;
-	unsigned pointerAddr;
-	if (typeId == Type::PointerTyID)
-	{
-		typeId	    = previousType->getPointerElementType()->getTypeID();
-		bitWidth    = previousType->getPointerElementType()->getIntegerBitWidth();
-		isPointer   = true;
-		pointerAddr = previousType->getPointerAddressSpace();
-	}
-	else
+unsigned
+findDependencyRoot(dependencySets & sets, unsigned id)
+{
+	while (sets.parents[id] != id)
 	{
-		bitWidth = previousType->getIntegerBitWidth();
+		sets.parents[id] = sets.parents[sets.parents[id]];
+		id		 = sets.parents[id];
 	}
-	assert(typeId == Type::IntegerTyID);
+	return id;
+}
 
-	switch (bitWidth)
+void
+unionDependency(dependencySets & sets, unsigned firstId, unsigned secondId)
+{
+	sets.linked[firstId]  = true;
+	sets.linked[secondId] = true;
+	unsigned firstRoot    = findDependencyRoot(sets, firstId);
+	unsigned secondRoot   = findDependencyRoot(sets, secondId);
+	if (firstRoot == secondRoot)
 	{
-		case 64:
-			if (finalType == INT32)
-			{
-				typeInformation.valueType = IntegerType::getInt32Ty(context);
-			}
-		case 32:
-			if (finalType == INT16)
-			{
-				typeInformation.valueType = IntegerType::getInt16Ty(context);
-			}
-		case 16:
-			if (finalType == INT8)
-			{
-				typeInformation.valueType = IntegerType::getInt8Ty(context);
-			}
-		case 8:
-			if (finalType == INT1)
-			{
-				typeInformation.valueType = IntegerType::getInt1Ty(context);
-			}
-			break;
-		default:
-			flexprint(N->Fe, N->Fm, N->Fpinfo,
-				  "\tgetShrinkIntType: Type::Integer, don't support such bit width yet.\n");
+		return;
 	}
-
-	if (typeInformation.valueType != nullptr)
+	if (sets.sizes[firstRoot] < sets.sizes[secondRoot])
 	{
-		typeInformation.valueType = isPointer ? typeInformation.valueType->getPointerTo(pointerAddr) : typeInformation.valueType;
+		std::swap(firstRoot, secondRoot);
 	}
-
-	return typeInformation;
+	sets.parents[secondRoot] = firstRoot;
+	sets.sizes[firstRoot] += sets.sizes[secondRoot];
 }
 
-typeInfo
-getShrinkDoubleType(State * N, Value * boundValue, const std::pair<double, double> & boundRange)
+/*
+ * the operands of an instruction that must have the same type as each other,
+ * and as the result when resultLinked is set
+ * */
+std::vector<unsigned>
+getDependencyOperands(Instruction * inInstruction, bool & resultLinked)
 {
-	typeInfo typeInformation;
-	typeInformation.valueType = nullptr;
-	typeInformation.signFlag  = boundRange.first < 0;
-
-	varType finalType = getFloatingTypeEnum(boundRange.first, boundRange.second);
+	resultLinked = true;
+	switch (inInstruction->getOpcode())
+	{
+		case Instruction::Add:
+		case Instruction::FAdd:
+		case Instruction::Sub:
+		case Instruction::FSub:
+		case Instruction::Mul:
+		case Instruction::FMul:
+		case Instruction::SDiv:
+		case Instruction::FDiv:
+		case Instruction::UDiv:
+		case Instruction::URem:
+		case Instruction::SRem:
+		case Instruction::FRem:
+		case Instruction::Shl:
+		case Instruction::LShr:
+		case Instruction::AShr:
+		case Instruction::And:
+		case Instruction::Or:
+		case Instruction::Xor:
+			return {0, 1};
+		case Instruction::FNeg:
+		case Instruction::Load:
+		case Instruction::GetElementPtr:
+			return {0};
+		case Instruction::PHI:
+		{
+			std::vector<unsigned> operandIds(inInstruction->getNumOperands());
+			std::iota(operandIds.begin(), operandIds.end(), 0);
+			return operandIds;
+		}
+		case Instruction::Select:
+			return {1, 2};
+		case Instruction::Alloca:
+			return {};
+		case Instruction::Store:
+		case Instruction::ICmp:
+		case Instruction::FCmp:
+			resultLinked = false;
+			return {0, 1};
+		default:
+			resultLinked = false;
+			return {};
+	}
+}
 
-	auto   previousType = boundValue->getType();
-	auto   typeId	    = previousType->getTypeID();
-	auto & context	    = previousType->getContext();
+bool
+isDependencyOperand(Instruction * inInstruction, unsigned operandIdx)
+{
+	bool resultLinked;
+	auto operandIds = getDependencyOperands(inInstruction, resultLinked);
+	return std::find(operandIds.begin(), operandIds.end(), operandIdx) != operandIds.end();
+}
 
-	bool	 isPointer = false;
-	unsigned pointerAddr;
-	if (typeId == Type::PointerTyID)
+/*
+ * group the values of a function into dependency links
+ * */
+std::vector<dependencyLink>
+getDependencyLink(State * N, Function & llvmIrFunction)
+{
+	dependencySets sets;
+	for (Argument & llvmIrArgument : llvmIrFunction.args())
 	{
-		typeId	    = previousType->getPointerElementType()->getTypeID();
-		isPointer   = true;
-		pointerAddr = previousType->getPointerAddressSpace();
+		getDependencyId(sets, &llvmIrArgument);
 	}
-	assert(typeId == Type::DoubleTyID);
-
-	if (finalType == FLOAT)
+	for (Instruction & llvmIrInstruction : instructions(llvmIrFunction))
 	{
-		typeInformation.valueType = Type::getFloatTy(context);
+		if (!llvmIrInstruction.getType()->isVoidTy())
+		{
+			getDependencyId(sets, &llvmIrInstruction);
+		}
 	}
-	else
+	for (Instruction & llvmIrInstruction : instructions(llvmIrFunction))
 	{
-		flexprint(N->Fe, N->Fm, N->Fperr, "\tgetShrinkDoubleType: Unsupported type!\n");
+		bool	resultLinked;
+		auto	operandIds = getDependencyOperands(&llvmIrInstruction, resultLinked);
+		Value * anchor	   = resultLinked ? &llvmIrInstruction : nullptr;
+		if (anchor != nullptr)
+		{
+			unsigned anchorId = getDependencyId(sets, anchor);
+			unionDependency(sets, anchorId, anchorId);
+		}
+		for (unsigned operandIdx : operandIds)
+		{
+			Value * operand = llvmIrInstruction.getOperand(operandIdx);
+			/*
+			 * the constants are shared between links, they are shrunk with their users
+			 * */
+			if (!isa<Instruction>(operand) && !isa<Argument>(operand))
+			{
+				continue;
+			}
+			if (anchor == nullptr)
+			{
+				anchor = operand;
+			}
+			unionDependency(sets, getDependencyId(sets, anchor), getDependencyId(sets, operand));
+		}
 	}
 
-	if (typeInformation.valueType != nullptr)
+	std::vector<dependencyLink> dependencyLinks;
+	std::vector<int>	    linkIndex(sets.values.size(), -1);
+	for (unsigned id = 0; id < sets.values.size(); id++)
 	{
-		typeInformation.valueType = isPointer ? typeInformation.valueType->getPointerTo(pointerAddr) : typeInformation.valueType;
+		if (!sets.linked[id])
+		{
+			continue;
+		}
+		unsigned root = findDependencyRoot(sets, id);
+		if (linkIndex[root] == -1)
+		{
+			linkIndex[root] = dependencyLinks.size();
+			dependencyLinks.emplace_back();
+		}
+		dependencyLinks[linkIndex[root]].values.emplace_back(sets.values[id]);
 	}
-
-	return typeInformation;
+	return dependencyLinks;
 }
 
-typeInfo
-getTypeInfo(State * N, Value * inValue,
-	    const std::map<llvm::Value *, std::pair<double, double>> & virtualRegisterRange)
+/*
+ * the scalar type a type is made of with pointers and arrays,
+ * or nullptr for aggregates and vectors
+ * */
+Type *
+getDependencyScalarType(Type * inputType, unsigned & pointerDepth)
 {
-	typeInfo typeInformation;
-	typeInformation.signFlag  = false;
-	typeInformation.valueType = nullptr;
-
-	auto vrRangeIt = virtualRegisterRange.find(inValue);
-	if (vrRangeIt == virtualRegisterRange.end())
+	pointerDepth = 0;
+	while (inputType->isPointerTy() || inputType->isArrayTy())
 	{
-		return typeInformation;
+		if (inputType->isPointerTy())
+		{
+			pointerDepth++;
+			inputType = inputType->getPointerElementType();
+		}
+		else
+		{
+			inputType = inputType->getArrayElementType();
+		}
 	}
-
-	auto inInstType = inValue->getType();
-	inInstType	= inInstType->getTypeID() == Type::PointerTyID ? inInstType->getPointerElementType() : inInstType;
-	switch (inInstType->getTypeID())
+	if (!inputType->isIntegerTy() && !inputType->isFloatingPointTy())
 	{
-		case Type::IntegerTyID:
-			typeInformation = getShrinkIntType(N, inValue, vrRangeIt->second);
-			break;
-		case Type::FloatTyID:
-			break;
-		case Type::DoubleTyID:
-			typeInformation = getShrinkDoubleType(N, inValue, vrRangeIt->second);
-			break;
-		default:
-			break;
+		return nullptr;
 	}
-	return typeInformation;
+	return inputType;
 }
+
 /*
- * extract raw type from pointer or array
+ * inputType with its scalar type replaced by the shrunk one
  * */
 Type *
-getRawType(Type * inputType, std::vector<Value *> indexValue = std::vector<Value *>(),
-	   unsigned * opId = nullptr)
+getShrunkType(Type * inputType, Type * scalarType, Type * shrunkType)
 {
-	if (opId != nullptr)
-	{
-		(*opId)++;
-	}
-	Type * eleType = nullptr;
-	if (inputType->getTypeID() == Type::PointerTyID)
-	{
-		eleType = inputType->getPointerElementType();
-		return getRawType(eleType, indexValue, opId);
-	}
-	else if (inputType->getTypeID() == Type::ArrayTyID)
-	{
-		eleType = inputType->getArrayElementType();
-		return getRawType(eleType, indexValue, opId);
-	}
-	else if (inputType->getTypeID() == Type::StructTyID)
+	if (inputType == scalarType)
 	{
-		/*
-		 * special case:
-		 *  %12 = getelementptr inbounds %struct.sincos_t, %struct.sincos_t* %2, i32 0, i32 6
-		 *
-		 * */
-		auto stType = cast<StructType>(inputType);
-		if (opId == nullptr)
-		{
-			/*
-			 * need further check: this might should be removed.
-			 * */
-			eleType = stType->getContainedType(0);
-		}
-		else
-		{
-			eleType = stType->getTypeAtIndex(indexValue[*opId]);
-		}
-		return getRawType(eleType, indexValue, opId);
+		return shrunkType;
 	}
-	else
+	if (inputType->isPointerTy())
 	{
-		eleType = inputType;
+		return getShrunkType(inputType->getPointerElementType(), scalarType, shrunkType)->getPointerTo(inputType->getPointerAddressSpace());
 	}
-	assert(eleType != nullptr && "get raw type failed or input type is nullptr");
-	return eleType;
+	assert(inputType->isArrayTy() && "only pointers and arrays can be shrunk");
+	return ArrayType::get(getShrunkType(inputType->getArrayElementType(), scalarType, shrunkType), inputType->getArrayNumElements());
 }
 
 /*
- * first > second: greater than 0,
- * first = second: equal to 0,
- * first < second: less than 0,
+ * the instructions whose type is changed with the link
  * */
-int
-compareType(Type * firstType, Type * secondType)
+bool
+isShrinkableInstruction(Value * inValue)
 {
-	auto typeEnumConvert = [&](Type * inputType) -> varType {
-		Type *	 eleType = getRawType(inputType);
-		uint64_t intBitWidth;
-		switch (eleType->getTypeID())
-		{
-			case Type::FloatTyID:
-				return varType::FLOAT;
-			case Type::DoubleTyID:
-				return varType::DOUBLE;
-			case Type::IntegerTyID:
-				intBitWidth = eleType->getIntegerBitWidth();
-				switch (intBitWidth)
-				{
-					case 1:
-						return varType::INT1;
-					case 8:
-						return varType::INT8;
-					case 16:
-						return varType::INT16;
-					case 32:
-						return varType::INT32;
-					case 64:
-						return varType::INT64;
-					default:
-						return varType::UNKNOWN;
-				}
-			default:
-				return varType::UNKNOWN;
-		}
-	};
-	return typeEnumConvert(firstType) - typeEnumConvert(secondType);
+	return isa<BinaryOperator>(inValue) || isa<UnaryOperator>(inValue) || isa<PHINode>(inValue) ||
+	       isa<SelectInst>(inValue) || isa<LoadInst>(inValue) || isa<GetElementPtrInst>(inValue) ||
+	       isa<AllocaInst>(inValue);
 }
 
 /*
- * return the instruction after roll back
+ * the type the link can be shrunk to, or nullptr. The values coming from outside
+ * the link (arguments, calls, casts) keep their type and are cast on the way in,
+ * so the pointers among them pin the link, as do the pointers that escape it.
+ * The integers must fit the signed range of the smaller type, and are
+ * non-negative if an unsigned operation uses them, so that sext and trunc
+ * are exact at the boundary and the operations give the same results.
  * */
-Value *
-rollbackType(State * N, Instruction * inInstruction, unsigned operandIdx, BasicBlock & llvmIrBasicBlock,
-	     std::map<Value *, typeInfo> & typeChangedInst, typeInfo backType = typeInfo())
+Type *
+getDependencyLinkType(State * N, const dependencyLink & depLink, const ValueRangeTable & virtualRegisterRange,
+		      Type *& scalarType, std::vector<Instruction *> & linkUsers)
 {
-	Value * inValue	 = inInstruction->getOperand(operandIdx);
-	Value * newValue = nullptr;
-	if (isa<GetElementPtrInst>(inInstruction) && isa<llvm::Constant>(inValue))
-	{
-		return newValue;
-	}
-	/*
-	 * check if the backType is specified by caller,
-	 *  if so, use the specified backType
-	 *  else, use the original backType
-	 *
-	 * */
-	bool specifiedBackType = true;
-	if (backType.valueType == nullptr)
-	{
-		specifiedBackType = false;
-		auto tcInstIt	  = typeChangedInst.find(inValue);
-		assert(tcInstIt != typeChangedInst.end() &&
-		       "backType is nullptr and cannot find it in typeChangedInst");
-		backType = tcInstIt->second;
-		assert(backType.valueType != nullptr && "backType cannot be nullptr");
-	}
-	if (compareType(backType.valueType, inValue->getType()) == 0)
-	{
-		return newValue;
-	}
+	scalarType = nullptr;
+	linkUsers.clear();
+	std::set<Value *> linkValues(depLink.values.begin(), depLink.values.end());
+	double		  lowerBound = std::numeric_limits<double>::infinity();
+	double		  upperBound = -std::numeric_limits<double>::infinity();
+	bool		  unsignedOperation = false;
+
+	auto joinBound = [&](double low, double high) {
+		lowerBound = std::min(lowerBound, low);
+		upperBound = std::max(upperBound, high);
+	};
+	auto sameScalarType = [&](Type * valueType, unsigned maxPointerDepth) {
+		unsigned pointerDepth;
+		Type *	 valueScalarType = getDependencyScalarType(valueType, pointerDepth);
+		if (valueScalarType == nullptr || pointerDepth > maxPointerDepth)
+		{
+			return false;
+		}
+		if (scalarType == nullptr)
+		{
+			scalarType = valueScalarType;
+		}
+		return valueScalarType == scalarType;
+	};
 
-	if (Instruction * valueInst = llvm::dyn_cast<llvm::Instruction>(inValue))
+	for (Value * value : depLink.values)
 	{
-		std::function<Type *(Value * inValue)> findOriginalType;
-		findOriginalType = [&](Value * inValue) -> Type * {
-			auto tcIt = typeChangedInst.find(inValue);
-			if (tcIt == typeChangedInst.end())
+		if (!sameScalarType(value->getType(), 1))
+		{
+			return nullptr;
+		}
+		bool isPointer = value->getType()->isPointerTy();
+		if (!isShrinkableInstruction(value))
+		{
+			/*
+			 * a value from outside the link, cast to the shrunk type after its definition
+			 * */
+			if (isPointer || (isa<Instruction>(value) && cast<Instruction>(value)->isTerminator()))
 			{
-				return inValue->getType();
+				return nullptr;
 			}
-			else
+		}
+		else
+		{
+			Instruction * valueInst = cast<Instruction>(value);
+			linkUsers.emplace_back(valueInst);
+			if (auto allocaInst = dyn_cast<AllocaInst>(valueInst))
 			{
-				if (Instruction * castValueInst = llvm::dyn_cast<llvm::CastInst>(inValue))
+				if (!sameScalarType(allocaInst->getAllocatedType(), 0))
 				{
-					/*
-					 * castInst
-					 * */
-					return findOriginalType(castValueInst->getOperand(0));
+					return nullptr;
 				}
-				else
+			}
+			else if (auto gepInst = dyn_cast<GetElementPtrInst>(valueInst))
+			{
+				if (!sameScalarType(gepInst->getSourceElementType(), 0))
 				{
-					/*
-					 * constant
-					 * */
-					return tcIt->second.valueType;
+					return nullptr;
 				}
 			}
-		};
-		typeInfo instPrevTypeInfo;
-		instPrevTypeInfo.signFlag  = backType.signFlag;
-		instPrevTypeInfo.valueType = specifiedBackType ? backType.valueType : findOriginalType(valueInst);
-		/*
-		 * store the previous value type
-		 * if it's an instruction that need to roll back, insert a cast
-		 * */
-		if (PHINode * inInstPhi = llvm::dyn_cast<llvm::PHINode>(inInstruction))
+			else if (auto loadInst = dyn_cast<LoadInst>(valueInst))
+			{
+				if (!loadInst->isSimple())
+				{
+					return nullptr;
+				}
+			}
+		}
+		for (Use & valueUse : value->uses())
 		{
-			/*
-			 * if it's a phi node, insert the cast instruction in the incoming basic block
-			 * */
-			auto	    incomingBB = inInstPhi->getIncomingBlock(operandIdx);
-			IRBuilder<> Builder(incomingBB);
-			auto	    terminatorInst = incomingBB->getTerminator();
-			Builder.SetInsertPoint(terminatorInst);
-			if (instPrevTypeInfo.valueType->isIntegerTy())
+			Instruction * userInst = dyn_cast<Instruction>(valueUse.getUser());
+			if (userInst == nullptr || !isDependencyOperand(userInst, valueUse.getOperandNo()))
 			{
-				newValue = Builder.CreateIntCast(valueInst, instPrevTypeInfo.valueType, false);
+				/*
+				 * a pointer used outside the link escapes it, a scalar is cast back
+				 * */
+				if (isPointer)
+				{
+					return nullptr;
+				}
+				continue;
 			}
-			else
+			if (isa<StoreInst>(userInst) || isa<CmpInst>(userInst))
 			{
-				newValue = Builder.CreateFPCast(valueInst, instPrevTypeInfo.valueType);
+				if (auto storeInst = dyn_cast<StoreInst>(userInst))
+				{
+					if (!storeInst->isSimple())
+					{
+						return nullptr;
+					}
+				}
+				if (std::find(linkUsers.begin(), linkUsers.end(), userInst) == linkUsers.end())
+				{
+					linkUsers.emplace_back(userInst);
+				}
 			}
-			inInstruction->setOperand(operandIdx, newValue);
-			typeChangedInst.emplace(newValue, instPrevTypeInfo);
 		}
-		else
+		if (!isPointer)
 		{
-			IRBuilder<> Builder(&llvmIrBasicBlock);
-			Builder.SetInsertPoint(inInstruction);
-			if (instPrevTypeInfo.valueType->isIntegerTy())
-			{
-				newValue = Builder.CreateIntCast(valueInst, instPrevTypeInfo.valueType, false);
-			}
-			else
+			auto vrRangeIt = virtualRegisterRange.find(value);
+			if (vrRangeIt == virtualRegisterRange.end())
 			{
-				newValue = Builder.CreateFPCast(valueInst, instPrevTypeInfo.valueType);
+				return nullptr;
 			}
-			inInstruction->replaceUsesOfWith(valueInst, newValue);
-			typeChangedInst.emplace(newValue, instPrevTypeInfo);
+			joinBound(vrRangeIt->second.first, vrRangeIt->second.second);
 		}
 	}
-	else if (isa<llvm::Constant>(inValue))
+
+	for (Instruction * userInst : linkUsers)
 	{
-		/*
-		 * Store the previous constant type.
-		 * If
-		 * */
-		auto	 tcIt = typeChangedInst.find(inValue);
-		typeInfo constTypeInfo;
-		constTypeInfo.signFlag = backType.signFlag;
-		if (tcIt == typeChangedInst.end())
-		{
-			constTypeInfo.valueType = inValue->getType();
-		}
-		else
+		switch (userInst->getOpcode())
 		{
-			constTypeInfo.valueType = tcIt->second.valueType;
+			case Instruction::UDiv:
+			case Instruction::URem:
+			case Instruction::LShr:
+				unsignedOperation = true;
+				break;
+			case Instruction::ICmp:
+				unsignedOperation |= cast<ICmpInst>(userInst)->isUnsigned();
+				break;
+			default:
+				break;
 		}
-
-		if (ConstantFP * constFp = llvm::dyn_cast<llvm::ConstantFP>(inValue))
+		for (unsigned operandIdx = 0; operandIdx < userInst->getNumOperands(); operandIdx++)
 		{
-			if (inValue->getType()->isFloatTy())
+			Value * operand = userInst->getOperand(operandIdx);
+			if (!isDependencyOperand(userInst, operandIdx) || !isa<llvm::Constant>(operand) || isa<UndefValue>(operand))
+			{
+				continue;
+			}
+			if (auto constInt = dyn_cast<ConstantInt>(operand))
 			{
-				float constValue = constFp->getValueAPF().convertToFloat();
-				newValue	 = ConstantFP::get(backType.valueType, constValue);
+				if (constInt->getBitWidth() > 64)
+				{
+					return nullptr;
+				}
+				joinBound(constInt->getSExtValue(), constInt->getSExtValue());
 			}
-			else if (inValue->getType()->isDoubleTy())
+			else if (auto constFp = dyn_cast<ConstantFP>(operand))
 			{
+				if (!constFp->getType()->isDoubleTy())
+				{
+					return nullptr;
+				}
 				double constValue = constFp->getValueAPF().convertToDouble();
-				newValue	  = ConstantFP::get(backType.valueType, constValue);
+				joinBound(constValue, constValue);
 			}
 			else
 			{
-				assert(false && "unknown floating type");
+				/*
+				 * globals, null and constant expressions keep their type
+				 * */
+				return nullptr;
 			}
-			inInstruction->replaceUsesOfWith(inValue, newValue);
-			typeChangedInst.emplace(newValue, constTypeInfo);
 		}
-		else if (ConstantInt * constInt = llvm::dyn_cast<llvm::ConstantInt>(inValue))
+	}
+	if (scalarType == nullptr || lowerBound > upperBound)
+	{
+		return nullptr;
+	}
+
+	auto & context = scalarType->getContext();
+	if (scalarType->isIntegerTy())
+	{
+		if (unsignedOperation && lowerBound < 0)
 		{
-			if (backType.signFlag)
-			{
-				auto constValue = constInt->getSExtValue();
-				newValue	= ConstantInt::get(backType.valueType, constValue, true);
-			}
-			else
-			{
-				auto constValue = constInt->getZExtValue();
-				newValue	= ConstantInt::get(backType.valueType, constValue, false);
-			}
-			inInstruction->replaceUsesOfWith(inValue, newValue);
-			typeChangedInst.emplace(newValue, constTypeInfo);
+			return nullptr;
 		}
-		else
+		Type * shrunkType = nullptr;
+		switch (getIntegerTypeEnum(lowerBound, upperBound, true))
 		{
-			assert(false && "implement when meet");
+			case INT8:
+				shrunkType = IntegerType::getInt8Ty(context);
+				break;
+			case INT16:
+				shrunkType = IntegerType::getInt16Ty(context);
+				break;
+			case INT32:
+				shrunkType = IntegerType::getInt32Ty(context);
+				break;
+			default:
+				return nullptr;
 		}
+		return shrunkType->getIntegerBitWidth() < scalarType->getIntegerBitWidth() ? shrunkType : nullptr;
+	}
+	if (scalarType->isDoubleTy() && getFloatingTypeEnum(lowerBound, upperBound) == FLOAT)
+	{
+		return Type::getFloatTy(context);
 	}
-	else if (isa<UndefValue>(inValue))
+	return nullptr;
+}
+
+/*
+ * the value cast to destType after its definition
+ * */
+Value *
+createBoundaryCast(Value * inValue, Type * destType, Function & llvmIrFunction)
+{
+	Instruction * insertPoint;
+	if (auto valueInst = dyn_cast<Instruction>(inValue))
 	{
-		// do nothing
+		insertPoint = isa<PHINode>(valueInst) ? valueInst->getParent()->getFirstNonPHI() : valueInst->getNextNode();
 	}
 	else
 	{
-		assert(false);
+		insertPoint = &*llvmIrFunction.getEntryBlock().getFirstInsertionPt();
+	}
+	IRBuilder<> Builder(insertPoint);
+	if (destType->isIntegerTy())
+	{
+		return Builder.CreateIntCast(inValue, destType, true);
 	}
-	return newValue;
+	return Builder.CreateFPCast(inValue, destType);
 }
 
+/*
+ * Shrink the values of a link to the smaller type its ranges fit, e.g.
+ *  %2 = fmul double %0, 5.000000e-01
+ *  %3 = fadd double %2, 1.250000e+00
+ *  ret double %3
+ *  ======================>
+ *  %2 = fptrunc double %0 to float
+ *  %3 = fmul float %2, 5.000000e-01
+ *  %4 = fadd float %3, 1.250000e+00
+ *  %5 = fpext float %4 to double
+ *  ret double %5
+ * The arguments, calls and other values from outside the link are cast once
+ * after their definition, and the shrunk values once where they are used outside it.
+ * */
 bool
-isSignedValue(Value * inValue)
+shrinkDependencyLink(State * N, dependencyLink & depLink, Function & llvmIrFunction,
+		     ValueRangeTable & virtualRegisterRange,
+		     std::map<Value *, typeInfo> & typeChangedInst)
 {
-	bool signFlag = false;
-	if (Instruction * valueInst = llvm::dyn_cast<llvm::Instruction>(inValue))
+	Type *			   scalarType;
+	std::vector<Instruction *> linkUsers;
+	Type *			   shrunkType = getDependencyLinkType(N, depLink, virtualRegisterRange, scalarType, linkUsers);
+	if (shrunkType == nullptr)
 	{
-		signFlag = valueInst->getOpcode() == Instruction::SExt;
+		return false;
 	}
-	return signFlag;
-}
 
-void
-matchPhiOperandType(State * N, Instruction * inInstruction, BasicBlock & llvmIrBasicBlock,
-		    std::map<llvm::Value *, std::pair<double, double>> & virtualRegisterRange,
-		    std::map<Value *, typeInfo> &			 typeChangedInst)
-{
-	std::vector<Value *> operands;
-	for (size_t id = 0; id < inInstruction->getNumOperands(); id++)
+	/*
+	 * mutate the type of the instructions of the link
+	 * */
+	std::set<Value *> shrunkValues;
+	for (Value * value : depLink.values)
 	{
-		operands.emplace_back(inInstruction->getOperand(id));
+		if (!isShrinkableInstruction(value))
+		{
+			continue;
+		}
+		typeInfo instPrevTypeInfo{value->getType(), scalarType->isIntegerTy()};
+		if (auto allocaInst = dyn_cast<AllocaInst>(value))
+		{
+			allocaInst->setAllocatedType(getShrunkType(allocaInst->getAllocatedType(), scalarType, shrunkType));
+		}
+		else if (auto gepInst = dyn_cast<GetElementPtrInst>(value))
+		{
+			instPrevTypeInfo.sourceElementType = gepInst->getSourceElementType();
+			gepInst->setSourceElementType(getShrunkType(gepInst->getSourceElementType(), scalarType, shrunkType));
+			gepInst->setResultElementType(getShrunkType(gepInst->getResultElementType(), scalarType, shrunkType));
+		}
+		value->mutateType(getShrunkType(value->getType(), scalarType, shrunkType));
+		typeChangedInst.emplace(value, instPrevTypeInfo);
+		shrunkValues.emplace(value);
+		depLink.shrunkValues++;
 	}
-	if (std::all_of(operands.begin(), operands.end(), [&](Value * const & v) {
-		    return compareType(v->getType(), operands.front()->getType()) == 0;
-	    }))
-		return;
 
 	/*
-	 * If both are non-constant, roll back
+	 * cast the values from outside the link, and shrink the constants
 	 * */
-	if (std::all_of(operands.begin(), operands.end(), [&](Value * const & v) {
-		    return !isa<llvm::Constant>(v);
-	    }))
+	auto &			  dataLayout = llvmIrFunction.getParent()->getDataLayout();
+	std::map<Value *, Value *> inboundCasts;
+	for (Instruction * userInst : linkUsers)
 	{
-		typeInfo backType;
-		backType.valueType = nullptr;
-		backType.signFlag  = false;
-		bool noPrevType	   = false;
-		for (size_t id = 0; id < operands.size(); id++)
+		for (unsigned operandIdx = 0; operandIdx < userInst->getNumOperands(); operandIdx++)
 		{
-			if (typeChangedInst.find(operands[id]) != typeChangedInst.end())
+			Use &	operandUse = userInst->getOperandUse(operandIdx);
+			Value * operand	   = operandUse.get();
+			if (!isDependencyOperand(userInst, operandIdx) || shrunkValues.count(operand) != 0)
 			{
-				auto newTypeValue = rollbackType(N, inInstruction, id, llvmIrBasicBlock,
-								 typeChangedInst);
-				auto vrIt	  = virtualRegisterRange.find(inInstruction->getOperand(id));
-				if (newTypeValue != nullptr && vrIt != virtualRegisterRange.end())
-				{
-					virtualRegisterRange.emplace(newTypeValue, vrIt->second);
-				}
+				continue;
 			}
-			else
+			Value * newOperand;
+			if (auto constInt = dyn_cast<ConstantInt>(operand))
 			{
-				/*
-				 * if current op didn't have previous type, reset all ops into this type
-				 * */
-				backType.valueType = operands[id]->getType();
-				backType.signFlag  = isSignedValue(operands[id]);
-				noPrevType	   = true;
-				break;
+				newOperand = ConstantInt::get(shrunkType, constInt->getSExtValue(), true);
 			}
-		}
-		if (noPrevType)
-		{
-			assert(backType.valueType != nullptr && "backType is not set");
-			for (size_t id = 0; id < operands.size(); id++)
+			else if (auto constFp = dyn_cast<ConstantFP>(operand))
+			{
+				newOperand = ConstantFP::get(shrunkType, constFp->getValueAPF().convertToDouble());
+			}
+			else if (isa<PoisonValue>(operand))
+			{
+				newOperand = PoisonValue::get(shrunkType);
+			}
+			else if (isa<UndefValue>(operand))
+			{
+				newOperand = UndefValue::get(shrunkType);
+			}
+			else
 			{
-				auto newTypeValue = rollbackType(N, inInstruction, id, llvmIrBasicBlock,
-								 typeChangedInst, backType);
-				auto vrIt	  = virtualRegisterRange.find(inInstruction->getOperand(id));
-				if (newTypeValue != nullptr && vrIt != virtualRegisterRange.end())
+				auto castIt = inboundCasts.find(operand);
+				if (castIt == inboundCasts.end())
 				{
-					virtualRegisterRange.emplace(newTypeValue, vrIt->second);
+					Value * castValue = createBoundaryCast(operand, shrunkType, llvmIrFunction);
+					auto	vrIt	  = virtualRegisterRange.find(operand);
+					if (vrIt != virtualRegisterRange.end())
+					{
+						virtualRegisterRange.emplace(castValue, vrIt->second);
+					}
+					castIt = inboundCasts.emplace(operand, castValue).first;
+					depLink.castCount++;
 				}
+				newOperand = castIt->second;
 			}
+			depLink.rewrittenOperands.emplace_back(&operandUse, operand);
+			operandUse.set(newOperand);
 		}
-	}
-	else
-	{
 		/*
-		 * If one of them is constant, shrink the constant operand
+		 * the elements of the shrunk memory are only aligned to the smaller type
 		 * */
-		auto opIt = std::find_if(operands.begin(), operands.end(), [&](Value * const & v) {
-			return isa<llvm::Constant>(v);
-		});
-		assert(opIt != operands.end() && "didn't find constant operand");
-		Type *	 constantType = (*opIt)->getType();
-		typeInfo backType;
-		backType.valueType = constantType;
-		backType.signFlag  = isSignedValue(*opIt);
-		for (size_t id = 0; id < operands.size(); id++)
+		if (auto loadInst = dyn_cast<LoadInst>(userInst))
 		{
-			auto newTypeValue = rollbackType(N, inInstruction, id, llvmIrBasicBlock,
-							 typeChangedInst, backType);
-			auto vrIt	  = virtualRegisterRange.find(inInstruction->getOperand(id));
-			if (newTypeValue != nullptr && vrIt != virtualRegisterRange.end())
-			{
-				virtualRegisterRange.emplace(newTypeValue, vrIt->second);
-			}
+			depLink.rewrittenAlignments.emplace_back(loadInst, loadInst->getAlign());
+			loadInst->setAlignment(std::min(loadInst->getAlign(), dataLayout.getABITypeAlign(shrunkType)));
+		}
+		else if (auto storeInst = dyn_cast<StoreInst>(userInst))
+		{
+			depLink.rewrittenAlignments.emplace_back(storeInst, storeInst->getAlign());
+			storeInst->setAlignment(std::min(storeInst->getAlign(), dataLayout.getABITypeAlign(shrunkType)));
 		}
 	}
-}
-
-void
-matchOperandType(State * N, Instruction * inInstruction, BasicBlock & llvmIrBasicBlock,
-		 std::map<llvm::Value *, std::pair<double, double>> & virtualRegisterRange,
-		 std::map<Value *, typeInfo> &			      typeChangedInst)
-{
-	auto leftOperand  = inInstruction->getOperand(0);
-	auto rightOperand = inInstruction->getOperand(1);
-	auto leftType	  = leftOperand->getType();
-	auto rightType	  = rightOperand->getType();
-
-	if (compareType(leftType, rightType) == 0)
-		return;
 
 	/*
-	 * aimType: is the 'backType' of 'rollbackType', which means the type that need to change to
-	 * siblingType: is the type of sibling operand
+	 * cast back the shrunk values used outside the link
 	 * */
-	auto changeStoreInstSiblingType = [](Type * aimType, Type * siblingType) {
-		/*
-		 * Special for StoreInst, the leftOperand doesn't have '*' but the rightOperand have.
-		 * e.g. store i32 %45, i32* %47
-		 * */
-		Type * retType = nullptr;
-		if (aimType->getTypeID() != Type::PointerTyID)
+	for (Value * value : depLink.values)
+	{
+		if (shrunkValues.count(value) == 0)
 		{
-			unsigned pointerAddr = siblingType->getPointerAddressSpace();
-			retType		     = aimType->getPointerTo(pointerAddr);
+			continue;
 		}
-		else if (aimType->getTypeID() == Type::PointerTyID)
+		std::vector<Use *> outboundUses;
+		for (Use & valueUse : value->uses())
 		{
-			retType = aimType->getPointerElementType();
+			Instruction * userInst = cast<Instruction>(valueUse.getUser());
+			if (!isDependencyOperand(userInst, valueUse.getOperandNo()))
+			{
+				outboundUses.emplace_back(&valueUse);
+			}
 		}
-		else
+		if (outboundUses.empty())
 		{
-			assert(false && "what happened in matchOperandType?");
+			continue;
 		}
-		return retType;
-	};
-	/*
-	 * If both are non-constant, roll back
-	 * */
-	if (!isa<llvm::Constant>(leftOperand) && !isa<llvm::Constant>(rightOperand))
-	{
-		if (isa<StoreInst>(inInstruction) && isa<Argument>(leftOperand))
+		Value * castValue = createBoundaryCast(value, typeChangedInst[value].valueType, llvmIrFunction);
+		auto	vrIt	  = virtualRegisterRange.find(value);
+		if (vrIt != virtualRegisterRange.end())
 		{
-			/*
-			 * Don't change the type of argument
-			 * */
-			unsigned    pointerAddr = rightType->getPointerAddressSpace();
-			IRBuilder<> Builder(&llvmIrBasicBlock);
-			Builder.SetInsertPoint(inInstruction);
-			Value * castInstValue = Builder.CreateBitCast(rightOperand, leftType->getPointerTo(pointerAddr));
-			auto	allocaValue   = rightOperand;
-			rightOperand->replaceAllUsesWith(castInstValue);
-			auto castInst = llvm::dyn_cast<llvm::Instruction>(castInstValue);
-			castInst->replaceUsesOfWith(castInst->getOperand(0), allocaValue);
-			auto vrIt = virtualRegisterRange.find(allocaValue);
-			if (castInstValue != nullptr && vrIt != virtualRegisterRange.end())
-			{
-				virtualRegisterRange.emplace(castInstValue, vrIt->second);
-			}
-			return;
-		}
-
-		typeInfo realLeftType  = getTypeInfo(N, leftOperand, virtualRegisterRange);
-		typeInfo realRightType = getTypeInfo(N, rightOperand, virtualRegisterRange);
-		typeInfo backType{nullptr, false};
-		if (compareType(leftType, rightType) < 0)
-		{
-			backType.signFlag  = realLeftType.signFlag;
-			backType.valueType = rightType;
-			if (isa<StoreInst>(inInstruction))
-			{
-				backType.valueType = changeStoreInstSiblingType(backType.valueType, leftType);
-			}
-			auto newTypeValue = rollbackType(N, inInstruction, 0, llvmIrBasicBlock, typeChangedInst, backType);
-			auto vrIt	  = virtualRegisterRange.find(inInstruction->getOperand(0));
-			if (newTypeValue != nullptr && vrIt != virtualRegisterRange.end())
-			{
-				virtualRegisterRange.emplace(newTypeValue, vrIt->second);
-			}
-		}
-		else if (compareType(leftType, rightType) > 0)
-		{
-			backType.signFlag  = realRightType.signFlag;
-			backType.valueType = leftType;
-			if (isa<StoreInst>(inInstruction))
-			{
-				backType.valueType = changeStoreInstSiblingType(backType.valueType, rightType);
-			}
-			auto newTypeValue = rollbackType(N, inInstruction, 1, llvmIrBasicBlock, typeChangedInst, backType);
-			auto vrIt	  = virtualRegisterRange.find(inInstruction->getOperand(1));
-			if (newTypeValue != nullptr && vrIt != virtualRegisterRange.end())
-			{
-				virtualRegisterRange.emplace(newTypeValue, vrIt->second);
-			}
-		}
-		return;
-	}
-
-	/*
-	 * If one of them is constant, shrink the constant operand
-	 * */
-	auto rollBackConstantOperand = [N, inInstruction, &llvmIrBasicBlock,
-					&virtualRegisterRange, &typeChangedInst,
-					changeStoreInstSiblingType](unsigned constOperandIdx, unsigned nonConstOperandIdx) {
-		Value * constOperand	= inInstruction->getOperand(constOperandIdx);
-		Value * nonConstOperand = inInstruction->getOperand(nonConstOperandIdx);
-		auto	constType	= constOperand->getType();
-		auto	nonConstType	= nonConstOperand->getType();
-		if (!isa<llvm::ConstantData>(constOperand))
-		{
-			/*
-			 * rollback the non-constant operand
-			 *
-			 * */
-			typeInfo backType;
-			backType.valueType = constType;
-			backType.signFlag  = false;
-			if (isa<StoreInst>(inInstruction))
-			{
-				backType.valueType = changeStoreInstSiblingType(backType.valueType, nonConstType);
-			}
-			auto newTypeValue = rollbackType(N, inInstruction, nonConstOperandIdx, llvmIrBasicBlock,
-							 typeChangedInst, backType);
-			auto vrIt	  = virtualRegisterRange.find(inInstruction->getOperand(nonConstOperandIdx));
-			if (newTypeValue != nullptr && vrIt != virtualRegisterRange.end())
-			{
-				virtualRegisterRange.emplace(newTypeValue, vrIt->second);
-			}
-			return;
-		}
-
-		if (ConstantFP * constFp = llvm::dyn_cast<llvm::ConstantFP>(constOperand))
-		{
-			double constValue;
-			if (constFp->getType()->isFloatTy())
-			{
-				constValue = constFp->getValueAPF().convertToFloat();
-			}
-			else if (constFp->getType()->isDoubleTy())
-			{
-				constValue = constFp->getValueAPF().convertToDouble();
-			}
-			else
-			{
-				assert(false && "unknown floating type");
-			}
-			std::map<Value *, std::pair<double, double>> constOperandRange =
-			    {{constOperand, std::make_pair(constValue, constValue)}};
-			typeInfo realType = getTypeInfo(N, constOperand, constOperandRange);
-			if ((realType.valueType != nullptr) &&
-			    (compareType(realType.valueType, nonConstType) <= 0))
-			{
-				typeInfo backType;
-				backType.valueType = nonConstType;
-				backType.signFlag  = realType.signFlag;
-				if (isa<StoreInst>(inInstruction))
-				{
-					backType.valueType = changeStoreInstSiblingType(backType.valueType, constType);
-				}
-				auto newTypeValue = rollbackType(N, inInstruction, constOperandIdx, llvmIrBasicBlock,
-								 typeChangedInst, backType);
-				auto vrIt	  = virtualRegisterRange.find(inInstruction->getOperand(constOperandIdx));
-				if (newTypeValue != nullptr && vrIt != virtualRegisterRange.end())
-				{
-					virtualRegisterRange.emplace(newTypeValue, vrIt->second);
-				}
-			}
-			else
-			{
-				typeInfo backType;
-				backType.valueType = constType;
-				backType.signFlag  = false;
-				if (isa<StoreInst>(inInstruction))
-				{
-					backType.valueType = changeStoreInstSiblingType(backType.valueType, nonConstType);
-				}
-				auto newTypeValue = rollbackType(N, inInstruction, nonConstOperandIdx, llvmIrBasicBlock,
-								 typeChangedInst, backType);
-				auto vrIt	  = virtualRegisterRange.find(inInstruction->getOperand(nonConstOperandIdx));
-				if (newTypeValue != nullptr && vrIt != virtualRegisterRange.end())
-				{
-					virtualRegisterRange.emplace(newTypeValue, vrIt->second);
-				}
-			}
+			virtualRegisterRange.emplace(castValue, vrIt->second);
 		}
-		else if (ConstantInt * constInt = llvm::dyn_cast<llvm::ConstantInt>(constOperand))
+		for (Use * outboundUse : outboundUses)
 		{
-			std::map<Value *, std::pair<double, double>> constOperandRange;
-			auto					     constValue = constInt->getSExtValue();
-			constOperandRange					= {{constOperand, std::make_pair(constValue, constValue)}};
-			typeInfo realType					= getTypeInfo(N, constOperand, constOperandRange);
-			if ((realType.valueType != nullptr) &&
-			    (compareType(realType.valueType, nonConstType) <= 0))
-			{
-				typeInfo backType;
-				backType.valueType = nonConstType;
-				backType.signFlag  = realType.signFlag;
-				if (isa<StoreInst>(inInstruction))
-				{
-					backType.valueType = changeStoreInstSiblingType(backType.valueType, constType);
-				}
-				auto newTypeValue = rollbackType(N, inInstruction, constOperandIdx, llvmIrBasicBlock,
-								 typeChangedInst, backType);
-				auto vrIt	  = virtualRegisterRange.find(inInstruction->getOperand(constOperandIdx));
-				if (newTypeValue != nullptr && vrIt != virtualRegisterRange.end())
-				{
-					virtualRegisterRange.emplace(newTypeValue, vrIt->second);
-				}
-			}
-			else
-			{
-				typeInfo backType;
-				backType.valueType = constType;
-				// todo: get the signFlag
-				backType.signFlag = false;
-				if (isa<StoreInst>(inInstruction))
-				{
-					backType.valueType = changeStoreInstSiblingType(backType.valueType, nonConstType);
-				}
-				auto newTypeValue = rollbackType(N, inInstruction, nonConstOperandIdx, llvmIrBasicBlock,
-								 typeChangedInst, backType);
-				auto vrIt	  = virtualRegisterRange.find(inInstruction->getOperand(nonConstOperandIdx));
-				if (newTypeValue != nullptr && vrIt != virtualRegisterRange.end())
-				{
-					virtualRegisterRange.emplace(newTypeValue, vrIt->second);
-				}
-			}
-		}
-		else
-		{
-			assert(false && "implement when meet");
+			depLink.rewrittenOperands.emplace_back(outboundUse, value);
+			outboundUse->set(castValue);
 		}
-	};
-	if (isa<llvm::Constant>(leftOperand))
-	{
-		/*
-		 * leftOperand is constant, rightOperand is non-constant
-		 * */
-		rollBackConstantOperand(0, 1);
-	}
-	else if (isa<llvm::Constant>(rightOperand))
-	{
-		/*
-		 * rightOperand is constant, leftOperand is non-constant
-		 * */
-		rollBackConstantOperand(1, 0);
+		depLink.castCount++;
 	}
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "\tshrinkType: %zu values shrunk with %zu casts.\n",
+		  depLink.shrunkValues, depLink.castCount);
+	return true;
 }
 
 /*
- * There are only two place have "mutateType":
- * 1. Mutate operand constant.
- *    The constant operand type might be changed for several time by different reasons.
- *    So it should always store the original type.
- * 2. Mutate destination type of each instruction.
- *    The destInst type can only be changed once, so we have an assert to check it.
+ * Keep the links that shrink more values than they need casts at their boundary.
+ * When the two are even, keep those computing with floating-point constants,
+ * which the smaller type makes cheaper.
  * */
-/*
- * if dest type cannot change, roll back operands type
- * if dest type can change and its real type <= operands type, mutate dest type to operand type
- * else roll back operand type to real type of dest and mutate dest type to real type
- * */
-void
-matchDestType(State * N, Instruction * inInstruction, BasicBlock & llvmIrBasicBlock,
-	      std::map<llvm::Value *, std::pair<double, double>> & virtualRegisterRange,
-	      std::map<Value *, typeInfo> &			   typeChangedInst)
+bool
+rollBackStrategy(State * N, const dependencyLink & depLink)
 {
-	typeInfo typeInformation;
-	typeInformation.valueType = nullptr;
-	typeInformation.signFlag  = false;
-	auto inInstType		  = inInstruction->getType();
-	auto srcOperand		  = inInstruction->getOperand(0);
-	auto srcType		  = srcOperand->getType();
-	if (isa<GetElementPtrInst>(inInstruction))
+	if (depLink.shrunkValues != depLink.castCount)
 	{
-		unsigned ptAddressSpace = srcType->getPointerAddressSpace();
-		srcType			= srcType->getPointerElementType();
-		std::vector<Value *> indexValue;
-		for (size_t idx = 0; idx < inInstruction->getNumOperands() - 1; idx++)
-		{
-			indexValue.emplace_back(inInstruction->getOperand(idx));
-		}
-		unsigned opId = 0;
-		srcType	      = getRawType(srcType, indexValue, &opId);
-		srcType	      = srcType->getPointerTo(ptAddressSpace);
+		return depLink.castCount > depLink.shrunkValues;
 	}
-
-	/*
-	 * if operand type < dest type
-	 * Now the type of inInstruction hasn't changed, so we check if it can be further changed (has range information).
-	 * If not, roll back all operands
-	 * */
-	assert(compareType(srcType, inInstType) <= 0 && "srcType must <= inInstType");
-	typeInformation = getTypeInfo(N, inInstruction, virtualRegisterRange);
-	if (typeInformation.valueType == nullptr)
+	for (const auto & rewrittenOperand : depLink.rewrittenOperands)
 	{
-		if (compareType(srcType, inInstType) != 0)
+		if (isa<ConstantFP>(rewrittenOperand.second))
 		{
-			typeInfo backType;
-			backType.signFlag  = isSignedValue(inInstruction);
-			backType.valueType = inInstType;
-			for (size_t id = 0; id < inInstruction->getNumOperands(); id++)
-			{
-				auto newTypeValue = rollbackType(N, inInstruction, id, llvmIrBasicBlock, typeChangedInst, backType);
-				auto vrIt	  = virtualRegisterRange.find(inInstruction->getOperand(id));
-				if (newTypeValue != nullptr && vrIt != virtualRegisterRange.end())
-				{
-					virtualRegisterRange.emplace(newTypeValue, vrIt->second);
-				}
-			}
+			return false;
 		}
-		return;
 	}
-
-	if (compareType(typeInformation.valueType, srcType) <= 0)
-	{
-		if (compareType(inInstType, srcType) == 0)
-		{
-			/*
-			 * leave to shrinkInstructionType
-			 * */
-			return;
-		}
-		/*
-		 * mutate dest type to srcType
-		 * */
-		Type * tmpType = nullptr;
-		if (isa<LoadInst>(inInstruction) && (srcType->getTypeID() == Type::PointerTyID))
-		{
-			tmpType = srcType->getPointerElementType();
-		}
-		else
-		{
-			tmpType = srcType;
-		}
-		typeInfo instPrevTypeInfo{inInstruction->getType(), typeInformation.signFlag};
-		assert(typeChangedInst.find(inInstruction) == typeChangedInst.end() && "destInst can only be mutated once");
-		inInstruction->mutateType(tmpType);
-		if (auto gepInst = dyn_cast<GetElementPtrInst>(inInstruction))
-		{
-			gepInst->setSourceElementType(srcType->getPointerElementType());
-			gepInst->setResultElementType(srcType->getPointerElementType());
-		}
-		typeChangedInst.emplace(inInstruction, instPrevTypeInfo);
-	}
-	else
-	{
-		/*
-		 * roll back operands to typeInformation.valueType
-		 * */
-		for (size_t id = 0; id < inInstruction->getNumOperands(); id++)
-		{
-			typeInfo operandPrevTypeInfo{typeInformation.valueType,
-						     isSignedValue(inInstruction->getOperand(id))};
-			auto	 newTypeValue = rollbackType(N, inInstruction, id, llvmIrBasicBlock, typeChangedInst,
-							     operandPrevTypeInfo);
-			auto	 vrIt	      = virtualRegisterRange.find(inInstruction->getOperand(id));
-			if (newTypeValue != nullptr && vrIt != virtualRegisterRange.end())
-			{
-				virtualRegisterRange.emplace(newTypeValue, vrIt->second);
-			}
-		}
-		/*
-		 * mutate dest to typeInformation.valueType
-		 * */
-		if (isa<LoadInst>(inInstruction) && (typeInformation.valueType->getTypeID() == Type::PointerTyID))
-		{
-			typeInformation.valueType = typeInformation.valueType->getPointerElementType();
-		}
-		typeInfo instPrevTypeInfo{inInstruction->getType(), typeInformation.signFlag};
-		assert(typeChangedInst.find(inInstruction) == typeChangedInst.end() && "destInst can only be mutated once");
-		inInstruction->mutateType(typeInformation.valueType);
-		if (auto gepInst = dyn_cast<GetElementPtrInst>(inInstruction))
-		{
-			gepInst->setSourceElementType(typeInformation.valueType->getPointerElementType());
-			gepInst->setResultElementType(typeInformation.valueType->getPointerElementType());
-		}
-		typeChangedInst.emplace(inInstruction, instPrevTypeInfo);
-	}
-	return;
+	return true;
 }
 
-bool
-shrinkStrategy(State * N, Instruction * inInstruction)
+/*
+ * Give the values of a link back their types first, so that the operands
+ * restored next have the types their users expect again.
+ * */
+void
+rollBackDependencyLink(State * N, dependencyLink & depLink,
+		       ValueRangeTable & virtualRegisterRange,
+		       std::map<Value *, typeInfo> & typeChangedInst)
 {
-	/*
-	 * first strategy:
-	 *  check its user is a compute instruction and its sibling is a constant, then shrink its type
-	 * */
-	for (auto * user : inInstruction->users())
+	for (Value * value : depLink.values)
 	{
-		auto * instUser = dyn_cast<Instruction>(user);
-		if (!instUser)
-			continue;
-		if (!isa<BinaryOperator>(instUser))
-			continue;
-		for (size_t idx = 0; idx < instUser->getNumOperands(); idx++)
+		auto tcInstIt = typeChangedInst.find(value);
+		if (tcInstIt == typeChangedInst.end())
 		{
-			if (isa<llvm::ConstantFP>(instUser->getOperand(idx)))
-				return true;
+			continue;
 		}
-	}
-	return false;
-}
-
-bool
-shrinkInstructionType(State * N, Instruction * inInstruction, BasicBlock & llvmIrBasicBlock,
-		      std::map<llvm::Value *, std::pair<double, double>> & virtualRegisterRange,
-		      std::map<Value *, typeInfo> &			   typeChangedInst)
-{
-	bool	 changed	 = false;
-	typeInfo typeInformation = getTypeInfo(N, inInstruction, virtualRegisterRange);
-	if (typeInformation.valueType == nullptr)
-		return changed;
-
-	if (isa<LoadInst>(inInstruction) && (typeInformation.valueType->getTypeID() == Type::PointerTyID))
-	{
-		typeInformation.valueType = typeInformation.valueType->getPointerElementType();
-	}
-
-	changed			= true;
-	auto	      valueType = inInstruction->getType();
-	IRBuilder<>   Builder(&llvmIrBasicBlock);
-	Instruction * insertPoint = inInstruction->getNextNode();
-	while (isa<PHINode>(insertPoint))
-	{
-		insertPoint = insertPoint->getNextNode();
-	}
-	Builder.SetInsertPoint(insertPoint);
-	auto cloneInst = inInstruction->clone();
-	/*
-	 * update the typeChangedInst with cloneInst
-	 * */
-	auto tcIt = typeChangedInst.find(inInstruction);
-	if (tcIt != typeChangedInst.end())
-	{
-		typeChangedInst.emplace(cloneInst, tcIt->second);
-	}
-	Value * castInst;
-	if (typeInformation.valueType->isIntegerTy())
-	{
-		castInst = Builder.CreateIntCast(cloneInst, typeInformation.valueType, typeInformation.signFlag);
-	}
-	else
-	{
-		castInst = Builder.CreateFPCast(cloneInst, typeInformation.valueType);
-	}
-	auto vrIt = virtualRegisterRange.find(inInstruction);
-	if (castInst != nullptr && vrIt != virtualRegisterRange.end())
-	{
-		virtualRegisterRange.emplace(castInst, vrIt->second);
-	}
-	/*
-	 * it must be the first meet inst, so it's safe to RAUW
-	 * */
-	inInstruction->replaceAllUsesWith(castInst);
-	ReplaceInstWithInst(inInstruction, cloneInst);
-	typeInfo instPrevTypeInfo{valueType, typeInformation.signFlag};
-	typeChangedInst.emplace(castInst, instPrevTypeInfo);
-	return changed;
-}
-
-void
-rollBackBasicBlock(State * N, BasicBlock & llvmIrBasicBlock,
-		   std::map<llvm::Value *, std::pair<double, double>> & virtualRegisterRange,
-		   std::map<Value *, typeInfo>				typeChangedInst)
-{
-	for (Instruction & llvmIrInstruction : llvmIrBasicBlock)
-	{
-		/*
-		 * roll back operands
-		 * */
-		for (size_t idx = 0; idx < llvmIrInstruction.getNumOperands(); idx++)
+		value->mutateType(tcInstIt->second.valueType);
+		if (auto allocaInst = dyn_cast<AllocaInst>(value))
 		{
-			auto tcInstIt = typeChangedInst.find(llvmIrInstruction.getOperand(idx));
-			if (tcInstIt != typeChangedInst.end())
-			{
-				auto newTypeValue = rollbackType(N, &llvmIrInstruction, idx, llvmIrBasicBlock,
-								 typeChangedInst);
-				auto vrIt	  = virtualRegisterRange.find(llvmIrInstruction.getOperand(idx));
-				if (newTypeValue != nullptr && vrIt != virtualRegisterRange.end())
-				{
-					virtualRegisterRange.emplace(newTypeValue, vrIt->second);
-				}
-			}
+			allocaInst->setAllocatedType(tcInstIt->second.valueType->getPointerElementType());
 		}
-		/*
-		 * roll back destination
-		 * */
-		auto tcInstIt = typeChangedInst.find(&llvmIrInstruction);
-		if (tcInstIt != typeChangedInst.end())
+		else if (auto gepInst = dyn_cast<GetElementPtrInst>(value))
 		{
-			llvmIrInstruction.mutateType(tcInstIt->second.valueType);
-			if (auto llvmIrAllocaInstruction = dyn_cast<AllocaInst>(&llvmIrInstruction))
-			{
-				llvmIrAllocaInstruction->setAllocatedType(
-				    tcInstIt->second.valueType->getPointerElementType());
-			}
+			gepInst->setSourceElementType(tcInstIt->second.sourceElementType);
+			gepInst->setResultElementType(tcInstIt->second.valueType->getPointerElementType());
 		}
+		typeChangedInst.erase(tcInstIt);
 	}
-}
 
-bool
-rollBackStrategy(State * N, const std::vector<Value *> & depLink)
-{
-	bool willBack = true;
-	for (Value * value : depLink)
+	for (auto rewrittenIt = depLink.rewrittenOperands.rbegin(); rewrittenIt != depLink.rewrittenOperands.rend(); rewrittenIt++)
 	{
-		if (isa<ConstantFP>(value))
+		Value * newOperand = rewrittenIt->first->get();
+		rewrittenIt->first->set(rewrittenIt->second);
+		auto castInst = dyn_cast<CastInst>(newOperand);
+		if (castInst != nullptr && castInst->use_empty())
 		{
-			willBack = false;
-			break;
+			virtualRegisterRange.erase(castInst);
+			castInst->eraseFromParent();
 		}
 	}
-	return willBack;
-}
-
-void
-rollBackDependencyLink(State * N, const std::vector<Value *> & depLink,
-		       std::map<llvm::Value *, std::pair<double, double>> & virtualRegisterRange,
-		       std::map<Value *, typeInfo>			    typeChangedInst)
-{
-	for (Value * value : depLink)
+	for (auto & rewrittenAlignment : depLink.rewrittenAlignments)
 	{
-		if (Instruction * valueInst = dyn_cast<Instruction>(value))
+		if (auto loadInst = dyn_cast<LoadInst>(rewrittenAlignment.first))
 		{
-			/*
-			 * roll back operands
-			 * */
-			for (size_t idx = 0; idx < valueInst->getNumOperands(); idx++)
-			{
-				auto tcInstIt = typeChangedInst.find(valueInst->getOperand(idx));
-				if (tcInstIt != typeChangedInst.end())
-				{
-					auto newTypeValue = rollbackType(N, valueInst, idx, *valueInst->getParent(),
-									 typeChangedInst);
-					auto vrIt	  = virtualRegisterRange.find(valueInst->getOperand(idx));
-					if (newTypeValue != nullptr && vrIt != virtualRegisterRange.end())
-					{
-						virtualRegisterRange.emplace(newTypeValue, vrIt->second);
-					}
-				}
-			}
+			loadInst->setAlignment(rewrittenAlignment.second);
 		}
-		/*
-		 * roll back destination
-		 * */
-		auto tcInstIt = typeChangedInst.find(value);
-		if (tcInstIt != typeChangedInst.end())
+		else
 		{
-			value->mutateType(tcInstIt->second.valueType);
-			if (auto llvmIrAllocaInstruction = dyn_cast<AllocaInst>(value))
-			{
-				llvmIrAllocaInstruction->setAllocatedType(
-				    tcInstIt->second.valueType->getPointerElementType());
-			}
+			cast<StoreInst>(rewrittenAlignment.first)->setAlignment(rewrittenAlignment.second);
 		}
 	}
+	depLink.rewrittenOperands.clear();
+	depLink.rewrittenAlignments.clear();
+	depLink.shrunkValues = 0;
+	depLink.castCount    = 0;
 }
 
 /*
- * Some special instructions that need to pay attention:
- * %i = alloca type, instType is type*
- * %i = call retType @func_name (type %p1, ...)
- * call void @llvm.dbg.declare/value (metadata type %p, ...)
- * %i = load type, type* %op, instType is type
- * %i = gep type, type1* %op1, type2 %op2, (type3 %op3)
- * %i = castInst type1 %op1 to type2
- * store type %op1, type* %op2
- * %.i = phi type [%op1, %bb1], [%op2, %bb2], ...
+ * Merge the redundant cast instructions, prototype:
+ *   %a = ext type1 %x to type2
+ *   %b = trunc type2 %a to type3
+ *   ============>
+ *   %b = castInst type1 %x to type3
+ *
+ * If type1 is equal to type3, %b is replaced by %x. An extension is exact,
+ * so the pair is always the same as the direct cast, unlike a truncation
+ * followed by an extension.
  * */
-std::map<Value *, typeInfo>
-shrinkInstType(State * N, BoundInfo * boundInfo, Function & llvmIrFunction)
-{
-	/*
-	 * <Value to be shrink, old type>
-	 * */
-	std::map<Value *, typeInfo> typeChangedInst;
-	std::vector<AllocaInst *>   allocaVec;
-
-	/*
-	 * Shrink the type of function parameters
-	 * e.g.
-	 *  define i32* @func_name(i32* %0, i32* %1) {
-	 *  ======================>
-	 *  define i32* @func_name(i32* %0, i32* %1) {
-	 *      %2 = bitcast i32* %0 to i8*
-	 *      %3 = bitcast i32* %1 to i8*
-	 * */
-	for (int idx = 0; idx < llvmIrFunction.arg_size(); idx++)
-	{
-		auto	 paramOp	 = llvmIrFunction.getArg(idx);
-		typeInfo typeInformation = getTypeInfo(N, paramOp, boundInfo->virtualRegisterRange);
-		if (typeInformation.valueType != nullptr)
-		{
-			typeInfo    instPrevTypeInfo{paramOp->getType(), typeInformation.signFlag};
-			IRBuilder<> Builder(&llvmIrFunction.getEntryBlock(), llvmIrFunction.getEntryBlock().begin());
-			Value *	    castValue;
-			if (typeInformation.valueType->isIntegerTy())
-			{
-				castValue = Builder.CreateIntCast(paramOp, typeInformation.valueType, typeInformation.signFlag);
-			}
-			else
-			{
-				castValue = Builder.CreateFPCast(paramOp, typeInformation.valueType);
-			}
-			auto vrIt = boundInfo->virtualRegisterRange.find(paramOp);
-			if (castValue != nullptr && vrIt != boundInfo->virtualRegisterRange.end())
-			{
-				boundInfo->virtualRegisterRange.emplace(castValue, vrIt->second);
-			}
-			paramOp->replaceAllUsesWith(castValue);
-			if (auto castInst = dyn_cast<CastInst>(castValue))
-			{
-				castInst->setOperand(0, paramOp);
-			}
-			typeChangedInst.emplace(castValue, instPrevTypeInfo);
-		}
-	}
-	for (BasicBlock & llvmIrBasicBlock : llvmIrFunction)
-	{
-		for (BasicBlock::iterator itBB = llvmIrBasicBlock.begin(); itBB != llvmIrBasicBlock.end();)
-		{
-			Instruction * llvmIrInstruction = &*itBB++;
-			switch (llvmIrInstruction->getOpcode())
-			{
-				case Instruction::Alloca:
-					if (auto llvmIrAllocaInstruction = dyn_cast<AllocaInst>(llvmIrInstruction))
-					{
-						typeInfo realType = getTypeInfo(N, llvmIrAllocaInstruction,
-										boundInfo->virtualRegisterRange);
-						if (realType.valueType != nullptr)
-						{
-							typeInfo instPrevTypeInfo{llvmIrAllocaInstruction->getType(), realType.signFlag};
-							typeChangedInst.emplace(llvmIrAllocaInstruction,
-										instPrevTypeInfo);
-							llvmIrAllocaInstruction->setAllocatedType(
-							    realType.valueType->getPointerElementType());
-							llvmIrAllocaInstruction->mutateType(realType.valueType);
-						}
-					}
-					break;
-				case Instruction::Call:
-					if (auto llvmIrCallInstruction = dyn_cast<CallInst>(llvmIrInstruction))
-					{
-						Function * calledFunction = llvmIrCallInstruction->getCalledFunction();
-						if (calledFunction == nullptr || !calledFunction->hasName() || calledFunction->getName().empty())
-							break;
-						if (!calledFunction->getName().startswith("llvm.dbg.value") &&
-						    !calledFunction->getName().startswith("llvm.dbg.declare") &&
-						    !calledFunction->getName().startswith("llvm.dbg.label"))
-						{
-							/*
-							 * don't change the type of function call's params
-							 * */
-							for (size_t idx = 0; idx < llvmIrCallInstruction->getNumOperands() - 1; idx++)
-							{
-								auto tcInstIt = typeChangedInst.find(llvmIrCallInstruction->getOperand(idx));
-								if (tcInstIt != typeChangedInst.end())
-								{
-									auto newTypeValue = rollbackType(N, llvmIrCallInstruction, idx, llvmIrBasicBlock,
-													 typeChangedInst);
-									auto vrIt	  = boundInfo->virtualRegisterRange.find(llvmIrCallInstruction->getOperand(idx));
-									if (newTypeValue != nullptr && vrIt != boundInfo->virtualRegisterRange.end())
-									{
-										boundInfo->virtualRegisterRange.emplace(newTypeValue, vrIt->second);
-									}
-								}
-							}
-							/*
-							 * shrink the type of callInst result
-							 * */
-							shrinkInstructionType(N, llvmIrInstruction, llvmIrBasicBlock,
-									      boundInfo->virtualRegisterRange,
-									      typeChangedInst);
-						}
-					}
-					break;
-				case Instruction::Add:
-				case Instruction::FAdd:
-				case Instruction::Sub:
-				case Instruction::FSub:
-				case Instruction::Mul:
-				case Instruction::FMul:
-				case Instruction::SDiv:
-				case Instruction::FDiv:
-				case Instruction::UDiv:
-				case Instruction::URem:
-				case Instruction::SRem:
-				case Instruction::FRem:
-				case Instruction::Shl:
-				case Instruction::LShr:
-				case Instruction::AShr:
-				case Instruction::And:
-				case Instruction::Or:
-				case Instruction::Xor:
-					/*
-					 * For binary operator, check if two operands are of the same type
-					 * */
-					matchOperandType(N, llvmIrInstruction, llvmIrBasicBlock,
-							 boundInfo->virtualRegisterRange, typeChangedInst);
-				case Instruction::PHI:
-					if (isa<PHINode>(llvmIrInstruction))
-					{
-						matchPhiOperandType(N, llvmIrInstruction, llvmIrBasicBlock,
-								    boundInfo->virtualRegisterRange, typeChangedInst);
-					}
-				case Instruction::FNeg:
-				case Instruction::Load:
-				case Instruction::GetElementPtr:
-					matchDestType(N, llvmIrInstruction, llvmIrBasicBlock,
-						      boundInfo->virtualRegisterRange, typeChangedInst);
-				case Instruction::FPToUI:
-				case Instruction::FPToSI:
-				case Instruction::SIToFP:
-				case Instruction::UIToFP:
-				case Instruction::ZExt:
-				case Instruction::SExt:
-				case Instruction::FPExt:
-				case Instruction::Trunc:
-				case Instruction::FPTrunc:
-				case Instruction::BitCast:
-					/*
-					 * only shrink the type because the computation of current operation
-					 * */
-					shrinkInstructionType(N, llvmIrInstruction, llvmIrBasicBlock,
-							      boundInfo->virtualRegisterRange,
-							      typeChangedInst);
-					break;
-				/*
-				 * the return type of storeInst is always void
-				 * the return type of cmpInst is always i1
-				 * */
-				case Instruction::Store:
-				case Instruction::ICmp:
-				case Instruction::FCmp:
-					matchOperandType(N, llvmIrInstruction, llvmIrBasicBlock,
-							 boundInfo->virtualRegisterRange, typeChangedInst);
-					break;
-				case Instruction::Ret:
-					if (auto llvmIrReturnInstruction = dyn_cast<ReturnInst>(llvmIrInstruction))
-					{
-						/*
-						 * If the function return type not match, roll back the returnType
-						 * e.g.
-						 *  define i32* @funcName {
-						 *    ...
-						 *    ret i8* %x
-						 *  }
-						 *  ======================>
-						 *  define i32* @funcName {
-						 *    ...
-						 *    %y = bitcast i8* %x to i32*
-						 *    ret i32* %y
-						 *  }
-						 * */
-						auto funcRetType = llvmIrFunction.getReturnType();
-						auto retInstType = llvmIrReturnInstruction->getType();
-						if (compareType(funcRetType, retInstType) != 0)
-						{
-							IRBuilder<> Builder(&llvmIrBasicBlock);
-							Builder.SetInsertPoint(llvmIrReturnInstruction);
-							Value * castInst;
-							auto	retValue = llvmIrReturnInstruction->getReturnValue();
-							assert(retValue != nullptr && "return void");
-							if (funcRetType->isIntegerTy())
-							{
-								castInst = Builder.CreateIntCast(retValue, funcRetType, false);
-							}
-							else
-							{
-								castInst = Builder.CreateFPCast(retValue, funcRetType);
-							}
-							auto vrIt = boundInfo->virtualRegisterRange.find(retValue);
-							if (castInst != nullptr && vrIt != boundInfo->virtualRegisterRange.end())
-							{
-								boundInfo->virtualRegisterRange.emplace(castInst, vrIt->second);
-							}
-							ReturnInst::Create(llvmIrReturnInstruction->getContext(),
-									   castInst,
-									   llvmIrReturnInstruction->getParent());
-							llvmIrReturnInstruction->removeFromParent();
-						}
-					}
-					break;
-				case Instruction::Switch:
-					if (auto llvmIrSwitchInstruction = dyn_cast<SwitchInst>(llvmIrInstruction))
-					{
-						/*
-						 * change the type of label, e.g.
-						 *
-						 * switch i8 %30, label %231 [
-						 *  i8 1, label %213
-						 *  i8 2, label %222
-						 * ]
-						 */
-						auto condType = llvmIrSwitchInstruction->getCondition()->getType();
-						for (auto caseEle : llvmIrSwitchInstruction->cases())
-						{
-							auto	 labelValue = caseEle.getCaseValue();
-							typeInfo constTypeInfo{labelValue->getType(), false};
-							auto	 constLabelValue = dyn_cast<ConstantInt>(labelValue);
-							auto	 constValue	 = constLabelValue->getZExtValue();
-							auto	 newConstant	 = ConstantInt::get(condType, constValue, false);
-							llvmIrSwitchInstruction->replaceUsesOfWith(labelValue, newConstant);
-							typeChangedInst.emplace(newConstant, constTypeInfo);
-						}
-						break;
-					}
-				case Instruction::Br:
-				case Instruction::Select:
-				case Instruction::IndirectBr:
-				case Instruction::Invoke:
-				case Instruction::Resume:
-				case Instruction::Unreachable:
-				case Instruction::CleanupRet:
-				case Instruction::CatchRet:
-				case Instruction::CatchSwitch:
-				case Instruction::CallBr:
-				case Instruction::Fence:
-				case Instruction::AtomicCmpXchg:
-				case Instruction::AtomicRMW:
-				case Instruction::PtrToInt:
-				case Instruction::IntToPtr:
-				case Instruction::AddrSpaceCast:
-				case Instruction::CleanupPad:
-				case Instruction::CatchPad:
-				case Instruction::UserOp1:
-				case Instruction::UserOp2:
-				case Instruction::VAArg:
-				case Instruction::ExtractElement:
-				case Instruction::InsertElement:
-				case Instruction::ShuffleVector:
-				case Instruction::ExtractValue:
-				case Instruction::InsertValue:
-				case Instruction::LandingPad:
-				case Instruction::Freeze:
-					break;
-				default:
-					break;
-			}
-		}
-	}
-	return typeChangedInst;
-}
-
 void
 mergeCast(State * N, Function & llvmIrFunction,
-	  std::map<llvm::Value *, std::pair<double, double>> & virtualRegisterRange,
-	  std::map<Value *, typeInfo> &			       typeChangedInst)
+	  ValueRangeTable & virtualRegisterRange)
 {
-	/*
-	 * Merge the redundant cast instruction, prototype:
-	 *   %a = castInst type1 %x to type2 // sourceInst
-	 *   ... (several instructions that don't contain %a)
-	 *   %b = castInst type2 %a to type3 // destInst
-	 *   %c = someInst %b
-	 *   ============>
-	 *   %a = castInst type1 %x to type3
-	 *
-	 * If type1 is equal to type3, remove these two castInst, prototype:
-	 *   ============>
-	 *   %c = someInst %x
-	 * */
-	std::vector<Value *> sourceInstVec;
 	for (BasicBlock & llvmIrBasicBlock : llvmIrFunction)
 	{
 		for (BasicBlock::iterator itBB = llvmIrBasicBlock.begin(); itBB != llvmIrBasicBlock.end();)
 		{
 			Instruction * llvmIrInstruction = &*itBB++;
-			switch (llvmIrInstruction->getOpcode())
+			if (llvmIrInstruction->getOpcode() != Instruction::Trunc && llvmIrInstruction->getOpcode() != Instruction::FPTrunc)
 			{
-				case Instruction::ZExt:
-				case Instruction::SExt:
-				case Instruction::FPExt:
-				case Instruction::Trunc:
-				case Instruction::FPTrunc:
-				case Instruction::BitCast:
-				{
-					/*
-					 * if the operand(0) is equal to operand(1), remove this inst,
-					 * except array time cast like
-					 * %a = bitcast [100 x i8]* %b to i8*
-					 * */
-					auto sourceOp = llvmIrInstruction->getOperand(0);
-					if (sourceOp->getType() == llvmIrInstruction->getType())
-					{
-						llvmIrInstruction->replaceAllUsesWith(sourceOp);
-						llvmIrInstruction->removeFromParent();
-						break;
-					}
-					auto sourceInst = llvm::dyn_cast<llvm::Instruction>(sourceOp);
-					if (sourceInst != nullptr)
-					{
-						auto siIt = std::find(sourceInstVec.begin(), sourceInstVec.end(), sourceInst);
-						if (siIt != sourceInstVec.end())
-						{
-							/*
-							 * substitute destInst to sourceInst
-							 * */
-							sourceInstVec.erase(siIt);
-							Instruction * sourceOperand = llvm::dyn_cast<llvm::Instruction>(sourceInst->getOperand(0));
-							IRBuilder<>   Builder(&llvmIrBasicBlock);
-							Builder.SetInsertPoint(sourceInst->getNextNode());
-							if (compareType(sourceOperand->getType(), llvmIrInstruction->getType()) == 0)
-							{
-								llvmIrInstruction->replaceAllUsesWith(sourceOperand);
-							}
-							else
-							{
-								/*
-								 * if llvmIrInstruction in typeChangedInst,
-								 * it means llvmIrInstruction is a created castInst.
-								 * */
-								Value * castInst;
-								auto	valueType = llvmIrInstruction->getType();
-								if (valueType->isIntegerTy())
-								{
-									castInst = Builder.CreateIntCast(sourceOperand, valueType,
-													 llvmIrInstruction->getOpcode() == Instruction::SExt);
-								}
-								else
-								{
-									castInst = Builder.CreateFPCast(sourceOperand, valueType);
-								}
-								auto vrIt = virtualRegisterRange.find(sourceOperand);
-								if (castInst != nullptr && vrIt != virtualRegisterRange.end())
-								{
-									virtualRegisterRange.emplace(castInst, vrIt->second);
-								}
-								auto	 tcIt = typeChangedInst.find(sourceInst);
-								typeInfo instPrevTypeInfo;
-								instPrevTypeInfo.signFlag = llvmIrInstruction->getOpcode() == Instruction::SExt;
-								if (tcIt == typeChangedInst.end())
-								{
-									/*
-									 * It's an original castInst
-									 * */
-									instPrevTypeInfo.valueType = sourceInst->getType();
-								}
-								else
-								{
-									instPrevTypeInfo.valueType = tcIt->second.valueType;
-								}
-								typeChangedInst.emplace(castInst, instPrevTypeInfo);
-								Instruction * newCastInst = llvm::dyn_cast<llvm::Instruction>(castInst);
-								llvmIrInstruction->replaceAllUsesWith(newCastInst);
-								sourceInstVec.emplace_back(newCastInst);
-							}
-							sourceInst->removeFromParent();
-							llvmIrInstruction->removeFromParent();
-						}
-						else
-						{
-							sourceInstVec.emplace_back(llvmIrInstruction);
-						}
-					}
-					break;
-				}
-				case Instruction::Call:
-					if (auto llvmIrCallInstruction = dyn_cast<CallInst>(llvmIrInstruction))
-					{
-						Function * calledFunction = llvmIrCallInstruction->getCalledFunction();
-						if (calledFunction == nullptr || !calledFunction->hasName() || calledFunction->getName().empty())
-							break;
-						if (calledFunction->getName().startswith("llvm.dbg.value") ||
-						    calledFunction->getName().startswith("llvm.dbg.declare"))
-						{
-							if (!isa<MetadataAsValue>(llvmIrCallInstruction->getOperand(0)))
-								break;
-							auto firstOperator = cast<MetadataAsValue>(llvmIrCallInstruction->getOperand(0));
-							if (!isa<ValueAsMetadata>(firstOperator->getMetadata()))
-								break;
-							auto localVariableAddressAsMetadata = cast<ValueAsMetadata>(firstOperator->getMetadata());
-							auto localVariableAddress	    = localVariableAddressAsMetadata->getValue();
-							auto siIt			    = std::find(sourceInstVec.begin(), sourceInstVec.end(),
-													localVariableAddress);
-							if (siIt != sourceInstVec.end())
-							{
-								sourceInstVec.erase(siIt);
-							}
-						}
-						else
-						{
-							for (size_t idx = 0; idx < llvmIrCallInstruction->getNumOperands() - 1; idx++)
-							{
-								auto siIt = std::find(sourceInstVec.begin(), sourceInstVec.end(),
-										      llvmIrCallInstruction->getOperand(idx));
-								if (siIt != sourceInstVec.end())
-								{
-									sourceInstVec.erase(siIt);
-								}
-							}
-						}
-						break;
-					}
-				default:
-					for (size_t idx = 0; idx < llvmIrInstruction->getNumOperands(); idx++)
-					{
-						auto siIt = std::find(sourceInstVec.begin(), sourceInstVec.end(),
-								      llvmIrInstruction->getOperand(idx));
-						if (siIt != sourceInstVec.end())
-						{
-							sourceInstVec.erase(siIt);
-						}
-					}
-					break;
+				continue;
 			}
-		}
-	}
-	return;
-}
-
-std::map<uint32_t, uint32_t>
-countCastInst(State * N, Function & llvmIrFunction)
-{
-	std::map<uint32_t, uint32_t> castCountVec{{0, 0}};
-	uint32_t		     bbId = 0;
-	for (BasicBlock & llvmIrBasicBlock : llvmIrFunction)
-	{
-		for (Instruction & llvmIrInstruction : llvmIrBasicBlock)
-		{
-			switch (llvmIrInstruction.getOpcode())
+			auto sourceInst = dyn_cast<CastInst>(llvmIrInstruction->getOperand(0));
+			if (sourceInst == nullptr ||
+			    (sourceInst->getOpcode() != Instruction::SExt && sourceInst->getOpcode() != Instruction::ZExt &&
+			     sourceInst->getOpcode() != Instruction::FPExt))
 			{
-				case Instruction::ZExt:
-				case Instruction::SExt:
-				case Instruction::FPExt:
-				case Instruction::Trunc:
-				case Instruction::FPTrunc:
-				case Instruction::BitCast:
-					castCountVec[bbId]++;
-					break;
-				default:
-					continue;
+				continue;
 			}
-		}
-		bbId++;
-	}
-	return castCountVec;
-}
-
-using dpLink = std::vector<std::vector<Value *>>;
-/*
- * get the index of the node if found, or return "-1"
- * */
-int
-findNode(const dpLink & dependencyLink, Value * node)
-{
-	auto dlIt = std::find_if(dependencyLink.begin(), dependencyLink.end(), [node](const auto & v) {
-		return std::find(v.begin(), v.end(), node) != v.end();
-	});
-	if (dlIt != dependencyLink.end())
-	{
-		return std::distance(dependencyLink.begin(), dlIt);
-	}
-	else
-	{
-		return -1;
-	}
-}
-
-void
-insertLink(dpLink & dependencyLink, Value * aimNode, Value * siblingNode)
-{
-	auto aimPos	= findNode(dependencyLink, aimNode);
-	auto siblingPos = findNode(dependencyLink, siblingNode);
-	if (aimPos != -1)
-	{
-		/*aimNode in dependencyLink*/
-		if (siblingPos != -1)
-		{
-			/*
-			 * sibling is also in dependencyLink, merge them
-			 * */
-			auto newPos    = aimPos < siblingPos ? aimPos : siblingPos;
-			auto deletePos = aimPos > siblingPos ? aimPos : siblingPos;
-			dependencyLink[newPos].insert(dependencyLink[newPos].end(),
-						      dependencyLink[deletePos].begin(),
-						      dependencyLink[deletePos].end());
-			dependencyLink.erase(dependencyLink.begin() + deletePos);
-		}
-		else
-		{
-			/*
-			 * sibling is not in dependencyLink, insert to aimPos
-			 * */
-			dependencyLink[aimPos].emplace_back(siblingNode);
-		}
-	}
-	else
-	{
-		/*aimNode not in dependencyLink*/
-		if (siblingPos == -1)
-		{
-			siblingPos = dependencyLink.capacity();
-			dependencyLink.resize(siblingPos + 1);
-			dependencyLink[siblingPos].emplace_back(siblingNode);
-		}
-		dependencyLink[siblingPos].emplace_back(aimNode);
-	}
-}
-
-std::vector<std::vector<Value *>>
-getDependencyLink(State * N, Function & llvmIrFunction)
-{
-	std::vector<std::vector<Value *>> dependencyLink;
-	for (BasicBlock & llvmIrBasicBlock : llvmIrFunction)
-	{
-		for (Instruction & llvmIrInstruction : llvmIrBasicBlock)
-		{
-			switch (llvmIrInstruction.getOpcode())
+			Value * sourceOperand = sourceInst->getOperand(0);
+			Value * castValue     = sourceOperand;
+			if (sourceOperand->getType() != llvmIrInstruction->getType())
 			{
-				case Instruction::Call:
-					if (auto llvmIrCallInstruction = dyn_cast<CallInst>(&llvmIrInstruction))
-					{
-						Function * calledFunction = llvmIrCallInstruction->getCalledFunction();
-						if (calledFunction == nullptr || !calledFunction->hasName() ||
-						    calledFunction->getName().empty())
-							break;
-						if (!calledFunction->getName().startswith("llvm.dbg.value") &&
-						    !calledFunction->getName().startswith("llvm.dbg.declare") &&
-						    !calledFunction->getName().startswith("llvm.dbg.label"))
-						{
-							for (size_t idx = 1; idx < llvmIrCallInstruction->getNumOperands() - 1; idx++)
-							{
-								insertLink(dependencyLink, llvmIrCallInstruction->getOperand(0),
-									   llvmIrCallInstruction->getOperand(idx));
-							}
-							insertLink(dependencyLink, llvmIrCallInstruction->getOperand(0),
-								   llvmIrCallInstruction);
-						}
-					}
-					break;
-				case Instruction::Add:
-				case Instruction::FAdd:
-				case Instruction::Sub:
-				case Instruction::FSub:
-				case Instruction::Mul:
-				case Instruction::FMul:
-				case Instruction::SDiv:
-				case Instruction::FDiv:
-				case Instruction::UDiv:
-				case Instruction::URem:
-				case Instruction::SRem:
-				case Instruction::FRem:
-				case Instruction::Shl:
-				case Instruction::LShr:
-				case Instruction::AShr:
-				case Instruction::And:
-				case Instruction::Or:
-				case Instruction::Xor:
-					/*match binary operands*/
-					insertLink(dependencyLink, llvmIrInstruction.getOperand(0),
-						   llvmIrInstruction.getOperand(1));
-				case Instruction::PHI:
-					if (isa<PHINode>(llvmIrInstruction))
-					{
-						/*match multi operands*/
-						for (size_t id = 1; id < llvmIrInstruction.getNumOperands(); id++)
-						{
-							insertLink(dependencyLink, llvmIrInstruction.getOperand(0),
-								   llvmIrInstruction.getOperand(id));
-						}
-					}
-				case Instruction::FNeg:
-				case Instruction::Load:
-				case Instruction::GetElementPtr:
-					/*match dest with operands*/
-					insertLink(dependencyLink, llvmIrInstruction.getOperand(0),
-						   &llvmIrInstruction);
-				case Instruction::FPToUI:
-				case Instruction::FPToSI:
-				case Instruction::SIToFP:
-				case Instruction::UIToFP:
-				case Instruction::ZExt:
-				case Instruction::SExt:
-				case Instruction::FPExt:
-				case Instruction::Trunc:
-				case Instruction::FPTrunc:
-				case Instruction::BitCast:
-					/*check dest*/
-					break;
-				case Instruction::Store:
-				case Instruction::ICmp:
-				case Instruction::FCmp:
-					/*match operands*/
-					insertLink(dependencyLink, llvmIrInstruction.getOperand(0),
-						   llvmIrInstruction.getOperand(1));
-				default:
-					continue;
+				IRBuilder<> Builder(llvmIrInstruction);
+				if (llvmIrInstruction->getType()->isIntegerTy())
+				{
+					castValue = Builder.CreateIntCast(sourceOperand, llvmIrInstruction->getType(),
+									  sourceInst->getOpcode() == Instruction::SExt);
+				}
+				else
+				{
+					castValue = Builder.CreateFPCast(sourceOperand, llvmIrInstruction->getType());
+				}
+				auto vrIt = virtualRegisterRange.find(llvmIrInstruction);
+				if (vrIt != virtualRegisterRange.end())
+				{
+					virtualRegisterRange.emplace(castValue, vrIt->second);
+				}
+			}
+			llvmIrInstruction->replaceAllUsesWith(castValue);
+			virtualRegisterRange.erase(llvmIrInstruction);
+			llvmIrInstruction->eraseFromParent();
+			if (sourceInst->use_empty())
+			{
+				virtualRegisterRange.erase(sourceInst);
+				sourceInst->eraseFromParent();
 			}
 		}
 	}
-	return dependencyLink;
 }
 
 void
@@ -1825,21 +904,22 @@ shrinkType(State * N, BoundInfo * boundInfo, Function & llvmIrFunction)
 {
 	/*
 	 * 1. construct instruction dependency link
-	 * 2. work with roll back strategies
+	 * 2. shrink each link, and roll back those the strategy rejects
 	 * */
-	std::vector<std::vector<Value *>> prevDepLink	  = getDependencyLink(N, llvmIrFunction);
-	std::map<Value *, typeInfo>	  typeChangedInst = shrinkInstType(N, boundInfo, llvmIrFunction);
-	mergeCast(N, llvmIrFunction, boundInfo->virtualRegisterRange, typeChangedInst);
-	std::vector<std::vector<Value *>> newDepLink = getDependencyLink(N, llvmIrFunction);
-
-	for (auto & depLink : newDepLink)
+	std::vector<dependencyLink> dependencyLinks = getDependencyLink(N, llvmIrFunction);
+	std::map<Value *, typeInfo> typeChangedInst;
+	for (auto & depLink : dependencyLinks)
 	{
+		if (!shrinkDependencyLink(N, depLink, llvmIrFunction, boundInfo->virtualRegisterRange, typeChangedInst))
+		{
+			continue;
+		}
 		if (rollBackStrategy(N, depLink))
 		{
 			rollBackDependencyLink(N, depLink, boundInfo->virtualRegisterRange, typeChangedInst);
 		}
 	}
 
-	mergeCast(N, llvmIrFunction, boundInfo->virtualRegisterRange, typeChangedInst);
+	mergeCast(N, llvmIrFunction, boundInfo->virtualRegisterRange);
+}
 }
-}
\ No newline at end of file
@@ -45,6 +45,23 @@ extern "C"
 {
 #endif /* __cplusplus */
 
+enum varType {
+	INT1	= 1,
+	INT8	= 2,
+	INT16	= 3,
+	INT32	= 4,
+	INT64	= 5,
+	FLOAT	= 6,
+	DOUBLE	= 7,
+	UNKNOWN = 8,
+};
+
+varType
+getIntegerTypeEnum(double min, double max, bool signFlag);
+
+varType
+getFloatingTypeEnum(double min, double max);
+
 void
 shrinkType(State * N, BoundInfo * boundInfo, llvm::Function & llvmIrFunction);
 
@@ -42,13 +42,6 @@ using namespace llvm;
 extern "C"
 {
 
-enum CmpRes {
-	Depends	    = 1,
-	AlwaysTrue  = 2,
-	AlwaysFalse = 3,
-	Unsupported = 6,
-};
-
 CmpRes
 compareFCmpConstWithVariableRange(FCmpInst * llvmIrFCmpInstruction, double variableLowerBound, double variableUpperBound,
 				  double constValue)
@@ -422,6 +415,62 @@ compareICmpWithVariableRange(ICmpInst * llvmIrICmpInstruction, double leftVariab
 	}
 }
 
+/*
+ * the outcome of a comparison of a variable with a constant or another
+ * variable under the ranges of boundInfo, as simplifyControlFlow folds it
+ * */
+CmpRes
+compareByRange(BoundInfo * boundInfo, CmpInst * llvmIrCmpInstruction)
+{
+	auto leftOperand  = llvmIrCmpInstruction->getOperand(0);
+	auto rightOperand = llvmIrCmpInstruction->getOperand(1);
+	if (isa<llvm::Constant>(leftOperand))
+	{
+		return CmpRes::Unsupported;
+	}
+	auto vrLeftRangeIt = boundInfo->virtualRegisterRange.find(leftOperand);
+	if (vrLeftRangeIt == boundInfo->virtualRegisterRange.end())
+	{
+		return CmpRes::Unsupported;
+	}
+	double leftLowerBound = vrLeftRangeIt->second.first;
+	double leftUpperBound = vrLeftRangeIt->second.second;
+
+	if (!isa<llvm::Constant>(rightOperand))
+	{
+		auto vrRightRangeIt = boundInfo->virtualRegisterRange.find(rightOperand);
+		if (vrRightRangeIt == boundInfo->virtualRegisterRange.end())
+		{
+			return CmpRes::Unsupported;
+		}
+		if (auto llvmIrICmpInstruction = dyn_cast<ICmpInst>(llvmIrCmpInstruction))
+		{
+			return compareICmpWithVariableRange(llvmIrICmpInstruction, leftLowerBound, leftUpperBound,
+							    vrRightRangeIt->second.first, vrRightRangeIt->second.second);
+		}
+		return compareFCmpWithVariableRange(cast<FCmpInst>(llvmIrCmpInstruction), leftLowerBound, leftUpperBound,
+						    vrRightRangeIt->second.first, vrRightRangeIt->second.second);
+	}
+
+	if (auto llvmIrICmpInstruction = dyn_cast<ICmpInst>(llvmIrCmpInstruction))
+	{
+		auto constInt = dyn_cast<ConstantInt>(rightOperand);
+		if (constInt == nullptr)
+		{
+			return CmpRes::Unsupported;
+		}
+		return compareICmpConstWithVariableRange(llvmIrICmpInstruction, leftLowerBound, leftUpperBound,
+							 constInt->getSExtValue());
+	}
+	auto constFp = dyn_cast<ConstantFP>(rightOperand);
+	if (constFp == nullptr)
+	{
+		return CmpRes::Unsupported;
+	}
+	return compareFCmpConstWithVariableRange(cast<FCmpInst>(llvmIrCmpInstruction), leftLowerBound, leftUpperBound,
+						 (constFp->getValueAPF()).convertToDouble());
+}
+
 static Type *
 GetCompareTy(Value * Op)
 {
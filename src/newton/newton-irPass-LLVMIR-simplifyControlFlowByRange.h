@@ -42,6 +42,16 @@ extern "C"
 {
 #endif /* __cplusplus */
 
+enum CmpRes {
+	Depends	    = 1,
+	AlwaysTrue  = 2,
+	AlwaysFalse = 3,
+	Unsupported = 6,
+};
+
+CmpRes
+compareByRange(BoundInfo * boundInfo, llvm::CmpInst * llvmIrCmpInstruction);
+
 bool
 simplifyControlFlow(State * N, BoundInfo * boundInfo, llvm::Function & llvmIrFunction);
 
@@ -0,0 +1,610 @@
+/*
+	Authored 2026. Phillip Stanley-Marbell.
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions
+	are met:
+
+	*	Redistributions of source code must retain the above
+		copyright notice, this list of conditions and the following
+		disclaimer.
+
+	*	Redistributions in binary form must reproduce the above
+		copyright notice, this list of conditions and the following
+		disclaimer in the documentation and/or other materials
+		provided with the distribution.
+
+	*	Neither the name of the author nor the names of its
+		contributors may be used to endorse or promote products
+		derived from this software without specific prior written
+		permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ *	Function specialization by range: a callee is cloned for the ranges
+ *	of its arguments at some of its call sites, where the clone pays for
+ *	the code it adds.
+ *
+ *	The call sites of a callee whose argument ranges overlap share one
+ *	specialization, for the union of their ranges. Its gain is estimated
+ *	from the analysis of the callee for those ranges, against the analysis
+ *	the callee gets on its own: the comparisons the ranges decide (which
+ *	simplifyControlFlow folds), the values they let shrinkType narrow and
+ *	the calls left in blocks they make unreachable. Its cost is the code
+ *	of the callee that stays reachable. The specializations gaining at
+ *	least one instruction per kSpecializationSizePerBenefit of cost are
+ *	made, best ratio first, until their code reaches N->specializationBudget
+ *	percent of the module. The argument ranges of a clone are kept in its
+ *	kSpecializationMetadata, for the analyses of the later passes.
+ *
+ *	A few rounds let the callees of a clone be specialized in turn, so
+ *	that call chains such as e_rem_pio2 to k_rem_pio2 are specialized end
+ *	to end. Within a round, the estimates share their callee analyses
+ *	through CalleeSummaries, so a deep call graph is analyzed once per
+ *	range rather than once per path.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+#include "newton-irPass-LLVMIR-optimizeByRange.h"
+#include "newton-irPass-LLVMIR-rangeSummaries.h"
+#include "newton-irPass-LLVMIR-simplifyControlFlowByRange.h"
+#include "newton-irPass-LLVMIR-shrinkTypeByRange.h"
+#include "newton-irPass-LLVMIR-specializeByRange.h"
+
+using namespace llvm;
+
+extern "C"
+{
+
+static const char *	kSpecializationMetadata = "newton.specialization";
+
+/*
+ *	N->specializationBudget when it is not given, in percent of the module
+ */
+static const int	kSpecializationDefaultBudget = 20;
+
+/*
+ *	Instructions of clone a specialization may cost per instruction it gains
+ */
+static const size_t	kSpecializationSizePerBenefit = 8;
+
+/*
+ *	Instructions gained per comparison folded and per call removed
+ */
+static const size_t	kSpecializationFoldedCompareBenefit = 2;
+static const size_t	kSpecializationRemovedCallBenefit = 4;
+
+/*
+ *	Callees with more call sites are left alone
+ */
+static const size_t	kSpecializationMaxCallSites = 32;
+
+/*
+ *	Rounds of specialization, each specializing the callees of the clones
+ *	made in the one before
+ */
+static const int	kSpecializationRounds = 3;
+
+typedef struct SpecializationCandidate {
+	Function *				callee;
+	std::vector<CallInst *>			callSites;
+	/*
+	 * NaN for the arguments without a range
+	 * */
+	std::vector<std::pair<double, double>>	argumentRanges;
+	size_t					benefit = 0;
+	size_t					cost	= 0;
+} SpecializationCandidate;
+
+static bool
+isKnownRange(const std::pair<double, double> & range)
+{
+	return !std::isnan(range.first) && !std::isnan(range.second);
+}
+
+/*
+ * the range of an argument of a call in the caller: a constant as a point,
+ * any other scalar by the range the caller's analysis gives it
+ * */
+static std::pair<double, double>
+callArgumentRange(const BoundInfo * boundInfo, Value * argument)
+{
+	if (auto constInt = dyn_cast<ConstantInt>(argument))
+	{
+		if (constInt->getBitWidth() <= 64)
+		{
+			double constIntValue = static_cast<double>(constInt->getSExtValue());
+			return std::make_pair(constIntValue, constIntValue);
+		}
+	}
+	else if (auto constFp = dyn_cast<ConstantFP>(argument))
+	{
+		double constDoubleValue = (constFp->getValueAPF()).convertToDouble();
+		return std::make_pair(constDoubleValue, constDoubleValue);
+	}
+	else if (argument->getType()->isIntegerTy() || argument->getType()->isFloatingPointTy())
+	{
+		auto vrRangeIt = boundInfo->virtualRegisterRange.find(argument);
+		if (vrRangeIt != boundInfo->virtualRegisterRange.end())
+		{
+			return vrRangeIt->second;
+		}
+	}
+	return std::make_pair(static_cast<double>(NAN), static_cast<double>(NAN));
+}
+
+/*
+ * two call sites overlap when they have ranges for the same arguments
+ * and these ranges intersect
+ * */
+static bool
+overlappingArgumentRanges(const std::vector<std::pair<double, double>> & leftRanges,
+			  const std::vector<std::pair<double, double>> & rightRanges)
+{
+	for (size_t idx = 0; idx < leftRanges.size(); idx++)
+	{
+		bool leftKnown	= isKnownRange(leftRanges[idx]);
+		bool rightKnown = isKnownRange(rightRanges[idx]);
+		if (leftKnown != rightKnown)
+		{
+			return false;
+		}
+		if (leftKnown && (leftRanges[idx].second < rightRanges[idx].first || rightRanges[idx].second < leftRanges[idx].first))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+ * the call sites of callee, merged while any two of them overlap
+ * */
+static std::vector<SpecializationCandidate>
+mergeOverlappingCallSites(Function * callee, const std::vector<std::pair<CallInst *, std::vector<std::pair<double, double>>>> & callSites)
+{
+	std::vector<SpecializationCandidate> candidates;
+	for (const auto & callSite : callSites)
+	{
+		SpecializationCandidate candidate;
+		candidate.callee	 = callee;
+		candidate.callSites	 = {callSite.first};
+		candidate.argumentRanges = callSite.second;
+		candidates.emplace_back(candidate);
+	}
+
+	bool merged = true;
+	while (merged)
+	{
+		merged = false;
+		for (size_t left = 0; left < candidates.size() && !merged; left++)
+		{
+			for (size_t right = left + 1; right < candidates.size() && !merged; right++)
+			{
+				if (!overlappingArgumentRanges(candidates[left].argumentRanges, candidates[right].argumentRanges))
+				{
+					continue;
+				}
+				auto & leftRanges = candidates[left].argumentRanges;
+				for (size_t idx = 0; idx < leftRanges.size(); idx++)
+				{
+					leftRanges[idx].first  = std::min(leftRanges[idx].first, candidates[right].argumentRanges[idx].first);
+					leftRanges[idx].second = std::max(leftRanges[idx].second, candidates[right].argumentRanges[idx].second);
+				}
+				candidates[left].callSites.insert(candidates[left].callSites.end(), candidates[right].callSites.begin(),
+								  candidates[right].callSites.end());
+				candidates.erase(candidates.begin() + right);
+				merged = true;
+			}
+		}
+	}
+	return candidates;
+}
+
+/*
+ * the candidates of the module, by callee in the order of the module
+ * */
+static std::vector<SpecializationCandidate>
+collectSpecializationCandidates(Module * Mod, std::map<std::string, BoundInfo *> & funcBoundInfo)
+{
+	std::map<Function *, std::vector<std::pair<CallInst *, std::vector<std::pair<double, double>>>>> calleeCallSites;
+	for (auto & mi : *Mod)
+	{
+		auto boundInfoIt = funcBoundInfo.find(mi.getName().str());
+		if (mi.isDeclaration() || boundInfoIt == funcBoundInfo.end())
+		{
+			continue;
+		}
+		for (Instruction & llvmIrInstruction : instructions(mi))
+		{
+			auto llvmIrCallInstruction = dyn_cast<CallInst>(&llvmIrInstruction);
+			if (llvmIrCallInstruction == nullptr)
+			{
+				continue;
+			}
+			Function * calledFunction = llvmIrCallInstruction->getCalledFunction();
+			if (calledFunction == nullptr || calledFunction->isDeclaration() || calledFunction->isVarArg() ||
+			    calledFunction == &mi || calledFunction->getSubprogram() == nullptr)
+			{
+				continue;
+			}
+			std::vector<std::pair<double, double>> argumentRanges;
+			bool				       knownArgument = false;
+			for (Value * argument : llvmIrCallInstruction->args())
+			{
+				argumentRanges.emplace_back(callArgumentRange(boundInfoIt->second, argument));
+				knownArgument |= isKnownRange(argumentRanges.back());
+			}
+			if (knownArgument)
+			{
+				calleeCallSites[calledFunction].emplace_back(llvmIrCallInstruction, argumentRanges);
+			}
+		}
+	}
+
+	std::vector<SpecializationCandidate> candidates;
+	for (auto & mi : *Mod)
+	{
+		auto callSitesIt = calleeCallSites.find(&mi);
+		if (callSitesIt == calleeCallSites.end() || callSitesIt->second.size() > kSpecializationMaxCallSites)
+		{
+			continue;
+		}
+		auto calleeCandidates = mergeOverlappingCallSites(&mi, callSitesIt->second);
+		candidates.insert(candidates.end(), calleeCandidates.begin(), calleeCandidates.end());
+	}
+	return candidates;
+}
+
+static bool
+isDecidedByRange(BoundInfo * boundInfo, CmpInst * llvmIrCmpInstruction)
+{
+	CmpRes compareResult = compareByRange(boundInfo, llvmIrCmpInstruction);
+	return compareResult == CmpRes::AlwaysTrue || compareResult == CmpRes::AlwaysFalse;
+}
+
+/*
+ * the blocks reachable from the entry, leaving out the successors of the
+ * branches on comparisons the ranges of boundInfo decide
+ * */
+static SmallPtrSet<BasicBlock *, 32>
+reachableBlocks(BoundInfo * boundInfo, Function & llvmIrFunction)
+{
+	SmallPtrSet<BasicBlock *, 32> reachable;
+	std::vector<BasicBlock *>     worklist = {&llvmIrFunction.getEntryBlock()};
+	reachable.insert(&llvmIrFunction.getEntryBlock());
+	while (!worklist.empty())
+	{
+		Instruction * terminator = worklist.back()->getTerminator();
+		worklist.pop_back();
+		CmpRes compareResult = CmpRes::Depends;
+		auto   llvmIrBranchInstruction = dyn_cast<BranchInst>(terminator);
+		if (llvmIrBranchInstruction != nullptr && llvmIrBranchInstruction->isConditional())
+		{
+			if (auto llvmIrCmpInstruction = dyn_cast<CmpInst>(llvmIrBranchInstruction->getCondition()))
+			{
+				compareResult = compareByRange(boundInfo, llvmIrCmpInstruction);
+			}
+		}
+		for (unsigned idx = 0; idx < terminator->getNumSuccessors(); idx++)
+		{
+			if ((compareResult == CmpRes::AlwaysTrue && idx == 1) || (compareResult == CmpRes::AlwaysFalse && idx == 0))
+			{
+				continue;
+			}
+			if (reachable.insert(terminator->getSuccessor(idx)).second)
+			{
+				worklist.emplace_back(terminator->getSuccessor(idx));
+			}
+		}
+	}
+	return reachable;
+}
+
+/*
+ * the narrowest type the range of a value fits, UNKNOWN without a range
+ * */
+static varType
+rangeTypeEnum(BoundInfo * boundInfo, Instruction * llvmIrInstruction)
+{
+	auto vrRangeIt = boundInfo->virtualRegisterRange.find(llvmIrInstruction);
+	if (vrRangeIt == boundInfo->virtualRegisterRange.end())
+	{
+		return UNKNOWN;
+	}
+	if (llvmIrInstruction->getType()->isIntegerTy())
+	{
+		return getIntegerTypeEnum(vrRangeIt->second.first, vrRangeIt->second.second, true);
+	}
+	if (llvmIrInstruction->getType()->isDoubleTy())
+	{
+		return getFloatingTypeEnum(vrRangeIt->second.first, vrRangeIt->second.second);
+	}
+	return UNKNOWN;
+}
+
+/*
+ * the benefit and cost of the candidate, by the analysis of its callee for its
+ * ranges against the analysis of the callee on its own
+ * */
+static void
+estimateSpecialization(BoundInfo * calleeBoundInfo, BoundInfo * specializedBoundInfo, SpecializationCandidate & candidate)
+{
+	Function &	callee		   = *candidate.callee;
+	auto		calleeBlocks	   = reachableBlocks(calleeBoundInfo, callee);
+	auto		specializedBlocks  = reachableBlocks(specializedBoundInfo, callee);
+	size_t		foldedCompares	   = 0;
+	size_t		narrowedValues	   = 0;
+	size_t		removedCalls	   = 0;
+
+	candidate.cost = 0;
+	for (BasicBlock & llvmIrBasicBlock : callee)
+	{
+		for (Instruction & llvmIrInstruction : llvmIrBasicBlock)
+		{
+			if (isa<DbgInfoIntrinsic>(llvmIrInstruction))
+			{
+				continue;
+			}
+			if (!specializedBlocks.count(&llvmIrBasicBlock))
+			{
+				removedCalls += calleeBlocks.count(&llvmIrBasicBlock) && isa<CallInst>(llvmIrInstruction);
+				continue;
+			}
+			candidate.cost++;
+			if (auto llvmIrCmpInstruction = dyn_cast<CmpInst>(&llvmIrInstruction))
+			{
+				foldedCompares += isDecidedByRange(specializedBoundInfo, llvmIrCmpInstruction) &&
+						  !isDecidedByRange(calleeBoundInfo, llvmIrCmpInstruction);
+				continue;
+			}
+			varType specializedType = rangeTypeEnum(specializedBoundInfo, &llvmIrInstruction);
+			narrowedValues += specializedType != UNKNOWN && specializedType < rangeTypeEnum(calleeBoundInfo, &llvmIrInstruction);
+		}
+	}
+	candidate.benefit = kSpecializationFoldedCompareBenefit * foldedCompares + narrowedValues +
+			    kSpecializationRemovedCallBenefit * removedCalls;
+
+	/*
+	 * a clone taking every call of a local callee replaces it
+	 * */
+	if (callee.hasLocalLinkage() && callee.getNumUses() == candidate.callSites.size())
+	{
+		candidate.cost = 0;
+	}
+}
+
+/*
+ * clone the callee of the candidate next to it, keep the argument ranges in the
+ * metadata of the clone, and call the clone from the call sites of the candidate
+ * */
+static void
+createSpecialization(State * N, Module * Mod, const SpecializationCandidate & candidate)
+{
+	Function *	  callee = candidate.callee;
+	ValueToValueMapTy vMap;
+	Function *	  specialized = CloneFunction(callee, vMap);
+	specialized->setName(callee->getName() + "_specialized");
+	specialized->setLinkage(GlobalValue::PrivateLinkage);
+	specialized->setVisibility(GlobalValue::DefaultVisibility);
+	specialized->setDSOLocal(true);
+	specialized->setUnnamedAddr(GlobalValue::UnnamedAddr::Global);
+	specialized->removeFromParent();
+	Mod->getFunctionList().insert(callee->getIterator(), specialized);
+
+	LLVMContext &	      context = Mod->getContext();
+	std::vector<Metadata *> argumentRanges;
+	for (size_t idx = 0; idx < candidate.argumentRanges.size(); idx++)
+	{
+		if (!isKnownRange(candidate.argumentRanges[idx]))
+		{
+			continue;
+		}
+		argumentRanges.emplace_back(ConstantAsMetadata::get(ConstantInt::get(Type::getInt32Ty(context), idx)));
+		argumentRanges.emplace_back(ConstantAsMetadata::get(ConstantFP::get(Type::getDoubleTy(context), candidate.argumentRanges[idx].first)));
+		argumentRanges.emplace_back(ConstantAsMetadata::get(ConstantFP::get(Type::getDoubleTy(context), candidate.argumentRanges[idx].second)));
+	}
+	specialized->setMetadata(kSpecializationMetadata, MDNode::get(context, argumentRanges));
+
+	for (CallInst * llvmIrCallInstruction : candidate.callSites)
+	{
+		llvmIrCallInstruction->setCalledFunction(specialized);
+	}
+	flexprint(N->Fe, N->Fm, N->Fpinfo, "\tspecialize %s as %s for %zu call sites: benefit %zu, cost %zu\n",
+		  callee->getName().str().c_str(), specialized->getName().str().c_str(), candidate.callSites.size(),
+		  candidate.benefit, candidate.cost);
+}
+
+void
+collectSpecializationBoundInfo(Module * Mod, BoundInfo * globalBoundInfo)
+{
+	for (auto & mi : *Mod)
+	{
+		MDNode * argumentRanges = mi.getMetadata(kSpecializationMetadata);
+		if (argumentRanges == nullptr)
+		{
+			continue;
+		}
+		for (unsigned idx = 0; idx + 2 < argumentRanges->getNumOperands(); idx += 3)
+		{
+			auto argNo	= mdconst::extract<ConstantInt>(argumentRanges->getOperand(idx))->getZExtValue();
+			auto lowerBound = mdconst::extract<ConstantFP>(argumentRanges->getOperand(idx + 1))->getValueAPF().convertToDouble();
+			auto upperBound = mdconst::extract<ConstantFP>(argumentRanges->getOperand(idx + 2))->getValueAPF().convertToDouble();
+			globalBoundInfo->virtualRegisterRange.emplace(mi.getArg(argNo), std::make_pair(lowerBound, upperBound));
+		}
+	}
+}
+
+/*
+ *	merged is about to be replaced by survivor, which computes the same.
+ *	Widen the argument ranges of survivor to cover those of merged, and
+ *	drop the ranges of the arguments either one does not restrict.
+ */
+void
+mergeSpecializationRanges(Function * survivor, Function * merged)
+{
+	MDNode * survivorRanges = survivor->getMetadata(kSpecializationMetadata);
+	MDNode * mergedRanges	= merged->getMetadata(kSpecializationMetadata);
+	if (survivorRanges == nullptr || survivorRanges == mergedRanges)
+	{
+		return;
+	}
+	if (mergedRanges == nullptr)
+	{
+		survivor->setMetadata(kSpecializationMetadata, nullptr);
+		return;
+	}
+
+	std::map<uint64_t, std::pair<double, double>> mergedArgumentRanges;
+	for (unsigned idx = 0; idx + 2 < mergedRanges->getNumOperands(); idx += 3)
+	{
+		auto argNo	= mdconst::extract<ConstantInt>(mergedRanges->getOperand(idx))->getZExtValue();
+		auto lowerBound = mdconst::extract<ConstantFP>(mergedRanges->getOperand(idx + 1))->getValueAPF().convertToDouble();
+		auto upperBound = mdconst::extract<ConstantFP>(mergedRanges->getOperand(idx + 2))->getValueAPF().convertToDouble();
+		mergedArgumentRanges.emplace(argNo, std::make_pair(lowerBound, upperBound));
+	}
+
+	LLVMContext &	      context = survivor->getContext();
+	std::vector<Metadata *> argumentRanges;
+	for (unsigned idx = 0; idx + 2 < survivorRanges->getNumOperands(); idx += 3)
+	{
+		auto argNo	 = mdconst::extract<ConstantInt>(survivorRanges->getOperand(idx))->getZExtValue();
+		auto mergedRange = mergedArgumentRanges.find(argNo);
+		if (mergedRange == mergedArgumentRanges.end())
+		{
+			continue;
+		}
+		auto lowerBound = mdconst::extract<ConstantFP>(survivorRanges->getOperand(idx + 1))->getValueAPF().convertToDouble();
+		auto upperBound = mdconst::extract<ConstantFP>(survivorRanges->getOperand(idx + 2))->getValueAPF().convertToDouble();
+		argumentRanges.emplace_back(survivorRanges->getOperand(idx));
+		argumentRanges.emplace_back(ConstantAsMetadata::get(ConstantFP::get(Type::getDoubleTy(context), std::min(lowerBound, mergedRange->second.first))));
+		argumentRanges.emplace_back(ConstantAsMetadata::get(ConstantFP::get(Type::getDoubleTy(context), std::max(upperBound, mergedRange->second.second))));
+	}
+	survivor->setMetadata(kSpecializationMetadata, argumentRanges.empty() ? nullptr : MDNode::get(context, argumentRanges));
+}
+
+void
+specializeFunctionsByRange(State * N, Module * Mod, const std::map<std::string, std::pair<double, double>> & typeRange,
+			   const std::map<llvm::Value *, std::vector<std::pair<double, double>>> & virtualRegisterVectorRange,
+			   BoundInfo * globalBoundInfo)
+{
+	int budgetPercent = N->specializationBudget == 0 ? kSpecializationDefaultBudget : N->specializationBudget;
+	if (budgetPercent < 0)
+	{
+		return;
+	}
+	size_t moduleSize = 0;
+	for (auto & mi : *Mod)
+	{
+		moduleSize += mi.getInstructionCount();
+	}
+	size_t budget = moduleSize * budgetPercent / 100;
+
+	/*
+	 * the analyses of the estimates are not part of the report. The summaries
+	 * of N->rangeAnalysisCache are read into N first, so that the copy shares them
+	 * */
+	if (N->rangeAnalysisCache != NULL)
+	{
+		rangeSummaryLoad(N);
+	}
+	State analysisState  = *N;
+	analysisState.Fpinfo = rangeAnalysisPrintBuffer();
+	analysisState.Fperr  = rangeAnalysisPrintBuffer();
+
+	for (int round = 0; round < kSpecializationRounds; round++)
+	{
+		std::map<std::string, BoundInfo *> funcBoundInfo;
+		inferModuleBound(&analysisState, Mod, typeRange, virtualRegisterVectorRange, globalBoundInfo, funcBoundInfo);
+		auto candidates = collectSpecializationCandidates(Mod, funcBoundInfo);
+
+		CalleeSummaries				calleeSummaries;
+		std::vector<SpecializationCandidate *>	profitableCandidates;
+		for (auto & candidate : candidates)
+		{
+			BoundInfo * specializedBoundInfo = new BoundInfo();
+			specializedBoundInfo->virtualRegisterRange.insert(globalBoundInfo->virtualRegisterRange.begin(),
+									  globalBoundInfo->virtualRegisterRange.end());
+			for (size_t idx = 0; idx < candidate.argumentRanges.size(); idx++)
+			{
+				if (isKnownRange(candidate.argumentRanges[idx]))
+				{
+					specializedBoundInfo->virtualRegisterRange.emplace(candidate.callee->getArg(idx), candidate.argumentRanges[idx]);
+				}
+			}
+			summarizedCalleeRange(&analysisState, typeRange, virtualRegisterVectorRange, &calleeSummaries,
+					      specializedBoundInfo, *candidate.callee);
+			estimateSpecialization(funcBoundInfo[candidate.callee->getName().str()], specializedBoundInfo, candidate);
+			if (candidate.benefit > 0 && candidate.benefit * kSpecializationSizePerBenefit >= candidate.cost)
+			{
+				profitableCandidates.emplace_back(&candidate);
+			}
+		}
+
+		std::stable_sort(profitableCandidates.begin(), profitableCandidates.end(),
+				 [](const SpecializationCandidate * left, const SpecializationCandidate * right) {
+					 return left->benefit * right->cost > right->benefit * left->cost;
+				 });
+		size_t		     specializations = 0;
+		std::set<Function *> replacedCallees;
+		for (auto candidate : profitableCandidates)
+		{
+			if (candidate->cost > budget)
+			{
+				continue;
+			}
+			budget -= candidate->cost;
+			createSpecialization(N, Mod, *candidate);
+			specializations++;
+			if (candidate->callee->hasLocalLinkage() && candidate->callee->use_empty())
+			{
+				replacedCallees.emplace(candidate->callee);
+			}
+		}
+		/*
+		 * erased once no candidate of the round refers to them
+		 * */
+		for (auto replacedCallee : replacedCallees)
+		{
+			for (auto & llvmIrArgument : replacedCallee->args())
+			{
+				globalBoundInfo->virtualRegisterRange.erase(&llvmIrArgument);
+			}
+			replacedCallee->eraseFromParent();
+		}
+		if (specializations == 0)
+		{
+			break;
+		}
+		collectSpecializationBoundInfo(Mod, globalBoundInfo);
+	}
+
+	rangeAnalysisFreePrintBuffer(analysisState.Fpinfo);
+	rangeAnalysisFreePrintBuffer(analysisState.Fperr);
+}
+
+}
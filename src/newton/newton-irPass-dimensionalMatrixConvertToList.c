@@ -56,6 +56,7 @@
 #include "newton-timeStamps.h"
 #include "common-timeStamps.h"
 #include "common-data-structures.h"
+#include "common-arena.h"
 #include "noisy-parser.h"
 #include "newton-parser.h"
 #include "noisy-lexer.h"
@@ -103,7 +104,7 @@ irPassGenLoopsInRightExpression(State *  N, IrNode *  newNodeQTerm, SourceInfo *
 				NULL,
 				genSrcInfo);
 
-	Token *		tokenExpression = (Token *) calloc(1, sizeof(Token));
+	Token *		tokenExpression = (Token *) commonArenaAlloc(N, kCommonArenaRegionLex, sizeof(Token));
 	tokenExpression->type = kNewtonIrNodeType_Tmul;
 	newNodeMulExpression->token = tokenExpression;
 	addLeafWithChainingSeqNoLex(N, newNodeQTerm, newNodeMulExpression, genSrcInfo);
@@ -137,7 +138,7 @@ irPassGenLoopsInRightExpression(State *  N, IrNode *  newNodeQTerm, SourceInfo *
 				NULL,
 				genSrcInfo);
 
-	Token *		tokenExponent = (Token *) calloc(1, sizeof(Token));
+	Token *		tokenExponent = (Token *) commonArenaAlloc(N, kCommonArenaRegionLex, sizeof(Token));
 	tokenExponent->type = kNewtonIrNodeType_Texponentiation;
 	newNodeExponent->token = tokenExponent;
 	
@@ -165,7 +166,7 @@ irPassGenLoopsInRightExpression(State *  N, IrNode *  newNodeQTerm, SourceInfo *
 	newNodeExponentConst->value = 0 - N->invariantList->nullSpaceWithoutDuplicates[kernel]
 									[colIndependent[kernel][whichParameter][whichIndependentParameter]]
 									[rowIndependent[kernel][whichParameter][whichIndependentParameter]];
-	Token *		tokenExponentConst = (Token *) calloc(1, sizeof(Token));
+	Token *		tokenExponentConst = (Token *) commonArenaAlloc(N, kCommonArenaRegionLex, sizeof(Token));
 	tokenExponentConst->type = kNewtonIrNodeType_PnumericConst;
 	newNodeExponentConst->token = tokenExponentConst;
 
@@ -252,7 +253,7 @@ irPassGenExpression(State *  N, IrNode *  node, SourceInfo *  genSrcInfo, int co
 				NULL,
 				NULL,
 				genSrcInfo);
-	Token *		tokenExponent = (Token *) calloc(1, sizeof(Token));
+	Token *		tokenExponent = (Token *) commonArenaAlloc(N, kCommonArenaRegionLex, sizeof(Token));
 	tokenExponent->type = kNewtonIrNodeType_Texponentiation;
 	newNodeExponent->token = tokenExponent;
 
@@ -290,7 +291,7 @@ irPassGenExpression(State *  N, IrNode *  node, SourceInfo *  genSrcInfo, int co
 										[rowIndependent[kernel][whichParameter][0]];
 	}
 
-	Token *		tokenExponentConst = (Token *) calloc(1, sizeof(Token));
+	Token *		tokenExponentConst = (Token *) commonArenaAlloc(N, kCommonArenaRegionLex, sizeof(Token));
 	tokenExponentConst->type = kNewtonIrNodeType_PnumericConst;
 	newNodeExponentConst->token = tokenExponentConst;
 
@@ -377,8 +378,7 @@ irPassDimensionalMatrixConvertToList(State *  N)
 	 *	temporary values, ideally should be more meaningful.
 	 */
 
-	SourceInfo *	genSrcInfo = calloc(1, sizeof(SourceInfo));
-	genSrcInfo->fileName = calloc(strlen("GeneratedByDA") + 1, sizeof(char));
+	SourceInfo *	genSrcInfo = (SourceInfo *) commonArenaAlloc(N, kCommonArenaRegionLex, sizeof(SourceInfo));
 	genSrcInfo->fileName = "GeneratedByDA";
 	genSrcInfo->lineNumber = -1;
 	genSrcInfo->columnNumber = -1;
@@ -405,10 +405,10 @@ irPassDimensionalMatrixConvertToList(State *  N)
 		int ***		locateIndependentInvariantColumn;
 		int ***		locateIndependentInvariantRow;
 
-		locateDependentInvariantRow = (int **) calloc(invariant->numberOfUniqueKernels, sizeof(int *));
-		locateDependentInvariantColumn = (int **) calloc(invariant->numberOfUniqueKernels, sizeof(int *));
-		locateIndependentInvariantRow = (int ***) calloc(invariant->numberOfUniqueKernels, sizeof(int **));
-		locateIndependentInvariantColumn = (int ***) calloc(invariant->numberOfUniqueKernels, sizeof(int **));
+		locateDependentInvariantRow = (int **) commonArenaAlloc(N, kCommonArenaRegionPassScratch, invariant->numberOfUniqueKernels * sizeof(int *));
+		locateDependentInvariantColumn = (int **) commonArenaAlloc(N, kCommonArenaRegionPassScratch, invariant->numberOfUniqueKernels * sizeof(int *));
+		locateIndependentInvariantRow = (int ***) commonArenaAlloc(N, kCommonArenaRegionPassScratch, invariant->numberOfUniqueKernels * sizeof(int **));
+		locateIndependentInvariantColumn = (int ***) commonArenaAlloc(N, kCommonArenaRegionPassScratch, invariant->numberOfUniqueKernels * sizeof(int **));
 
 		for (int countKernel = 0; countKernel < invariant->numberOfUniqueKernels; countKernel++)
 		{
@@ -426,8 +426,8 @@ irPassDimensionalMatrixConvertToList(State *  N)
 			 *	list described by Newton are constants at the first instance, by checking the
 			 *	'constant' keyword, we currently do not do this.
 			 */
-			locateDependentInvariantRow[countKernel] = (int *) calloc(invariant->dimensionalMatrixColumnCount, sizeof(int));
-			locateDependentInvariantColumn[countKernel] = (int *) calloc(invariant->dimensionalMatrixColumnCount, sizeof(int));
+			locateDependentInvariantRow[countKernel] = (int *) commonArenaAlloc(N, kCommonArenaRegionPassScratch, invariant->dimensionalMatrixColumnCount * sizeof(int));
+			locateDependentInvariantColumn[countKernel] = (int *) commonArenaAlloc(N, kCommonArenaRegionPassScratch, invariant->dimensionalMatrixColumnCount * sizeof(int));
 
 			int	zerosCount = 0;
 			int	onesCount = 0;
@@ -460,13 +460,13 @@ irPassDimensionalMatrixConvertToList(State *  N)
 						countAddRightExpression = countDependentInvariant++;
 					}
 				}
-				locateIndependentInvariantRow[countKernel] = (int **) calloc(countDependentInvariant, sizeof(int *));
-				locateIndependentInvariantColumn[countKernel] = (int **) calloc(countDependentInvariant, sizeof(int *));
+				locateIndependentInvariantRow[countKernel] = (int **) commonArenaAlloc(N, kCommonArenaRegionPassScratch, countDependentInvariant * sizeof(int *));
+				locateIndependentInvariantColumn[countKernel] = (int **) commonArenaAlloc(N, kCommonArenaRegionPassScratch, countDependentInvariant * sizeof(int *));
 
 				for (int i = 0; i < countDependentInvariant; i++)
 				{
-					locateIndependentInvariantRow[countKernel][i] = (int *) calloc(invariant->dimensionalMatrixColumnCount, sizeof(int));
-					locateIndependentInvariantColumn[countKernel][i] = (int *) calloc(invariant->dimensionalMatrixColumnCount, sizeof(int));
+					locateIndependentInvariantRow[countKernel][i] = (int *) commonArenaAlloc(N, kCommonArenaRegionPassScratch, invariant->dimensionalMatrixColumnCount * sizeof(int));
+					locateIndependentInvariantColumn[countKernel][i] = (int *) commonArenaAlloc(N, kCommonArenaRegionPassScratch, invariant->dimensionalMatrixColumnCount * sizeof(int));
 
 					for (int countRow = 0, countIndependentInvariant = 0; countRow < invariant->dimensionalMatrixColumnCount; countRow++)
 					{
@@ -542,15 +542,15 @@ irPassDimensionalMatrixConvertToList(State *  N)
 						locateDependentInvariantColumn[countKernel][countDependentInvariant++] = whichColumn;
 					}
 				}
-				locateIndependentInvariantRow[countKernel] = (int **) calloc(countDependentInvariant, sizeof(int *));
-				locateIndependentInvariantColumn[countKernel] = (int **) calloc(countDependentInvariant, sizeof(int *));
+				locateIndependentInvariantRow[countKernel] = (int **) commonArenaAlloc(N, kCommonArenaRegionPassScratch, countDependentInvariant * sizeof(int *));
+				locateIndependentInvariantColumn[countKernel] = (int **) commonArenaAlloc(N, kCommonArenaRegionPassScratch, countDependentInvariant * sizeof(int *));
 
 				for (int countColumn = 0; countColumn < invariant->kernelColumnCount; countColumn++)
 				{
 					for (int i = 0, countIndependentInvariant = 0; i < countDependentInvariant; i++)
 					{
-						locateIndependentInvariantRow[countKernel][i] = (int *) calloc(invariant->dimensionalMatrixColumnCount, sizeof(int));
-						locateIndependentInvariantColumn[countKernel][i] = (int *) calloc(invariant->dimensionalMatrixColumnCount, sizeof(int));
+						locateIndependentInvariantRow[countKernel][i] = (int *) commonArenaAlloc(N, kCommonArenaRegionPassScratch, invariant->dimensionalMatrixColumnCount * sizeof(int));
+						locateIndependentInvariantColumn[countKernel][i] = (int *) commonArenaAlloc(N, kCommonArenaRegionPassScratch, invariant->dimensionalMatrixColumnCount * sizeof(int));
 
 						for (int countRow = 0; countRow < invariant->dimensionalMatrixColumnCount; countRow++)
 						{
@@ -610,12 +610,11 @@ irPassDimensionalMatrixConvertToList(State *  N)
 		 */
 		invariant->constraints = invariant->parameterList->irParent->irRightChild->irLeftChild;
 
-		free(locateDependentInvariantColumn);
-		free(locateDependentInvariantRow);
-		free(locateIndependentInvariantColumn);
-		free(locateIndependentInvariantRow);
+		/*
+		 *	The locate* tables are only needed while we build this invariant's constraints.
+		 */
+		commonArenaReset(N, kCommonArenaRegionPassScratch);
 
 		invariant = invariant->next;
 	}
-	free(genSrcInfo);
 }
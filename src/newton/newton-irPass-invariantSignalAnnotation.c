@@ -54,6 +54,7 @@
 #include "newton-timeStamps.h"
 #include "common-timeStamps.h"
 #include "common-data-structures.h"
+#include "common-stringIntern.h"
 #include "noisy-parser.h"
 #include "noisy-lexer.h"
 #include "common-irPass-helpers.h"
@@ -69,13 +70,15 @@
 
 /*
  *	Function to find the kth instance of a signal struct
- *	with a particular identifier in the AST.
+ *	with a particular identifier in the AST. Signal identifiers
+ *	are interned, so we compare against the interned handle.
  */
 Signal *
 findKthSignalByIdentifier(State * N, char * identifier, int kth)
 {
 	Signal * signal = NULL;
 	Invariant * invariant = N->invariantList;
+	const char * internedIdentifier = commonStringInternLookup(N, identifier);
 	int count = 0;
 	while(invariant)
 	{
@@ -84,7 +87,7 @@ findKthSignalByIdentifier(State * N, char * identifier, int kth)
 		IrNode * parameter = findNthIrNodeOfType(N, parameterList, kNewtonIrNodeType_Pparameter, nth);
 		while(parameter != NULL)
 		{
-			if(strcmp(parameter->signal->identifier, identifier) == 0)
+			if(internedIdentifier != NULL && parameter->signal->identifier == internedIdentifier)
 			{
 				if(count == kth)
 				{
@@ -162,6 +165,7 @@ findKthSignalByInvariantExpressionIdentifier(State * N, char * identifier, int k
 {
 	Signal * signal = NULL;
 	Invariant * invariant = N->invariantList;
+	const char * internedIdentifier = commonStringInternLookup(N, identifier);
 	int count = 0;
 	while(invariant)
 	{
@@ -170,7 +174,7 @@ findKthSignalByInvariantExpressionIdentifier(State * N, char * identifier, int k
 		IrNode * parameter = findNthIrNodeOfType(N, parameterList, kNewtonIrNodeType_Pparameter, nth);
 		while(parameter != NULL)
 		{
-			if(strcmp(parameter->signal->invariantExpressionIdentifier, identifier) == 0)
+			if(internedIdentifier != NULL && parameter->signal->invariantExpressionIdentifier == internedIdentifier)
 			{
 				if(count == kth)
 				{
@@ -246,6 +250,7 @@ findKthSignalBySensorIdentifier(State * N, char * sensorIdentifier, int kth)
 {
 	Signal * signal = NULL;
 	Invariant * invariant = N->invariantList;
+	const char * internedSensorIdentifier = commonStringInternLookup(N, sensorIdentifier);
 	int count = 0;
 	while(invariant)
 	{
@@ -254,7 +259,7 @@ findKthSignalBySensorIdentifier(State * N, char * sensorIdentifier, int kth)
 		IrNode * parameter = findNthIrNodeOfType(N, parameterList, kNewtonIrNodeType_Pparameter, nth);
 		while(parameter != NULL)
 		{
-			if(strcmp(parameter->signal->sensorIdentifier, sensorIdentifier) == 0)
+			if(internedSensorIdentifier != NULL && parameter->signal->sensorIdentifier == internedSensorIdentifier)
 			{
 				if(count == kth)
 				{
@@ -306,11 +311,12 @@ getSignalAxis(State * N, Invariant * invariant, char * invariantExpressionIdenti
 {
 	int axis = 0;
 	IrNode * parameterList = invariant->parameterList;
+	const char * internedIdentifier = commonStringInternLookup(N, invariantExpressionIdentifier);
 	int nth = 0;
 	IrNode * parameter = findNthIrNodeOfType(N, parameterList, kNewtonIrNodeType_Pparameter, nth);
 	while(parameter != NULL)
 	{
-		if(!strcmp(parameter->signal->invariantExpressionIdentifier, invariantExpressionIdentifier))
+		if(internedIdentifier != NULL && parameter->signal->invariantExpressionIdentifier == internedIdentifier)
 		{
 			break;
 		}
@@ -413,14 +419,14 @@ attachSignalsToParameterNodes(State * N)
 			char * identifier = parameter->irRightChild->tokenString;
 			char * invariantExpressionIdentifier = parameter->irLeftChild->tokenString;
 			parameter->signal->baseNode = findSignalBaseNodeByIdentifier(N, identifier);
-			parameter->signal->identifier = identifier;
-			parameter->signal->invariantExpressionIdentifier = invariantExpressionIdentifier;
+			parameter->signal->identifier = (char *)commonStringIntern(N, identifier);
+			parameter->signal->invariantExpressionIdentifier = (char *)commonStringIntern(N, invariantExpressionIdentifier);
 			/*
 			 *	TODO: Add correct physicalGroupNumber and sensor identifier.
 			 */
 			char * sensorIdentifier = "BMX055";
 			parameter->signal->physicalGroupNumber = 1;
-			parameter->signal->sensorIdentifier = sensorIdentifier;
+			parameter->signal->sensorIdentifier = (char *)commonStringIntern(N, sensorIdentifier);
 
 			nth++;
 			parameter = findNthIrNodeOfType(N, parameterList, kNewtonIrNodeType_Pparameter, nth);
@@ -540,7 +546,7 @@ checkIfSignalPresentInList(State * N, Signal * signalList, Signal * signal)
 {
 	while(signalList != NULL)
 	{
-		if(strcmp(signalList->identifier, signal->identifier) == 0 && signalList->axis == signal->axis)
+		if(signalList->identifier == signal->identifier && signalList->axis == signal->axis)
 		{
 			return true;
 		}
@@ -738,7 +744,7 @@ annotateSignalsInvariantConstraints(State * N)
 			 *	Create a new Signal corresponding to the identifier.
 			 */
 			Signal * signal = (Signal *) calloc(1, sizeof(Signal));
-			signal->invariantExpressionIdentifier = invariantExpressionIdentifier;
+			signal->invariantExpressionIdentifier = (char *)commonStringIntern(N, invariantExpressionIdentifier);
 
 			int axis = getSignalAxis(N, invariant, invariantExpressionIdentifier);
 			Signal * baseSignal = findSignalByInvariantExpressionIdentifierAndAxis(N, invariantExpressionIdentifier, axis);
@@ -785,7 +791,7 @@ annotateSignalsInvariantConstraints(State * N)
 			
 				Signal * nextSignal = (Signal *) calloc(1, sizeof(Signal));
 			
-				nextSignal->invariantExpressionIdentifier = invariantExpressionIdentifier;
+				nextSignal->invariantExpressionIdentifier = (char *)commonStringIntern(N, invariantExpressionIdentifier);
 
 				axis = getSignalAxis(N, invariant, invariantExpressionIdentifier);
 				Signal * baseSignal = findSignalByInvariantExpressionIdentifierAndAxis(N, invariantExpressionIdentifier, axis);
@@ -934,7 +940,7 @@ irPassInvariantSignalAnnotation(State * N)
 	 *	TODO: Remove the two lines below preceding the call to updatePhysicalGroupNumbers when associating sensors with Signals has been implemented.
 	 */
 	Signal * testSignal = findSignalByIdentifierAndAxis(N, "temperature", 2);
-    testSignal->sensorIdentifier = "BME680";
+    testSignal->sensorIdentifier = (char *)commonStringIntern(N, "BME680");
 	updatePhysicalGroupNumbers(N);
 
 
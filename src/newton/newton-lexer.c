@@ -102,10 +102,15 @@ newtonLexInit(State *  N, char *  fileName)
 	 */
 	
 	/*
-	 *	The following two are needed in order for getline() to allocate the buffer itself
+	 *	N->lineBuffer points into the source buffer set up by lexSourceOpen()
 	 */
 	N->lineBuffer = NULL;
 
+	if (N->keywordTable == NULL)
+	{
+		lexKeywordTableInit(N, gNewtonTokenDescriptions, kCommonIrNodeTypeMax);
+	}
+
 	newtonLex(N, fileName);
 
 	SourceInfo *	eofSourceInfo = lexAllocateSourceInfo(N,	NULL		/* genealogy	*/,
@@ -124,11 +129,9 @@ newtonLexInit(State *  N, char *  fileName)
 
 	if (N->verbosityLevel & kCommonVerbosityDebugLexer)
 	{
-		Token *	p = N->tokenList;
-		while (p != NULL)
+		for (uint64_t i = 0; i < N->tokenCount; i++)
 		{
-			lexDebugPrintToken(N, p, gNewtonTokenDescriptions);
-			p = p->next;
+			lexDebugPrintToken(N, N->tokens[i], gNewtonTokenDescriptions);
 		}
 	}
 }
@@ -138,17 +141,9 @@ newtonLex(State *  N, char *  fileName)
 {
 	TimeStampTraceMacro(kNewtonTimeStampKey);
 
-	size_t			lineBufferSize;
+	lexSourceOpen(N, fileName);
 
-	N->filePointer = fopen(fileName, "r");
-	if (N->filePointer == NULL)
-	{
-		flexprint(N->Fe, N->Fm, N->Fperr, "Could not open file \"%s\".\n", fileName);
-		fatal(N, Eopen);
-	}
-
-	lineBufferSize = 0;
-	while ((N->lineLength = getline(&(N->lineBuffer), &lineBufferSize, N->filePointer)) != -1)
+	while (lexSourceNextLine(N))
 	{
 		N->columnNumber = 0;
 		while (N->columnNumber < N->lineLength)
@@ -328,19 +323,25 @@ newtonLex(State *  N, char *  fileName)
 				}
 			}
 
-			checkTokenLength(N, 1);
-			N->currentToken[N->currentTokenLength++] = N->lineBuffer[N->columnNumber++];
+			/*
+			 *	Take the whole run of characters up to the next operator or
+			 *	separator from the source buffer at once.
+			 */
+			uint64_t	sliceEnd = N->columnNumber + 1;
+			while (sliceEnd < N->lineLength && !isOperatorOrSeparator(N, N->lineBuffer[sliceEnd]))
+			{
+				sliceEnd++;
+			}
+
+			checkTokenLength(N, sliceEnd - N->columnNumber);
+			memcpy(&N->currentToken[N->currentTokenLength], &N->lineBuffer[N->columnNumber], sliceEnd - N->columnNumber);
+			N->currentTokenLength += sliceEnd - N->columnNumber;
+			N->columnNumber = sliceEnd;
 		}
 		N->lineNumber++;
-
-		/*
-		 *	In order for getline() to allocate the buffer itself on the next iteration...
-		 */
-		N->lineBuffer = NULL;
-		lineBufferSize = 0;
 	}
 
-	fclose(N->filePointer);
+	lexSourceClose(N);
 
 	return;
 }
@@ -363,10 +364,9 @@ checkComment(State *  N)
 	finishToken(N);
 
 	/*
-	 *	NOTE: currentToken is allocated only once, but lineBuffer is allocated each 
-	 *	time a line is read via getline().
+	 *	NOTE: N->lineBuffer points into the source buffer, which lexSourceClose()
+	 *	releases once the whole file has been lexed.
 	 */
-	free(N->lineBuffer);
 }
 
 
@@ -426,13 +426,22 @@ checkDoubleQuote(State *  N, bool callFinishTokenFlag)
 	 *	N->lineBuffer must contain the closing quote, else we flag this as a
 	 *	bad string constant (kNewtonIrNodeType_ZbadStringConst)
 	 */
-	if (strchr(&N->lineBuffer[N->columnNumber+1], '"') == NULL)
+	if (memchr(&N->lineBuffer[N->columnNumber+1], '"', N->lineLength - N->columnNumber - 1) == NULL)
 	{
+		/*
+		 *	Lines in the source buffer are not '\0'-terminated, so the rest
+		 *	of the line is taken into N->currentToken for the token.
+		 */
+		checkTokenLength(N, N->lineLength - N->columnNumber);
+		memcpy(&N->currentToken[N->currentTokenLength], &N->lineBuffer[N->columnNumber], N->lineLength - N->columnNumber);
+		N->currentTokenLength	+= N->lineLength - N->columnNumber;
+		N->columnNumber		= N->lineLength;
+
 		newToken = lexAllocateToken(N,		kNewtonIrNodeType_ZbadStringConst	/* type		*/,
 							NULL					/* identifier	*/,
 							0					/* integerConst	*/,
 							0.0					/* realConst	*/,
-							&N->lineBuffer[N->columnNumber]		/* stringConst	*/,
+							N->currentToken				/* stringConst	*/,
 							NULL					/* sourceInfo	*/);
 	}
 	else
@@ -501,85 +510,81 @@ finishToken(State *  N)
 		return;
 	}
 
-	for (int i = 0; i < kCommonIrNodeTypeMax; i++)
+	if (!strcmp("include", N->currentToken))
 	{
-		if (!strcmp("include", N->currentToken))
-		{
-			/*
-			 *	Reset the index in the current token to place the filename string
-			 *	over the "include" since we don't need to keep that. Then, call
-			 *	checkDoubleQuote()
-			 */
-			N->currentTokenLength = 0;
-			checkDoubleQuote(N, false /* callFinishTokenFlag */);
-
-			/*
-			 *	Since we don't call done() (which sets the N->currentTokenLength
-			 *	to zero and bzero's the N->currentToken buffer), we need to do
-			 *	this manually.
-			 */
-			bzero(N->currentToken, kCommonMaxBufferLength);
-			N->currentTokenLength = 0;
-
-			char *	newFileName = strdup(N->lastToken->stringConst);
-			if (!newFileName)
-			{
-				fatal(N, Emalloc);
-			}
-
-			Token *	tmp		= N->lastToken;
-			N->lastToken		= N->lastToken->prev;
-			if (N->lastToken == NULL)
-			{
-				N->tokenList = N->lastToken;
-			}
-
-			free(tmp->stringConst);
-			free(tmp);
+		/*
+		 *	Reset the index in the current token to place the filename string
+		 *	over the "include" since we don't need to keep that. Then, call
+		 *	checkDoubleQuote()
+		 */
+		N->currentTokenLength = 0;
+		checkDoubleQuote(N, false /* callFinishTokenFlag */);
 
-			char *	oldFileName	= N->fileName;
-			int	oldColumnNumber	= N->columnNumber;
-			int	oldLineNumber	= N->lineNumber;
-			FILE *	oldFilePointer	= N->filePointer;
+		/*
+		 *	Since we don't call done() (which sets the N->currentTokenLength
+		 *	to zero and bzero's the N->currentToken buffer), we need to do
+		 *	this manually.
+		 */
+		bzero(N->currentToken, kCommonMaxBufferLength);
+		N->currentTokenLength = 0;
 
-			N->fileName 		= newFileName;
-			N->columnNumber		= 1;
-			N->lineNumber		= 1;
-			N->lineLength		= 0;
-			N->lineBuffer		= NULL;
-			newtonLex(N, newFileName);
-			free(newFileName);
+		char *	newFileName = strdup(N->tokens[N->tokenCount - 1]->stringConst);
+		if (!newFileName)
+		{
+			fatal(N, Emalloc);
+		}
 
-			N->fileName		= oldFileName;
-			N->filePointer		= oldFilePointer;
-			N->lineNumber		= oldLineNumber;
+		/*
+		 *	Drop the file name token. It lives in the lex arena and its
+		 *	string in the intern pool, so neither is freed here.
+		 */
+		N->tokenCount--;
+
+		char *	oldFileName	= N->fileName;
+		int	oldColumnNumber	= N->columnNumber;
+		int	oldLineNumber	= N->lineNumber;
+		char *	oldLineBuffer	= N->lineBuffer;
+		SourceBuffer	oldSource	= N->source;
+
+		N->fileName 		= newFileName;
+		N->columnNumber		= 1;
+		N->lineNumber		= 1;
+		N->lineLength		= 0;
+		N->lineBuffer		= NULL;
+		newtonLex(N, newFileName);
+		free(newFileName);
+
+		N->fileName		= oldFileName;
+		N->source		= oldSource;
+		N->lineBuffer		= oldLineBuffer;
+		N->lineNumber		= oldLineNumber;
 
-			/*
-			 *	Set the columnNumber and lineLength to be same to force
-			 *	ourselves to stop chomping on the same line.
-			 */
-			N->columnNumber		= oldColumnNumber;
-			N->lineLength		= oldColumnNumber;
+		/*
+		 *	Set the columnNumber and lineLength to be same to force
+		 *	ourselves to stop chomping on the same line.
+		 */
+		N->columnNumber		= oldColumnNumber;
+		N->lineLength		= oldColumnNumber;
 
-			return;
-		}
+		return;
+	}
 
-		if ((gNewtonTokenDescriptions[i] != NULL) && !strcmp(gNewtonTokenDescriptions[i], N->currentToken))
-		{
-			Token *	newToken = lexAllocateToken(N,			i	/* type		*/,
-										NULL	/* identifier	*/,
-										0	/* integerConst	*/,
-										0.0	/* realConst	*/,
-										NULL	/* stringConst	*/,
-										NULL	/* sourceInfo	*/);
+	int	keywordType = lexKeywordLookup(N, N->currentToken, N->currentTokenLength);
+	if (keywordType >= 0)
+	{
+		Token *	newToken = lexAllocateToken(N,			keywordType	/* type		*/,
+									NULL	/* identifier	*/,
+									0	/* integerConst	*/,
+									0.0	/* realConst	*/,
+									NULL	/* stringConst	*/,
+									NULL	/* sourceInfo	*/);
 
-			/*
-			 *	done() sets the N->currentTokenLength to zero and bzero's the N->currentToken buffer.
-			 */
-			done(N, newToken);
+		/*
+		 *	done() sets the N->currentTokenLength to zero and bzero's the N->currentToken buffer.
+		 */
+		done(N, newToken);
 
-			return;
-		}
+		return;
 	}
 
 	if (N->currentToken[0] >= '0' && N->currentToken[0] <= '9')
@@ -794,12 +799,12 @@ checkGt(State *  N)
 	 */
 	finishToken(N);
 
-	if (N->lineLength >= 2 && N->lineBuffer[N->columnNumber+1] == '<')
+	if (N->columnNumber + 2 <= N->lineLength && N->lineBuffer[N->columnNumber+1] == '<')
 	{
 		gobble(N, 2);
 		type = kNewtonIrNodeType_Tmutualinf;
 	}
-	if (N->lineLength >= 2 && N->lineBuffer[N->columnNumber+1] == '>')
+	if (N->columnNumber + 2 <= N->lineLength && N->lineBuffer[N->columnNumber+1] == '>')
 	{
 		gobble(N, 2);
 		type = kNewtonIrNodeType_TrightShift;
@@ -841,12 +846,12 @@ checkLt(State *  N)
 	 */
 	finishToken(N);
 
-	if (N->lineLength >= 3 && N->lineBuffer[N->columnNumber+1] == '-' && N->lineBuffer[N->columnNumber+2] == '>')
+	if (N->columnNumber + 3 <= N->lineLength && N->lineBuffer[N->columnNumber+1] == '-' && N->lineBuffer[N->columnNumber+2] == '>')
 	{
 		gobble(N, 3);
 		type = kNewtonIrNodeType_Trelated;
 	}
-	else if (N->lineLength >= 2 && N->lineBuffer[N->columnNumber+1] == '<')
+	else if (N->columnNumber + 2 <= N->lineLength && N->lineBuffer[N->columnNumber+1] == '<')
 	{
 		gobble(N, 2);
 		type = kNewtonIrNodeType_TleftShift;
@@ -887,7 +892,7 @@ checkColon(State *  N)
 	 */
 	finishToken(N);
 
-	if (N->lineLength >= 2 && N->lineBuffer[N->columnNumber+1] == '=')
+	if (N->columnNumber + 2 <= N->lineLength && N->lineBuffer[N->columnNumber+1] == '=')
 	{
 		gobble(N, 2);
 		type = kNewtonIrNodeType_Tdef;
@@ -923,7 +928,7 @@ checkEqual(State *  N)
 	 */
 	finishToken(N);
 
-	if (N->lineLength >= 2 && N->lineBuffer[N->columnNumber+1] == '=')
+	if (N->columnNumber + 2 <= N->lineLength && N->lineBuffer[N->columnNumber+1] == '=')
 	{
 		gobble(N, 2);
 		type = kNewtonIrNodeType_Tequals;
@@ -955,7 +960,7 @@ checkProportionality(State * N)
 	IrNodeType		type;
 
 
-	if (N->lineLength >= 2 && N->lineBuffer[N->columnNumber+1] == '<')
+	if (N->columnNumber + 2 <= N->lineLength && N->lineBuffer[N->columnNumber+1] == '<')
 	{
 		/*
 		 *	Gobble any extant chars.
@@ -993,7 +998,7 @@ checkPlusMinus(State *  N, IrNodeType plusOrMinusTokenType)
 	*	
 	*		If the current character is '-' and the next is '>' create the rightArrow token.
 	*/
-	if (N->lineLength >=2 && N->lineBuffer[N->columnNumber+1] == '>' && N->lineBuffer[N->columnNumber] == '-')
+	if (N->columnNumber + 2 <= N->lineLength && N->lineBuffer[N->columnNumber+1] == '>' && N->lineBuffer[N->columnNumber] == '-')
 	{
 		finishToken(N);
 
@@ -1019,7 +1024,7 @@ checkPlusMinus(State *  N, IrNodeType plusOrMinusTokenType)
 	/*
 	 *	If the previous two characters were a number and 'e' or 'E', keep eating chars until the first non-number.
 	 */
-	if ((N->lineLength > 2) && isdigit(N->lineBuffer[N->columnNumber-2]) && ((N->lineBuffer[N->columnNumber-1] == 'e') || (N->lineBuffer[N->columnNumber-1] == 'E')))
+	if ((N->columnNumber >= 2) && isdigit(N->lineBuffer[N->columnNumber-2]) && ((N->lineBuffer[N->columnNumber-1] == 'e') || (N->lineBuffer[N->columnNumber-1] == 'E')))
 	{
 		/*
 		 *	Consume the '+' or '-':
@@ -1040,7 +1045,7 @@ checkPlusMinus(State *  N, IrNodeType plusOrMinusTokenType)
 	 *	If the next character is not a number, then simply do checkSingle.
 	 *	Otherwise, create a positive or negative numeric constant.
 	 */
-	if (N->lineLength >= 2 && (N->lineBuffer[N->columnNumber+1] < '0' || N->lineBuffer[N->columnNumber+1] > '9'))
+	if (N->columnNumber + 2 > N->lineLength || N->lineBuffer[N->columnNumber+1] < '0' || N->lineBuffer[N->columnNumber+1] > '9')
 	{
 		checkSingle(N, plusOrMinusTokenType);
 
@@ -1078,7 +1083,7 @@ checkMul(State *  N)
 	 */
 	finishToken(N);
 
-	if (N->lineLength >= 2 && N->lineBuffer[N->columnNumber+1] == '*')
+	if (N->columnNumber + 2 <= N->lineLength && N->lineBuffer[N->columnNumber+1] == '*')
 	{
 		gobble(N, 2);
 		type = kNewtonIrNodeType_Texponentiation;
@@ -50,6 +50,8 @@
 #include "common-errors.h"
 #include "common-timeStamps.h"
 #include "common-data-structures.h"
+#include "common-arena.h"
+#include "common-stringIntern.h"
 #include "newton-symbolTable.h"
 
 
@@ -450,7 +452,7 @@ newtonInitPhysics(State * N, Scope * scope, Token * token)
 
 	if (token != NULL)
 	{
-		newPhysics->identifier = token->identifier;
+		newPhysics->identifier = (char *)commonStringIntern(N, token->identifier);
 		newPhysics->sourceInfo = token->sourceInfo;
 	}
 	newPhysics->next = NULL;
@@ -472,7 +474,7 @@ newtonPhysicsTableAddPhysicsForToken(State *  N, Scope *  scope, Token *  token)
 
 		if (token != NULL)
 		{
-			newPhysics->identifier = token->identifier;
+			newPhysics->identifier = (char *)commonStringIntern(N, token->identifier);
 			newPhysics->sourceInfo = token->sourceInfo;
 		}
 	}
@@ -604,6 +606,10 @@ newtonPhysicsTablePhysicsForDimensionAlias(State *  N, Scope *  scope, const cha
 	return newtonPhysicsTablePhysicsForDimensionAlias(N, scope->parent, dimensionAliasIdentifier);
 }
 
+/*
+ *	Physics identifiers are interned, so once we have the interned handle
+ *	for the identifier we are looking for, matching is a pointer comparison.
+ */
 Physics *
 newtonPhysicsTablePhysicsForIdentifierAndSubindex(State *  N, Scope *  scope, const char *  identifier, int subindex)
 {
@@ -614,10 +620,16 @@ newtonPhysicsTablePhysicsForIdentifierAndSubindex(State *  N, Scope *  scope, co
 		return NULL;
 	}
 
+	const char *	internedIdentifier = commonStringInternLookup(N, identifier);
+	if (internedIdentifier == NULL)
+	{
+		return NULL;
+	}
+
 	Physics *	curPhysics = scope->firstPhysics;
 	while (curPhysics != NULL)
 	{
-		if (!strcmp(curPhysics->identifier, identifier) && curPhysics->subindex == subindex)
+		if ((curPhysics->identifier == internedIdentifier) && curPhysics->subindex == subindex)
 		{
 			assert(curPhysics->dimensions != NULL);
 			return curPhysics;
@@ -625,7 +637,7 @@ newtonPhysicsTablePhysicsForIdentifierAndSubindex(State *  N, Scope *  scope, co
 		curPhysics = curPhysics->next;
 	}
 
-	return newtonPhysicsTablePhysicsForIdentifier(N, scope->parent, identifier);
+	return newtonPhysicsTablePhysicsForIdentifier(N, scope->parent, internedIdentifier);
 }
 
 Physics *
@@ -633,23 +645,27 @@ newtonPhysicsTablePhysicsForIdentifier(State *  N, Scope *  scope, const char *
 {
 	TimeStampTraceMacro(kNewtonTimeStampKey);
 
-	if (scope == NULL)
+	const char *	internedIdentifier = commonStringInternLookup(N, identifier);
+	if (internedIdentifier == NULL)
 	{
 		return NULL;
 	}
 
-	Physics *	curPhysics = scope->firstPhysics;
-	while (curPhysics != NULL)
+	for (Scope *  p = scope; p != NULL; p = p->parent)
 	{
-		if (!strcmp(curPhysics->identifier, identifier))
+		Physics *	curPhysics = p->firstPhysics;
+		while (curPhysics != NULL)
 		{
-			assert(curPhysics->dimensions != NULL);
-			return curPhysics;
+			if (curPhysics->identifier == internedIdentifier)
+			{
+				assert(curPhysics->dimensions != NULL);
+				return curPhysics;
+			}
+			curPhysics = curPhysics->next;
 		}
-		curPhysics = curPhysics->next;
 	}
 
-	return newtonPhysicsTablePhysicsForIdentifier(N, scope->parent, identifier);
+	return NULL;
 }
 
 Scope *
@@ -659,11 +675,7 @@ newtonSymbolTableAllocScope(State *  N)
 
 	Scope *		newScope;
 
-	newScope = (Scope *) calloc(1, sizeof(Scope));
-	if (newScope == NULL)
-	{
-		fatal(N, Emalloc);
-	}
+	newScope = (Scope *) commonArenaAlloc(N, kCommonArenaRegionParse, sizeof(Scope));
 
 	return newScope;
 }
@@ -61,6 +61,8 @@
 #include "common-timeStamps.h"
 #include "common-data-structures.h"
 #include "common-symbolTable.h"
+#include "common-stringIntern.h"
+#include "common-arena.h"
 #include "common-irPass-helpers.h"
 
 #include "newton-parser.h"
@@ -79,6 +81,7 @@
 #include "newton-irPass-LLVMIR-dimension-check.h"
 #include "newton-irPass-LLVMIR-livenessAnalysis.h"
 #include "newton-irPass-LLVMIR-optimizeByRange.h"
+#include "newton-irPass-LLVMIR-module.h"
 #include "newton-irPass-dimensionalMatrixAnnotation.h"
 #include "newton-irPass-dimensionalMatrixPiGroups.h"
 #include "newton-irPass-dimensionalMatrixPrinter.h"
@@ -93,10 +96,6 @@
 
 extern char *	gNewtonAstNodeStrings[kNoisyIrNodeTypeMax];
 
-static State *
-processNewtonFileDimensionPass(char * filename);
-
-
 void
 processNewtonFile(State *  N, char *  filename)
 {
@@ -105,15 +104,18 @@ processNewtonFile(State *  N, char *  filename)
 	/*
 	 *	Tokenize input, then parse it and build AST + symbol table.
 	 */
+	TimeStampPhaseBeginMacro("lex");
 	newtonLexInit(N, filename);
+	TimeStampPhaseEndMacro("lex");
 
 	/*
 	 *	Create a top-level scope, then parse.
 	 */
 	N->newtonIrTopScope = commonSymbolTableAllocScope(N);
 
-	State *	N_dim = processNewtonFileDimensionPass(filename);
-	N->newtonIrTopScope->firstDimension = N_dim->newtonIrTopScope->firstDimension;
+	TimeStampPhaseBeginMacro("dimension pass");
+	newtonDimensionPassParse(N, N->newtonIrTopScope);
+	TimeStampPhaseEndMacro("dimension pass");
 
 	if (N->newtonIrTopScope->firstDimension == NULL)
 	{
@@ -126,8 +128,11 @@ processNewtonFile(State *  N, char *  filename)
 		newtonParserErrorRecovery(N, kNewtonIrNodeType_PnewtonDescription);
 	}
 
+	TimeStampPhaseBeginMacro("parse");
 	N->newtonIrRoot = newtonParse(N, N->newtonIrTopScope);
+	TimeStampPhaseEndMacro("parse");
 
+	TimeStampPhaseBeginMacro("IR passes");
 	if (!(N->irPasses & kNewtonIrPassSensorsDisable))
 	{
 		irPassSensors(N);
@@ -202,22 +207,23 @@ processNewtonFile(State *  N, char *  filename)
 	{
 		irPassLLVMIRLivenessAnalysis(N);
 	}
-	if (N->irPasses & kNewtonirPassLLVMIROptimizeByRange)
+	/*
+	 *	Auto quantization runs as the last of the range optimizations.
+	 */
+	if (N->irPasses & (kNewtonirPassLLVMIROptimizeByRange | kNewtonirPassLLVMIRAutoQuantization))
 	{
 		irPassLLVMIROptimizeByRange(N);
 	}
-	if (N->irPasses & kNewtonirPassLLVMIRAutoQuantization)
-	{
-		/*
-		 *	irPassLLVMIRAutoQuantization pass is causing issues with the current implementation.
-		 */
-		// irPassLLVMIRAutoQuantization(N);
-		flexprint(N->Fe, N->Fm, N->Fperr, "AutoQuantization pass was disabled at compilation.\n");
-	}
+	/*
+	 *	The LLVM IR passes above share one parsed module.
+	 */
+	irPassLLVMIRModuleRelease(N);
+	TimeStampPhaseEndMacro("IR passes");
 
 	/*
 	 *	Dot backend.
 	 */
+	TimeStampPhaseBeginMacro("backends");
 	if (N->irBackends & kNewtonIrBackendDot)
 	{
 		fprintf(stdout, "%s\n", irPassDotBackend(N, N->newtonIrTopScope, N->newtonIrRoot, gNewtonAstNodeStrings));
@@ -254,12 +260,18 @@ processNewtonFile(State *  N, char *  filename)
 	{
 		flexprint(N->Fe, N->Fm, N->Fpmathjax, "\\end{document}\n");
 	}
+	TimeStampPhaseEndMacro("backends");
 
 	if (N->mode & kCommonModeCallTracing)
 	{
 		timeStampDumpTimeline(N);
 	}
 
+	if (N->outputTraceJsonFilePath != NULL)
+	{
+		timeStampDumpChromeTrace(N, N->outputTraceJsonFilePath);
+	}
+
 	if (N->mode & kCommonModeCallStatistics)
 	{
 		uint64_t	irNodeCount = 0, symbolTableNodeCount = 0;
@@ -274,6 +286,10 @@ processNewtonFile(State *  N, char *  filename)
 		flexprint(N->Fe, N->Fm, N->Fpinfo, "Intermediate Representation Information:\n\n");
 		flexprint(N->Fe, N->Fm, N->Fpinfo, "    IR node count                        : %llu\n", irNodeCount);
 		flexprint(N->Fe, N->Fm, N->Fpinfo, "    Symbol Table node count              : %llu\n", symbolTableNodeCount);
+		flexprint(N->Fe, N->Fm, N->Fpinfo, "\n");
+
+		commonStringInternDumpStatistics(N);
+		commonArenaDumpStatistics(N);
 
 		/*
 		 *	Libflex malloc statistics:
@@ -316,22 +332,3 @@ processNewtonFile(State *  N, char *  filename)
 		irPassSignalTypedefGenerationBackend(N);
 	}
 }
-
-static State*
-processNewtonFileDimensionPass(char * filename)
-{
-	State *		N = init(kCommonModeDefault);
-	
-
-	/*
-	 *	In this case, put macro here since it needs 'N'
-	 */
-	TimeStampTraceMacro(kNewtonTimeStampKey);
-
-	newtonLexInit(N, filename);
-
-	N->newtonIrTopScope = commonSymbolTableAllocScope(N);
-	newtonDimensionPassParse(N, N->newtonIrTopScope);
-
-	return N;
-}
@@ -69,6 +69,8 @@
 #include "noisy-symbolTable.h"
 #include "common-irPass-helpers.h"
 #include "common-lexers-helpers.h"
+#include "common-stringIntern.h"
+#include "common-arena.h"
 #include "noisy-irPass-dotBackend.h"
 
 static const char		kNoisyCgiInputLogStub[]		= "XXXXXXXXXX";
@@ -692,6 +694,10 @@ main(void)
 			flexprint(noisyCgiState->Fe, noisyCgiState->Fm, noisyCgiState->Fpinfo, "Intermediate Representation Information:\n\n");
 			flexprint(noisyCgiState->Fe, noisyCgiState->Fm, noisyCgiState->Fpinfo, "    IR node count                        : %llu\n", irNodeCount);
 			flexprint(noisyCgiState->Fe, noisyCgiState->Fm, noisyCgiState->Fpinfo, "    Symbol Table node count              : %llu\n", symbolTableNodeCount);
+			flexprint(noisyCgiState->Fe, noisyCgiState->Fm, noisyCgiState->Fpinfo, "\n");
+
+			commonStringInternDumpStatistics(noisyCgiState);
+			commonArenaDumpStatistics(noisyCgiState);
 
 			/*
 			 *	Libflex malloc statistics:
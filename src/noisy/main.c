@@ -55,6 +55,8 @@
 #include "noisy-parser.h"
 #include "noisy-lexer.h"
 #include "common-symbolTable.h"
+#include "common-stringIntern.h"
+#include "common-arena.h"
 #include "common-irPass-helpers.h"
 #include "noisy-irPass-dotBackend.h"
 #include "noisy-irPass-protobufBackend.h"
@@ -99,6 +101,10 @@ main(int argc, char *argv[])
 			{"trace",		no_argument,		0,	't'},
 			{"statistics",		no_argument,		0,	's'},
 			{"optimize",		required_argument,	0,	'O'},
+			{"trace-json",		required_argument,	0,	551},
+			{"emit-object",		no_argument,		0,	552},
+			{"run",			no_argument,		0,	553},
+			{"frame-pool",		no_argument,		0,	554},
 			{0,			0,			0,	0}
 		};
 
@@ -221,10 +227,19 @@ main(int argc, char *argv[])
 				//N->irPasses |= xxx;
 				//N->irPasses |= yyy;
 
+				/*
+				 *	-Os and -Oz optimize at -O2 for size, as in clang.
+				 */
 				uint64_t tmpInt = strtoul(optarg, &ep, 0);
-				if (*ep == '\0')
+				if (!strcmp(optarg, "s") || !strcmp(optarg, "z"))
+				{
+					N->optimizationLevel = 2;
+					N->optimizationSizeLevel = optarg[0] == 's' ? 1 : 2;
+				}
+				else if (*ep == '\0')
 				{
 					N->optimizationLevel = tmpInt;
+					N->optimizationSizeLevel = 0;
 				}
 				else
 				{
@@ -236,6 +251,43 @@ main(int argc, char *argv[])
 				break;
 			}
 
+			case 551:
+			{
+				N->outputTraceJsonFilePath = optarg;
+
+				/*
+				 *	The trace is built from the statistics timeline.
+				 */
+				if (!(N->mode & kCommonModeCallStatistics))
+				{
+					N->mode |= kCommonModeCallStatistics;
+					timestampsInit(N);
+				}
+
+				break;
+			}
+
+			case 552:
+			{
+				N->irBackends |= kNoisyIrBackendObject;
+
+				break;
+			}
+
+			case 553:
+			{
+				N->irBackends |= kNoisyIrBackendJit;
+
+				break;
+			}
+
+			case 554:
+			{
+				N->irPasses |= kNoisyIrPassCoroutineFramePool;
+
+				break;
+			}
+
 			case '?':
 			{
 				/*
@@ -289,7 +341,7 @@ main(int argc, char *argv[])
 		consolePrintBuffers(N);
 	}
 
-	return 0;
+	return N->jitExitStatus;
 }
 
 
@@ -299,13 +351,17 @@ processFile(State *  N, char *  fileName)
 	/*
 	 *	Tokenize input, then parse it and build AST + symbol table.
 	 */
+	TimeStampPhaseBeginMacro("lex");
 	noisyLexInit(N, fileName);
+	TimeStampPhaseEndMacro("lex");
 
 	/*
 	 *	Create a top-level scope, then parse.
 	 */
 	N->noisyIrTopScope = commonSymbolTableAllocScope(N);
+	TimeStampPhaseBeginMacro("parse");
 	N->noisyIrRoot = noisyParse(N, N->noisyIrTopScope);
+	TimeStampPhaseEndMacro("parse");
 
 
 	/*
@@ -322,9 +378,13 @@ processFile(State *  N, char *  fileName)
 	*	Actual code generation takes place.
 	*/
 
+	TimeStampPhaseBeginMacro("type check");
 	noisyTypeCheck(N);
+	TimeStampPhaseEndMacro("type check");
 
+	TimeStampPhaseBeginMacro("code generation");
 	noisyCodeGen(N);
+	TimeStampPhaseEndMacro("code generation");
 
 	/*
 	 *	Bytecode backend. Emit IR in protobuf.
@@ -349,6 +409,11 @@ processFile(State *  N, char *  fileName)
 		timeStampDumpTimeline(N);
 	}
 
+	if (N->outputTraceJsonFilePath != NULL)
+	{
+		timeStampDumpChromeTrace(N, N->outputTraceJsonFilePath);
+	}
+
 	if (N->mode & kCommonModeCallStatistics)
 	{
 		uint64_t	irNodeCount = 0, symbolTableNodeCount = 0;
@@ -363,6 +428,10 @@ processFile(State *  N, char *  fileName)
 		flexprint(N->Fe, N->Fm, N->Fpinfo, "Intermediate Representation Information:\n\n");
 		flexprint(N->Fe, N->Fm, N->Fpinfo, "    IR node count                        : %llu\n", irNodeCount);
 		flexprint(N->Fe, N->Fm, N->Fpinfo, "    Symbol Table node count              : %llu\n", symbolTableNodeCount);
+		flexprint(N->Fe, N->Fm, N->Fpinfo, "\n");
+
+		commonStringInternDumpStatistics(N);
+		commonArenaDumpStatistics(N);
 
 		/*
 		 *	Libflex malloc statistics:
@@ -391,8 +460,12 @@ usage(State *  N)
 						"                | (--verbose <level>, -v <level>)                    \n"
 						"                | (--dot <level>, -d <level>)                        \n"
 						"                | (--bytecode <output file name>, -b <output file name>)\n"
-						"                | (--optimize <level>, -O <level>)                   \n"
+						"                | (--optimize <0-3|s|z>, -O <0-3|s|z>)               \n"
 						"                | (--trace, -t)                                      \n"
+						"                | (--trace-json <path to output file>)               \n"
+						"                | (--emit-object)                                    \n"
+						"                | (--run)                                            \n"
+						"                | (--frame-pool)                                     \n"
 						"                | (--statistics, -s) ]                               \n"
 						"                                                                     \n"
 						"              <filenames>\n\n");
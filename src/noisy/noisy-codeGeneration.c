@@ -21,28 +21,46 @@
 #include "noisy-codeGeneration.h"
 #include "common-irHelpers.h"
 #include "noisy-typeCheck.h"
+#include "noisyLib.h"
+#include "noisyParallel.h"
+#include "noisyChannel.h"
+#include "noisyFramePool.h"
 #include <llvm-c/Core.h>
 #include <llvm-c/BitWriter.h>
 #include <llvm-c/Analysis.h>
-#include <llvm-c/Transforms/Coroutines.h>
-#include <llvm-c/Transforms/InstCombine.h>
-#include <llvm-c/Transforms/PassManagerBuilder.h>
+#include <llvm-c/BitReader.h>
+#include <llvm-c/LLJIT.h>
+#include <llvm-c/Orc.h>
+#include <llvm-c/Target.h>
+#include <llvm-c/TargetMachine.h>
+#include <llvm-c/Transforms/PassBuilder.h>
 
 typedef struct FrameListNode {
 	LLVMValueRef		frameValue;
 	Symbol *		ownerFunction;
+	int			blockDepth;
 	struct FrameListNode *	next;
 } FrameListNode;
 
 typedef FrameListNode *  FrameList;
 
+typedef struct ChannelListNode {
+	Symbol *		instanceSymbol;
+	LLVMValueRef		channelValue;
+	struct ChannelListNode *	next;
+} ChannelListNode;
+
+typedef ChannelListNode *  ChannelList;
+
 typedef struct {
 	LLVMContextRef		theContext;
 	LLVMBuilderRef		theBuilder;
 	LLVMModuleRef		theModule;
 	LLVMValueRef		currentFunction;
-	LLVMPassManagerRef	thePassManager;
+	LLVMTargetMachineRef	theTargetMachine;
 	FrameList		frameList;
+	int			blockDepth;
+	ChannelList		channelList;
 	LLVMBasicBlockRef	suspendBB;
 	LLVMBasicBlockRef	cleanupBB;
 } CodeGenState;
@@ -58,6 +76,7 @@ noisyAddFrameToList(FrameList list, LLVMValueRef frame, Symbol * ownerFunction)
 	FrameListNode * newFrameNode = (FrameListNode *)malloc(sizeof(FrameListNode));
 	newFrameNode->frameValue     = frame;
 	newFrameNode->ownerFunction  = ownerFunction;
+	newFrameNode->blockDepth     = 0;
 	newFrameNode->next	     = list;
 	list			     = newFrameNode;
 	return list;
@@ -89,27 +108,89 @@ noisyGetFrameFromList(FrameList list)
 	return list->frameValue;
 }
 
+/*
+ *	A return destroys all the instances of the function. Those of enclosing blocks are still
+ *	live on the paths that do not return, so only the ones of the returning block leave the list.
+ */
 void
 noisyDestroyCoroutineFrames(State *  N, CodeGenState *  S)
 {
-	FrameListNode *  iter = S->frameList;
-	while (iter != NULL)
+	FrameList *  link = &S->frameList;
+	while (*link != NULL)
 	{
-		if (iter->ownerFunction == N->currentFunction)
+		if ((*link)->ownerFunction == N->currentFunction)
 		{
-			int		argNum = 1;
-			LLVMValueRef	args[1];
-
-			args[0] = noisyGetFrameFromList(iter);
-			iter = noisyRemoveFrameFromList(iter);
+			LLVMValueRef args[]   = {noisyGetFrameFromList(*link)};
 			LLVMValueRef callFunc = LLVMGetNamedFunction(S->theModule, "llvm.coro.destroy");
-			LLVMBuildCall2(S->theBuilder, LLVMGetElementType(LLVMTypeOf(callFunc)), callFunc, args, argNum, "");
+			LLVMBuildCall2(S->theBuilder, LLVMGetElementType(LLVMTypeOf(callFunc)), callFunc, args, 1, "");
+		}
+
+		if ((*link)->ownerFunction == N->currentFunction && (*link)->blockDepth == S->blockDepth)
+		{
+			*link = noisyRemoveFrameFromList(*link);
+		}
+		else
+		{
+			link = &(*link)->next;
+		}
+	}
+}
+
+/*
+ *	Instances defined in a block cannot be used after it. We destroy them at its end rather than
+ *	at the end of the function, so a loop that loads an instance in every iteration does not pile
+ *	up frames, and the next iteration can reuse the frame. A block that ends in a return has
+ *	destroyed them there, so we only drop them, before a sibling block at the same depth ends.
+ */
+void
+noisyDestroyBlockFrames(State *  N, CodeGenState *  S)
+{
+	bool	     isTerminated = LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(S->theBuilder)) != NULL;
+	FrameList *  link	  = &S->frameList;
+	while (*link != NULL)
+	{
+		if ((*link)->ownerFunction == N->currentFunction && (*link)->blockDepth == S->blockDepth)
+		{
+			if (!isTerminated)
+			{
+				LLVMValueRef args[]   = {noisyGetFrameFromList(*link)};
+				LLVMValueRef callFunc = LLVMGetNamedFunction(S->theModule, "llvm.coro.destroy");
+				LLVMBuildCall2(S->theBuilder, LLVMGetElementType(LLVMTypeOf(callFunc)), callFunc, args, 1, "");
+			}
+			*link = noisyRemoveFrameFromList(*link);
 		}
 		else
 		{
-			iter = iter->next;
+			link = &(*link)->next;
+		}
+	}
+}
+
+/*
+ *	In the body of a parallel statement, the function instances it captures are reached through
+ *	channels of the runtime. We keep the channel of each such instance while we generate the body.
+ */
+ChannelList
+noisyAddChannelToList(ChannelList list, Symbol *  instanceSymbol, LLVMValueRef channel)
+{
+	ChannelListNode * newChannelNode = (ChannelListNode *)malloc(sizeof(ChannelListNode));
+	newChannelNode->instanceSymbol	 = instanceSymbol;
+	newChannelNode->channelValue	 = channel;
+	newChannelNode->next		 = list;
+	return newChannelNode;
+}
+
+LLVMValueRef
+noisyGetChannelOfInstance(ChannelList list, Symbol *  instanceSymbol)
+{
+	for (ChannelListNode *  iter = list; iter != NULL; iter = iter->next)
+	{
+		if (iter->instanceSymbol == instanceSymbol)
+		{
+			return iter->channelValue;
 		}
 	}
+	return NULL;
 }
 
 LLVMTypeRef	getLLVMTypeFromTypeExpr(State *, IrNode *);
@@ -224,6 +305,26 @@ noisyDeclareCoroutineIntrinsics(CodeGenState * S)
 	LLVMAddFunction(S->theModule, "llvm.coro.destroy", functionType);
 }
 
+/*
+ *	With --frame-pool, coroutine frames come from noisyFramePoolAllocate and go back with
+ *	noisyFramePoolFree instead of malloc and free.
+ */
+LLVMValueRef
+noisyFramePoolCallCodeGen(CodeGenState *  S, const char *  functionName, LLVMValueRef argument)
+{
+	bool	     isAllocate	     = !strcmp(functionName, "noisyFramePoolAllocate");
+	LLVMTypeRef  bytePointerType = LLVMPointerType(LLVMInt8TypeInContext(S->theContext), 0);
+	LLVMTypeRef  paramType	     = isAllocate ? LLVMInt64TypeInContext(S->theContext) : bytePointerType;
+	LLVMTypeRef  functionType    = LLVMFunctionType(isAllocate ? bytePointerType : LLVMVoidTypeInContext(S->theContext), &paramType, 1, false);
+	LLVMValueRef function	     = LLVMGetNamedFunction(S->theModule, functionName);
+	if (function == NULL)
+	{
+		function = LLVMAddFunction(S->theModule, functionName, functionType);
+	}
+
+	return LLVMBuildCall2(S->theBuilder, functionType, function, &argument, 1, isAllocate ? "k_alloc" : "");
+}
+
 /*
  *	TODO; Find better name for that function.
  */
@@ -261,6 +362,14 @@ noisyGenerateCoroutineInitials(CodeGenState *  S, State *  N, IrNode *  outputSi
 	LLVMValueRef callFunc  = LLVMGetNamedFunction(S->theModule, "llvm.coro.id");
 	LLVMValueRef coroToken = LLVMBuildCall2(S->theBuilder, LLVMGetElementType(LLVMTypeOf(callFunc)), callFunc, args, argNum, "k_coroId");
 
+	/*
+	 *	The coroutine passes only split the functions the front end marked
+	 *	as coroutines that have not been split yet.
+	 */
+	char *		 presplitAttr	 = "coroutine.presplit";
+	LLVMAttributeRef presplitAttrRef = LLVMCreateStringAttribute(S->theContext, presplitAttr, strlen(presplitAttr), "0", 1);
+	LLVMAddAttributeAtIndex(S->currentFunction, LLVMAttributeFunctionIndex, presplitAttrRef);
+
 	/*
 	 *	Check if dynamic memory allocation is needed for coro token.
 	 */
@@ -282,8 +391,16 @@ noisyGenerateCoroutineInitials(CodeGenState *  S, State *  N, IrNode *  outputSi
 	callFunc	  = LLVMGetNamedFunction(S->theModule, "llvm.coro.size.i32");
 	LLVMValueRef size = LLVMBuildCall2(S->theBuilder, LLVMGetElementType(LLVMTypeOf(callFunc)), callFunc, args, argNum, "k_size");
 
-	LLVMValueRef mallocedMem = LLVMBuildArrayMalloc(S->theBuilder, LLVMInt1TypeInContext(S->theContext), size, "k_alloc");
-	mallocedMem		 = LLVMBuildBitCast(S->theBuilder, mallocedMem, LLVMPointerType(LLVMInt8TypeInContext(S->theContext), 0), "");
+	LLVMValueRef mallocedMem;
+	if (N->irPasses & kNoisyIrPassCoroutineFramePool)
+	{
+		mallocedMem = noisyFramePoolCallCodeGen(S, "noisyFramePoolAllocate", LLVMBuildZExt(S->theBuilder, size, LLVMInt64TypeInContext(S->theContext), ""));
+	}
+	else
+	{
+		mallocedMem = LLVMBuildArrayMalloc(S->theBuilder, LLVMInt1TypeInContext(S->theContext), size, "k_alloc");
+		mallocedMem = LLVMBuildBitCast(S->theBuilder, mallocedMem, LLVMPointerType(LLVMInt8TypeInContext(S->theContext), 0), "");
+	}
 
 	LLVMBuildBr(S->theBuilder, coroBegin);
 	LLVMPositionBuilderAtEnd(S->theBuilder, coroBegin);
@@ -343,7 +460,14 @@ noisyGenerateCoroutineInitials(CodeGenState *  S, State *  N, IrNode *  outputSi
 	/*
 	 *	On dynamic free we free the malloc'ed memory and we branch to suspend.
 	 */
-	LLVMBuildFree(S->theBuilder, mem);
+	if (N->irPasses & kNoisyIrPassCoroutineFramePool)
+	{
+		noisyFramePoolCallCodeGen(S, "noisyFramePoolFree", mem);
+	}
+	else
+	{
+		LLVMBuildFree(S->theBuilder, mem);
+	}
 	LLVMBuildBr(S->theBuilder, suspendBB);
 
 	LLVMPositionBuilderAtEnd(S->theBuilder, suspendBB);
@@ -873,7 +997,10 @@ noisyFactorCodeGen(State *  N, CodeGenState *  S, IrNode *  noisyFactorNode)
 	else if (L(noisyFactorNode)->type == kNoisyIrNodeType_PqualifiedIdentifier)
 	{
 		Symbol *  identifierSymbol = LL(noisyFactorNode)->symbol;
-		if (identifierSymbol->symbolType == kNoisySymbolTypeParameter)
+		/*
+		 *	In the body of a parallel statement a parameter is read through its copy in the environment.
+		 */
+		if (identifierSymbol->symbolType == kNoisySymbolTypeParameter && identifierSymbol->llvmPointer == NULL)
 		{
 			if (identifierSymbol->noisyType.basicType != noisyBasicTypeArrayType && identifierSymbol->noisyType.basicType != noisyBasicTypeString)
 			{
@@ -1217,6 +1344,73 @@ noisyFactorCodeGen(State *  N, CodeGenState *  S, IrNode *  noisyFactorNode)
 	return LLVMConstNull(LLVMInt32TypeInContext(S->theContext));
 }
 
+/*
+ *	The types of the messages on the output and on the input channel of a channel function.
+ */
+NoisyType
+noisyChannelOutputType(Symbol *  functionSymbol)
+{
+	return (functionSymbol->typeTree->type != kNoisyIrNodeType_PfunctionDecl) ? RL(functionSymbol->typeTree)->symbol->noisyType
+										  : RLL(functionSymbol->typeTree)->symbol->noisyType;
+}
+
+NoisyType
+noisyChannelInputType(State *  N, Symbol *  functionSymbol)
+{
+	return getNoisyTypeFromTypeExpr(N, LRL(functionSymbol->typeTree));
+}
+
+LLVMValueRef
+noisySizeOfType(CodeGenState *  S, LLVMTypeRef type)
+{
+	LLVMValueRef oneVal[]	   = {LLVMConstInt(LLVMInt64TypeInContext(S->theContext), 1, false)};
+	LLVMValueRef sizeOfExprVal = LLVMBuildGEP2(S->theBuilder, type, LLVMConstPointerNull(LLVMPointerType(type, 0)), oneVal, 1, "");
+	return LLVMBuildPtrToInt(S->theBuilder, sizeOfExprVal, LLVMInt64TypeInContext(S->theContext), "k_sizeOfT");
+}
+
+/*
+ *	An alloca in the entry block happens once per call, not once per iteration of the loop it is used in.
+ */
+LLVMValueRef
+noisyBuildEntryAlloca(CodeGenState *  S, LLVMTypeRef type, const char *  name)
+{
+	LLVMBasicBlockRef currentBlock	   = LLVMGetInsertBlock(S->theBuilder);
+	LLVMBasicBlockRef entryBlock	   = LLVMGetEntryBasicBlock(S->currentFunction);
+	LLVMValueRef	  firstInstruction = LLVMGetFirstInstruction(entryBlock);
+
+	if (firstInstruction != NULL)
+	{
+		LLVMPositionBuilderBefore(S->theBuilder, firstInstruction);
+	}
+	else
+	{
+		LLVMPositionBuilderAtEnd(S->theBuilder, entryBlock);
+	}
+	LLVMValueRef allocaVal = LLVMBuildAlloca(S->theBuilder, type, name);
+	LLVMPositionBuilderAtEnd(S->theBuilder, currentBlock);
+
+	return allocaVal;
+}
+
+/*
+ *	Calls noisyChannelSend or noisyChannelReceive of the runtime with the address of the message.
+ */
+void
+noisyChannelCallCodeGen(CodeGenState *  S, const char *  functionName, LLVMValueRef channel, LLVMValueRef message)
+{
+	LLVMTypeRef  bytePointerType = LLVMPointerType(LLVMInt8TypeInContext(S->theContext), 0);
+	LLVMTypeRef  paramTypes[]    = {bytePointerType, bytePointerType};
+	LLVMTypeRef  functionType    = LLVMFunctionType(LLVMVoidTypeInContext(S->theContext), paramTypes, 2, false);
+	LLVMValueRef function	     = LLVMGetNamedFunction(S->theModule, functionName);
+	if (function == NULL)
+	{
+		function = LLVMAddFunction(S->theModule, functionName, functionType);
+	}
+
+	LLVMValueRef args[] = {channel, LLVMBuildBitCast(S->theBuilder, message, bytePointerType, "")};
+	LLVMBuildCall2(S->theBuilder, functionType, function, args, 2, "");
+}
+
 LLVMValueRef
 noisyUnaryOpCodeGen(State *  N, CodeGenState *  S, IrNode *  noisyUnaryOpNode, LLVMValueRef termVal, IrNode *  noisyFactorNode)
 {
@@ -1262,23 +1456,36 @@ noisyUnaryOpCodeGen(State *  N, CodeGenState *  S, IrNode *  noisyUnaryOpNode, L
 			 */
 			if (factorNoisyType.basicType == noisyBasicTypeNamegenType)
 			{
-				int	     argNum = 1;
-				LLVMValueRef args[3];
-				args[0]		      = termVal;
-				LLVMValueRef callFunc = LLVMGetNamedFunction(S->theModule, "llvm.coro.resume");
-				LLVMBuildCall2(S->theBuilder, LLVMGetElementType(LLVMTypeOf(callFunc)), callFunc, args, argNum, "");
 				/*
 				 *	Case for autogen coroutines.
 				 */
-				NoisyType   outputNoisyType = (factorNoisyType.functionDefinition->typeTree->type != kNoisyIrNodeType_PfunctionDecl) ? RL(factorNoisyType.functionDefinition->typeTree)->symbol->noisyType
-																		     : RLL(factorNoisyType.functionDefinition->typeTree)->symbol->noisyType;
-				LLVMTypeRef outputType	    = getLLVMTypeFromNoisyType(S, outputNoisyType, true, 0);
-				argNum			    = 3;
-				args[0]			    = termVal;
-				args[1]			    = LLVMConstInt(LLVMInt32TypeInContext(S->theContext), 0, false);
-				args[2]			    = LLVMConstInt(LLVMInt1TypeInContext(S->theContext), 0, false);
-				callFunc		    = LLVMGetNamedFunction(S->theModule, "llvm.coro.promise");
-				LLVMValueRef promiseAddr    = LLVMBuildCall2(S->theBuilder, LLVMGetElementType(LLVMTypeOf(callFunc)), callFunc, args, argNum, "k_promiseAddrRaw");
+				NoisyType    outputNoisyType = noisyChannelOutputType(factorNoisyType.functionDefinition);
+				LLVMTypeRef  outputType	     = getLLVMTypeFromNoisyType(S, outputNoisyType, true, 0);
+				LLVMValueRef channel	     = (L(noisyFactorNode)->type == kNoisyIrNodeType_PqualifiedIdentifier) ? noisyGetChannelOfInstance(S->channelList, LL(noisyFactorNode)->symbol)
+															   : NULL;
+				LLVMValueRef promiseAddr;
+				if (channel != NULL)
+				{
+					/*
+					 *	The instance belongs to the function around the parallel statement we are in.
+					 */
+					promiseAddr = noisyBuildEntryAlloca(S, getLLVMTypeFromNoisyType(S, outputNoisyType, false, 0), "k_channelMessage");
+					noisyChannelCallCodeGen(S, "noisyChannelReceive", channel, promiseAddr);
+				}
+				else
+				{
+					int	     argNum = 1;
+					LLVMValueRef args[3];
+					args[0]		      = termVal;
+					LLVMValueRef callFunc = LLVMGetNamedFunction(S->theModule, "llvm.coro.resume");
+					LLVMBuildCall2(S->theBuilder, LLVMGetElementType(LLVMTypeOf(callFunc)), callFunc, args, argNum, "");
+					argNum	    = 3;
+					args[0]	    = termVal;
+					args[1]	    = LLVMConstInt(LLVMInt32TypeInContext(S->theContext), 0, false);
+					args[2]	    = LLVMConstInt(LLVMInt1TypeInContext(S->theContext), 0, false);
+					callFunc    = LLVMGetNamedFunction(S->theModule, "llvm.coro.promise");
+					promiseAddr = LLVMBuildCall2(S->theBuilder, LLVMGetElementType(LLVMTypeOf(callFunc)), callFunc, args, argNum, "k_promiseAddrRaw");
+				}
 				if (outputNoisyType.basicType == noisyBasicTypeArrayType)
 				{
 					promiseAddr = LLVMBuildBitCast(S->theBuilder, promiseAddr, outputType, "k_promiseAddr");
@@ -1933,6 +2140,13 @@ noisyAssignmentStatementCodeGen(State *  N, CodeGenState *  S, IrNode *  noisyAs
 							asprintf(&name, "var_%s", lvalSym->identifier);
 							lvalSym->llvmPointer = LLVMBuildAlloca(S->theBuilder, getLLVMTypeFromNoisyType(S, lvalSym->noisyType, false, 0), name);
 						}
+						else if (S->frameList != NULL && S->frameList->frameValue == exprVal)
+						{
+							/*
+							 *	The instance lives as long as the block that defines it.
+							 */
+							S->frameList->blockDepth = S->blockDepth;
+						}
 						break;
 					case kNoisyIrNodeType_TplusAssign:
 						asprintf(&name, "val_%s", lvalSym->identifier);
@@ -2171,7 +2385,17 @@ noisyAssignmentStatementCodeGen(State *  N, CodeGenState *  S, IrNode *  noisyAs
 							/*
 							 *	TODO; CHANGE llvmsym pointer to llvm chan address.
 							 */
+							LLVMValueRef channel	      = noisyGetChannelOfInstance(S->channelList, lvalSym);
 							LLVMValueRef inputChanAddress = lvalSym->noisyType.functionDefinition->inputChanAddress;
+							if (channel != NULL)
+							{
+								/*
+								 *	The instance belongs to the function around the parallel statement we are in,
+								 *	so the message goes through its channel.
+								 */
+								LLVMTypeRef inputType = getLLVMTypeFromNoisyType(S, noisyChannelInputType(N, lvalSym->noisyType.functionDefinition), false, 0);
+								inputChanAddress      = noisyBuildEntryAlloca(S, inputType, "k_channelMessage");
+							}
 							if (RRL(noisyAssignmentStatementNode)->noisyType.basicType == noisyBasicTypeArrayType)
 							{
 								/*
@@ -2212,6 +2436,11 @@ noisyAssignmentStatementCodeGen(State *  N, CodeGenState *  S, IrNode *  noisyAs
 							{
 								LLVMBuildStore(S->theBuilder, exprVal, inputChanAddress);
 							}
+							if (channel != NULL)
+							{
+								noisyChannelCallCodeGen(S, "noisyChannelSend", channel, inputChanAddress);
+								return;
+							}
 							int	     argNum = 1;
 							LLVMValueRef args[1];
 							args[0]		      = lvalSym->llvmPointer;
@@ -2312,6 +2541,18 @@ noisyAssignmentStatementCodeGen(State *  N, CodeGenState *  S, IrNode *  noisyAs
 	}
 }
 
+/*
+ *	The statement list of a guarded statement, of a loop or of braces.
+ */
+void
+noisyBlockCodeGen(State *  N, CodeGenState *  S, IrNode *  statementListNode)
+{
+	S->blockDepth++;
+	noisyStatementListCodeGen(N, S, statementListNode);
+	noisyDestroyBlockFrames(N, S);
+	S->blockDepth--;
+}
+
 void
 noisyMatchStatementCodeGen(State *  N, CodeGenState *  S, IrNode *  matchNode)
 {
@@ -2338,7 +2579,7 @@ noisyMatchStatementCodeGen(State *  N, CodeGenState *  S, IrNode *  matchNode)
 
 			LLVMBuildCondBr(S->theBuilder, condVal, thenBlock, elseBlock);
 			LLVMPositionBuilderAtEnd(S->theBuilder, thenBlock);
-			noisyStatementListCodeGen(N, S, RLL(iter));
+			noisyBlockCodeGen(N, S, RLL(iter));
 			/*
 			 *	TODO; This is questionable. I added it so we can have a return statemnt inside statements that end with branc instruction.
 			 *	Probably it works.
@@ -2384,7 +2625,7 @@ noisyMatchStatementCodeGen(State *  N, CodeGenState *  S, IrNode *  matchNode)
 			LLVMBuildCondBr(S->theBuilder, condVal, thenBlock, afterBlock);
 
 			LLVMPositionBuilderAtEnd(S->theBuilder, thenBlock);
-			noisyStatementListCodeGen(N, S, RLL(iter));
+			noisyBlockCodeGen(N, S, RLL(iter));
 
 			LLVMValueRef terminatorValue = LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(S->theBuilder));
 			;
@@ -2422,7 +2663,7 @@ noisyIterateStatementCodeGen(State *  N, CodeGenState *  S, IrNode *  iterateNod
 		LLVMBuildCondBr(S->theBuilder, condVal, thenBlock, afterBlock);
 
 		LLVMPositionBuilderAtEnd(S->theBuilder, thenBlock);
-		noisyStatementListCodeGen(N, S, RLL(iter));
+		noisyBlockCodeGen(N, S, RLL(iter));
 		LLVMBuildBr(S->theBuilder, loopBlock);
 
 		LLVMPositionBuilderAtEnd(S->theBuilder, afterBlock);
@@ -2443,7 +2684,7 @@ noisySequenceStatementCodeGen(State *  N, CodeGenState *  S, IrNode *  sequenceN
 	LLVMBuildCondBr(S->theBuilder, condVal, loopBlock, afterBlock);
 
 	LLVMPositionBuilderAtEnd(S->theBuilder, loopBlock);
-	noisyStatementListCodeGen(N, S, RL(sequenceNode));
+	noisyBlockCodeGen(N, S, RL(sequenceNode));
 	noisyAssignmentStatementCodeGen(N, S, LRR(sequenceNode)->irLeftChild);
 
 	LLVMValueRef terminatorValue = LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(S->theBuilder));
@@ -2466,6 +2707,456 @@ noisySequenceStatementCodeGen(State *  N, CodeGenState *  S, IrNode *  sequenceN
 	LLVMPositionBuilderAtEnd(S->theBuilder, afterBlock);
 }
 
+/*
+ *	Whether a value is an instruction or an argument of the function we generate code for.
+ */
+bool
+noisyIsLocalValue(CodeGenState *  S, LLVMValueRef value)
+{
+	if (value == NULL)
+	{
+		return false;
+	}
+	else if (LLVMIsAInstruction(value) != NULL)
+	{
+		return LLVMGetBasicBlockParent(LLVMGetInstructionParent(value)) == S->currentFunction;
+	}
+	else if (LLVMIsAArgument(value) != NULL)
+	{
+		return LLVMGetParamParent(value) == S->currentFunction;
+	}
+	return false;
+}
+
+/*
+ *	Collects the variables of the enclosing function that the body of a parallel statement uses.
+ *	Scalar parameters have no address, they are read with LLVMGetParam, so we collect them too.
+ */
+void
+noisyParallelCollectCaptures(CodeGenState *  S, IrNode *  node, Symbol *  indexSymbol, Symbol ***  captures, int *  captureCount)
+{
+	if (node == NULL)
+	{
+		return;
+	}
+
+	if (node->type == kNoisyIrNodeType_PqualifiedIdentifier && L(node)->symbol != NULL && L(node)->symbol != indexSymbol)
+	{
+		Symbol *  symbol	    = L(node)->symbol;
+		bool	  isScalarParameter = symbol->symbolType == kNoisySymbolTypeParameter && symbol->llvmPointer == NULL
+					    && symbol->noisyType.basicType != noisyBasicTypeArrayType && symbol->noisyType.basicType != noisyBasicTypeString;
+
+		if (noisyIsLocalValue(S, symbol->llvmPointer) || isScalarParameter)
+		{
+			bool isCaptured = false;
+			for (int i = 0; i < *captureCount; i++)
+			{
+				isCaptured |= (*captures)[i] == symbol;
+			}
+
+			if (!isCaptured)
+			{
+				*captures		     = realloc(*captures, (*captureCount + 1) * sizeof(Symbol *));
+				(*captures)[(*captureCount)++] = symbol;
+			}
+		}
+	}
+
+	noisyParallelCollectCaptures(S, L(node), indexSymbol, captures, captureCount);
+	noisyParallelCollectCaptures(S, R(node), indexSymbol, captures, captureCount);
+}
+
+/*
+ *	Counts the receives from and the sends to instanceSymbol in the body of a parallel statement.
+ */
+void
+noisyParallelCountChannelOps(IrNode *  node, Symbol *  instanceSymbol, int *  sendCount, int *  receiveCount)
+{
+	if (node == NULL)
+	{
+		return;
+	}
+
+	if (node->type == kNoisyIrNodeType_PunaryOp && L(node) != NULL && L(node)->type == kNoisyIrNodeType_TchannelOperator
+	    && node->irParent != NULL && R(node->irParent) != NULL && RL(node->irParent) != NULL
+	    && RL(node->irParent)->type == kNoisyIrNodeType_PqualifiedIdentifier && L(RL(node->irParent))->symbol == instanceSymbol)
+	{
+		(*receiveCount)++;
+	}
+	else if (node->type == kNoisyIrNodeType_PassignmentStatement && R(node) != NULL && R(node)->type == kNoisyIrNodeType_Xseq
+		 && RLL(node)->type == kNoisyIrNodeType_TchannelOperatorAssign)
+	{
+		for (IrNode *  iter = L(node); iter != NULL; iter = R(iter))
+		{
+			if (LL(iter)->type == kNoisyIrNodeType_PqualifiedIdentifier && LLL(iter)->symbol == instanceSymbol)
+			{
+				(*sendCount)++;
+			}
+		}
+	}
+
+	noisyParallelCountChannelOps(L(node), instanceSymbol, sendCount, receiveCount);
+	noisyParallelCountChannelOps(R(node), instanceSymbol, sendCount, receiveCount);
+}
+
+/*
+ *	Whether a parallel statement nested in node sends to or receives from instanceSymbol. It uses
+ *	the channel of the enclosing statement from all its indexes at once, whatever the count of that one.
+ */
+bool
+noisyParallelNestedUsesChannel(IrNode *  node, Symbol *  instanceSymbol)
+{
+	if (node == NULL)
+	{
+		return false;
+	}
+
+	if (node->type == kNoisyIrNodeType_PparallelStatement)
+	{
+		int sendCount	 = 0;
+		int receiveCount = 0;
+		noisyParallelCountChannelOps(R(node), instanceSymbol, &sendCount, &receiveCount);
+		if (sendCount + receiveCount > 0)
+		{
+			return true;
+		}
+	}
+
+	return noisyParallelNestedUsesChannel(L(node), instanceSymbol) || noisyParallelNestedUsesChannel(R(node), instanceSymbol);
+}
+
+/*
+ *	The functions the channel runtime calls to hand a message to an instance of functionSymbol and to
+ *	get one from it. They do what a send or a receive does on an instance without a channel.
+ */
+LLVMValueRef
+noisyChannelServeCodeGen(State *  N, CodeGenState *  S, Symbol *  functionSymbol, bool isWrite)
+{
+	char *	name;
+	asprintf(&name, isWrite ? "k_channelWrite_%s" : "k_channelRead_%s", functionSymbol->identifier);
+	LLVMValueRef serveFunction = LLVMGetNamedFunction(S->theModule, name);
+	if (serveFunction != NULL)
+	{
+		free(name);
+		return serveFunction;
+	}
+
+	LLVMTypeRef	  bytePointerType = LLVMPointerType(LLVMInt8TypeInContext(S->theContext), 0);
+	LLVMTypeRef	  serveParamTypes[] = {bytePointerType, bytePointerType, bytePointerType};
+	LLVMTypeRef	  serveType	    = LLVMFunctionType(LLVMVoidTypeInContext(S->theContext), serveParamTypes, 3, false);
+	LLVMBasicBlockRef parentBlock	    = LLVMGetInsertBlock(S->theBuilder);
+
+	serveFunction = LLVMAddFunction(S->theModule, name, serveType);
+	LLVMSetLinkage(serveFunction, LLVMInternalLinkage);
+	LLVMPositionBuilderAtEnd(S->theBuilder, LLVMAppendBasicBlock(serveFunction, "entry"));
+	free(name);
+
+	LLVMValueRef instance	  = LLVMGetParam(serveFunction, 0);
+	LLVMValueRef message	  = LLVMGetParam(serveFunction, 2);
+	LLVMValueRef resumeArgs[] = {instance};
+	LLVMValueRef resumeFunc	  = LLVMGetNamedFunction(S->theModule, "llvm.coro.resume");
+	if (isWrite)
+	{
+		LLVMTypeRef inputType = getLLVMTypeFromNoisyType(S, noisyChannelInputType(N, functionSymbol), false, 0);
+		LLVMBuildMemCpy(S->theBuilder, LLVMGetParam(serveFunction, 1), 0, message, 0, noisySizeOfType(S, inputType));
+		LLVMBuildCall2(S->theBuilder, LLVMGetElementType(LLVMTypeOf(resumeFunc)), resumeFunc, resumeArgs, 1, "");
+	}
+	else
+	{
+		LLVMTypeRef outputType = getLLVMTypeFromNoisyType(S, noisyChannelOutputType(functionSymbol), false, 0);
+		LLVMBuildCall2(S->theBuilder, LLVMGetElementType(LLVMTypeOf(resumeFunc)), resumeFunc, resumeArgs, 1, "");
+
+		LLVMValueRef promiseArgs[] = {instance, LLVMConstInt(LLVMInt32TypeInContext(S->theContext), 0, false), LLVMConstInt(LLVMInt1TypeInContext(S->theContext), 0, false)};
+		LLVMValueRef promiseFunc   = LLVMGetNamedFunction(S->theModule, "llvm.coro.promise");
+		LLVMValueRef promiseAddr   = LLVMBuildCall2(S->theBuilder, LLVMGetElementType(LLVMTypeOf(promiseFunc)), promiseFunc, promiseArgs, 3, "");
+		LLVMBuildMemCpy(S->theBuilder, message, 0, promiseAddr, 0, noisySizeOfType(S, outputType));
+	}
+	LLVMBuildRetVoid(S->theBuilder);
+
+	LLVMPositionBuilderAtEnd(S->theBuilder, parentBlock);
+
+	return serveFunction;
+}
+
+/*
+ *	Calls noisyChannelCreate of the runtime for an instance the body of a parallel statement uses.
+ *	A direction the body does not use gets no ring.
+ */
+LLVMValueRef
+noisyChannelCreateCodeGen(State *  N, CodeGenState *  S, Symbol *  instanceSymbol, bool isShared, bool hasWrites, bool hasReads)
+{
+	Symbol *     functionSymbol  = instanceSymbol->noisyType.functionDefinition;
+	LLVMTypeRef  bytePointerType = LLVMPointerType(LLVMInt8TypeInContext(S->theContext), 0);
+	LLVMTypeRef  int64Type	     = LLVMInt64TypeInContext(S->theContext);
+	LLVMTypeRef  serveParamTypes[] = {bytePointerType, bytePointerType, bytePointerType};
+	LLVMTypeRef  servePointerType  = LLVMPointerType(LLVMFunctionType(LLVMVoidTypeInContext(S->theContext), serveParamTypes, 3, false), 0);
+	LLVMTypeRef  createParamTypes[] = {LLVMInt32TypeInContext(S->theContext), bytePointerType, bytePointerType, servePointerType, int64Type, servePointerType, int64Type};
+	LLVMTypeRef  createType	       = LLVMFunctionType(bytePointerType, createParamTypes, 7, false);
+	LLVMValueRef createFunction    = LLVMGetNamedFunction(S->theModule, "noisyChannelCreate");
+	if (createFunction == NULL)
+	{
+		createFunction = LLVMAddFunction(S->theModule, "noisyChannelCreate", createType);
+	}
+
+	LLVMValueRef args[7];
+	args[0] = LLVMConstInt(LLVMInt32TypeInContext(S->theContext), isShared ? kNoisyChannelMultipleProducerMultipleConsumer : kNoisyChannelSingleProducerSingleConsumer, false);
+	args[1] = LLVMBuildBitCast(S->theBuilder, instanceSymbol->llvmPointer, bytePointerType, "");
+	args[2] = (functionSymbol->inputChanAddress != NULL) ? LLVMBuildBitCast(S->theBuilder, functionSymbol->inputChanAddress, bytePointerType, "")
+							      : LLVMConstPointerNull(bytePointerType);
+	if (hasWrites)
+	{
+		args[3] = noisyChannelServeCodeGen(N, S, functionSymbol, true);
+		args[4] = noisySizeOfType(S, getLLVMTypeFromNoisyType(S, noisyChannelInputType(N, functionSymbol), false, 0));
+	}
+	else
+	{
+		args[3] = LLVMConstPointerNull(servePointerType);
+		args[4] = LLVMConstInt(int64Type, 0, false);
+	}
+	if (hasReads)
+	{
+		args[5] = noisyChannelServeCodeGen(N, S, functionSymbol, false);
+		args[6] = noisySizeOfType(S, getLLVMTypeFromNoisyType(S, noisyChannelOutputType(functionSymbol), false, 0));
+	}
+	else
+	{
+		args[5] = LLVMConstPointerNull(servePointerType);
+		args[6] = LLVMConstInt(int64Type, 0, false);
+	}
+
+	return LLVMBuildCall2(S->theBuilder, createType, createFunction, args, 7, "k_channel");
+}
+
+void
+noisyChannelDestroyCodeGen(CodeGenState *  S, LLVMValueRef channel)
+{
+	LLVMTypeRef  bytePointerType = LLVMPointerType(LLVMInt8TypeInContext(S->theContext), 0);
+	LLVMTypeRef  destroyType     = LLVMFunctionType(LLVMVoidTypeInContext(S->theContext), &bytePointerType, 1, false);
+	LLVMValueRef destroyFunction = LLVMGetNamedFunction(S->theModule, "noisyChannelDestroy");
+	if (destroyFunction == NULL)
+	{
+		destroyFunction = LLVMAddFunction(S->theModule, "noisyChannelDestroy", destroyType);
+	}
+
+	LLVMBuildCall2(S->theBuilder, destroyType, destroyFunction, &channel, 1, "");
+}
+
+/*
+ *	The body of a parallel statement becomes a function of an environment and of an index, which
+ *	noisyParallelFor of the runtime calls for every index, on as many workers as there are, and
+ *	returns when they are all done. The environment holds the addresses of the variables the body
+ *	uses, so it updates their array elements in place. When the set is an array, the index is its
+ *	element, so that assigning to the index updates the element in place too. The typecheck keeps
+ *	the body from assigning to anything else it shares with other indexes. The environment lives on our
+ *	stack since we wait for the body, in the entry block so that a loop does not grow the stack.
+ */
+void
+noisyParallelStatementCodeGen(State *  N, CodeGenState *  S, IrNode *  parallelNode)
+{
+	IrNode *     setHeadNode	= L(parallelNode);
+	Symbol *     indexSymbol	= L(setHeadNode)->symbol;
+	NoisyType    setType		= setHeadNode->noisyType;
+	bool	     isArraySet		= setType.basicType == noisyBasicTypeArrayType;
+	LLVMTypeRef  bytePointerType	= LLVMPointerType(LLVMInt8TypeInContext(S->theContext), 0);
+	LLVMTypeRef  int64Type		= LLVMInt64TypeInContext(S->theContext);
+	Symbol **    captures		= NULL;
+	int	     captureCount	= 0;
+
+	noisyParallelCollectCaptures(S, R(parallelNode), indexSymbol, &captures, &captureCount);
+
+	LLVMValueRef setValue = noisyExpressionCodeGen(N, S, R(setHeadNode));
+	LLVMValueRef countValue;
+	if (isArraySet)
+	{
+		countValue = LLVMConstInt(int64Type, setType.sizeOfDimension[0], false);
+	}
+	else
+	{
+		countValue = LLVMBuildIntCast2(S->theBuilder, setValue, int64Type, noisyIsSigned(setType), "k_parallelCount");
+	}
+
+	/*
+	 *	The function instances the body sends to or receives from get a channel each, unless an
+	 *	enclosing parallel statement made one for them already. When at most one index runs at
+	 *	a time, and no parallel statement nested in the body uses the channel, the body side of
+	 *	a channel has a single producer and consumer.
+	 */
+	Symbol **      channelSymbols = calloc(captureCount + 1, sizeof(Symbol *));
+	LLVMValueRef * channelValues  = calloc(captureCount + 1, sizeof(LLVMValueRef));
+	bool *	       isOwnChannel   = calloc(captureCount + 1, sizeof(bool));
+	int	       channelCount   = 0;
+	bool	       isSharedBody   = LLVMIsAConstantInt(countValue) == NULL || LLVMConstIntGetSExtValue(countValue) > 1;
+	for (int i = 0; i < captureCount; i++)
+	{
+		int sendCount	 = 0;
+		int receiveCount = 0;
+		if (captures[i]->noisyType.basicType != noisyBasicTypeNamegenType)
+		{
+			continue;
+		}
+
+		noisyParallelCountChannelOps(R(parallelNode), captures[i], &sendCount, &receiveCount);
+		if (sendCount + receiveCount == 0)
+		{
+			continue;
+		}
+
+		channelSymbols[channelCount] = captures[i];
+		channelValues[channelCount]  = noisyGetChannelOfInstance(S->channelList, captures[i]);
+		if (channelValues[channelCount] == NULL)
+		{
+			bool isShared		    = isSharedBody || noisyParallelNestedUsesChannel(R(parallelNode), captures[i]);
+			channelValues[channelCount] = noisyChannelCreateCodeGen(N, S, captures[i], isShared, sendCount > 0, receiveCount > 0);
+			isOwnChannel[channelCount]  = true;
+		}
+		channelCount++;
+	}
+
+	int	       channelSlot     = captureCount + (isArraySet ? 1 : 0);
+	int	       environmentSize = channelSlot + channelCount;
+	LLVMTypeRef    environmentType = LLVMArrayType(bytePointerType, environmentSize);
+	LLVMValueRef   environment     = noisyBuildEntryAlloca(S, environmentType, "k_parallelEnv");
+	LLVMValueRef * capturedValues  = calloc(environmentSize, sizeof(LLVMValueRef));
+	for (int i = 0; i < environmentSize; i++)
+	{
+		if (i >= channelSlot)
+		{
+			capturedValues[i] = channelValues[i - channelSlot];
+		}
+		else if (i == captureCount)
+		{
+			capturedValues[i] = setValue;
+		}
+		else if (captures[i]->llvmPointer == NULL)
+		{
+			LLVMValueRef parameterValue = LLVMGetParam(S->currentFunction, captures[i]->paramPosition);
+			capturedValues[i]	    = noisyBuildEntryAlloca(S, LLVMTypeOf(parameterValue), "k_parallelParam");
+			LLVMBuildStore(S->theBuilder, parameterValue, capturedValues[i]);
+		}
+		else
+		{
+			capturedValues[i] = captures[i]->llvmPointer;
+		}
+
+		LLVMValueRef idxValueList[] = {LLVMConstInt(LLVMInt32TypeInContext(S->theContext), 0, false), LLVMConstInt(LLVMInt32TypeInContext(S->theContext), i, false)};
+		LLVMValueRef slot	    = LLVMBuildGEP2(S->theBuilder, environmentType, environment, idxValueList, 2, "k_parallelSlot");
+		LLVMBuildStore(S->theBuilder, LLVMBuildBitCast(S->theBuilder, capturedValues[i], bytePointerType, ""), slot);
+	}
+
+	/*
+	 *	Generate the body in a function of its own.
+	 */
+	LLVMTypeRef	  bodyParamTypes[] = {bytePointerType, int64Type};
+	LLVMTypeRef	  bodyType	   = LLVMFunctionType(LLVMVoidTypeInContext(S->theContext), bodyParamTypes, 2, false);
+	LLVMValueRef	  bodyFunction	   = LLVMAddFunction(S->theModule, "k_parallelBody", bodyType);
+	LLVMValueRef	  parentFunction   = S->currentFunction;
+	LLVMBasicBlockRef parentBlock	   = LLVMGetInsertBlock(S->theBuilder);
+	LLVMBasicBlockRef parentSuspendBB  = S->suspendBB;
+	LLVMBasicBlockRef parentCleanupBB  = S->cleanupBB;
+	FrameList	  parentFrameList  = S->frameList;
+	ChannelList	  parentChannelList = S->channelList;
+	LLVMValueRef *	  parentPointers   = calloc(captureCount + 1, sizeof(LLVMValueRef));
+
+	LLVMSetLinkage(bodyFunction, LLVMInternalLinkage);
+	S->currentFunction = bodyFunction;
+	S->suspendBB	   = NULL;
+	S->cleanupBB	   = NULL;
+	LLVMPositionBuilderAtEnd(S->theBuilder, LLVMAppendBasicBlock(bodyFunction, "entry"));
+
+	LLVMValueRef bodyEnvironment = LLVMBuildBitCast(S->theBuilder, LLVMGetParam(bodyFunction, 0), LLVMPointerType(environmentType, 0), "k_parallelEnv");
+	LLVMValueRef bodyIndex	     = LLVMGetParam(bodyFunction, 1);
+	for (int i = 0; i < environmentSize; i++)
+	{
+		LLVMValueRef idxValueList[] = {LLVMConstInt(LLVMInt32TypeInContext(S->theContext), 0, false), LLVMConstInt(LLVMInt32TypeInContext(S->theContext), i, false)};
+		LLVMValueRef slot	    = LLVMBuildGEP2(S->theBuilder, environmentType, bodyEnvironment, idxValueList, 2, "k_parallelSlot");
+		LLVMValueRef value	    = LLVMBuildLoad2(S->theBuilder, bytePointerType, slot, "");
+		value			    = LLVMBuildBitCast(S->theBuilder, value, LLVMTypeOf(capturedValues[i]), "");
+
+		if (i >= channelSlot)
+		{
+			S->channelList = noisyAddChannelToList(S->channelList, channelSymbols[i - channelSlot], value);
+		}
+		else if (i == captureCount)
+		{
+			setValue = value;
+		}
+		else
+		{
+			parentPointers[i]	 = captures[i]->llvmPointer;
+			captures[i]->llvmPointer = value;
+		}
+	}
+
+	char *	name;
+	asprintf(&name, "var_%s", indexSymbol->identifier);
+	LLVMTypeRef indexType = getLLVMTypeFromNoisyType(S, indexSymbol->noisyType, false, 0);
+	if (isArraySet)
+	{
+		LLVMValueRef elementBase = LLVMBuildBitCast(S->theBuilder, setValue, LLVMPointerType(indexType, 0), "");
+		indexSymbol->llvmPointer = LLVMBuildGEP2(S->theBuilder, indexType, elementBase, &bodyIndex, 1, name);
+	}
+	else
+	{
+		indexSymbol->llvmPointer = LLVMBuildAlloca(S->theBuilder, indexType, name);
+		LLVMBuildStore(S->theBuilder, LLVMBuildIntCast2(S->theBuilder, bodyIndex, indexType, noisyIsSigned(indexSymbol->noisyType), ""), indexSymbol->llvmPointer);
+	}
+
+	noisyStatementListCodeGen(N, S, RL(parallelNode));
+
+	/*
+	 *	Function instances loaded in the body do not outlive it.
+	 */
+	while (S->frameList != parentFrameList)
+	{
+		LLVMValueRef args[]   = {noisyGetFrameFromList(S->frameList)};
+		LLVMValueRef callFunc = LLVMGetNamedFunction(S->theModule, "llvm.coro.destroy");
+		LLVMBuildCall2(S->theBuilder, LLVMGetElementType(LLVMTypeOf(callFunc)), callFunc, args, 1, "");
+		S->frameList = noisyRemoveFrameFromList(S->frameList);
+	}
+	LLVMBuildRetVoid(S->theBuilder);
+
+	for (int i = 0; i < captureCount; i++)
+	{
+		captures[i]->llvmPointer = parentPointers[i];
+	}
+	while (S->channelList != parentChannelList)
+	{
+		ChannelList channelNode = S->channelList;
+		S->channelList		= channelNode->next;
+		free(channelNode);
+	}
+	S->currentFunction = parentFunction;
+	S->suspendBB	   = parentSuspendBB;
+	S->cleanupBB	   = parentCleanupBB;
+	LLVMPositionBuilderAtEnd(S->theBuilder, parentBlock);
+
+	LLVMValueRef parallelFor = LLVMGetNamedFunction(S->theModule, "noisyParallelFor");
+	LLVMTypeRef  forParamTypes[] = {LLVMPointerType(bodyType, 0), bytePointerType, int64Type};
+	LLVMTypeRef  forType	     = LLVMFunctionType(LLVMVoidTypeInContext(S->theContext), forParamTypes, 3, false);
+	if (parallelFor == NULL)
+	{
+		parallelFor = LLVMAddFunction(S->theModule, "noisyParallelFor", forType);
+	}
+
+	LLVMValueRef args[] = {bodyFunction, LLVMBuildBitCast(S->theBuilder, environment, bytePointerType, ""), countValue};
+	LLVMBuildCall2(S->theBuilder, forType, parallelFor, args, 3, "");
+
+	for (int i = 0; i < channelCount; i++)
+	{
+		if (isOwnChannel[i])
+		{
+			noisyChannelDestroyCodeGen(S, channelValues[i]);
+		}
+	}
+
+	free(parentPointers);
+	free(capturedValues);
+	free(captures);
+	free(channelSymbols);
+	free(channelValues);
+	free(isOwnChannel);
+}
+
 void
 noisyOperatorToleranceDeclCodeGen(State *  N, CodeGenState *  S, IrNode *  toleranceDeclNode)
 {
@@ -2512,8 +3203,11 @@ noisyStatementCodeGen(State *  N, CodeGenState *  S, IrNode *  noisyStatementNod
 		case kNoisyIrNodeType_PsequenceStatement:
 			noisySequenceStatementCodeGen(N, S, L(noisyStatementNode));
 			break;
+		case kNoisyIrNodeType_PparallelStatement:
+			noisyParallelStatementCodeGen(N, S, L(noisyStatementNode));
+			break;
 		case kNoisyIrNodeType_PscopedStatementList:
-			noisyStatementListCodeGen(N, S, LL(noisyStatementNode));
+			noisyBlockCodeGen(N, S, LL(noisyStatementNode));
 			break;
 		case kNoisyIrNodeType_PoperatorToleranceDecl:
 			noisyOperatorToleranceDeclCodeGen(N, S, L(noisyStatementNode));
@@ -2702,6 +3396,235 @@ noisyProgramCodeGen(State *  N, CodeGenState *  S, IrNode *  noisyProgramNode)
 	}
 }
 
+/*
+ *	The Noisy runtime functions, for the JIT to resolve calls to them
+ *	without linking noisyLib.o.
+ */
+static const struct
+{
+	const char *	name;
+	void *		address;
+} noisyRuntimeSymbols[] = {
+	{"printInt32",			(void *)printInt32},
+	{"printNat32",			(void *)printNat32},
+	{"printFloat64",		(void *)printFloat64},
+	{"readInt32",			(void *)readInt32},
+	{"readMiddleInt32FromCSV",	(void *)readMiddleInt32FromCSV},
+	{"readInt16FromCSV",		(void *)readInt16FromCSV},
+	{"readFloat64FromCSV",		(void *)readFloat64FromCSV},
+	{"readStartFloat64FromCSV",	(void *)readStartFloat64FromCSV},
+	{"readMiddleFloat64FromCSV",	(void *)readMiddleFloat64FromCSV},
+	{"ekfWrite",			(void *)ekfWrite},
+	{"bmeWrite",			(void *)bmeWrite},
+	{"readFloat32FromCSV",		(void *)readFloat32FromCSV},
+	{"readTemperature",		(void *)readTemperature},
+	{"noisyParallelFor",		(void *)noisyParallelFor},
+	{"noisyChannelCreate",		(void *)noisyChannelCreate},
+	{"noisyChannelSend",		(void *)noisyChannelSend},
+	{"noisyChannelReceive",		(void *)noisyChannelReceive},
+	{"noisyChannelDestroy",		(void *)noisyChannelDestroy},
+	{"noisyFramePoolAllocate",	(void *)noisyFramePoolAllocate},
+	{"noisyFramePoolFree",		(void *)noisyFramePoolFree},
+};
+
+static void
+noisyCodeGenCheckError(State *  N, LLVMErrorRef error, const char *  what)
+{
+	if (error == NULL)
+	{
+		return;
+	}
+
+	char *	msg = LLVMGetErrorMessage(error);
+	flexprint(N->Fe, N->Fm, N->Fperr, "%s failed: %s\n", what, msg);
+	LLVMDisposeErrorMessage(msg);
+	fatal(N, "Code generation Error\n");
+}
+
+/*
+ *	The host target machine, at the code generation level given by -O.
+ *	Relocations are PIC so that the objects link into PIE executables.
+ */
+static LLVMTargetMachineRef
+noisyCodeGenCreateTargetMachine(State *  N)
+{
+	LLVMCodeGenOptLevel	codeGenLevel;
+	LLVMTargetRef		target;
+	char *			msg;
+
+	switch (N->optimizationLevel)
+	{
+		case 0:
+			codeGenLevel = LLVMCodeGenLevelNone;
+			break;
+		case 1:
+			codeGenLevel = LLVMCodeGenLevelLess;
+			break;
+		case 2:
+			codeGenLevel = LLVMCodeGenLevelDefault;
+			break;
+		default:
+			codeGenLevel = LLVMCodeGenLevelAggressive;
+			break;
+	}
+
+	LLVMInitializeNativeTarget();
+	LLVMInitializeNativeAsmPrinter();
+
+	char *	triple = LLVMGetDefaultTargetTriple();
+	if (LLVMGetTargetFromTriple(triple, &target, &msg))
+	{
+		flexprint(N->Fe, N->Fm, N->Fperr, "No target for \"%s\": %s\n", triple, msg);
+		LLVMDisposeMessage(msg);
+		fatal(N, "Code generation Error\n");
+	}
+
+	LLVMTargetMachineRef	targetMachine = LLVMCreateTargetMachine(target, triple, "", "", codeGenLevel,
+									LLVMRelocPIC, LLVMCodeModelDefault);
+	LLVMDisposeMessage(triple);
+
+	return targetMachine;
+}
+
+/*
+ *	Optimize the module with the new pass manager's default pipeline for
+ *	-O1 to -O3, -Os or -Oz. These pipelines split the coroutines, inline
+ *	their ramps into the callers and then elide the frames they no longer
+ *	need on the heap. At -O0 the coroutines are only split, since neither
+ *	the code generator nor the JIT lowers the llvm.coro intrinsics.
+ */
+static void
+noisyCodeGenOptimize(State *  N, CodeGenState *  S)
+{
+	char *				pipeline;
+	LLVMPassBuilderOptionsRef	options = LLVMCreatePassBuilderOptions();
+
+	if (N->optimizationSizeLevel == 1)
+	{
+		pipeline = strdup("default<Os>");
+	}
+	else if (N->optimizationSizeLevel > 1)
+	{
+		pipeline = strdup("default<Oz>");
+	}
+	else if (N->optimizationLevel > 0)
+	{
+		asprintf(&pipeline, "default<O%d>", N->optimizationLevel > 3 ? 3 : (int)N->optimizationLevel);
+	}
+	else
+	{
+		pipeline = strdup("function(coro-early),cgscc(coro-split),function(coro-cleanup)");
+	}
+
+	/*
+	 *	As clang does, vectorize only when optimizing for speed from -O2.
+	 */
+	bool	vectorize = N->optimizationLevel >= 2 && N->optimizationSizeLevel == 0;
+	LLVMPassBuilderOptionsSetLoopVectorization(options, vectorize);
+	LLVMPassBuilderOptionsSetSLPVectorization(options, vectorize);
+
+	LLVMErrorRef	error = LLVMRunPasses(S->theModule, pipeline, S->theTargetMachine, options);
+	if (error != NULL)
+	{
+		char *	msg = LLVMGetErrorMessage(error);
+		flexprint(N->Fe, N->Fm, N->Fperr, "Running \"%s\" failed: %s\n", pipeline, msg);
+		LLVMDisposeErrorMessage(msg);
+		fatal(N, "Code generation Error\n");
+	}
+
+	LLVMDisposePassBuilderOptions(options);
+	free(pipeline);
+}
+
+/*
+ *	Emit an object file with the target machine, in place of llc.
+ */
+static void
+noisyCodeGenEmitObject(State *  N, CodeGenState *  S, char *  fileName)
+{
+	char *	msg;
+
+	if (LLVMTargetMachineEmitToFile(S->theTargetMachine, S->theModule, fileName, LLVMObjectFile, &msg))
+	{
+		flexprint(N->Fe, N->Fm, N->Fperr, "Writing \"%s\" failed: %s\n", fileName, msg);
+		LLVMDisposeMessage(msg);
+		fatal(N, "Code generation Error\n");
+	}
+}
+
+/*
+ *	Run the program's init in this process with an ORC JIT. The runtime
+ *	comes from noisyRuntimeSymbols and everything else, such as libc and
+ *	libm, from the symbols of the process. The JIT needs the module in a
+ *	context of its own, so it is moved across as in-memory bitcode.
+ */
+static int
+noisyCodeGenRun(State *  N, CodeGenState *  S)
+{
+	LLVMOrcLLJITRef				jit;
+	LLVMOrcDefinitionGeneratorRef		processSymbols;
+	LLVMOrcExecutorAddress			initAddress;
+	LLVMModuleRef				jitModule;
+	size_t					runtimeSymbolCount = sizeof(noisyRuntimeSymbols) / sizeof(noisyRuntimeSymbols[0]);
+	LLVMJITCSymbolMapPair			runtimeSymbols[sizeof(noisyRuntimeSymbols) / sizeof(noisyRuntimeSymbols[0])];
+
+	LLVMValueRef	init = LLVMGetNamedFunction(S->theModule, "main");
+	if (init == NULL || LLVMCountParams(init) != 0)
+	{
+		flexprint(N->Fe, N->Fm, N->Fperr, "Running needs an init function without arguments\n");
+		fatal(N, "Code generation Error\n");
+	}
+
+	noisyCodeGenCheckError(N, LLVMOrcCreateLLJIT(&jit, NULL), "Creating the JIT");
+
+	LLVMOrcJITDylibRef	mainLibrary = LLVMOrcLLJITGetMainJITDylib(jit);
+	noisyCodeGenCheckError(N, LLVMOrcCreateDynamicLibrarySearchGeneratorForProcess(&processSymbols, LLVMOrcLLJITGetGlobalPrefix(jit),
+										      NULL, NULL),
+			       "Looking up the process symbols");
+	LLVMOrcJITDylibAddGenerator(mainLibrary, processSymbols);
+
+	for (size_t i = 0; i < runtimeSymbolCount; i++)
+	{
+		runtimeSymbols[i].Name = LLVMOrcLLJITMangleAndIntern(jit, noisyRuntimeSymbols[i].name);
+		runtimeSymbols[i].Sym.Address = (LLVMOrcExecutorAddress)(uintptr_t)noisyRuntimeSymbols[i].address;
+		runtimeSymbols[i].Sym.Flags.GenericFlags = LLVMJITSymbolGenericFlagsExported | LLVMJITSymbolGenericFlagsCallable;
+		runtimeSymbols[i].Sym.Flags.TargetFlags = 0;
+	}
+	LLVMOrcMaterializationUnitRef	runtime = LLVMOrcAbsoluteSymbols(runtimeSymbols, runtimeSymbolCount);
+	LLVMErrorRef			error = LLVMOrcJITDylibDefine(mainLibrary, runtime);
+	if (error != NULL)
+	{
+		LLVMOrcDisposeMaterializationUnit(runtime);
+	}
+	noisyCodeGenCheckError(N, error, "Defining the Noisy runtime");
+
+	LLVMOrcThreadSafeContextRef	context = LLVMOrcCreateNewThreadSafeContext();
+	LLVMMemoryBufferRef		bitcode = LLVMWriteBitcodeToMemoryBuffer(S->theModule);
+	if (LLVMParseBitcodeInContext2(LLVMOrcThreadSafeContextGetContext(context), bitcode, &jitModule))
+	{
+		flexprint(N->Fe, N->Fm, N->Fperr, "Moving the module to the JIT failed\n");
+		fatal(N, "Code generation Error\n");
+	}
+	LLVMDisposeMemoryBuffer(bitcode);
+
+	LLVMOrcThreadSafeModuleRef	module = LLVMOrcCreateNewThreadSafeModule(jitModule, context);
+	LLVMOrcDisposeThreadSafeContext(context);
+	error = LLVMOrcLLJITAddLLVMIRModule(jit, mainLibrary, module);
+	if (error != NULL)
+	{
+		LLVMOrcDisposeThreadSafeModule(module);
+	}
+	noisyCodeGenCheckError(N, error, "Adding the module to the JIT");
+	noisyCodeGenCheckError(N, LLVMOrcLLJITLookup(jit, &initAddress, "main"), "Looking up init");
+
+	int	result = ((int (*)(void))(uintptr_t)initAddress)();
+	fflush(stdout);
+
+	noisyCodeGenCheckError(N, LLVMOrcDisposeLLJIT(jit), "Releasing the JIT");
+
+	return result;
+}
+
 void
 noisyCodeGen(State * N)
 {
@@ -2711,16 +3634,34 @@ noisyCodeGen(State * N)
 	CodeGenState *  S = (CodeGenState *)calloc(1, sizeof(CodeGenState));
 	S->theContext	  = LLVMContextCreate();
 	S->theBuilder	  = LLVMCreateBuilderInContext(S->theContext);
-	S->thePassManager = LLVMCreatePassManager();
 
+	TimeStampPhaseBeginMacro("LLVM IR generation");
 	noisyProgramCodeGen(N, S, N->noisyIrRoot);
+	TimeStampPhaseEndMacro("LLVM IR generation");
 
-	// LLVMAddCoroEarlyPass(S->thePassManager);
-	// LLVMAddCoroSplitPass(S->thePassManager);
-	// LLVMAddCoroElidePass(S->thePassManager);
-	// LLVMAddCoroCleanupPass(S->thePassManager);
+	/*
+	 *	The passes, the object emission and the JIT all expect valid IR, so stop here if it is not.
+	 */
+	char *  msg;
+	if (LLVMVerifyModule(S->theModule, LLVMReturnStatusAction, &msg))
+	{
+		flexprint(N->Fe, N->Fm, N->Fperr, "Verifying the generated module failed: %s\n", msg);
+		LLVMDisposeMessage(msg);
+		fatal(N, "Code generation Error\n");
+	}
+	LLVMDisposeMessage(msg);
+
+	S->theTargetMachine = noisyCodeGenCreateTargetMachine(N);
+	char *			triple = LLVMGetTargetMachineTriple(S->theTargetMachine);
+	LLVMTargetDataRef	dataLayout = LLVMCreateTargetDataLayout(S->theTargetMachine);
+	LLVMSetTarget(S->theModule, triple);
+	LLVMSetModuleDataLayout(S->theModule, dataLayout);
+	LLVMDisposeTargetData(dataLayout);
+	LLVMDisposeMessage(triple);
 
-	LLVMRunPassManager(S->thePassManager, S->theModule);
+	TimeStampPhaseBeginMacro("LLVM passes");
+	noisyCodeGenOptimize(N, S);
+	TimeStampPhaseEndMacro("LLVM passes");
 
 	/*
 	 *	We need to dispose LLVM structures in order to avoid leaking memory. Free code gen state.
@@ -2730,12 +3671,34 @@ noisyCodeGen(State * N)
 	strncpy(fileName2, N->fileName, strlen(N->fileName) - 2);
 	// fileName2[strlen(N->fileName)-2]='\0';
 	asprintf(&fileName, "%s.bc", fileName2);
-	char *  msg;
-	LLVMVerifyModule(S->theModule, LLVMPrintMessageAction, &msg);
-	LLVMDisposeMessage(msg);
-	LLVMWriteBitcodeToFile(S->theModule, fileName);
 
-	LLVMDisposePassManager(S->thePassManager);
+	/*
+	 *	Running in-process needs no files.
+	 */
+	if (N->irBackends & kNoisyIrBackendJit)
+	{
+		TimeStampPhaseBeginMacro("JIT run");
+		N->jitExitStatus = noisyCodeGenRun(N, S);
+		TimeStampPhaseEndMacro("JIT run");
+	}
+	else
+	{
+		TimeStampPhaseBeginMacro("bitcode emission");
+		LLVMWriteBitcodeToFile(S->theModule, fileName);
+		TimeStampPhaseEndMacro("bitcode emission");
+	}
+
+	if (N->irBackends & kNoisyIrBackendObject)
+	{
+		char *  objectFileName;
+		asprintf(&objectFileName, "%s.o", fileName2);
+		TimeStampPhaseBeginMacro("object emission");
+		noisyCodeGenEmitObject(N, S, objectFileName);
+		TimeStampPhaseEndMacro("object emission");
+		free(objectFileName);
+	}
+
+	LLVMDisposeTargetMachine(S->theTargetMachine);
 	LLVMDisposeBuilder(S->theBuilder);
 	LLVMDisposeModule(S->theModule);
 	LLVMContextDispose(S->theContext);
@@ -98,10 +98,15 @@ noisyLexInit(State *  N, char *  fileName)
 	 */
 	
 	/*
-	 *	The following two are needed in order for getline() to allocate the buffer itself
+	 *	N->lineBuffer points into the source buffer set up by lexSourceOpen()
 	 */
 	N->lineBuffer = NULL;
 
+	if (N->keywordTable == NULL)
+	{
+		lexKeywordTableInit(N, gNoisyTokenDescriptions, kNoisyIrNodeTypeMax);
+	}
+
 	noisyLex(N, fileName);
 
 	SourceInfo *	eofSourceInfo = lexAllocateSourceInfo(N,	NULL /* genealogy */,
@@ -123,11 +128,9 @@ noisyLexInit(State *  N, char *  fileName)
 		flexprint(N->Fe, N->Fm, N->Fperr, "Done lexing...\n");
 		
 		flexprint(N->Fe, N->Fm, N->Fperr, "\n\n");
-		Token *	p = N->tokenList;
-		while (p != NULL)
+		for (uint64_t i = 0; i < N->tokenCount; i++)
 		{
-			lexDebugPrintToken(N, p, gNoisyTokenDescriptions);
-			p = p->next;
+			lexDebugPrintToken(N, N->tokens[i], gNoisyTokenDescriptions);
 		}
 		flexprint(N->Fe, N->Fm, N->Fperr, "\n\n");
 	}
@@ -140,15 +143,7 @@ noisyLexInit(State *  N, char *  fileName)
 static void
 noisyLex(State *  N, char *  fileName)
 {
-	size_t		lineBufferSize;
-
-
-	N->filePointer = fopen(fileName, "r");
-	if (N->filePointer == NULL)
-	{
-		flexprint(N->Fe, N->Fm, N->Fperr, "Could not open file \"%s\".\n", fileName);
-		fatal(N, Eopen);
-	}
+	lexSourceOpen(N, fileName);
 
 
 	/*
@@ -164,13 +159,7 @@ noisyLex(State *  N, char *  fileName)
 	 *		anyway to keep copies of inputs), and feed that file to the compiler.
 	 */
 	
-	/*
-	 *	The following two are needed in order for getline() to allocate the buffer itself
-	 */
-	N->lineBuffer = NULL;
-	lineBufferSize = 0;
-
-	while ((N->lineLength = getline(&(N->lineBuffer), &lineBufferSize, N->filePointer)) != -1)
+	while (lexSourceNextLine(N))
 	{
 		N->columnNumber = 0;
 		while (N->columnNumber < N->lineLength)
@@ -393,19 +382,25 @@ noisyLex(State *  N, char *  fileName)
 				}
 			}
 			
-			checkTokenLength(N, 1);
-			N->currentToken[N->currentTokenLength++] = N->lineBuffer[N->columnNumber++];
+			/*
+			 *	Take the whole run of characters up to the next operator or
+			 *	separator from the source buffer at once.
+			 */
+			uint64_t	sliceEnd = N->columnNumber + 1;
+			while (sliceEnd < N->lineLength && !isOperatorOrSeparator(N, N->lineBuffer[sliceEnd]))
+			{
+				sliceEnd++;
+			}
+
+			checkTokenLength(N, sliceEnd - N->columnNumber);
+			memcpy(&N->currentToken[N->currentTokenLength], &N->lineBuffer[N->columnNumber], sliceEnd - N->columnNumber);
+			N->currentTokenLength += sliceEnd - N->columnNumber;
+			N->columnNumber = sliceEnd;
 		}
 		N->lineNumber++;
-	
-		/*
-		 *	In order for getline() to allocate the buffer itself on the next iteration...
-		 */
-		N->lineBuffer = NULL;
-		lineBufferSize = 0;
 	}
 
-	fclose(N->filePointer);
+	lexSourceClose(N);
 	
 }
 
@@ -435,10 +430,9 @@ checkComment(State *  N)
 	finishToken(N);
 
 	/*
-	 *	NOTE: currentToken is allocated only once, but lineBuffer is allocated each 
-	 *	time a line is read via getline().
+	 *	NOTE: N->lineBuffer points into the source buffer, which lexSourceClose()
+	 *	releases once the whole file has been lexed.
 	 */
-	free(N->lineBuffer);
 }
 
 
@@ -508,7 +502,7 @@ checkWeq3(State *  N, IrNodeType type1, IrNodeType type2, char char2, IrNodeType
 		gobble(N, 2);
 		type = type1;
 	}
-	else if (N->lineLength >= 2 && N->lineBuffer[N->columnNumber+1] == char2)
+	else if (N->columnNumber + 2 <= N->lineLength && N->lineBuffer[N->columnNumber+1] == char2)
 	{
 		gobble(N, 2);
 		type = type2;
@@ -621,14 +615,14 @@ checkGt(State *  N)
 		gobble(N, 2);
 		type = kNoisyIrNodeType_TgreaterThanEqual;
 	}
-	else if (N->lineLength >= 3 &&
+	else if (N->columnNumber + 3 <= N->lineLength &&
 		N->lineBuffer[N->columnNumber+1] == '>' &&
 		N->lineBuffer[N->columnNumber+2] == '=')
 	{
 		gobble(N, 3);
 		type = kNoisyIrNodeType_TrightShiftAssign;
 	}
-	else if (N->lineLength >= 2 &&
+	else if (N->columnNumber + 2 <= N->lineLength &&
 		N->lineBuffer[N->columnNumber+1] == '>')
 	{
 		gobble(N, 2);
@@ -671,27 +665,27 @@ checkLt(State *  N)
 		gobble(N, 2);
 		type = kNoisyIrNodeType_TlessThanEqual;
 	}
-	else if (N->lineLength >= 3 &&
+	else if (N->columnNumber + 3 <= N->lineLength &&
 		N->lineBuffer[N->columnNumber+1] == '<' &&
 		N->lineBuffer[N->columnNumber+2] == '=')
 	{
 		gobble(N, 3);
 		type = kNoisyIrNodeType_TleftShiftAssign;
 	}
-	else if (N->lineLength >= 3 &&
+	else if (N->columnNumber + 3 <= N->lineLength &&
 		N->lineBuffer[N->columnNumber+1] == '-' &&
 		N->lineBuffer[N->columnNumber+2] == '=')
 	{
 		gobble(N, 3);
 		type = kNoisyIrNodeType_TchannelOperatorAssign;
 	}
-	else if (N->lineLength >= 2 &&
+	else if (N->columnNumber + 2 <= N->lineLength &&
 		N->lineBuffer[N->columnNumber+1] == '<')
 	{
 		gobble(N, 2);
 		type = kNoisyIrNodeType_TleftShift;
 	}
-	else if (N->lineLength >= 2 &&
+	else if (N->columnNumber + 2 <= N->lineLength &&
 		N->lineBuffer[N->columnNumber+1] == '-')
 	{
 		gobble(N, 2);
@@ -735,7 +729,7 @@ checkSingleQuote(State *  N)
 	finishToken(N);
 
 
-	if ((N->lineLength >= 3) && (N->lineBuffer[N->columnNumber+2] == '\''))
+	if ((N->columnNumber + 3 <= N->lineLength) && (N->lineBuffer[N->columnNumber+2] == '\''))
 	{
 		type = kNoisyIrNodeType_TcharConst;
 		quotedChar = N->lineBuffer[N->columnNumber+1];
@@ -751,7 +745,7 @@ checkSingleQuote(State *  N)
 		 *	character after the quote as the token character constant.
 		 */
 		type = kNoisyIrNodeType_ZbadCharConst;
-		quotedChar = N->lineBuffer[N->columnNumber+1];
+		quotedChar = (N->columnNumber + 2 <= N->lineLength) ? N->lineBuffer[N->columnNumber+1] : '\0';
 		gobble(N, 1);
 	}
 
@@ -795,13 +789,22 @@ checkDoubleQuote(State *  N, bool callFinishTokenFlag)
 	 *	N->lineBuffer must contain the closing quote, else we flag this as a
 	 *	bad string constant (kNoisyIrNodeType_ZbadStringConst)
 	 */
-	if (strchr(&N->lineBuffer[N->columnNumber+1], '\"') == NULL)
+	if (memchr(&N->lineBuffer[N->columnNumber+1], '\"', N->lineLength - N->columnNumber - 1) == NULL)
 	{
+		/*
+		 *	Lines in the source buffer are not '\0'-terminated, so the rest
+		 *	of the line is taken into N->currentToken for the token.
+		 */
+		checkTokenLength(N, N->lineLength - N->columnNumber);
+		memcpy(&N->currentToken[N->currentTokenLength], &N->lineBuffer[N->columnNumber], N->lineLength - N->columnNumber);
+		N->currentTokenLength	+= N->lineLength - N->columnNumber;
+		N->columnNumber		= N->lineLength;
+
 		newToken = lexAllocateToken(N,	kNoisyIrNodeType_ZbadStringConst	/* type		*/,
 							NULL					/* identifier	*/,
 							0					/* integerConst	*/,
 							0.0					/* realConst	*/,
-							&N->lineBuffer[N->columnNumber]		/* stringConst	*/,
+							N->currentToken				/* stringConst	*/,
 							NULL					/* sourceInfo	*/);
 	}
 	else
@@ -885,12 +888,12 @@ checkMinus(State *  N)
 		gobble(N, 2);
 		type = kNoisyIrNodeType_TminusAssign;
 	}
-	else if (N->lineLength >= 2 && N->lineBuffer[N->columnNumber+1] == '-')
+	else if (N->columnNumber + 2 <= N->lineLength && N->lineBuffer[N->columnNumber+1] == '-')
 	{
 		gobble(N, 2);
 		type = kNoisyIrNodeType_TminusMinus;
 	}
-	else if (N->lineLength >= 2 && N->lineBuffer[N->columnNumber+1] == '>')
+	else if (N->columnNumber + 2 <= N->lineLength && N->lineBuffer[N->columnNumber+1] == '>')
 	{
 		gobble(N, 2);
 		type = kNoisyIrNodeType_Tarrow;
@@ -1174,85 +1177,81 @@ finishToken(State *  N)
 		return;
 	}
 
-	for (int i = 0; i < kNoisyIrNodeTypeMax; i++)
+	if (!strcmp("include", N->currentToken))
 	{
-		if (!strcmp("include", N->currentToken))
-		{
-			/*
-			 *	Reset the index in the current token to place the filename string
-			 *	over the "include" since we don't need to keep that. Then, call
-			 *	checkDoubleQuote()
-			 */
-			N->currentTokenLength = 0;
-			checkDoubleQuote(N, false /* callFinishTokenFlag */);
-
-			/*
-			 *	Since we don't call done() (which sets the N->currentTokenLength
-			 *	to zero and bzero's the N->currentToken buffer), we need to do
-			 *	this manually.
-			 */
-			bzero(N->currentToken, kCommonMaxBufferLength);
-			N->currentTokenLength = 0;
-
-			char *	newFileName = strdup(N->lastToken->stringConst);
-			if (!newFileName)
-			{
-				fatal(N, Emalloc);
-			}
-
-			Token *	tmp		= N->lastToken;
-			N->lastToken		= N->lastToken->prev;
-			if (N->lastToken == NULL)
-			{
-				N->tokenList = N->lastToken;
-			}
-
-			free(tmp->stringConst);
-			free(tmp);
+		/*
+		 *	Reset the index in the current token to place the filename string
+		 *	over the "include" since we don't need to keep that. Then, call
+		 *	checkDoubleQuote()
+		 */
+		N->currentTokenLength = 0;
+		checkDoubleQuote(N, false /* callFinishTokenFlag */);
 
-			char *	oldFileName	= N->fileName;
-			int	oldColumnNumber	= N->columnNumber;
-			int	oldLineNumber	= N->lineNumber;
-			FILE *	oldFilePointer	= N->filePointer;
+		/*
+		 *	Since we don't call done() (which sets the N->currentTokenLength
+		 *	to zero and bzero's the N->currentToken buffer), we need to do
+		 *	this manually.
+		 */
+		bzero(N->currentToken, kCommonMaxBufferLength);
+		N->currentTokenLength = 0;
 
-			N->fileName 		= newFileName;
-			N->columnNumber		= 1;
-			N->lineNumber		= 1;
-			N->lineLength		= 0;
-			N->lineBuffer		= NULL;
-			noisyLex(N, newFileName);
-			free(newFileName);
+		char *	newFileName = strdup(N->tokens[N->tokenCount - 1]->stringConst);
+		if (!newFileName)
+		{
+			fatal(N, Emalloc);
+		}
 
-			N->fileName		= oldFileName;
-			N->filePointer		= oldFilePointer;
-			N->lineNumber		= oldLineNumber;
+		/*
+		 *	Drop the file name token. It lives in the lex arena and its
+		 *	string in the intern pool, so neither is freed here.
+		 */
+		N->tokenCount--;
+
+		char *	oldFileName	= N->fileName;
+		int	oldColumnNumber	= N->columnNumber;
+		int	oldLineNumber	= N->lineNumber;
+		char *	oldLineBuffer	= N->lineBuffer;
+		SourceBuffer	oldSource	= N->source;
+
+		N->fileName 		= newFileName;
+		N->columnNumber		= 1;
+		N->lineNumber		= 1;
+		N->lineLength		= 0;
+		N->lineBuffer		= NULL;
+		noisyLex(N, newFileName);
+		free(newFileName);
+
+		N->fileName		= oldFileName;
+		N->source		= oldSource;
+		N->lineBuffer		= oldLineBuffer;
+		N->lineNumber		= oldLineNumber;
 
-			/*
-			 *	Set the columnNumber and lineLength to be same to force
-			 *	ourselves to stop chomping on the same line.
-			 */
-			N->columnNumber		= oldColumnNumber;
-			N->lineLength		= oldColumnNumber;
+		/*
+		 *	Set the columnNumber and lineLength to be same to force
+		 *	ourselves to stop chomping on the same line.
+		 */
+		N->columnNumber		= oldColumnNumber;
+		N->lineLength		= oldColumnNumber;
 
-			return;
-		}
+		return;
+	}
 
-		if ((gNoisyTokenDescriptions[i] != NULL) && !strcmp(gNoisyTokenDescriptions[i], N->currentToken))
-		{
-			Token *	newToken = lexAllocateToken(N,	i	/* type		*/,
-										NULL	/* identifier	*/,
-										0	/* integerConst	*/,
-										0.0	/* realConst	*/,
-										NULL	/* stringConst	*/,
-										NULL	/* sourceInfo	*/);
+	int	keywordType = lexKeywordLookup(N, N->currentToken, N->currentTokenLength);
+	if (keywordType >= 0)
+	{
+		Token *	newToken = lexAllocateToken(N,	keywordType	/* type		*/,
+									NULL	/* identifier	*/,
+									0	/* integerConst	*/,
+									0.0	/* realConst	*/,
+									NULL	/* stringConst	*/,
+									NULL	/* sourceInfo	*/);
 
-			/*
-			 *	done() sets the N->currentTokenLength to zero and bzero's the N->currentToken buffer.
-			 */
-			done(N, newToken);
+		/*
+		 *	done() sets the N->currentTokenLength to zero and bzero's the N->currentToken buffer.
+		 */
+		done(N, newToken);
 
-			return;
-		}
+		return;
 	}
 
 	if (N->currentToken[0] >= '0' && N->currentToken[0] <= '9')
@@ -60,6 +60,7 @@
 #include "common-lexers-helpers.h"
 #include "noisy-lexer.h"
 #include "common-symbolTable.h"
+#include "common-arena.h"
 #include "common-irHelpers.h"
 #include "noisy-irHelpers.h"
 #include "common-firstAndFollow.h"
@@ -3157,7 +3158,7 @@ noisyParseFunctionDefn(State *  N, Scope *  scope)
 	 *	main AST with new links, so we make copies.
 	 */
 	
-	IrNode * typeTree = calloc(1,sizeof(IrNode));
+	IrNode * typeTree = commonArenaAlloc(N, kCommonArenaRegionParse, sizeof(IrNode));
 	addLeaf(N, typeTree, shallowCopyIrNode(N, t1));
 	addLeaf(N, typeTree, shallowCopyIrNode(N, t2));
 
@@ -8047,7 +8048,7 @@ noisyParserErrorRecovery(State *  N, IrNodeType expectedProductionOrToken)
 	}
 
 	/*
-	while (!inFollow(N, expectedProductionOrToken, gNoisyFollows, kNoisyIrNodeTypeMax) && N->tokenList != NULL)
+	while (!inFollow(N, expectedProductionOrToken, gNoisyFollows, kNoisyIrNodeTypeMax) && N->tokenCursor < N->tokenCount)
 	{
 		 *
 		 *	Retrieve token and discard...
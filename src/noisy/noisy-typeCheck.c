@@ -18,6 +18,7 @@
 #include "common-timeStamps.h"
 #include "common-data-structures.h"
 #include "common-symbolTable.h"
+#include "common-arena.h"
 #include "common-irHelpers.h"
 #include "noisy-typeCheck.h"
 
@@ -1453,7 +1454,7 @@ getNoisyTypeFromExpression(State *  N, IrNode *  noisyExpressionNode, Scope *  c
 				 */
 				funcSymbol->isTypeComplete = true;
 
-				Token *  t     = calloc(1, sizeof(Token));
+				Token *  t     = commonArenaAlloc(N, kCommonArenaRegionLex, sizeof(Token));
 				t->sourceInfo = funcSymbol->sourceInfo;
 
 				// FIX: NoisySymbolType to IrNodeType without a cast
@@ -1467,7 +1468,7 @@ getNoisyTypeFromExpression(State *  N, IrNode *  noisyExpressionNode, Scope *  c
 				newFunctionSym->parameterNum   = funcSymbol->parameterNum;
 				newFunctionSym->isTypeComplete = funcSymbol->isTypeComplete;
 				
-				IrNode *  newTypeTree	       = calloc(1, sizeof(IrNode));
+				IrNode *  newTypeTree	       = commonArenaAlloc(N, kCommonArenaRegionParse, sizeof(IrNode));
 				newTypeTree->irLeftChild       = RL(newFunctionSym->functionDefinition);
 				newTypeTree->irRightChild      = RRL(newFunctionSym->functionDefinition);
 				newFunctionSym->typeTree       = newTypeTree;
@@ -1985,6 +1986,163 @@ noisySequenceStatementTypeCheck(State *  N, IrNode *  noisySequenceStatementNode
 	noisyStatementListTypeCheck(N, RL(noisySequenceStatementNode), currentScope);
 }
 
+/*
+ *	The body of a parallel statement runs outside the coroutine of its function,
+ *	so it cannot return from the function nor suspend on its channels. It can
+ *	use the channels of function instances, which the runtime serializes.
+ */
+bool
+noisyParallelIsInstance(IrNode *  node)
+{
+	return node != NULL && node->type == kNoisyIrNodeType_PqualifiedIdentifier && L(node)->symbol != NULL
+		&& L(node)->symbol->noisyType.basicType == noisyBasicTypeNamegenType;
+}
+
+void
+noisyParallelBodyTypeCheck(State *  N, IrNode *  node)
+{
+	if (node == NULL)
+	{
+		return;
+	}
+
+	if (node->type == kNoisyIrNodeType_PreturnStatement)
+	{
+		noisySemanticError(N, node, "Return statements are not allowed in the body of a parallel statement\n");
+		noisySemanticErrorRecovery(N);
+	}
+	else if (node->type == kNoisyIrNodeType_PunaryOp && L(node) != NULL && L(node)->type == kNoisyIrNodeType_TchannelOperator
+		 && (R(node->irParent) == NULL || !noisyParallelIsInstance(RL(node->irParent))))
+	{
+		noisySemanticError(N, node, "The body of a parallel statement can only use the channels of function instances\n");
+		noisySemanticErrorRecovery(N);
+	}
+	else if (node->type == kNoisyIrNodeType_PassignmentStatement && R(node) != NULL && R(node)->type == kNoisyIrNodeType_Xseq
+		 && RLL(node)->type == kNoisyIrNodeType_TchannelOperatorAssign)
+	{
+		for (IrNode *  iter = L(node); iter != NULL; iter = R(iter))
+		{
+			if (!noisyParallelIsInstance(LL(iter)))
+			{
+				noisySemanticError(N, node, "The body of a parallel statement can only use the channels of function instances\n");
+				noisySemanticErrorRecovery(N);
+			}
+		}
+	}
+
+	noisyParallelBodyTypeCheck(N, L(node));
+	noisyParallelBodyTypeCheck(N, R(node));
+}
+
+/*
+ *	Whether the subtree defines symbol, in a definition or as the identifier of the set head of
+ *	a parallel statement.
+ */
+bool
+noisyParallelDefines(IrNode *  node, Symbol *  symbol)
+{
+	if (node == NULL)
+	{
+		return false;
+	}
+
+	if (node->type == kNoisyIrNodeType_PassignmentStatement && R(node) != NULL
+	    && (R(node)->type != kNoisyIrNodeType_Xseq || RLL(node)->type == kNoisyIrNodeType_TcolonAssign))
+	{
+		for (IrNode *  iter = L(node); iter != NULL; iter = R(iter))
+		{
+			if (LL(iter)->type == kNoisyIrNodeType_PqualifiedIdentifier && LLL(iter)->symbol == symbol)
+			{
+				return true;
+			}
+		}
+	}
+	else if (node->type == kNoisyIrNodeType_PsetHead && L(node)->symbol == symbol)
+	{
+		return true;
+	}
+
+	return noisyParallelDefines(L(node), symbol) || noisyParallelDefines(R(node), symbol);
+}
+
+/*
+ *	All indexes of a parallel statement share the variables its body does not define, so the
+ *	body can only assign to its own variables and its index. Of the others it can only assign to
+ *	the elements of arrays, and each index should only assign to elements no other index uses.
+ */
+void
+noisyParallelAssignmentsTypeCheck(State *  N, IrNode *  node, IrNode *  bodyNode, Symbol *  indexSymbol)
+{
+	if (node == NULL)
+	{
+		return;
+	}
+
+	if (node->type == kNoisyIrNodeType_PassignmentStatement && R(node) != NULL && R(node)->type == kNoisyIrNodeType_Xseq
+	    && RLL(node)->type != kNoisyIrNodeType_TcolonAssign && RLL(node)->type != kNoisyIrNodeType_TchannelOperatorAssign)
+	{
+		for (IrNode *  iter = L(node); iter != NULL; iter = R(iter))
+		{
+			if (LL(iter)->type != kNoisyIrNodeType_PqualifiedIdentifier)
+			{
+				continue;
+			}
+
+			Symbol *   lvalSymbol = LLL(iter)->symbol;
+			NoisyType  lValueType = lvalSymbol->typeTree != NULL ? getNoisyTypeFromTypeExpr(N, lvalSymbol->typeTree) : lvalSymbol->noisyType;
+			bool	   isElement  = lValueType.basicType == noisyBasicTypeArrayType && LLR(iter) != NULL;
+
+			if (lvalSymbol != indexSymbol && !isElement && !noisyParallelDefines(bodyNode, lvalSymbol))
+			{
+				char *  details;
+
+				asprintf(&details, "The indexes of a parallel statement share \"%s\", so its body can only assign to it element by element, if it is an array\n",
+					 lvalSymbol->identifier);
+				noisySemanticError(N, iter, details);
+				noisySemanticErrorRecovery(N);
+			}
+		}
+	}
+
+	noisyParallelAssignmentsTypeCheck(N, L(node), bodyNode, indexSymbol);
+	noisyParallelAssignmentsTypeCheck(N, R(node), bodyNode, indexSymbol);
+}
+
+/*
+ *	The identifier of the set head goes over 0 up to the value of an integer expression,
+ *	or over the elements of a one-dimensional array.
+ */
+void
+noisyParallelStatementTypeCheck(State *  N, IrNode *  noisyParallelStatementNode, Scope *  currentScope)
+{
+	IrNode *   setHeadNode = L(noisyParallelStatementNode);
+	NoisyType  exprType    = getNoisyTypeFromExpression(N, R(setHeadNode), currentScope->parent);
+	NoisyType  elementType = exprType;
+
+	if (exprType.basicType == noisyBasicTypeArrayType && exprType.dimensions == 1)
+	{
+		elementType.basicType = exprType.arrayType;
+	}
+	else if (exprType.basicType == noisyBasicTypeIntegerConstType)
+	{
+		elementType.basicType = noisyBasicTypeInt32;
+	}
+	else if (!noisyIsOfType(exprType, noisyBasicTypeIntegerConstType))
+	{
+		char *  details;
+
+		asprintf(&details, "The set of a parallel statement must be an integer or a one-dimensional array\n");
+		noisySemanticError(N, R(setHeadNode), details);
+		noisySemanticErrorRecovery(N);
+	}
+	setHeadNode->noisyType		  = exprType.basicType == noisyBasicTypeArrayType ? exprType : elementType;
+	L(setHeadNode)->symbol->noisyType = elementType;
+
+	noisyStatementListTypeCheck(N, RL(noisyParallelStatementNode), currentScope);
+	noisyParallelBodyTypeCheck(N, R(noisyParallelStatementNode));
+	noisyParallelAssignmentsTypeCheck(N, R(noisyParallelStatementNode), R(noisyParallelStatementNode), L(setHeadNode)->symbol);
+}
+
 void
 noisyReturnStatementTypeCheck(State *  N, IrNode *  noisyReturnStatementNode, Scope *  currentScope)
 {
@@ -2040,6 +2198,9 @@ noisyStatementTypeCheck(State *  N, IrNode *  noisyStatementNode, Scope *  curre
 		case kNoisyIrNodeType_PsequenceStatement:
 			noisySequenceStatementTypeCheck(N, L(noisyStatementNode), currentScope);
 			break;
+		case kNoisyIrNodeType_PparallelStatement:
+			noisyParallelStatementTypeCheck(N, L(noisyStatementNode), currentScope);
+			break;
 		case kNoisyIrNodeType_PscopedStatementList:
 			noisyStatementListTypeCheck(N, LL(noisyStatementNode), currentScope);
 			break;
@@ -2071,7 +2232,7 @@ noisyStatementListTypeCheck(State *  N, IrNode * statementListNode, Scope *  cur
 				noisyStatementTypeCheck(N, L(iter), nextScope);
 				nextScope = currentScope->next;
 			}
-			else if (LL(iter)->type == kNoisyIrNodeType_PsequenceStatement || LL(iter)->type == kNoisyIrNodeType_PmatchStatement)
+			else if (LL(iter)->type == kNoisyIrNodeType_PsequenceStatement || LL(iter)->type == kNoisyIrNodeType_PparallelStatement || LL(iter)->type == kNoisyIrNodeType_PmatchStatement)
 			{
 				noisyStatementTypeCheck(N, L(iter), sequenceScope);
 				sequenceScope = sequenceScope->next;